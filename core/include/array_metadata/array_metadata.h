@@ -183,6 +183,13 @@ class ArrayMetadata {
       const std::vector<std::string>& attributes,
       std::vector<unsigned int>& attribute_ids) const;
 
+  /**
+   * Returns *true* if per-tile min/max statistics are maintained for the
+   * input attribute, i.e., if it is a real attribute storing a single
+   * numeric value per cell.
+   */
+  bool has_tile_stats(unsigned int attribute_id) const;
+
   /**
    * Serializes the array metadata object into a buffer.
    *
@@ -309,12 +316,33 @@ class ArrayMetadata {
    */
   bool check_attribute_dimension_names() const;
 
+  /** Returns false if some attribute has a zero chunk size. */
+  bool check_chunk_sizes() const;
+
   /**
-   * Returns false if double delta compression is used with real attributes
-   * or coordinates and true otherwise.
+   * Returns false if (block) double delta compression is used with real
+   * attributes or coordinates and true otherwise.
    */
   bool check_double_delta_compressor() const;
 
+  /**
+   * Returns false if Gorilla compression is used with attributes or
+   * coordinates whose values are not 32-bit or 64-bit and true otherwise.
+   */
+  bool check_gorilla_compressor() const;
+
+  /**
+   * Returns false if the delta filter is used with real attributes and true
+   * otherwise.
+   */
+  bool check_delta_filter() const;
+
+  /**
+   * Returns false if the dictionary filter is used with fixed-sized
+   * attributes and true otherwise.
+   */
+  bool check_dictionary_filter() const;
+
   /** Clears all members. Use with caution! */
   void clear();
 
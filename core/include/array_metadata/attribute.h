@@ -38,6 +38,7 @@
 #include "buffer.h"
 #include "compressor.h"
 #include "datatype.h"
+#include "filter.h"
 #include "status.h"
 
 namespace tiledb {
@@ -83,23 +84,39 @@ class Attribute {
   /** Returns the number of values per cell. */
   unsigned int cell_val_num() const;
 
+  /**
+   * Returns the size of the chunks that the attribute tiles are split into
+   * upon compression.
+   */
+  uint64_t chunk_size() const;
+
   /** Returns the compressor. */
   Compressor compressor() const;
 
   /** Returns the compression level. */
   int compression_level() const;
 
+  /**
+   * Returns the capacity of the ZSTD dictionaries trained for the attribute
+   * files upon writing a fragment (0 if no dictionaries are trained).
+   */
+  uint64_t compression_dictionary_size() const;
+
   /**
    * Populates the object members from the data in the input binary buffer.
    *
    * @param buff The buffer to deserialize from.
+   * @param version The version of the library that serialized the buffer.
    * @return Status
    */
-  Status deserialize(ConstBuffer* buff);
+  Status deserialize(ConstBuffer* buff, const int* version);
 
   /** Dumps the attribute contents in ASCII form in the selected output. */
   void dump(FILE* out) const;
 
+  /** Returns the filter applied to the tile chunks before compression. */
+  Filter filter() const;
+
   /** Returns the attribute name. */
   const std::string& name() const;
 
@@ -114,12 +131,33 @@ class Attribute {
   /** Sets the attribute number of values per cell. */
   void set_cell_val_num(unsigned int cell_val_num);
 
+  /**
+   * Sets the size of the chunks that the attribute tiles are split into
+   * upon compression. Chunks are compressed independently (and in parallel).
+   */
+  void set_chunk_size(uint64_t chunk_size);
+
   /** Sets the attribute compressor. */
   void set_compressor(Compressor compressor);
 
   /** Sets the attribute compression level. */
   void set_compression_level(int compression_level);
 
+  /**
+   * Sets the capacity of the ZSTD dictionaries trained for the attribute
+   * files upon writing a fragment. A dictionary is trained on a sample of
+   * the first tiles of each ZSTD-compressed file of the attribute (i.e., the
+   * values and, for variable-sized attributes, the offsets), and it is
+   * stored in the fragment metadata. 0 disables the dictionaries.
+   */
+  void set_compression_dictionary_size(uint64_t compression_dictionary_size);
+
+  /**
+   * Sets the filter applied to the tile chunks before compression (and
+   * undone after decompression).
+   */
+  void set_filter(Filter filter);
+
   /** Returns the attribute type. */
   Datatype type() const;
 
@@ -137,12 +175,21 @@ class Attribute {
   /** The attribute number of values per cell. */
   unsigned int cell_val_num_;
 
+  /** The size of the chunks the attribute tiles are compressed in. */
+  uint64_t chunk_size_;
+
   /** The attribute compressor. */
   Compressor compressor_;
 
   /** The attribute compression level. */
   int compression_level_;
 
+  /** The capacity of the ZSTD dictionaries of the attribute files. */
+  uint64_t compression_dictionary_size_;
+
+  /** The filter applied to the tile chunks before compression. */
+  Filter filter_;
+
   /** The attribute name. */
   std::string name_;
 
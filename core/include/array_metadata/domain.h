@@ -85,6 +85,12 @@ class Domain {
   Status add_dimension(
       const char* name, const void* domain, const void* tile_extent);
 
+  /**
+   * Returns the number of cells in the input subarray (applicable only to
+   * dense arrays).
+   */
+  uint64_t cell_num(const void* subarray) const;
+
   /** Returns the number of cells per tile (only for the dense case). */
   uint64_t cell_num_per_tile() const;
 
@@ -128,6 +128,15 @@ class Buffer {
   /** Returns the buffer size. */
   uint64_t size() const;
 
+  /**
+   * Exchanges the contents (data, size, offset and ownership) of the buffer
+   * with those of the input buffer, without copying any data.
+   *
+   * @param buffer The buffer to swap with.
+   * @return void
+   */
+  void swap(Buffer* buffer);
+
   /**
    * Returns the value of type T at the input offset.
    *
@@ -146,6 +155,17 @@ class Buffer {
     return ((T*)(((char*)data_) + offset_))[0];
   }
 
+  /**
+   * Makes the buffer reference an existing memory region, which it does not
+   * own, deallocating any memory the buffer owned. The size is set to
+   * *size* and the offset is reset.
+   *
+   * @param data The memory region to reference.
+   * @param size The size of the region.
+   * @return void
+   */
+  void wrap(void* data, uint64_t size);
+
   /**
    * Writes into the local buffer by reading as much data as possible from
    * the input buffer. No new memory is allocated for the local buffer.
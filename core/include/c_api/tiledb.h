@@ -135,6 +135,13 @@ typedef enum {
 #undef TILEDB_COMPRESSOR_ENUM
 } tiledb_compressor_t;
 
+/** Pre-compression filter type. */
+typedef enum {
+#define TILEDB_FILTER_ENUM(id) TILEDB_##id
+#include "tiledb_enum.inc"
+#undef TILEDB_FILTER_ENUM
+} tiledb_filter_t;
+
 /** Walk traversal order. */
 typedef enum {
 #define TILEDB_WALK_ORDER_ENUM(id) TILEDB_##id
@@ -142,6 +149,13 @@ typedef enum {
 #undef TILEDB_WALK_ORDER_ENUM
 } tiledb_walk_order_t;
 
+/** Predicate comparison operator. */
+typedef enum {
+#define TILEDB_PREDICATE_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.inc"
+#undef TILEDB_PREDICATE_OP_ENUM
+} tiledb_predicate_op_t;
+
 /* ****************************** */
 /*            VERSION             */
 /* ****************************** */
@@ -159,6 +173,9 @@ TILEDB_EXPORT void tiledb_version(int* major, int* minor, int* rev);
 /*           TILEDB TYPES            */
 /* ********************************* */
 
+/** A TileDB configuration. */
+typedef struct tiledb_config_t tiledb_config_t;
+
 /** A TileDB context. */
 typedef struct tiledb_ctx_t tiledb_ctx_t;
 
@@ -186,6 +203,68 @@ typedef struct tiledb_domain_t tiledb_domain_t;
 /** A TileDB query. */
 typedef struct tiledb_query_t tiledb_query_t;
 
+/* ********************************* */
+/*               CONFIG              */
+/* ********************************* */
+
+/**
+ * Creates a TileDB configuration object, with all the parameters set to
+ * their default values.
+ *
+ * @param config The configuration object to be created.
+ * @return TILEDB_OK for success and TILEDB_OOM or TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_config_create(tiledb_config_t** config);
+
+/**
+ * Destroys a TileDB configuration object, properly freeing-up all memory.
+ *
+ * @param config The configuration object to be freed.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_config_free(tiledb_config_t* config);
+
+/**
+ * Sets a configuration parameter. The supported parameters are:
+ *
+ * - `sm.adaptive_compressors`: The candidate compressors TILEDB_ADAPTIVE
+ *    tries on every tile chunk, as a comma-separated list of compressor
+ *    names (e.g., `ZSTD`), each optionally followed by `:` and a
+ *    compression level. Default: `RLE,DOUBLE_DELTA,LZ4,ZSTD:1,ZSTD:9`.
+ * - `sm.adaptive_decode_weight`: How much TILEDB_ADAPTIVE favors
+ *    decompression speed over compression ratio. With 0, the candidate
+ *    with the smallest output is selected. Default: 0.
+ * - `sm.num_threads`: The number of threads the storage manager uses for
+ *    internal parallel work, such as compression and decompression.
+ *    Default: the number of hardware threads.
+ * - `sm.parallel_read_blocks`: The maximum number of blocks of tiles that
+ *    a read query is split into, which are read concurrently. Setting it
+ *    to 1 disables parallel reads. Default: 0, i.e., `sm.num_threads`.
+ * - `sm.tile_cache_size`: The maximum total size in bytes of the
+ *    decompressed tiles cached across queries. Setting it to 0 disables
+ *    the tile cache. Default: 10MB.
+ * - `vfs.max_open_files`: The maximum number of file descriptors kept open
+ *    across reads and writes, so that files need not be reopened upon
+ *    every tile access. Setting it to 0 disables the descriptor cache.
+ *    Default: 256.
+ * - `vfs.mmap_reads`: If `true`, uncompressed tiles of POSIX files are read
+ *    through a read-only memory mapping of the file, without copying them.
+ *    Default: `false`.
+ * - `vfs.io_uring`: If `true`, asynchronous reads and writes of POSIX files
+ *    are submitted to io_uring, if supported by the build and the kernel.
+ *    Default: `true`.
+ * - `vfs.async_threads`: The number of threads executing the asynchronous
+ *    reads and writes when io_uring is not used. Default: 4.
+ *
+ * @param config The configuration object.
+ * @param param The parameter name.
+ * @param value The parameter value.
+ * @return TILEDB_OK for success and TILEDB_ERR for error, e.g., if the
+ *     parameter is unknown or the value is invalid.
+ */
+TILEDB_EXPORT int tiledb_config_set(
+    tiledb_config_t* config, const char* param, const char* value);
+
 /* ********************************* */
 /*              CONTEXT              */
 /* ********************************* */
@@ -195,9 +274,13 @@ typedef struct tiledb_query_t tiledb_query_t;
  * that manages everything in the TileDB library.
  *
  * @param ctx The TileDB context to be created.
+ * @param config The configuration parameters of the context. If it is
+ *     NULL, the default configuration is used. The object can be freed
+ *     right after the context is created.
  * @return TILEDB_OK for success and TILEDB_OOM or TILEDB_ERR for error.
  */
-TILEDB_EXPORT int tiledb_ctx_create(tiledb_ctx_t** ctx);
+TILEDB_EXPORT int tiledb_ctx_create(
+    tiledb_ctx_t** ctx, tiledb_config_t* config);
 
 /**
  * Destroys the TileDB context, properly freeing-up all memory.
@@ -207,6 +290,19 @@ TILEDB_EXPORT int tiledb_ctx_create(tiledb_ctx_t** ctx);
  */
 TILEDB_EXPORT int tiledb_ctx_free(tiledb_ctx_t* ctx);
 
+/**
+ * Retrieves the statistics of the tile cache of a TileDB context, which
+ * holds decompressed tiles across queries (see `sm.tile_cache_size` in
+ * `tiledb_config_set`).
+ *
+ * @param ctx The TileDB context.
+ * @param hits The number of tile reads served by the cache.
+ * @param misses The number of tile reads that missed the cache.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_ctx_get_tile_cache_stats(
+    tiledb_ctx_t* ctx, uint64_t* hits, uint64_t* misses);
+
 /* ********************************* */
 /*              ERROR                */
 /* ********************************* */
@@ -308,6 +404,59 @@ TILEDB_EXPORT int tiledb_attribute_set_compressor(
 TILEDB_EXPORT int tiledb_attribute_set_cell_val_num(
     tiledb_ctx_t* ctx, tiledb_attribute_t* attr, unsigned int cell_val_num);
 
+/**
+ * Sets the size of the chunks that the attribute tiles are split into upon
+ * compression. The chunks of a tile are compressed and decompressed
+ * independently and in parallel.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param chunk_size The chunk size in bytes. It is rounded down to a
+ *     multiple of the attribute cell size.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_chunk_size(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, uint64_t chunk_size);
+
+/**
+ * Sets a filter to an attribute, which is applied to every chunk of the
+ * attribute tiles right before compression, and undone right after
+ * decompression. It has no effect if the attribute is not compressed.
+ *
+ * - TILEDB_BYTESHUFFLE groups the i-th bytes of all values together.
+ * - TILEDB_BITSHUFFLE groups the i-th bits of all values together.
+ * - TILEDB_DELTA replaces each value with its difference from the previous
+ *   one (integer attributes only).
+ * - TILEDB_DICTIONARY stores each tile of a variable-sized attribute as a
+ *   dictionary of its distinct cell values plus a fixed-width code per cell,
+ *   which is then compressed as usual (variable-sized attributes only).
+ *   Unlike the other filters, it applies also to uncompressed attributes.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param filter The filter to be set.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_filter(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, tiledb_filter_t filter);
+
+/**
+ * Sets the capacity of the ZSTD dictionaries of an attribute. Upon writing a
+ * fragment, a dictionary is trained on a sample of the first tiles of each
+ * attribute file compressed with TILEDB_ZSTD (the values and, for
+ * variable-sized attributes, the offsets), and it is stored in the fragment
+ * metadata. All the tiles of the file are then compressed with the
+ * dictionary, which improves considerably the compression of small tiles.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The target attribute.
+ * @param dictionary_size The dictionary capacity in bytes (e.g., 16384).
+ *     0 disables the dictionaries, which is the default.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_set_compression_dictionary_size(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, uint64_t dictionary_size);
+
 /**
  * Retrieves the attribute name.
  *
@@ -358,6 +507,42 @@ TILEDB_EXPORT int tiledb_attribute_get_cell_val_num(
     const tiledb_attribute_t* attr,
     unsigned int* cell_val_num);
 
+/**
+ * Retrieves the size of the chunks that the attribute tiles are split into
+ * upon compression.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param chunk_size The chunk size to be retrieved.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_chunk_size(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, uint64_t* chunk_size);
+
+/**
+ * Retrieves the filter of an attribute.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param filter The filter to be retrieved.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_filter(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, tiledb_filter_t* filter);
+
+/**
+ * Retrieves the capacity of the ZSTD dictionaries of an attribute.
+ *
+ * @param ctx The TileDB context.
+ * @param attr The attribute.
+ * @param dictionary_size The dictionary capacity to be retrieved.
+ * @return TILEDB_OK for success and TILEDB_ERR for error.
+ */
+TILEDB_EXPORT int tiledb_attribute_get_compression_dictionary_size(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    uint64_t* dictionary_size);
+
 /**
  * Dumps the contents of an attribute in ASCII form to some output (e.g.,
  * file or stdout).
@@ -984,6 +1169,37 @@ TILEDB_EXPORT int tiledb_query_reset_buffers(
     void** buffers,
     uint64_t* buffer_sizes);
 
+/**
+ * Adds a predicate to a read query on a sparse array, so that only the
+ * cells whose value on the input attribute satisfies it are retrieved. The
+ * attribute must store a single numeric value per cell, and it does not
+ * need to be one of the attributes of the query. If multiple predicates are
+ * added, the retrieved cells satisfy all of them. The predicates are also
+ * evaluated on per-tile statistics of the attribute, so that the tiles that
+ * cannot contain satisfying cells are not read.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * float value = 30.0f;
+ * tiledb_query_add_predicate(ctx, query, "temperature", TILEDB_GT, &value);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query, which must not have been submitted yet.
+ * @param attribute The name of the attribute the predicate is on.
+ * @param op The comparison operator.
+ * @param value The value the attribute values are compared with, which must
+ *     be of the attribute type.
+ * @return TILEDB_OK upon success, and TILEDB_ERR upon error.
+ */
+TILEDB_EXPORT int tiledb_query_add_predicate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_predicate_op_t op,
+    const void* value);
+
 /**
  * Retrieves the status of a query.
  *
@@ -1036,6 +1252,36 @@ TILEDB_EXPORT int tiledb_array_create(
 TILEDB_EXPORT int tiledb_array_consolidate(
     tiledb_ctx_t* ctx, const char* array_name);
 
+/**
+ * Computes buffer sizes that suffice to hold the results of a read query on
+ * the input subarray and attributes, so that the buffers can be allocated
+ * once and the query completes without becoming INCOMPLETE. The sizes are
+ * computed from the fragment metadata alone, without reading any data. For
+ * dense arrays, the sizes of the fixed-sized attributes (and of the offsets
+ * of the variable-sized ones) are exact, whereas all the other sizes are
+ * upper bounds.
+ *
+ * @param ctx The TileDB context.
+ * @param array_name The name of the array.
+ * @param subarray The subarray of the read query. A NULL value indicates
+ *     the entire domain.
+ * @param attributes The attributes of the read query, as in
+ *     *tiledb_query_create*. A NULL value indicates **all** attributes.
+ * @param attribute_num The number of the input attributes. If *attributes* is
+ *     NULL, then this should be set to 0.
+ * @param buffer_sizes The buffer sizes to be computed, in one-to-one
+ *     correspondence with the buffers of the read query (i.e., one per
+ *     fixed-sized attribute and two per variable-sized attribute).
+ * @return TILEDB_OK on success, and TILEDB_ERR on error.
+ */
+TILEDB_EXPORT int tiledb_array_compute_max_read_buffer_sizes(
+    tiledb_ctx_t* ctx,
+    const char* array_name,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num,
+    uint64_t* buffer_sizes);
+
 /* ********************************* */
 /*        RESOURCE MANAGEMENT        */
 /* ********************************* */
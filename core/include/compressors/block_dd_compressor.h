@@ -0,0 +1,153 @@
+/**
+ * @file   block_dd_compressor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the block double delta compressor class.
+ */
+
+#ifndef TILEDB_BLOCK_DOUBLE_DELTA_H
+#define TILEDB_BLOCK_DOUBLE_DELTA_H
+
+#include "buffer.h"
+#include "const_buffer.h"
+#include "datatype.h"
+#include "status.h"
+
+namespace tiledb {
+
+/**
+ * Implements a block-based double delta compressor, which bit-packs the
+ * double deltas in frames of a fixed number of values with a separate
+ * bitsize per frame, in the spirit of FastPFor (SIMD-BP128).
+ */
+class BlockDoubleDelta {
+ public:
+  /** The number of double deltas in a frame. */
+  static const uint64_t FRAME_SIZE;
+
+  /** The frame bitsize signifying that the frame stores raw values. */
+  static const uint8_t RAW_FRAME;
+
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Compression function. The output buffer will contain the following
+   * after compression:
+   *
+   * n | in_0 | delta_1 | frame_0 | frame_1 | ...
+   *
+   * where:
+   *  - *n* (uint64_t) is the number of values in the input buffer.
+   *  - *delta_1* is equal to in_1 - in_0.
+   *  - Each frame holds the zigzag-encoded double deltas dd_i =
+   *    (in_i - in_{i-1}) - (in_{i-1} - in_{i-2}) of FRAME_SIZE consecutive
+   *    values (fewer for the last frame). It starts with a byte holding
+   *    the bitsize *b* (at most 32) of the largest one in the frame,
+   *    followed by the double deltas packed in *b* bits each. In a full
+   *    frame, double delta *i* goes to lane *i % 4*, and the 32-bit words
+   *    of the four lanes are interleaved, so that a 128-bit register
+   *    unpacks four values at a time. The last frame packs its values
+   *    one after the other, least significant bit first.
+   *
+   * All arithmetic is done modulo the width of the datatype, hence it
+   * never overflows. If the double deltas of a frame do not fit in 32 bits,
+   * or packing would not make the frame smaller, the frame stores the
+   * input values as they are, after a RAW_FRAME byte.
+   *
+   * @param type The type of the input values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Decompression function.
+   *
+   * @param type The type of the original decompressed values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Returns the compression overhead for the given input, i.e., the number
+   * of values and one byte per frame.
+   */
+  static uint64_t overhead(uint64_t nbytes);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /** Templated version of *compress* on the type of buffer values. */
+  template <class T>
+  static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /** Templated version of *decompress* on the type of buffer values. */
+  template <class T>
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Packs a full frame of values into interleaved 32-bit lanes.
+   *
+   * @param in The FRAME_SIZE values to pack.
+   * @param bitsize The number of bits of each value.
+   * @param out The output, of 4 * *bitsize* 32-bit words.
+   */
+  static void pack_frame(const uint32_t* in, int bitsize, unsigned char* out);
+
+  /**
+   * Packs the values of a partial frame one after the other.
+   *
+   * @param in The values to pack.
+   * @param num The number of values.
+   * @param bitsize The number of bits of each value.
+   * @param out The output, of *ceil(num * bitsize / 8)* bytes.
+   */
+  static void pack_tail(
+      const uint32_t* in, uint64_t num, int bitsize, unsigned char* out);
+
+  /** Inverse of *pack_frame*, using SIMD instructions where available. */
+  static void unpack_frame(
+      const unsigned char* in, int bitsize, uint32_t* out);
+
+  /** Inverse of *pack_tail*. */
+  static void unpack_tail(
+      const unsigned char* in, uint64_t num, int bitsize, uint32_t* out);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_BLOCK_DOUBLE_DELTA_H
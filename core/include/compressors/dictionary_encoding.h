@@ -0,0 +1,146 @@
+/**
+ * @file   dictionary_encoding.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DictionaryEncoding.
+ */
+
+#ifndef TILEDB_DICTIONARY_ENCODING_H
+#define TILEDB_DICTIONARY_ENCODING_H
+
+#include "buffer.h"
+#include "const_buffer.h"
+#include "status.h"
+
+namespace tiledb {
+
+/**
+ * Implements the dictionary encoding of the variable-sized tiles. The
+ * distinct cell values of a tile are stored once in a dictionary, and each
+ * cell is replaced by the fixed-width code of its value, i.e., its index in
+ * the dictionary. This shrinks considerably the tiles of attributes with few
+ * distinct values, such as country codes or sensor names.
+ */
+class DictionaryEncoding {
+ public:
+  /** Encoding byte signifying that the values are stored as they are. */
+  static const uint8_t RAW;
+
+  /** Encoding byte signifying that the values are dictionary-encoded. */
+  static const uint8_t DICTIONARY;
+
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Encodes the values of a variable-sized tile. The output buffer will
+   * contain the following after encoding:
+   *
+   * encoding | payload
+   *
+   * where *encoding* is a byte. If it is RAW, the payload holds the input
+   * values as they are. This is the case if the dictionary would not make
+   * the data smaller. Otherwise, the payload is:
+   *
+   * cell_num | dict_num | dict_size | code_size | dict_offsets |
+   * dict_values | codes
+   *
+   * where *cell_num*, *dict_num* (the number of distinct values) and
+   * *dict_size* (the total size of the distinct values) are uint64_t,
+   * *code_size* is a byte (1, 2 or 4), *dict_offsets* are the uint64_t
+   * offsets of the distinct values in *dict_values*, and *codes* holds
+   * *code_size* bytes per cell.
+   *
+   * @param offsets The offsets of the cells, where the first offset
+   *     corresponds to the start of the input buffer.
+   * @param cell_num The number of cells.
+   * @param input_buffer The cell values.
+   * @param output_buffer The buffer to write the encoded tile to.
+   * @return Status
+   */
+  static Status encode(
+      const uint64_t* offsets,
+      uint64_t cell_num,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
+  /**
+   * Decodes a tile, writing the cell values to the output buffer.
+   *
+   * @param input_buffer The encoded tile.
+   * @param output_buffer The buffer to write the cell values to.
+   * @return Status
+   */
+  static Status decode(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /**
+   * Copies the dictionary value of each code to the output.
+   *
+   * @tparam T The type of the codes.
+   * @param codes The codes.
+   * @param cell_num The number of codes.
+   * @param dict_offsets The offsets of the dictionary values.
+   * @param dict_lengths The sizes of the dictionary values.
+   * @param dict_values The dictionary values.
+   * @param dict_num The number of dictionary values.
+   * @param output_buffer The buffer to write the cell values to.
+   * @return Status
+   */
+  template <class T>
+  static Status decode(
+      const unsigned char* codes,
+      uint64_t cell_num,
+      const uint64_t* dict_offsets,
+      const uint64_t* dict_lengths,
+      const unsigned char* dict_values,
+      uint64_t dict_num,
+      Buffer* output_buffer);
+
+  /**
+   * Writes the codes of the cells to the output.
+   *
+   * @tparam T The type of the codes.
+   * @param codes The codes.
+   * @param cell_num The number of codes.
+   * @param output The output.
+   * @return void
+   */
+  template <class T>
+  static void write_codes(
+      const uint32_t* codes, uint64_t cell_num, unsigned char* output);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_DICTIONARY_ENCODING_H
@@ -0,0 +1,159 @@
+/**
+ * @file   filter_kernels.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FilterKernels.
+ */
+
+#ifndef TILEDB_FILTER_KERNELS_H
+#define TILEDB_FILTER_KERNELS_H
+
+#include "datatype.h"
+#include "filter.h"
+#include "status.h"
+
+namespace tiledb {
+
+/**
+ * Implements the filters that reorganize the tile chunks before compression,
+ * so that the compressors find more redundancy in them:
+ *
+ * - BYTESHUFFLE stores the first bytes of all values, then the second bytes,
+ *   etc.
+ * - BITSHUFFLE stores the first bits of all values, then the second bits,
+ *   etc. The values are processed in groups of 8, and the values that do
+ *   not form a full group are only byte-shuffled.
+ * - DELTA stores the first value, followed by the differences between
+ *   consecutive values (modulo the width of the type).
+ *
+ * Any trailing bytes that do not form a whole value are copied as they are.
+ * The kernels use SSE2 instructions where available.
+ */
+class FilterKernels {
+ public:
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Applies a filter.
+   *
+   * @param filter The filter.
+   * @param type The type of the values.
+   * @param input The input data.
+   * @param nbytes The size of the input data.
+   * @param output The output, which must have room for *nbytes* bytes and
+   *     must not overlap with the input.
+   * @return Status
+   */
+  static Status apply(
+      Filter filter,
+      Datatype type,
+      const void* input,
+      uint64_t nbytes,
+      void* output);
+
+  /**
+   * Reverses a filter, i.e., it is the inverse of *apply*.
+   *
+   * @param filter The filter.
+   * @param type The type of the values.
+   * @param input The filtered data.
+   * @param nbytes The size of the filtered data.
+   * @param output The output, which must have room for *nbytes* bytes and
+   *     must not overlap with the input.
+   * @return Status
+   */
+  static Status reverse(
+      Filter filter,
+      Datatype type,
+      const void* input,
+      uint64_t nbytes,
+      void* output);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /** Byte-shuffles *num* values of *type_size* bytes. */
+  static void byteshuffle(
+      const unsigned char* input,
+      uint64_t num,
+      uint64_t type_size,
+      unsigned char* output);
+
+  /** Inverse of *byteshuffle*. */
+  static void byteunshuffle(
+      const unsigned char* input,
+      uint64_t num,
+      uint64_t type_size,
+      unsigned char* output);
+
+  /** Bit-shuffles *num* values (a multiple of 8) of *type_size* bytes. */
+  static void bitshuffle(
+      const unsigned char* input,
+      uint64_t num,
+      uint64_t type_size,
+      unsigned char* output);
+
+  /** Inverse of *bitshuffle*. */
+  static void bitunshuffle(
+      const unsigned char* input,
+      uint64_t num,
+      uint64_t type_size,
+      unsigned char* output);
+
+  /** Delta-encodes *num* values of type T. */
+  template <class T>
+  static void delta_encode(const T* input, uint64_t num, T* output);
+
+  /** Inverse of *delta_encode*. */
+  template <class T>
+  static void delta_decode(const T* input, uint64_t num, T* output);
+
+  /**
+   * Applies (if *forward* is *true*) or reverses the delta filter, with
+   * the proper type.
+   */
+  static Status delta(
+      bool forward,
+      Datatype type,
+      const void* input,
+      uint64_t num,
+      void* output);
+
+  /** Templated version of *delta* on the type of the values. */
+  template <class T>
+  static void delta(
+      bool forward, const void* input, uint64_t num, void* output);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_FILTER_KERNELS_H
@@ -0,0 +1,129 @@
+/**
+ * @file   gorilla_compressor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the Gorilla compressor class.
+ */
+
+#ifndef TILEDB_GORILLA_H
+#define TILEDB_GORILLA_H
+
+#include "buffer.h"
+#include "const_buffer.h"
+#include "datatype.h"
+#include "status.h"
+
+namespace tiledb {
+
+/**
+ * Implements the XOR-based compressor of the Gorilla time series database
+ * (Pelkonen et al., VLDB 2015), which targets floating-point values. Each
+ * value is XOR-ed with the previous one, so that the sign, the exponent and
+ * the most significant mantissa bits cancel out for values that are close
+ * to each other, and only the remaining meaningful bits are stored.
+ */
+class Gorilla {
+ public:
+  /** Encoding byte signifying that the values are stored as they are. */
+  static const uint8_t RAW;
+
+  /** Encoding byte signifying that the values are XOR-encoded. */
+  static const uint8_t XOR;
+
+  /* ****************************** */
+  /*               API              */
+  /* ****************************** */
+
+  /**
+   * Compression function. The output buffer will contain the following
+   * after compression:
+   *
+   * n | encoding | payload
+   *
+   * where *n* (uint64_t) is the number of values in the input buffer, and
+   * *encoding* is a byte. If it is RAW, the payload holds the input values
+   * as they are. This is the case if XOR encoding would not make the data
+   * smaller. Otherwise, the payload is a bitstream (most significant bit
+   * first) starting with the first value, followed by one code per
+   * subsequent value, whose XOR *x* with the previous value is stored as:
+   *  - '0' if *x* is zero.
+   *  - '10' followed by the meaningful bits of *x*, if they fall within the
+   *    meaningful bits of the last XOR stored with a '11' code.
+   *  - '11' followed by the number of leading zeros of *x* (capped to 15 and
+   *    31 bits in 4 and 5 bits for 32-bit and 64-bit values respectively),
+   *    the number of meaningful bits minus one (in 5 and 6 bits
+   *    respectively), and the meaningful bits.
+   *
+   * @param type The type of the input values. It must be 32-bit or 64-bit.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Decompression function.
+   *
+   * @param type The type of the original decompressed values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Returns the compression overhead for the given input, i.e., the number
+   * of values and the encoding byte.
+   */
+  static uint64_t overhead(uint64_t nbytes);
+
+ private:
+  /* ****************************** */
+  /*         PRIVATE METHODS        */
+  /* ****************************** */
+
+  /**
+   * Templated version of *compress* on the unsigned integer type of the
+   * same width as the buffer values.
+   */
+  template <class T>
+  static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Templated version of *decompress* on the unsigned integer type of the
+   * same width as the buffer values.
+   */
+  template <class T>
+  static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_GORILLA_H
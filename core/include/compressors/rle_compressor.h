@@ -39,7 +39,19 @@
 
 namespace tiledb {
 
-/** Handles compression/decompression Run-Length-Encoding. */
+/**
+ * Handles compression/decompression Run-Length-Encoding.
+ *
+ * The compressed data start with a byte holding the format version (see
+ * `constants::rle_format_version`), followed by the runs. Each run stores
+ * the repeated value, followed by the run length as a varint (7 bits per
+ * byte, least significant group first, with the high bit set on all bytes
+ * but the last), so the length of a run is not bounded.
+ *
+ * The run boundaries are detected many values at a time, comparing the
+ * input with itself shifted by one value, using AVX2 or SSE2 instructions
+ * when the CPU supports them (detected at runtime).
+ */
 class RLE {
  public:
   /**
@@ -64,7 +76,24 @@ class RLE {
   static Status decompress(
       uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer);
 
-  /** Returns the compression overhead for the given input. */
+  /**
+   * Decompression function for the legacy format, which is written by the
+   * versions before `constants::rle_format_min_version`. It has no format
+   * version byte, and each run stores the repeated value followed by the
+   * run length in two bytes (most significant first).
+   *
+   * @param value_size The size of a single value.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the decompressed data.
+   * @return Status
+   */
+  static Status decompress_legacy(
+      uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Returns the compression overhead for the given input. In the worst
+   * case, every value forms its own run with a one-byte run length.
+   */
   static uint64_t overhead(uint64_t nbytes, uint64_t value_size);
 };
 
@@ -36,6 +36,7 @@
 #include "buffer.h"
 #include "const_buffer.h"
 #include "status.h"
+#include "zstd_dictionary.h"
 
 namespace tiledb {
 
@@ -53,6 +54,21 @@ class ZStd {
   static Status compress(
       int level, ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Compression function that primes the compression with a dictionary.
+   *
+   * @param level Compression level.
+   * @param dictionary The dictionary, or null for plain compression.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      int level,
+      ZStdDictionary* dictionary,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /**
    * Decompression function.
    *
@@ -62,6 +78,20 @@ class ZStd {
    */
   static Status decompress(ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Decompression function for data compressed with a dictionary.
+   *
+   * @param dictionary The dictionary the data were compressed with, or null
+   *     if they were compressed without one.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      ZStdDictionary* dictionary,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /** Returns the default compression level. */
   static int default_level() {
     return 5;
@@ -0,0 +1,146 @@
+/**
+ * @file   zstd_dictionary.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file defines class ZStdDictionary.
+ */
+
+#ifndef TILEDB_ZSTD_DICTIONARY_H
+#define TILEDB_ZSTD_DICTIONARY_H
+
+#include "buffer.h"
+#include "status.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace tiledb {
+
+/**
+ * A zstd dictionary, which primes the compression of small inputs with the
+ * content that is common to them. The dictionary is digested once for
+ * decompression, and once per compression level for compression, so that
+ * the digested forms are shared by all the (concurrent) calls that use it.
+ */
+class ZStdDictionary {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  ZStdDictionary();
+
+  /** Destructor. */
+  ~ZStdDictionary();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the dictionary digested for compression at the input level,
+   * creating it upon its first use.
+   *
+   * @param level The compression level.
+   * @param cdict The digested dictionary.
+   * @return Status
+   */
+  Status cdict(int level, const ZSTD_CDict_s** cdict);
+
+  /** Returns the dictionary content. */
+  const void* data() const;
+
+  /**
+   * Returns the dictionary digested for decompression, creating it upon its
+   * first use.
+   *
+   * @param ddict The digested dictionary.
+   * @return Status
+   */
+  Status ddict(const ZSTD_DDict_s** ddict);
+
+  /**
+   * Initializes the dictionary with the input content, e.g., as loaded from
+   * the fragment metadata.
+   *
+   * @param data The dictionary content, which is copied.
+   * @param size The size of the content.
+   * @return Status
+   */
+  Status init(const void* data, uint64_t size);
+
+  /** Returns the size of the dictionary content. */
+  uint64_t size() const;
+
+  /**
+   * Trains the dictionary on the input samples. If the samples are too few
+   * or too uniform for zstd to extract a dictionary from, the dictionary is
+   * left empty and the function still succeeds.
+   *
+   * @param samples The samples, stored one after the other.
+   * @param sample_sizes The size of each sample.
+   * @param capacity The maximum dictionary size.
+   * @return Status
+   */
+  Status train(
+      const Buffer* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t capacity);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The dictionaries digested for compression, one per level. */
+  std::map<int, ZSTD_CDict_s*> cdicts_;
+
+  /** The dictionary content. */
+  Buffer* data_;
+
+  /** The dictionary digested for decompression. */
+  ZSTD_DDict_s* ddict_;
+
+  /** Protects the creation of the digested dictionaries. */
+  std::mutex mtx_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Frees the digested dictionaries. */
+  void clear();
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_ZSTD_DICTIONARY_H
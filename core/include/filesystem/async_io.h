@@ -0,0 +1,290 @@
+/**
+ * @file   async_io.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class AsyncIO.
+ */
+
+#ifndef TILEDB_ASYNC_IO_H
+#define TILEDB_ASYNC_IO_H
+
+#include "file_handle_cache.h"
+#include "status.h"
+#include "thread_pool.h"
+
+#include <sys/uio.h>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace tiledb {
+
+/**
+ * Executes file reads and writes asynchronously. A request is submitted
+ * with one of the *submit_* functions, which returns immediately with a
+ * request id, and it is completed with *wait*, which blocks until the
+ * request finishes and returns its status. Every submitted request must be
+ * waited on exactly once, and its buffer must remain valid until then.
+ *
+ * On Linux, the requests on open file descriptors are submitted to an
+ * io_uring instance, so that many of them are in flight without occupying
+ * any thread. If io_uring is not available (or disabled), they are executed
+ * by a pool of threads instead, which is created upon the first such request.
+ */
+class AsyncIO {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  AsyncIO();
+
+  /**
+   * Destructor. It waits for the requests in flight to finish, and discards
+   * any results that were not waited on.
+   */
+  ~AsyncIO();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the object.
+   *
+   * @param use_io_uring If *true*, io_uring is used if it is supported by
+   *     the build and the running kernel.
+   * @param thread_num The number of threads that execute the requests when
+   *     io_uring is not used, as well as the generic tasks (see
+   *     *submit_task*). It must be positive. The threads are started only
+   *     if such requests are submitted.
+   * @return Status
+   */
+  Status init(bool use_io_uring, unsigned int thread_num);
+
+  /**
+   * Submits a read from an open file.
+   *
+   * @param handle The file handle, which is kept open until the read
+   *     finishes.
+   * @param offset The offset in the file where the read starts.
+   * @param buffer The buffer to read into.
+   * @param nbytes The number of bytes to read.
+   * @param request_id The id of the submitted request.
+   * @return Status
+   */
+  Status submit_read(
+      const std::shared_ptr<FileHandle>& handle,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      uint64_t* request_id);
+
+  /**
+   * Submits an arbitrary (blocking) task, which is executed by the thread
+   * pool. This is used for filesystems that do not expose file descriptors.
+   *
+   * @param task The task to be executed.
+   * @param request_id The id of the submitted request.
+   * @return Status
+   */
+  Status submit_task(
+      const std::function<Status()>& task, uint64_t* request_id);
+
+  /**
+   * Submits a write to an open file at the input offset. The descriptor
+   * must not have been opened with `O_APPEND`.
+   *
+   * @param handle The file handle, which is kept open until the write
+   *     finishes.
+   * @param offset The offset in the file where the write starts.
+   * @param buffer The buffer to write from.
+   * @param nbytes The number of bytes to write.
+   * @param request_id The id of the submitted request.
+   * @return Status
+   */
+  Status submit_write(
+      const std::shared_ptr<FileHandle>& handle,
+      uint64_t offset,
+      const void* buffer,
+      uint64_t nbytes,
+      uint64_t* request_id);
+
+  /** Returns *true* if the requests are submitted to io_uring. */
+  bool uses_io_uring() const;
+
+  /**
+   * Waits for a request to finish.
+   *
+   * @param request_id The id of the request.
+   * @return The status of the request.
+   */
+  Status wait(uint64_t request_id);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The io_uring instance (defined only on supported builds). */
+  struct Ring;
+
+  /** A submitted request. */
+  struct Request {
+    /** Set when the request finishes. */
+    bool done_;
+
+    /** The file handle (null for generic tasks). */
+    std::shared_ptr<FileHandle> handle_;
+
+    /** *true* if the request was submitted to io_uring. */
+    bool in_ring_;
+
+    /** The part of the buffer that remains to be read or written. */
+    struct iovec iov_;
+
+    /** The file offset of the remaining part. */
+    uint64_t offset_;
+
+    /** The status of the request, once finished. */
+    Status st_;
+
+    /** *true* for writes, *false* for reads. */
+    bool write_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Notifies the waiters about finished requests and free ring slots. */
+  std::condition_variable cv_;
+
+  /** Set by a successful *init*. */
+  bool initialized_;
+
+  /** The thread that reaps the io_uring completions. */
+  std::thread completion_thread_;
+
+  /** The number of requests currently submitted to io_uring. */
+  uint64_t inflight_;
+
+  /** Protects the requests and the ring. */
+  std::mutex mtx_;
+
+  /** The id of the next submitted request. */
+  uint64_t next_request_id_;
+
+  /** The submitted requests that have not been waited on yet. */
+  std::map<uint64_t, Request*> requests_;
+
+  /** The io_uring instance, or null if io_uring is not used. */
+  Ring* ring_;
+
+  /**
+   * Set if io_uring broke down, in which case the subsequent requests are
+   * executed by the thread pool.
+   */
+  bool ring_failed_;
+
+  /** The number of threads of the thread pool. */
+  unsigned int thread_num_;
+
+  /**
+   * Executes the requests when io_uring is not used. It is null until the
+   * first such request.
+   */
+  ThreadPool* thread_pool_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Creates the thread pool if it does not exist yet. Must be called while
+   * holding `mtx_`.
+   */
+  Status create_thread_pool();
+
+  /**
+   * Marks a request as finished and wakes up its waiter. Must be called
+   * while holding `mtx_`.
+   */
+  void finish(Request* request, const Status& st);
+
+  /**
+   * Fails all the requests submitted to io_uring, e.g., when io_uring breaks
+   * down. Must be called while holding `mtx_`.
+   */
+  void fail_inflight(const Status& st);
+
+  /** Reaps the io_uring completions until the object is destroyed. */
+  void reap_completions();
+
+  /**
+   * Registers a new request and returns its id. Must be called while
+   * holding `mtx_`.
+   */
+  uint64_t register_request(Request* request);
+
+  /**
+   * Creates the io_uring instance and maps its rings.
+   *
+   * @param entries The requested number of submission queue entries.
+   * @return Status
+   */
+  Status ring_create(unsigned int entries);
+
+  /** Unmaps the rings and closes the io_uring instance. */
+  void ring_destroy();
+
+  /**
+   * Submits a read or write request to io_uring. Must be called while
+   * holding `mtx_`.
+   *
+   * @param request_id The id of the request (0 submits a no-op, which is
+   *     used to wake up the completion thread).
+   * @param request The request.
+   * @return Status
+   */
+  Status ring_submit(uint64_t request_id, Request* request);
+
+  /**
+   * Submits a read or write request either to io_uring, or to the thread
+   * pool.
+   */
+  Status submit(Request* request, uint64_t* request_id);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_ASYNC_IO_H
@@ -0,0 +1,187 @@
+/**
+ * @file   file_handle_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FileHandleCache.
+ */
+
+#ifndef TILEDB_FILE_HANDLE_CACHE_H
+#define TILEDB_FILE_HANDLE_CACHE_H
+
+#include "status.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace tiledb {
+
+/**
+ * An open POSIX file descriptor, which is closed upon destruction. Handles
+ * are shared between the cache and its users, so that a descriptor evicted
+ * from the cache remains valid until the last user releases it.
+ */
+class FileHandle {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param fd The file descriptor, now owned by the handle.
+   */
+  explicit FileHandle(int fd);
+
+  /** Destructor. It closes the file descriptor. */
+  ~FileHandle();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the file descriptor. */
+  int fd() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The file descriptor. */
+  int fd_;
+};
+
+/**
+ * A thread-safe LRU cache of open POSIX file descriptors, keyed by the file
+ * path and the flags the file was opened with. It bounds the number of
+ * descriptors kept open; the least recently used one is closed when the
+ * bound is exceeded.
+ *
+ * A cached descriptor is revalidated upon every hit, and it is reopened if
+ * its file has been removed or replaced behind the back of the cache. The
+ * cache should still be invalidated whenever a cached file is removed, moved
+ * or replaced, so that the stale descriptors are closed promptly.
+ */
+class FileHandleCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_handles The maximum number of cached descriptors. If it is
+   *     0, no descriptor is cached and every handle is closed as soon as its
+   *     user releases it.
+   */
+  explicit FileHandleCache(uint64_t max_handles);
+
+  /** Destructor. It closes all the cached descriptors. */
+  ~FileHandleCache();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Retrieves a handle for the input file, opening the file if it is not
+   * already cached, or if the cached descriptor no longer refers to the file
+   * at the input path. The handle becomes the most recently used one.
+   *
+   * @param path The name of the file.
+   * @param flags The flags passed to `open` if the file is not cached.
+   * @param handle The retrieved handle.
+   * @return Status
+   */
+  Status get(
+      const std::string& path, int flags, std::shared_ptr<FileHandle>* handle);
+
+  /**
+   * Drops from the cache all the handles of the input path and of any path
+   * that lies below it (if it is a directory).
+   *
+   * @param path The path to be invalidated.
+   */
+  void invalidate(const std::string& path);
+
+  /**
+   * Drops from the cache the handle of the input file opened with the
+   * input flags, if one exists.
+   *
+   * @param path The name of the file.
+   * @param flags The flags the file was opened with.
+   */
+  void release(const std::string& path, int flags);
+
+  /** Returns the number of cached descriptors. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** A cache key, i.e., a (file path, open flags) pair. */
+  typedef std::pair<std::string, int> Key;
+
+  /** A cache entry, i.e., a key along with its handle. */
+  typedef std::pair<Key, std::shared_ptr<FileHandle>> Entry;
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /**
+   * The cached entries, from the most to the least recently used. The list
+   * iterators remain valid upon insertions and removals, which allows
+   * `index_` to point into the list.
+   */
+  std::list<Entry> entries_;
+
+  /**
+   * Maps each key to its position in `entries_`. It is ordered, so that all
+   * the paths below a directory can be found with a range scan.
+   */
+  std::map<Key, std::list<Entry>::iterator> index_;
+
+  /** The maximum number of cached descriptors. */
+  uint64_t max_handles_;
+
+  /** Protects the cache. */
+  mutable std::mutex mtx_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_FILE_HANDLE_CACHE_H
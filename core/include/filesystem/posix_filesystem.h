@@ -137,6 +137,17 @@ bool is_dir(const std::string& path);
  */
 bool is_file(const std::string& path);
 
+/**
+ * Checks if the input file descriptor refers to the file currently found at
+ * the input path, i.e., the file has not been removed or replaced since the
+ * descriptor was opened.
+ *
+ * @param fd The file descriptor.
+ * @param path The name of the file.
+ * @return *True* if *fd* refers to the file at *path*, and *false* otherwise.
+ */
+bool is_same_file(int fd, const std::string& path);
+
 /**
  *
  * Lists files one level deep under a given path.
@@ -169,6 +180,70 @@ Status move_path(const std::string& old_path, const std::string& new_path);
  */
 void purge_dots_from_path(std::string* path);
 
+/**
+ * Opens a file, returning its descriptor.
+ *
+ * @param path The name of the file.
+ * @param flags The flags passed to `open` (e.g., `O_RDONLY`).
+ * @param fd The descriptor of the opened file.
+ * @return Status
+ */
+Status open_file(const std::string& path, int flags, int* fd);
+
+/**
+ * Closes a file descriptor.
+ *
+ * @param fd The file descriptor.
+ * @return Status
+ */
+Status close_file(int fd);
+
+/**
+ * Maps a file into memory as a private, read-only mapping.
+ *
+ * @param fd The descriptor of the file, opened for reading. It may be closed
+ *     right after the mapping is created.
+ * @param nbytes The number of bytes to map, starting at the beginning of
+ *     the file.
+ * @param data The start of the mapped region.
+ * @return Status
+ */
+Status map_file(int fd, uint64_t nbytes, void** data);
+
+/**
+ * Unmaps a region mapped with `map_file`.
+ *
+ * @param data The start of the mapped region.
+ * @param nbytes The size of the mapped region.
+ * @return Status
+ */
+Status unmap_file(void* data, uint64_t nbytes);
+
+/**
+ * Advises the kernel about the expected access pattern of part of a mapped
+ * region.
+ *
+ * @param data The start of the mapped region.
+ * @param offset The offset of the advised range in the region.
+ * @param nbytes The size of the advised range.
+ * @param advice The advice passed to `posix_madvise` (e.g.,
+ *     `POSIX_MADV_SEQUENTIAL`).
+ * @return Status
+ */
+Status advise_mapped(void* data, uint64_t offset, uint64_t nbytes, int advice);
+
+/**
+ * Reads data from an open file into a buffer, using `pread` (i.e., without
+ * altering the file offset of the descriptor).
+ *
+ * @param fd The file descriptor.
+ * @param offset The offset in the file from which the read will start.
+ * @param buffer The buffer into which the data will be written.
+ * @param nbytes The size of the data to be read from the file.
+ * @return Status.
+ */
+Status read_from_file(int fd, uint64_t offset, void* buffer, uint64_t nbytes);
+
 /**
  * Reads data from a file into a buffer.
  *
@@ -189,6 +264,30 @@ Status read_from_file(
  */
 Status sync(const std::string& path);
 
+/**
+ * Writes the input buffer to an open file. The file must have been opened
+ * with `O_APPEND`.
+ *
+ * @param fd The file descriptor.
+ * @param buffer The input buffer.
+ * @param buffer_size The size of the input buffer.
+ * @return Status
+ */
+Status write_to_file(int fd, const void* buffer, uint64_t buffer_size);
+
+/**
+ * Writes the input buffer to an open file at the input offset, using
+ * `pwrite`. The file must not have been opened with `O_APPEND`.
+ *
+ * @param fd The file descriptor.
+ * @param offset The offset in the file where the write will start.
+ * @param buffer The input buffer.
+ * @param buffer_size The size of the input buffer.
+ * @return Status
+ */
+Status write_to_file(
+    int fd, uint64_t offset, const void* buffer, uint64_t buffer_size);
+
 /**
  * Writes the input buffer to a file.
  *
@@ -33,7 +33,10 @@
 #ifndef TILEDB_VFS_H
 #define TILEDB_VFS_H
 
+#include "async_io.h"
 #include "buffer.h"
+#include "config.h"
+#include "file_handle_cache.h"
 #include "status.h"
 #include "uri.h"
 
@@ -46,9 +49,27 @@
 
 namespace tiledb {
 
+/** The expected access pattern of a memory-mapped file. */
+enum class MmapAdvice : char {
+  /** No particular pattern. */
+  NORMAL,
+  /** The file is accessed mostly sequentially. */
+  SEQUENTIAL,
+  /** The file is accessed in random order. */
+  RANDOM,
+  /** The advised range will be accessed soon. */
+  WILLNEED
+};
+
 /**
  * This class implements a virtual filesystem that directs filesystem-related
  * function execution to the appropriate backend based on the input URI.
+ *
+ * For POSIX files, the VFS keeps the file descriptors used by reads and
+ * writes open in an LRU cache, so that successive tile accesses to the same
+ * file need not reopen it. The cache is invalidated whenever the VFS
+ * creates, removes or moves a path, whereas files modified outside the VFS
+ * are not tracked.
  */
 class VFS {
  public:
@@ -136,6 +157,54 @@ class VFS {
    */
   Status file_size(const URI& uri, uint64_t* size) const;
 
+  /**
+   * Initializes the VFS.
+   *
+   * @param config The configuration parameters.
+   * @return Status
+   */
+  Status init(const Config& config);
+
+  /**
+   * Maps a file into memory as a read-only region. This is supported only
+   * for POSIX files.
+   *
+   * @param uri The URI of the file.
+   * @param nbytes The number of bytes to map, starting at the beginning of
+   *     the file.
+   * @param data The start of the mapped region.
+   * @return Status
+   */
+  Status map_file(const URI& uri, uint64_t nbytes, void** data) const;
+
+  /**
+   * Advises the backend about the expected access pattern of part of a
+   * region mapped with `map_file`.
+   *
+   * @param uri The URI of the mapped file.
+   * @param data The start of the mapped region.
+   * @param offset The offset of the advised range in the region.
+   * @param nbytes The size of the advised range.
+   * @param advice The access pattern.
+   * @return Status
+   */
+  Status advise_mapped(
+      const URI& uri,
+      void* data,
+      uint64_t offset,
+      uint64_t nbytes,
+      MmapAdvice advice) const;
+
+  /**
+   * Unmaps a region mapped with `map_file`.
+   *
+   * @param uri The URI of the mapped file.
+   * @param data The start of the mapped region.
+   * @param nbytes The size of the mapped region.
+   * @return Status
+   */
+  Status unmap_file(const URI& uri, void* data, uint64_t nbytes) const;
+
   /**
    * Checks if a directory exists.
    *
@@ -191,6 +260,24 @@ class VFS {
   Status read_from_file(
       const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const;
 
+  /**
+   * Submits an asynchronous read from a file. The read must be completed
+   * with *wait_async*, and the buffer must remain valid until then.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Number of bytes to read.
+   * @param request_id The id of the submitted request.
+   * @return Status
+   */
+  Status read_from_file_async(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      uint64_t* request_id) const;
+
   /**
    * Syncs (flushes) a file.
    *
@@ -210,10 +297,46 @@ class VFS {
   Status write_to_file(
       const URI& uri, const void* buffer, uint64_t buffer_size) const;
 
+  /**
+   * Waits for an asynchronous read or write to finish.
+   *
+   * @param request_id The id of the request.
+   * @return The status of the request.
+   */
+  Status wait_async(uint64_t request_id) const;
+
+  /**
+   * Submits an asynchronous write of a buffer at an offset of a file,
+   * creating the file if it does not exist. The write must be completed
+   * with *wait_async*, and the buffer must remain valid until then. Note
+   * that *sync* does not wait for the pending writes. Only POSIX files
+   * are supported.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the write begins.
+   * @param buffer The buffer to write from.
+   * @param buffer_size The buffer size.
+   * @param request_id The id of the submitted request.
+   * @return Status
+   */
+  Status write_to_file_async(
+      const URI& uri,
+      uint64_t offset,
+      const void* buffer,
+      uint64_t buffer_size,
+      uint64_t* request_id) const;
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
+
+  /** Executes the asynchronous reads and writes. */
+  AsyncIO* async_io_;
+
+  /** Caches the open descriptors of POSIX files. */
+  FileHandleCache* handle_cache_;
+
 #ifdef HAVE_HDFS
   hdfsFS hdfs_;
 #endif
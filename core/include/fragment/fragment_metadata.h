@@ -38,13 +38,27 @@
 #include "buffer.h"
 #include "query_type.h"
 #include "status.h"
+#include "zstd_dictionary.h"
 
 #include <zlib.h>
+#include <mutex>
 #include <vector>
 
 namespace tiledb {
 
-/** Stores the metadata structures of a fragment. */
+class StorageManager;
+
+/**
+ * Stores the metadata structures of a fragment.
+ *
+ * The metadata are stored in separate sections, which are loaded lazily
+ * (see *load_sections*): one per attribute (holding its tile offsets,
+ * variable tile offsets and sizes, ZSTD dictionaries and per-tile min/max
+ * statistics), one for the
+ * coordinates (holding their tile offsets), one for the MBRs and one for
+ * the bounding coordinates. A footer holds the rest of the metadata, along
+ * with the offsets of the sections in the fragment metadata file.
+ */
 class FragmentMetadata {
  public:
   /* ********************************* */
@@ -68,6 +82,28 @@ class FragmentMetadata {
   /*                API                */
   /* ********************************* */
 
+  /**
+   * Adds to the input buffer sizes an upper bound on the number of bytes
+   * that a read in the input subarray may retrieve from the fragment, without
+   * reading any tiles. For sparse fragments, the bound is derived from the
+   * tiles whose MBRs overlap the subarray, whereas for dense fragments from
+   * the overlap of the subarray with the non-empty domain. The needed
+   * sections are loaded if they are not in memory already.
+   *
+   * @param storage_manager The storage manager used to load the sections.
+   * @param subarray The subarray of the read.
+   * @param attribute_ids The ids of the attributes of the read.
+   * @param buffer_sizes The buffer sizes to be increased, one per fixed-sized
+   *     attribute and two per variable-sized attribute (as in the read
+   *     query).
+   * @return Status
+   */
+  Status add_max_read_buffer_sizes(
+      StorageManager* storage_manager,
+      const void* subarray,
+      const std::vector<unsigned int>& attribute_ids,
+      uint64_t* buffer_sizes);
+
   /**
    * Appends the tile bounding coordinates to the fragment metadata.
    *
@@ -115,8 +151,34 @@ class FragmentMetadata {
    */
   void append_tile_var_size(unsigned int attribute_id, uint64_t size);
 
-  /** Returns the bounding coordinates. */
-  const std::vector<void*>& bounding_coords() const;
+  /**
+   * Appends the encoded size of a variable tile of a dictionary-encoded
+   * attribute, i.e., the size with which the tile is compressed.
+   *
+   * @param attribute_id The id of the attribute for which the size is appended.
+   * @param size The size to be appended.
+   * @return void
+   */
+  void append_tile_var_encoded_size(unsigned int attribute_id, uint64_t size);
+
+  /**
+   * Appends the minimum and maximum values of a tile of the input attribute
+   * (see *ArrayMetadata::has_tile_stats*).
+   *
+   * @param attribute_id The id of the attribute whose statistics are
+   *     appended.
+   * @param min The minimum value of the tile.
+   * @param max The maximum value of the tile.
+   * @return void
+   */
+  void append_tile_stats(
+      unsigned int attribute_id, const void* min, const void* max);
+
+  /**
+   * Returns the bounding coordinates (i.e., the first and last coordinates)
+   * of the tile at the input position.
+   */
+  const void* bounding_coords(uint64_t tile_pos) const;
 
   /** Returns the number of cells in the tile at the input position. */
   uint64_t cell_num(uint64_t tile_pos) const;
@@ -128,13 +190,35 @@ class FragmentMetadata {
   bool dense() const;
 
   /**
-   * Loads the fragment metadata structures from the input binary buffer.
+   * Loads all the fragment metadata structures from the input binary
+   * buffer, which is in the (unsectioned) format of earlier versions.
    *
    * @param buff The binary buffer to deserialize from.
    * @return Status
    */
   Status deserialize(ConstBuffer* buff);
 
+  /**
+   * Loads the footer of the fragment metadata from the input binary buffer.
+   * The sections are loaded later with *load_sections*.
+   *
+   * @param buff The binary buffer to deserialize from.
+   * @return Status
+   */
+  Status deserialize_footer(ConstBuffer* buff);
+
+  /**
+   * Returns the ZSTD dictionary of the file of the input attribute (or of
+   * its offsets, if it is variable-sized), or null if there is none.
+   */
+  ZStdDictionary* dictionary(unsigned int attribute_id) const;
+
+  /**
+   * Returns the ZSTD dictionary of the file of the values of the input
+   * variable-sized attribute, or null if there is none.
+   */
+  ZStdDictionary* dictionary_var(unsigned int attribute_id) const;
+
   /** Returns the (expanded) domain in which the fragment is constrained. */
   const void* domain() const;
 
@@ -159,19 +243,89 @@ class FragmentMetadata {
   /** Returns the number of cells in the last tile. */
   uint64_t last_tile_cell_num() const;
 
-  /** Returns the MBRs. */
-  const std::vector<void*>& mbrs() const;
+  /**
+   * Loads the sections of the fragment metadata needed to read the input
+   * attributes, along with the MBRs, bounding coordinates and coordinate
+   * tile offsets if the fragment is sparse. The sections that are already
+   * loaded are skipped. This function is thread-safe.
+   *
+   * @param storage_manager The storage manager used to read the sections.
+   * @param attribute_ids The ids of the attributes to be read.
+   * @return Status
+   */
+  Status load_sections(
+      StorageManager* storage_manager,
+      const std::vector<unsigned int>& attribute_ids);
+
+  /**
+   * Copies the MBR of the tile at the input position into *mbr*, in the
+   * same form as the subarrays (i.e., low/high pairs per dimension).
+   */
+  void get_mbr(uint64_t tile_pos, void* mbr) const;
+
+  /**
+   * Returns the lower or upper MBR bounds of a dimension for all the tiles,
+   * as a contiguous array of coordinates (one per tile).
+   *
+   * @param dim The dimension index.
+   * @param upper If *true*, the upper bounds are returned, otherwise the
+   *     lower ones.
+   */
+  const void* mbr_bounds(unsigned int dim, bool upper) const;
+
+  /** Returns the number of MBRs that are in memory. */
+  uint64_t mbr_num() const;
 
   /** Returns the non-empty domain in which the fragment is constrained. */
   const void* non_empty_domain() const;
 
+  /** Returns the number of sections of the fragment metadata. */
+  unsigned int section_num() const;
+
+  /**
+   * Serializes the footer of the fragment metadata into a binary buffer.
+   *
+   * @param section_offsets The offsets of the sections in the fragment
+   *     metadata file.
+   * @param buff The buffer to serialize into.
+   * @return Status
+   */
+  Status serialize_footer(
+      const std::vector<uint64_t>& section_offsets, Buffer* buff);
+
   /**
-   * Serializes the metadata structures into a binary buffer.
+   * Serializes a section of the fragment metadata into a binary buffer.
+   * Sections `0` to `attribute_num - 1` are the attributes, followed by the
+   * coordinates, the MBRs and the bounding coordinates.
    *
+   * @param section The section to be serialized.
    * @param buff The buffer to serialize into.
    * @return Status
    */
-  Status serialize(Buffer* buff);
+  Status serialize_section(unsigned int section, Buffer* buff);
+
+  /**
+   * Sets the ZSTD dictionary of the file of the input attribute (or of its
+   * offsets, if it is variable-sized). The fragment metadata take ownership
+   * of the dictionary.
+   *
+   * @param attribute_id The attribute id.
+   * @param dictionary The dictionary.
+   * @return void
+   */
+  void set_dictionary(unsigned int attribute_id, ZStdDictionary* dictionary);
+
+  /**
+   * Sets the ZSTD dictionary of the file of the values of the input
+   * variable-sized attribute. The fragment metadata take ownership of the
+   * dictionary.
+   *
+   * @param attribute_id The attribute id.
+   * @param dictionary The dictionary.
+   * @return void
+   */
+  void set_dictionary_var(
+      unsigned int attribute_id, ZStdDictionary* dictionary);
 
   /**
    * Simply sets the number of cells for the last tile.
@@ -187,12 +341,39 @@ class FragmentMetadata {
   /** Returns the tile offsets. */
   const std::vector<std::vector<uint64_t>>& tile_offsets() const;
 
+  /**
+   * Returns the minimum or maximum values of all the tiles of the input
+   * attribute, as a contiguous array of values (one per tile).
+   *
+   * @param attribute_id The attribute id.
+   * @param upper If *true*, the maximum values are returned, otherwise the
+   *     minimum ones.
+   */
+  const void* tile_stats(unsigned int attribute_id, bool upper) const;
+
+  /**
+   * Returns the number of tiles of the input attribute with statistics in
+   * memory. This is zero for the attributes without statistics and for the
+   * fragments created by earlier versions.
+   */
+  uint64_t tile_stats_num(unsigned int attribute_id) const;
+
   /** Returns the variable tile offsets. */
   const std::vector<std::vector<uint64_t>>& tile_var_offsets() const;
 
   /** Returns the variable tile sizes. */
   const std::vector<std::vector<uint64_t>>& tile_var_sizes() const;
 
+  /**
+   * Returns the encoded variable tile sizes. These are empty for the
+   * attributes that are not dictionary-encoded and for the fragments created
+   * by earlier versions.
+   */
+  const std::vector<std::vector<uint64_t>>& tile_var_encoded_sizes() const;
+
+  /** Returns the version of the library that created the fragment. */
+  const int* version() const;
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -201,12 +382,24 @@ class FragmentMetadata {
   /** The array schema */
   const ArrayMetadata* array_metadata_;
 
-  /** A vector storing the first and last coordinates of each tile. */
-  std::vector<void*> bounding_coords_;
+  /** The first and last coordinates of each tile, stored contiguously. */
+  Buffer* bounding_coords_;
 
   /** True if the fragment is dense, and false if it is sparse. */
   bool dense_;
 
+  /**
+   * The ZSTD dictionaries of the attribute files, one per attribute (null
+   * for the files without a dictionary).
+   */
+  std::vector<ZStdDictionary*> dictionaries_;
+
+  /**
+   * The ZSTD dictionaries of the variable-sized attribute files, one per
+   * attribute (null for the files without a dictionary).
+   */
+  std::vector<ZStdDictionary*> dictionaries_var_;
+
   /**
    * The (expanded) domain in which the fragment is constrained. "Expanded"
    * means that the domain is enlarged minimally to coincide with tile
@@ -227,8 +420,15 @@ class FragmentMetadata {
   /** Number of cells in the last tile (meaningful only in the sparse case). */
   uint64_t last_tile_cell_num_;
 
-  /** The MBRs (applicable only to the sparse case with irregular tiles). */
-  std::vector<void*> mbrs_;
+  /**
+   * The MBRs (applicable only to the sparse case with irregular tiles),
+   * stored as columns: `mbrs_[2 * d]` holds the lower bounds of dimension
+   * `d` of all the MBRs, and `mbrs_[2 * d + 1]` the upper bounds.
+   */
+  std::vector<Buffer*> mbrs_;
+
+  /** Protects the lazy loading of the sections. */
+  std::mutex mtx_;
 
   /** The offsets of the next tile for each attribute. */
   std::vector<uint64_t> next_tile_offsets_;
@@ -248,6 +448,14 @@ class FragmentMetadata {
    */
   std::vector<std::vector<uint64_t>> tile_offsets_;
 
+  /**
+   * The per-tile statistics of the attributes, stored as columns:
+   * `tile_stats_[2 * i]` holds the minimum values of all the tiles of
+   * attribute `i`, and `tile_stats_[2 * i + 1]` the maximum values. They
+   * are empty for the attributes without statistics.
+   */
+  std::vector<Buffer*> tile_stats_;
+
   /**
    * The variable tile offsets in their corresponding attribute files.
    * Meaningful only for variable-sized tiles.
@@ -260,6 +468,21 @@ class FragmentMetadata {
    */
   std::vector<std::vector<uint64_t>> tile_var_sizes_;
 
+  /**
+   * The sizes of the uncompressed variable tiles after their dictionary
+   * encoding. Meaningful only for dictionary-encoded attributes.
+   */
+  std::vector<std::vector<uint64_t>> tile_var_encoded_sizes_;
+
+  /** Indicates which sections are loaded. */
+  std::vector<bool> section_loaded_;
+
+  /** The offsets of the sections in the fragment metadata file. */
+  std::vector<uint64_t> section_offsets_;
+
+  /** The number of tiles (meaningful only in the sparse case). */
+  uint64_t sparse_tile_num_;
+
   /** The version of the library that created this metadata. */
   int version_[3];
 
@@ -267,6 +490,36 @@ class FragmentMetadata {
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /**
+   * Implements *add_max_read_buffer_sizes* for dense fragments.
+   *
+   * @tparam T The coordinates type.
+   * @param subarray The subarray of the read.
+   * @param attribute_ids The ids of the attributes of the read.
+   * @param buffer_sizes The buffer sizes to be increased.
+   * @return void
+   */
+  template <class T>
+  void add_max_read_buffer_sizes_dense(
+      const T* subarray,
+      const std::vector<unsigned int>& attribute_ids,
+      uint64_t* buffer_sizes) const;
+
+  /**
+   * Implements *add_max_read_buffer_sizes* for sparse fragments.
+   *
+   * @tparam T The coordinates type.
+   * @param subarray The subarray of the read.
+   * @param attribute_ids The ids of the attributes of the read.
+   * @param buffer_sizes The buffer sizes to be increased.
+   * @return void
+   */
+  template <class T>
+  void add_max_read_buffer_sizes_sparse(
+      const T* subarray,
+      const std::vector<unsigned int>& attribute_ids,
+      uint64_t* buffer_sizes) const;
+
   /**
    * Loads the bounding coordinates from the fragment metadata buffer.
    *
@@ -275,6 +528,33 @@ class FragmentMetadata {
    */
   Status load_bounding_coords(ConstBuffer* buff);
 
+  /**
+   * Deserializes a section of the fragment metadata (see
+   * *serialize_section*).
+   *
+   * @param section The section to be deserialized.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status deserialize_section(unsigned int section, ConstBuffer* buff);
+
+  /**
+   * Loads the ZSTD dictionaries from the fragment metadata buffer.
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_dictionaries(ConstBuffer* buff);
+
+  /**
+   * Loads a ZSTD dictionary from the fragment metadata buffer.
+   *
+   * @param buff Metadata buffer.
+   * @param dictionary The loaded dictionary, or null if there is none.
+   * @return Status
+   */
+  Status load_dictionary(ConstBuffer* buff, ZStdDictionary** dictionary);
+
   /** Loads the sizes of each attribute file from the buffer. */
   Status load_file_sizes(ConstBuffer* buff);
 
@@ -290,13 +570,23 @@ class FragmentMetadata {
   Status load_last_tile_cell_num(ConstBuffer* buff);
 
   /**
-   * Loads the MBRs from the fragment metadata buffer.
+   * Loads the MBRs from the fragment metadata buffer, where they are stored
+   * by column (see `mbrs_`).
    *
    * @param buff Metadata buffer.
    * @return Status
    */
   Status load_mbrs(ConstBuffer* buff);
 
+  /**
+   * Loads the MBRs from the fragment metadata buffer, where they are stored
+   * one after the other (in the format of earlier versions).
+   *
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_mbrs_interleaved(ConstBuffer* buff);
+
   /**
    * Loads the non-empty domain from the fragment metadata buffer.
    *
@@ -305,6 +595,19 @@ class FragmentMetadata {
    */
   Status load_non_empty_domain(ConstBuffer* buff);
 
+  /**
+   * Reads a section from the fragment metadata file and deserializes it, if
+   * it is not loaded yet. Must be called while holding `mtx_`.
+   *
+   * @param storage_manager The storage manager used to read the section.
+   * @param section The section to be loaded.
+   * @return Status
+   */
+  Status load_section(StorageManager* storage_manager, unsigned int section);
+
+  /** Loads the section offsets from the fragment metadata buffer. */
+  Status load_section_offsets(ConstBuffer* buff);
+
   /**
    * Loads the tile offsets from the fragment metadata buffer.
    *
@@ -313,6 +616,37 @@ class FragmentMetadata {
    */
   Status load_tile_offsets(ConstBuffer* buff);
 
+  /**
+   * Loads the tile offsets of an attribute from the fragment metadata
+   * buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_offsets(unsigned int attribute_id, ConstBuffer* buff);
+
+  /**
+   * Loads the tile statistics of an attribute from the fragment metadata
+   * buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_stats(unsigned int attribute_id, ConstBuffer* buff);
+
+  /**
+   * Loads the encoded variable tile sizes of an attribute from the fragment
+   * metadata buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_encoded_sizes(
+      unsigned int attribute_id, ConstBuffer* buff);
+
   /**
    * Loads the variable tile offsets from the fragment metadata buffer.
    *
@@ -321,6 +655,16 @@ class FragmentMetadata {
    */
   Status load_tile_var_offsets(ConstBuffer* buff);
 
+  /**
+   * Loads the variable tile offsets of an attribute from the fragment
+   * metadata buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_offsets(unsigned int attribute_id, ConstBuffer* buff);
+
   /**
    * Loads the variable tile sizes from the fragment metadata.
    *
@@ -329,6 +673,16 @@ class FragmentMetadata {
    */
   Status load_tile_var_sizes(ConstBuffer* buff);
 
+  /**
+   * Loads the variable tile sizes of an attribute from the fragment
+   * metadata buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status load_tile_var_sizes(unsigned int attribute_id, ConstBuffer* buff);
+
   /** Loads the library version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
@@ -340,6 +694,15 @@ class FragmentMetadata {
    */
   Status write_bounding_coords(Buffer* buff);
 
+  /**
+   * Writes a ZSTD dictionary to the fragment metadata buffer.
+   *
+   * @param dictionary The dictionary, or null if there is none.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_dictionary(const ZStdDictionary* dictionary, Buffer* buff);
+
   /** Writes the sizes of each attribute file in the buffer. */
   Status write_file_sizes(Buffer* buff);
 
@@ -370,29 +733,58 @@ class FragmentMetadata {
    */
   Status write_non_empty_domain(Buffer* buff);
 
+  /** Writes the section offsets to the fragment metadata buffer. */
+  Status write_section_offsets(
+      const std::vector<uint64_t>& section_offsets, Buffer* buff);
+
+  /**
+   * Writes the tile offsets of an attribute to the fragment metadata buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_tile_offsets(unsigned int attribute_id, Buffer* buff);
+
+  /**
+   * Writes the tile statistics of an attribute to the fragment metadata
+   * buffer.
+   *
+   * @param attribute_id The attribute id.
+   * @param buff Metadata buffer.
+   * @return Status
+   */
+  Status write_tile_stats(unsigned int attribute_id, Buffer* buff);
+
   /**
-   * Writes the tile offsets to the fragment metadata buffer.
+   * Writes the encoded variable tile sizes of an attribute to the fragment
+   * metadata buffer.
    *
+   * @param attribute_id The attribute id.
    * @param buff Metadata buffer.
    * @return Status
    */
-  Status write_tile_offsets(Buffer* buff);
+  Status write_tile_var_encoded_sizes(unsigned int attribute_id, Buffer* buff);
 
   /**
-   * Writes the variable tile offsets to the fragment metadata buffer.
+   * Writes the variable tile offsets of an attribute to the fragment
+   * metadata buffer.
    *
+   * @param attribute_id The attribute id.
    * @param buff Metadata buffer.
    * @return Status
    */
-  Status write_tile_var_offsets(Buffer* buff);
+  Status write_tile_var_offsets(unsigned int attribute_id, Buffer* buff);
 
   /**
-   * Writes the variable tile sizes to the fragment metadata buffer.
+   * Writes the variable tile sizes of an attribute to the fragment metadata
+   * buffer.
    *
+   * @param attribute_id The attribute id.
    * @param buff Metadata buffer.
    * @return Status
    */
-  Status write_tile_var_sizes(Buffer* buff);
+  Status write_tile_var_sizes(unsigned int attribute_id, Buffer* buff);
 
   /** Writes the library version to the buffer. */
   Status write_version(Buffer* buff);
@@ -38,6 +38,7 @@
 
 #include "fragment.h"
 #include "fragment_metadata.h"
+#include "predicate.h"
 #include "tile.h"
 #include "tile_io.h"
 
@@ -92,6 +93,20 @@ class ReadState {
   /*                API                */
   /* ********************************* */
 
+  /**
+   * Applies the query predicates to the input cell position range, and
+   * appends the maximal sub-ranges of its cells that satisfy all of them
+   * to *fragment_cell_pos_ranges*. The range is appended intact if the
+   * query has no predicates.
+   *
+   * @param fragment_cell_pos_range The cell position range to be filtered.
+   * @param fragment_cell_pos_ranges The ranges to append the result to.
+   * @return Status
+   */
+  Status apply_predicates(
+      const FragmentCellPosRange& fragment_cell_pos_range,
+      std::vector<FragmentCellPosRange>* fragment_cell_pos_ranges);
+
   /**
    * Copies the cells of the input attribute into the input buffers, as
    * determined by the input cell position range.
@@ -145,6 +160,18 @@ class ReadState {
   /** Returns *true* if the read operation is finished for this fragment. */
   bool done() const;
 
+  /**
+   * Fetches (reads and decompresses) a tile of the input attribute, unless
+   * it is already fetched. For a variable-sized attribute, both the offsets
+   * and the values tile are fetched. Tiles of different attributes can be
+   * fetched concurrently.
+   *
+   * @param attribute_id The id of the targeted attribute.
+   * @param tile_i The tile to be fetched.
+   * @return Status
+   */
+  Status fetch_tile(unsigned int attribute_id, uint64_t tile_i);
+
   /**
    * Copies the bounding coordinates of the current search tile into the input
    * *bounding_coords*.
@@ -289,6 +316,15 @@ class ReadState {
   template <class T>
   void get_next_overlapping_tile_sparse(const T* tile_coords);
 
+  /**
+   * Initializes the structures used for evaluating the query predicates,
+   * and (re)computes the tiles needed by the query, since the tiles whose
+   * statistics do not satisfy the predicates may be skipped. It must be
+   * invoked again whenever a predicate is added to the query, before the
+   * read starts.
+   */
+  void init_predicates();
+
   /**
    * Returns *true* if the MBR of the search tile overlaps with the current
    * tile under investigation. Applicable only to **sparse** fragments in
@@ -326,6 +362,9 @@ class ReadState {
   /** Indicates if the read operation on this fragment finished. */
   bool done_;
 
+  /** Keeps track of which tile is in main memory for each predicate. */
+  std::vector<uint64_t> fetched_predicate_tile_;
+
   /** Keeps track of which tile is in main memory for each attribute. */
   std::vector<uint64_t> fetched_tile_;
 
@@ -341,6 +380,23 @@ class ReadState {
    */
   void* last_tile_coords_;
 
+  /** Auxiliary buffer holding the MBR of the current search tile. */
+  void* mbr_;
+
+  /**
+   * The overlap flags of a batch of MBRs with the query subarray (1 if the
+   * tile must be read, 0 otherwise). They are computed for
+   * `constants::mbr_overlap_batch_size` tiles at a time, and they are
+   * reused until the search tile position leaves the batch.
+   */
+  uint8_t* mbr_overlaps_;
+
+  /**
+   * The (inclusive) range of tile positions whose MBR overlaps are
+   * currently held in `mbr_overlaps_`.
+   */
+  uint64_t mbr_overlaps_range_[2];
+
   /**
    * The overlap between an MBR and the current tile under investigation
    * in the case of **sparse** fragments in **dense** arrays. The overlap
@@ -355,9 +411,31 @@ class ReadState {
   /** The bookkeeping of the fragment the read state belongs to. */
   FragmentMetadata* metadata_;
 
+  /**
+   * The sorted positions of the fragment tiles that overlap the query
+   * subarray. They are used to coalesce the reads of nearby tiles.
+   */
+  std::vector<uint64_t> needed_tiles_;
+
   /** Indicates buffer overflow for each attribute. */
   std::vector<bool> overflow_;
 
+  /**
+   * Auxiliary buffer holding which cells of a range satisfy the query
+   * predicates.
+   */
+  std::vector<uint8_t> predicate_matches_;
+
+  /**
+   * Local tile buffers for evaluating the query predicates, one per
+   * predicate. They are separate from the attribute tiles, whose read
+   * progress they must not disturb.
+   */
+  std::vector<Tile*> predicate_tiles_;
+
+  /** Tile I/O objects for the predicate tiles. */
+  std::vector<TileIO*> predicate_tile_io_;
+
   /** The query for which the read state was created. */
   Query* query_;
 
@@ -377,6 +455,12 @@ class ReadState {
   /** The positions of the currently investigated tile. */
   uint64_t search_tile_pos_;
 
+  /**
+   * True if the tiles whose statistics do not satisfy the query predicates
+   * are skipped.
+   */
+  bool skip_tiles_;
+
   /**
    * True if the fragment non-empty domain fully covers the subarray area
    * in the current overlapping tile.
@@ -418,6 +502,29 @@ class ReadState {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Reads the range of the file of *tile_io* that starts at the input tile
+   * and extends over the subsequent tiles the query needs, as long as they
+   * are close enough to each other in the file (see
+   * *compute_coalesced_range_end*). The tiles in the range are then served
+   * from memory by *tile_io*. Nothing is read if the tile already lies in
+   * the current range, or if no subsequent tile qualifies. The range
+   * following the current one is then read ahead asynchronously.
+   *
+   * @param tile_io The TileIO object of the tile file.
+   * @param tile The tile to be read.
+   * @param attribute_id The (real) attribute id.
+   * @param tile_i The tile index.
+   * @param var *true* if the tile holds variable-sized values.
+   * @return Status
+   */
+  Status coalesce_tile_reads(
+      TileIO* tile_io,
+      Tile* tile,
+      unsigned int attribute_id,
+      uint64_t tile_i,
+      bool var);
+
   /**
    * Computes the number of bytes to copy from the local tile buffers of a given
    * attribute in the case of variable-sized cells. It takes as input a range
@@ -480,6 +587,70 @@ class ReadState {
       uint64_t file_size,
       uint64_t* tile_compressed_size) const;
 
+  /**
+   * Computes the end of a range of tiles to be read with a single request.
+   * The range starts at the input needed tile, and extends over the
+   * subsequent needed tiles as long as the gaps between them are at most
+   * `constants::coalesced_read_max_gap` bytes and the range is at most
+   * `constants::coalesced_read_max_size` bytes.
+   *
+   * @param tile_offsets The offsets of the tiles in their file.
+   * @param file_size The size of the file.
+   * @param it The position of the first tile of the range in
+   *     `needed_tiles_`.
+   * @return The end offset (exclusive) of the range in the file.
+   */
+  uint64_t compute_coalesced_range_end(
+      const std::vector<uint64_t>& tile_offsets,
+      uint64_t file_size,
+      std::vector<uint64_t>::const_iterator it) const;
+
+  /**
+   * Computes the positions of the fragment tiles that overlap the query
+   * subarray and stores them in `needed_tiles_`.
+   *
+   * @return void
+   */
+  void compute_needed_tiles();
+
+  /**
+   * Computes the positions of the tiles of a dense fragment that overlap
+   * the query subarray.
+   *
+   * @tparam T The coordinates type.
+   * @return void
+   */
+  template <class T>
+  void compute_needed_tiles_dense();
+
+  /**
+   * Computes the positions of the tiles of a sparse fragment whose MBRs
+   * overlap the query subarray.
+   *
+   * @tparam T The coordinates type.
+   * @return void
+   */
+  template <class T>
+  void compute_needed_tiles_sparse();
+
+  /**
+   * Checks which tiles in a range of a sparse fragment have MBRs that
+   * overlap the query subarray, and statistics that satisfy the query
+   * predicates (if the tiles are skipped, see `skip_tiles_`). The MBR
+   * columns are scanned one bound at a time, so that the compiler can
+   * vectorize the comparisons.
+   *
+   * @tparam T The coordinates type.
+   * @param first The position of the first tile in the range.
+   * @param num The number of tiles in the range.
+   * @param overlaps Set to 1 for each tile that must be read, and to 0
+   *     otherwise. It must hold *num* elements.
+   * @return void
+   */
+  template <class T>
+  void compute_mbr_overlaps(
+      uint64_t first, uint64_t num, uint8_t* overlaps) const;
+
   /**
    * Computes the ranges of tile positions that need to be searched for finding
    * overlapping tiles with the query subarray.
@@ -599,6 +770,25 @@ class ReadState {
   /** Returns *true* if the file of the input attribute is empty. */
   bool is_empty_attribute(unsigned int attribute_id) const;
 
+  /**
+   * Returns *true* if the non-empty domain of a fragment older than this
+   * one overlaps with the non-empty domain of this fragment.
+   *
+   * @tparam T The coordinates type.
+   */
+  template <class T>
+  bool overlaps_older_fragments() const;
+
+  /**
+   * Reads an entire tile of the attribute of a predicate into the tile
+   * buffer of the predicate.
+   *
+   * @param predicate_i The index of the predicate in the query.
+   * @param tile_i The tile index.
+   * @return Status
+   */
+  Status read_predicate_tile(unsigned int predicate_i, uint64_t tile_i);
+
   /**
    * Reads from a tile based on the input parameters.
    *
@@ -623,6 +813,34 @@ class ReadState {
    */
   Status read_tile(unsigned int attribute_id, uint64_t tile_i);
 
+  /**
+   * Reads a tile from its file through the storage manager tile cache.
+   * Compressed tiles are looked up in the cache first, and inserted into
+   * it after they are read and decompressed. Uncompressed tiles bypass the
+   * cache, since they are served as efficiently by the OS page cache.
+   * Tiles that are not in the cache are read along with their nearby
+   * needed tiles (see *coalesce_tile_reads*).
+   *
+   * @param tile_io The TileIO object of the tile file.
+   * @param tile The tile to read into.
+   * @param attribute_id The (real) attribute id.
+   * @param tile_i The tile index.
+   * @param var *true* if the tile holds variable-sized values.
+   * @param file_offset The offset of the tile in the file.
+   * @param compressed_size The size of the compressed tile.
+   * @param tile_size The size of the decompressed tile.
+   * @return Status
+   */
+  Status read_tile_cached(
+      TileIO* tile_io,
+      Tile* tile,
+      unsigned int attribute_id,
+      uint64_t tile_i,
+      bool var,
+      uint64_t file_offset,
+      uint64_t compressed_size,
+      uint64_t tile_size);
+
   /**
    * Prepares a variable-sized tile from the disk for reading for an attribute.
    *
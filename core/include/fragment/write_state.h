@@ -91,6 +91,22 @@ class WriteState {
   Status write(void** buffers, uint64_t* buffer_sizes);
 
  private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The state of the training of the ZSTD dictionary of a file. */
+  struct DictionaryTraining {
+    /** The size of the withheld tiles. */
+    uint64_t size_;
+
+    /**
+     * The full tiles withheld until the dictionary is trained, since they
+     * are compressed with it.
+     */
+    std::vector<Tile*> tiles_;
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -101,6 +117,22 @@ class WriteState {
   /** The first and last coordinates of the tile currently being populated. */
   void* bounding_coords_;
 
+  /**
+   * The training of the ZSTD dictionaries of the attribute files, one per
+   * attribute plus one for the coordinates. An entry is null if the file
+   * has no dictionary, or if its dictionary has already been trained.
+   */
+  std::vector<DictionaryTraining*> dictionary_training_;
+
+  /**
+   * The training of the ZSTD dictionaries of the variable-sized attribute
+   * files, one per attribute (see `dictionary_training_`).
+   */
+  std::vector<DictionaryTraining*> dictionary_training_var_;
+
+  /** Auxiliary buffer holding a dictionary-encoded variable-sized tile. */
+  Buffer* encoded_tile_var_;
+
   /**
    * The current offsets of the variable-sized attributes in their
    * respective files, or alternatively, the current file size of each
@@ -151,6 +183,13 @@ class WriteState {
   template <class T>
   void expand_mbr(const T* coords);
 
+  /**
+   * Initializes the training of the ZSTD dictionaries of the attribute files
+   * that are compressed with ZSTD, for the attributes that have a dictionary
+   * size.
+   */
+  void init_dictionary_training();
+
   /** Initializes the internal tile structures. */
   void init_tiles();
 
@@ -189,6 +228,26 @@ class WriteState {
       uint64_t buffer_size,
       std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Trains the ZSTD dictionary of an attribute file on the tiles withheld so
+   * far, and writes them compressed with it. If no dictionary can be
+   * trained on them, the file is compressed without one.
+   *
+   * @param attribute_id The id of the attribute.
+   * @param var If *true*, this focuses on the file of the values of a
+   *     variable-sized attribute.
+   * @return Status
+   */
+  Status train_dictionary(unsigned int attribute_id, bool var);
+
+  /**
+   * Trains the ZSTD dictionaries of all the attribute files that are still
+   * withholding tiles.
+   *
+   * @return Status
+   */
+  Status train_dictionaries();
+
   /**
    * Updates the bookkeeping structures as tiles are written. Specifically, it
    * updates the MBR and bounding coordinates of each tile.
@@ -211,6 +270,29 @@ class WriteState {
   template <class T>
   void update_bookkeeping(const void* buffer, uint64_t buffer_size);
 
+  /**
+   * Computes the minimum and maximum values of a tile of an attribute that
+   * has tile statistics, and appends them to the fragment metadata.
+   *
+   * @param attribute_id The id of the attribute the tile belongs to.
+   * @param tile The tile to be written.
+   * @return void
+   */
+  void update_tile_stats(unsigned int attribute_id, const Tile* tile);
+
+  /**
+   * Computes the minimum and maximum values of a tile of an attribute that
+   * has tile statistics, and appends them to the fragment metadata. NaN
+   * values are ignored.
+   *
+   * @tparam T The attribute type.
+   * @param attribute_id The id of the attribute the tile belongs to.
+   * @param tile The tile to be written.
+   * @return void
+   */
+  template <class T>
+  void update_tile_stats(unsigned int attribute_id, const Tile* tile);
+
   /**
    * Performs the write operation for the case of a dense fragment, focusing
    * on a single fixed-sized attribute.
@@ -310,6 +392,30 @@ class WriteState {
       void* buffer_var,
       uint64_t buffer_var_size,
       const std::vector<uint64_t>& cell_pos);
+
+  /**
+   * Writes a full tile of an attribute file to the disk and records its
+   * offset (and size, for variable-sized tiles) in the fragment metadata. If
+   * the ZSTD dictionary of the file is being trained, a copy of the tile is
+   * withheld instead, and it is written once the dictionary is trained.
+   *
+   * @param attribute_id The id of the attribute.
+   * @param var If *true*, the tile is written to the file of the values of
+   *     a variable-sized attribute.
+   * @param tile The tile.
+   * @return Status
+   */
+  Status write_tile(unsigned int attribute_id, bool var, Tile* tile);
+
+  /**
+   * Writes the current variable-sized tile of an attribute to the disk and
+   * records its offset and size in the fragment metadata. If the attribute
+   * uses the dictionary filter, the tile is dictionary-encoded first.
+   *
+   * @param attribute_id The id of the attribute.
+   * @return Status
+   */
+  Status write_tile_var(unsigned int attribute_id);
 };
 
 }  // namespace tiledb
@@ -117,6 +117,12 @@ extern const char* file_suffix;
 /** The fragment metadata file name. */
 extern const char* fragment_metadata_filename;
 
+/**
+ * The magic number at the end of a fragment metadata file, which marks that
+ * its metadata are stored in separately loaded sections.
+ */
+extern const uint64_t fragment_metadata_magic;
+
 /** Default datatype for a generic tile. */
 extern const Datatype generic_tile_datatype;
 
@@ -192,6 +198,30 @@ extern const char* bzip2_str;
 /** String describing DOUBLE_DELTA. */
 extern const char* double_delta_str;
 
+/** String describing BLOCK_DOUBLE_DELTA. */
+extern const char* block_double_delta_str;
+
+/** String describing GORILLA. */
+extern const char* gorilla_str;
+
+/** String describing ADAPTIVE. */
+extern const char* adaptive_str;
+
+/** String describing NO_FILTER. */
+extern const char* no_filter_str;
+
+/** String describing BYTESHUFFLE. */
+extern const char* byteshuffle_str;
+
+/** String describing BITSHUFFLE. */
+extern const char* bitshuffle_str;
+
+/** String describing DELTA. */
+extern const char* delta_str;
+
+/** String describing DICTIONARY. */
+extern const char* dictionary_str;
+
 /** The string representation for type int32. */
 extern const char* int32_str;
 
@@ -249,9 +279,87 @@ extern const char* null_str;
 /** The version in format { major, minor, revision }. */
 extern const int version[3];
 
-/** The size of a tile chunk. */
+/**
+ * The first library version that stores the chunk size, the filter and the
+ * compression dictionary size of the attributes in the array metadata.
+ */
+extern const int attribute_options_min_version[3];
+
+/**
+ * The maximum size of a tile chunk. This is bounded by the largest input
+ * the compression libraries accept in a single call.
+ */
 extern const uint64_t tile_chunk_size;
 
+/** The default size of a tile chunk upon compression. */
+extern const uint64_t default_tile_chunk_size;
+
+/**
+ * The default capacity of the ZSTD dictionaries of an attribute (0 means
+ * that no dictionaries are trained).
+ */
+extern const uint64_t default_compression_dictionary_size;
+
+/**
+ * The tiles of an attribute file are sampled for training its ZSTD
+ * dictionary until they amount to this many times the dictionary capacity.
+ */
+extern const uint64_t compression_dictionary_sample_ratio;
+
+/**
+ * The default number of threads of the storage manager thread pool, used if
+ * the number of hardware threads cannot be determined.
+ */
+extern const unsigned int num_threads;
+
+/** The default size of the storage manager tile cache in bytes. */
+extern const uint64_t tile_cache_size;
+
+/** The default maximum number of file descriptors the VFS keeps open. */
+extern const uint64_t vfs_max_open_files;
+
+/** The default number of threads that execute asynchronous VFS requests. */
+extern const unsigned int vfs_async_threads;
+
+/** The default candidate compressors of the ADAPTIVE compressor. */
+extern const char* adaptive_compressors;
+
+/**
+ * The maximum number of bytes of a tile chunk the ADAPTIVE compressor
+ * trial-compresses with every candidate compressor.
+ */
+extern const uint64_t adaptive_sample_size;
+
+/** The number of evenly spaced blocks an ADAPTIVE sample consists of. */
+extern const uint64_t adaptive_sample_block_num;
+
+/** The maximum number of asynchronous requests in flight in io_uring. */
+extern const unsigned int async_io_queue_depth;
+
+/**
+ * The maximum number of bytes between two tiles of a file, for their reads
+ * to be coalesced into a single read.
+ */
+extern const uint64_t coalesced_read_max_gap;
+
+/** The maximum size of a single coalesced read of multiple tiles. */
+extern const uint64_t coalesced_read_max_size;
+
+/** The size of the batches of tiles written with write-behind buffering. */
+extern const uint64_t write_behind_buffer_size;
+
+/** The version of the format of the RLE-compressed data. */
+extern const uint8_t rle_format_version;
+
+/**
+ * The first library version whose fragments store RLE-compressed data in
+ * the versioned format.
+ */
+extern const int rle_format_min_version[3];
+
+/** The number of MBRs checked together for overlap with a subarray. */
+extern const uint64_t mbr_overlap_batch_size;
+
 }  // namespace constants
 
 }  // namespace tiledb
@@ -98,7 +98,9 @@ enum class StatusCode : char {
   ConstBuffer,
   Dimension,
   Domain,
-  Consolidation
+  Consolidation,
+  Config,
+  ThreadPool
 };
 
 class Status {
@@ -250,6 +252,16 @@ class Status {
     return Status(StatusCode::Consolidation, msg, -1);
   }
 
+  /** Return a ConfigError error class Status with a given message **/
+  static Status ConfigError(const std::string& msg) {
+    return Status(StatusCode::Config, msg, -1);
+  }
+
+  /** Return a ThreadPoolError error class Status with a given message **/
+  static Status ThreadPoolError(const std::string& msg) {
+    return Status(StatusCode::ThreadPool, msg, -1);
+  }
+
   /** Returns true iff the status indicates success **/
   bool ok() const {
     return (state_ == nullptr);
@@ -0,0 +1,165 @@
+/**
+ * @file   thread_pool.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ThreadPool.
+ */
+
+#ifndef TILEDB_THREAD_POOL_H
+#define TILEDB_THREAD_POOL_H
+
+#include "status.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tiledb {
+
+/**
+ * A work-stealing thread pool. Every worker thread owns a task queue. Tasks
+ * submitted by a worker are pushed to its own queue, whereas tasks submitted
+ * by any other thread are distributed round-robin across the queues. An idle
+ * worker first serves its own queue and then steals from the queues of the
+ * other workers.
+ */
+class ThreadPool {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  ThreadPool();
+
+  /** Destructor. It waits for all the enqueued tasks to complete. */
+  ~ThreadPool();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Enqueues a task for execution.
+   *
+   * @param function The task to be executed.
+   * @return A future holding the status returned by the task.
+   */
+  std::future<Status> enqueue(const std::function<Status()>& function);
+
+  /**
+   * Spawns the worker threads.
+   *
+   * @param thread_num The number of worker threads. It must be positive.
+   * @return Status
+   */
+  Status init(unsigned int thread_num);
+
+  /** Returns the number of worker threads. */
+  unsigned int thread_num() const;
+
+  /**
+   * Waits for the input tasks to complete. While waiting, the calling
+   * thread executes pending tasks itself, which allows tasks to enqueue
+   * and wait on other tasks without exhausting the worker threads.
+   *
+   * @param tasks The futures of the tasks to wait on.
+   * @return The first error status returned by a task, or Ok if all the
+   *     tasks succeeded.
+   */
+  Status wait_all(std::vector<std::future<Status>>& tasks);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** A task queue owned by a single worker thread. */
+  struct TaskQueue {
+    /** Protects the queue. */
+    std::mutex mtx_;
+
+    /** The pending tasks. */
+    std::deque<std::packaged_task<Status()>> tasks_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Notifies the idle worker threads about new tasks or termination. */
+  std::condition_variable cv_;
+
+  /** Protects the idle worker threads' waiting on `cv_`. */
+  std::mutex mtx_;
+
+  /** The queue where the next task of a non-worker thread is pushed. */
+  std::atomic<uint64_t> next_queue_;
+
+  /** One task queue per worker thread. */
+  std::vector<TaskQueue*> queues_;
+
+  /** If true, the worker threads terminate once the queues are empty. */
+  bool should_terminate_;
+
+  /** The number of tasks currently in the queues. */
+  std::atomic<int64_t> task_num_;
+
+  /** The worker threads. */
+  std::vector<std::thread> threads_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Retrieves a pending task. It first looks at the back of the queue with
+   * index `queue_idx` and then steals from the front of the other queues.
+   *
+   * @param queue_idx The index of the queue to look at first.
+   * @param task The retrieved task.
+   * @return *true* if a task was retrieved and *false* otherwise.
+   */
+  bool pop_task(uint64_t queue_idx, std::packaged_task<Status()>* task);
+
+  /**
+   * The function executed by every worker thread.
+   *
+   * @param queue_idx The index of the queue owned by the worker.
+   */
+  void worker(uint64_t queue_idx);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_THREAD_POOL_H
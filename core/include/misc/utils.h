@@ -148,6 +148,27 @@ int cmp_row_order(
     const T* coords_b,
     unsigned int dim_num);
 
+/**
+ * Gathers equally-sized blocks that lie at a fixed stride in the source
+ * into consecutive positions in the destination. Blocks of 1, 2, 4, 8 and
+ * 16 bytes (i.e., single cells of the common types) are copied with
+ * dedicated kernels, which the compiler can vectorize.
+ *
+ * @param dst The destination buffer.
+ * @param src The start of the first block in the source buffer.
+ * @param block_size The size of each block in bytes.
+ * @param block_num The number of blocks.
+ * @param src_stride The distance in bytes between the starts of two
+ *     consecutive blocks in the source.
+ * @return void
+ */
+void copy_strided(
+    void* dst,
+    const void* src,
+    uint64_t block_size,
+    uint64_t block_num,
+    uint64_t src_stride);
+
 /**
  * Returns the input domain as a string of the form "[low, high]".
  *
@@ -236,6 +257,15 @@ bool intersect(const std::vector<T>& v1, const std::vector<T>& v2);
 template <class T>
 bool is_contained(const T* range_A, const T* range_B, unsigned int dim_num);
 
+/**
+ * Checks if a library version precedes another.
+ *
+ * @param version The version in format { major, minor, revision }.
+ * @param other The version to compare with, in the same format.
+ * @return *true* if *version* is older than *other*.
+ */
+bool is_older_version(const int* version, const int* other);
+
 /** Returns *true* if the input string is a positive (>0) integer number. */
 bool is_positive_integer(const char* s);
 
@@ -604,8 +604,10 @@ class ArrayOrderedReadState {
    * properly re-organizing the cell order to fit the targeted order.
    * Applicable to dense arrays.
    *
+   * @tparam T The domain type.
    * @return void.
    */
+  template <class T>
   void copy_tile_slab_dense();
 
   /**
@@ -623,10 +625,12 @@ class ArrayOrderedReadState {
    * focusing on a particular fixed-length attribute.
    * Applicable to dense arrays.
    *
+   * @tparam T The domain type.
    * @param aid The index on attribute_ids_ to focus on.
    * @param bid The index on the copy state buffers to focus on.
    * @return void.
    */
+  template <class T>
   void copy_tile_slab_dense(unsigned int aid, unsigned int bid);
 
   /**
@@ -647,10 +651,12 @@ class ArrayOrderedReadState {
    * focusing on a particular variable-length attribute.
    * Applicable to dense arrays.
    *
+   * @tparam T The domain type.
    * @param aid The index on attribute_ids_ to focus on.
    * @param bid The index on the copy state buffers to focus on.
    * @return void.
    */
+  template <class T>
   void copy_tile_slab_dense_var(unsigned int aid, unsigned int bid);
 
   /**
@@ -34,12 +34,14 @@
 #ifndef TILEDB_ARRAY_READ_STATE_H
 #define TILEDB_ARRAY_READ_STATE_H
 
+#include <atomic>
 #include <cinttypes>
 #include <cstring>
 #include <queue>
 #include <vector>
 
 #include "array_metadata.h"
+#include "buffer.h"
 #include "query.h"
 
 namespace tiledb {
@@ -122,6 +124,10 @@ class ArrayReadState {
    *     next invocation will resume for the point the previous one stopped,
    *     without inflicting a considerable performance penalty due to overflow.
    * @return Status
+   *
+   * @note Upon the first invocation, the subarray is split into blocks of
+   *     tiles that are read in parallel, if all the results fit in the
+   *     buffers (see *read_parallel*).
    */
   Status read(void** buffers, uint64_t* buffer_sizes);
 
@@ -172,6 +178,12 @@ class ArrayReadState {
   /** Indicates overflow for each attribute. */
   std::vector<bool> overflow_;
 
+  /** Indicates whether all the results were retrieved by a parallel read. */
+  bool parallel_read_done_;
+
+  /** Indicates whether a parallel read has been attempted. */
+  bool parallel_read_tried_;
+
   /** The query this array read state belongs to. */
   Query* query_;
 
@@ -229,6 +241,24 @@ class ArrayReadState {
   template <class T>
   void compute_min_bounding_coords_end();
 
+  /**
+   * Splits the query subarray into blocks that can be read independently,
+   * such that the concatenation of their results in the global cell order
+   * yields the results of the subarray. The subarray is split along the
+   * most significant dimension in the tile order (or the cell order, if
+   * there is no tile grid) that spans more than one tile, at tile
+   * boundaries.
+   *
+   * @tparam T The coordinates type.
+   * @param max_block_num The maximum number of blocks.
+   * @param blocks The block subarrays, in the global cell order. No blocks
+   *     are returned if the subarray spans a single tile.
+   * @return void
+   */
+  template <class T>
+  void compute_read_blocks(
+      uint64_t max_block_num, std::vector<std::vector<T>>* blocks) const;
+
   /**
    * Computes the relevant fragment cell ranges for the current read run,
    * focusing on the **dense* array case. These cell ranges will be properly
@@ -474,6 +504,18 @@ class ArrayReadState {
   template <class T>
   void init_subarray_tile_coords();
 
+  /**
+   * Fetches concurrently the tiles needed by the most recently computed
+   * fragment cell position ranges, for every query attribute that will
+   * process these ranges next. The tiles of all attributes (and fragments)
+   * are read and decompressed in parallel on the storage manager thread
+   * pool, so that the subsequent per-attribute cell copies find them
+   * already in memory.
+   *
+   * @return Status
+   */
+  Status prefetch_tiles();
+
   /**
    * Performs a read operation in a **dense** array.
    *
@@ -547,6 +589,69 @@ class ArrayReadState {
       void* buffer_var,
       uint64_t* buffer_var_size);
 
+  /**
+   * Reads a block of the query subarray with an internal query, which
+   * retrieves the cells of the block in the global cell order. The results
+   * of each buffer are either written directly at their final location in
+   * the user buffers, or appended to a block buffer that grows as needed.
+   *
+   * @param block The block subarray.
+   * @param direct_buffers The locations where the results of each buffer
+   *     are written directly, or *nullptr* for the buffers whose results are
+   *     appended to *block_buffers*.
+   * @param direct_buffer_sizes The sizes of the direct locations, which must
+   *     fit all the results of the block.
+   * @param block_buffers The buffers the results are appended to (*nullptr*
+   *     for the buffers written directly).
+   * @param max_buffer_sizes The maximum total size of the results of each
+   *     buffer across all blocks.
+   * @param result_sizes The total size of the results appended for each
+   *     buffer across all blocks. It is updated after every read round.
+   * @param fits Set to *false* if the results do not fit in the maximum
+   *     buffer sizes, which stops reading all the blocks.
+   * @return Status
+   */
+  Status read_block(
+      const void* block,
+      void** direct_buffers,
+      const uint64_t* direct_buffer_sizes,
+      Buffer** block_buffers,
+      const uint64_t* max_buffer_sizes,
+      std::vector<std::atomic<uint64_t>>* result_sizes,
+      std::atomic<bool>* fits);
+
+  /**
+   * Attempts to retrieve all the results of the query at once, by
+   * splitting the subarray into blocks of tiles (see *compute_read_blocks*)
+   * that are read concurrently by the storage manager thread pool. The
+   * fixed-sized results of dense arrays are written directly at their
+   * precomputed offsets in the user buffers, whereas the rest are gathered
+   * per block and copied to the user buffers once all blocks are done.
+   * Nothing is retrieved if the subarray cannot be split, or if the results
+   * may not fit in the user buffers (judging from the upper bounds computed
+   * by *StorageManager::array_compute_max_read_buffer_sizes*), in which
+   * case the serial read must be performed instead.
+   *
+   * @param buffers See read().
+   * @param buffer_sizes See read().
+   * @param done Set to *true* if all the results were retrieved.
+   * @return Status
+   */
+  Status read_parallel(void** buffers, uint64_t* buffer_sizes, bool* done);
+
+  /**
+   * Attempts to retrieve all the results of the query at once (see the
+   * non-templated *read_parallel*).
+   *
+   * @tparam T The coordinates type.
+   * @param buffers See read().
+   * @param buffer_sizes See read().
+   * @param done Set to *true* if all the results were retrieved.
+   * @return Status
+   */
+  template <class T>
+  Status read_parallel(void** buffers, uint64_t* buffer_sizes, bool* done);
+
   /**
    * Performs a read operation in a **sparse** array.
    *
@@ -0,0 +1,160 @@
+/**
+ * @file   predicate.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Predicate.
+ */
+
+#ifndef TILEDB_PREDICATE_H
+#define TILEDB_PREDICATE_H
+
+#include "datatype.h"
+#include "predicate_op.h"
+
+#include <cinttypes>
+#include <vector>
+
+namespace tiledb {
+
+/**
+ * A comparison of the values of a fixed-sized numeric attribute with a
+ * constant, e.g., `a > 30`. A read query returns only the cells that
+ * satisfy all of its predicates. The predicates are evaluated on the tile
+ * statistics first, in order to skip the tiles whose cells cannot satisfy
+ * them, and then on the cells of the tiles that are read.
+ */
+class Predicate {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param attribute_id The id of the attribute the predicate is on.
+   * @param type The type of the attribute.
+   * @param op The comparison operator.
+   * @param value The value the attribute values are compared with, of type
+   *     *type*. It is copied into the predicate.
+   */
+  Predicate(
+      unsigned int attribute_id,
+      Datatype type,
+      PredicateOp op,
+      const void* value);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the id of the attribute the predicate is on. */
+  unsigned int attribute_id() const;
+
+  /**
+   * Evaluates the predicate on a range of cells.
+   *
+   * @param values The attribute values of the cells.
+   * @param num The number of cells.
+   * @param matches Set to 0 for each cell that does not satisfy the
+   *     predicate, and left intact otherwise. It must hold *num* elements.
+   * @return void
+   */
+  void check_cells(const void* values, uint64_t num, uint8_t* matches) const;
+
+  /**
+   * Evaluates the predicate on the statistics of a range of tiles. A tile
+   * may contain cells that satisfy the predicate only if its [min, max]
+   * range allows it. The NE operator never excludes a tile.
+   *
+   * @param mins The minimum attribute values of the tiles.
+   * @param maxs The maximum attribute values of the tiles.
+   * @param num The number of tiles.
+   * @param overlaps Set to 0 for each tile that cannot contain cells that
+   *     satisfy the predicate, and left intact otherwise. It must hold *num*
+   *     elements.
+   * @return void
+   */
+  void check_tiles(
+      const void* mins,
+      const void* maxs,
+      uint64_t num,
+      uint8_t* overlaps) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The id of the attribute the predicate is on. */
+  unsigned int attribute_id_;
+
+  /** The comparison operator. */
+  PredicateOp op_;
+
+  /** The type of the attribute. */
+  Datatype type_;
+
+  /** The value the attribute values are compared with. */
+  std::vector<char> value_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Implements *check_cells* for the attribute type.
+   *
+   * @tparam T The attribute type.
+   * @param values The attribute values of the cells.
+   * @param num The number of cells.
+   * @param matches The cell matches to be updated.
+   * @return void
+   */
+  template <class T>
+  void check_cells(const T* values, uint64_t num, uint8_t* matches) const;
+
+  /**
+   * Implements *check_tiles* for the attribute type.
+   *
+   * @tparam T The attribute type.
+   * @param mins The minimum attribute values of the tiles.
+   * @param maxs The maximum attribute values of the tiles.
+   * @param num The number of tiles.
+   * @param overlaps The tile overlaps to be updated.
+   * @return void
+   */
+  template <class T>
+  void check_tiles(
+      const T* mins, const T* maxs, uint64_t num, uint8_t* overlaps) const;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_PREDICATE_H
@@ -37,6 +37,7 @@
 #include "array_ordered_write_state.h"
 #include "array_read_state.h"
 #include "fragment.h"
+#include "predicate.h"
 #include "query_status.h"
 #include "query_type.h"
 #include "status.h"
@@ -77,6 +78,23 @@ class Query {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Adds a predicate to a read query on a sparse array, so that only the
+   * cells whose value on the input attribute satisfies it are returned.
+   * The attribute must be fixed-sized with a single numeric value per cell
+   * (see *ArrayMetadata::has_tile_stats*), and it does not need to be one
+   * of the attributes of the query. All the predicates of a query must be
+   * satisfied.
+   *
+   * @param attribute The name of the attribute the predicate is on.
+   * @param op The comparison operator.
+   * @param value The value the attribute values are compared with, which
+   *     must be of the attribute type.
+   * @return Status
+   */
+  Status add_predicate(
+      const char* attribute, PredicateOp op, const void* value);
+
   /** Returns the array metadata.*/
   const ArrayMetadata* array_metadata() const;
 
@@ -219,6 +237,15 @@ class Query {
    */
   Status overflow(const char* attribute_name, unsigned int* overflow) const;
 
+  /**
+   * Returns *true* if a read in the global cell order may be split into
+   * blocks of tiles that are read in parallel.
+   */
+  bool parallel_reads() const;
+
+  /** Returns the predicates of the query. */
+  const std::vector<Predicate>& predicates() const;
+
   /** Executes a read query. */
   Status read();
 
@@ -238,6 +265,19 @@ class Query {
    */
   void set_callback(void* (*callback)(void*), void* callback_data);
 
+  /**
+   * Sets whether a read in the global cell order may be split into blocks
+   * of tiles that are read in parallel. This is disabled for the internal
+   * queries that read the blocks.
+   */
+  void set_parallel_reads(bool parallel_reads);
+
+  /**
+   * Sets the predicates of the query. This is used for the internal queries,
+   * which inherit the predicates of the user query.
+   */
+  void set_predicates(const std::vector<Predicate>& predicates);
+
   /** Sets the query status. */
   void set_status(QueryStatus status);
 
@@ -339,6 +379,12 @@ class Query {
   /** The cell layout. */
   Layout layout_;
 
+  /** Indicates whether a read may be split into blocks read in parallel. */
+  bool parallel_reads_;
+
+  /** The predicates that the cells returned by a read must satisfy. */
+  std::vector<Predicate> predicates_;
+
   /** The storage manager. */
   StorageManager* storage_manager_;
 
@@ -0,0 +1,230 @@
+/**
+ * @file   config.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Config.
+ */
+
+#ifndef TILEDB_CONFIG_H
+#define TILEDB_CONFIG_H
+
+#include "compressor.h"
+#include "status.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tiledb {
+
+/**
+ * Holds the configuration parameters of the storage manager. The parameters
+ * are set as (name, value) string pairs. The currently supported parameters
+ * are:
+ *
+ * - `sm.adaptive_compressors`: The candidate compressors the ADAPTIVE
+ *    compressor tries on every tile chunk, as a comma-separated list of
+ *    compressor names, each optionally followed by `:` and a compression
+ *    level (e.g., `RLE,LZ4,ZSTD:1,ZSTD:9`). It defaults to
+ *    `RLE,DOUBLE_DELTA,LZ4,ZSTD:1,ZSTD:9`.
+ * - `sm.adaptive_decode_weight`: How much the ADAPTIVE compressor favors
+ *    decompression speed over compression ratio. A candidate is scored by
+ *    its compressed size plus its relative decompression cost, multiplied
+ *    by this weight. It defaults to 0, i.e., the smallest output wins.
+ * - `sm.num_threads`: The number of threads of the storage manager thread
+ *    pool, which executes all internal parallel work (e.g., compression).
+ *    It defaults to the number of hardware threads.
+ * - `sm.parallel_read_blocks`: The maximum number of blocks of tiles a
+ *    read query in the global cell order is split into, which are read
+ *    concurrently by the thread pool. It defaults to 0, in which case it
+ *    equals the number of threads of the thread pool; 1 disables parallel
+ *    reads.
+ * - `sm.tile_cache_size`: The maximum total size in bytes of the
+ *    decompressed tiles the storage manager caches across queries. It
+ *    defaults to 10MB; 0 disables the cache.
+ * - `vfs.max_open_files`: The maximum number of file descriptors the VFS
+ *    keeps open across reads and writes. It defaults to 256; 0 disables
+ *    caching the descriptors.
+ * - `vfs.mmap_reads`: If `true`, uncompressed tiles of POSIX files are read
+ *    by referencing a read-only memory mapping of the file instead of being
+ *    copied into the tile buffers. It defaults to `false`.
+ * - `vfs.io_uring`: If `true`, the asynchronous VFS requests on POSIX files
+ *    are submitted to io_uring when the build and the kernel support it.
+ *    It defaults to `true`.
+ * - `vfs.async_threads`: The number of threads that execute asynchronous
+ *    VFS requests when io_uring is not used. It defaults to 4.
+ */
+class Config {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. It sets all the parameters to their default values. */
+  Config();
+
+  /** Destructor. */
+  ~Config();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the candidate compressors of the ADAPTIVE compressor, as
+   * (compressor, compression level) pairs.
+   */
+  const std::vector<std::pair<Compressor, int>>& adaptive_compressors() const;
+
+  /** Returns the weight of the decompression cost in ADAPTIVE compression. */
+  uint64_t adaptive_decode_weight() const;
+
+  /** Returns the number of threads of the storage manager thread pool. */
+  unsigned int num_threads() const;
+
+  /**
+   * Returns the maximum number of blocks a read is split into (0 means the
+   * number of threads of the thread pool).
+   */
+  uint64_t parallel_read_blocks() const;
+
+  /**
+   * Sets a configuration parameter.
+   *
+   * @param param The parameter name.
+   * @param value The parameter value.
+   * @return Status
+   */
+  Status set(const std::string& param, const std::string& value);
+
+  /** Returns the size of the storage manager tile cache in bytes. */
+  uint64_t tile_cache_size() const;
+
+  /** Returns the number of threads that execute asynchronous requests. */
+  unsigned int vfs_async_threads() const;
+
+  /** Returns *true* if asynchronous requests may use io_uring. */
+  bool vfs_io_uring() const;
+
+  /** Returns the maximum number of file descriptors the VFS keeps open. */
+  uint64_t vfs_max_open_files() const;
+
+  /** Returns *true* if uncompressed tiles are read via memory mapping. */
+  bool vfs_mmap_reads() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The candidate (compressor, level) pairs of ADAPTIVE compression. */
+  std::vector<std::pair<Compressor, int>> adaptive_compressors_;
+
+  /** The weight of the decompression cost in ADAPTIVE compression. */
+  uint64_t adaptive_decode_weight_;
+
+  /** The number of threads of the storage manager thread pool. */
+  unsigned int num_threads_;
+
+  /** The maximum number of blocks a read is split into. */
+  uint64_t parallel_read_blocks_;
+
+  /** The size of the storage manager tile cache in bytes. */
+  uint64_t tile_cache_size_;
+
+  /** The number of threads that execute asynchronous requests. */
+  unsigned int vfs_async_threads_;
+
+  /** If *true*, asynchronous requests may use io_uring. */
+  bool vfs_io_uring_;
+
+  /** The maximum number of file descriptors the VFS keeps open. */
+  uint64_t vfs_max_open_files_;
+
+  /** If *true*, uncompressed tiles are read via memory mapping. */
+  bool vfs_mmap_reads_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Parses a boolean parameter value, i.e., `true` or `false`.
+   *
+   * @param param The parameter name (used in error messages).
+   * @param value The parameter value to be parsed.
+   * @param result The parsed value.
+   * @return Status
+   */
+  Status parse_bool(
+      const std::string& param, const std::string& value, bool* result) const;
+
+  /**
+   * Parses a list of compressors, i.e., comma-separated compressor names,
+   * each optionally followed by `:` and a compression level.
+   *
+   * @param param The parameter name (used in error messages).
+   * @param value The parameter value to be parsed.
+   * @param result The parsed (compressor, compression level) pairs.
+   * @return Status
+   */
+  Status parse_compressors(
+      const std::string& param,
+      const std::string& value,
+      std::vector<std::pair<Compressor, int>>* result) const;
+
+  /**
+   * Parses a non-negative integer parameter value.
+   *
+   * @param param The parameter name (used in error messages).
+   * @param value The parameter value to be parsed.
+   * @param result The parsed value.
+   * @return Status
+   */
+  Status parse_non_negative_integer(
+      const std::string& param,
+      const std::string& value,
+      uint64_t* result) const;
+
+  /**
+   * Parses a positive integer parameter value.
+   *
+   * @param param The parameter name (used in error messages).
+   * @param value The parameter value to be parsed.
+   * @param result The parsed value.
+   * @return Status
+   */
+  Status parse_positive_integer(
+      const std::string& param,
+      const std::string& value,
+      uint64_t* result) const;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CONFIG_H
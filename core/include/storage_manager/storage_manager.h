@@ -43,12 +43,15 @@
 #include <thread>
 
 #include "array_metadata.h"
+#include "config.h"
 #include "consolidator.h"
 #include "locked_array.h"
 #include "object_type.h"
 #include "open_array.h"
 #include "query.h"
 #include "status.h"
+#include "thread_pool.h"
+#include "tile_cache.h"
 #include "uri.h"
 #include "vfs.h"
 #include "walk_order.h"
@@ -93,6 +96,51 @@ class StorageManager {
   /*                API                */
   /* ********************************* */
 
+  /**
+   * Computes the sizes of the buffers that suffice to hold the results of a
+   * read query on the input subarray, so that the query completes without
+   * overflowing. The sizes are computed solely from the fragment metadata,
+   * without reading any tiles. For dense arrays, the sizes of the
+   * fixed-sized attributes and of the offsets of the variable-sized ones are
+   * exact, whereas all the other sizes are upper bounds.
+   *
+   * @param array_name The name of the array.
+   * @param subarray The subarray of the read (*nullptr* means the entire
+   *     domain).
+   * @param attributes The attributes of the read (*nullptr* means all
+   *     attributes, as in *query_init*).
+   * @param attribute_num The number of attributes.
+   * @param buffer_sizes The buffer sizes to be computed, one per fixed-sized
+   *     attribute and two per variable-sized attribute, in the same order as
+   *     the buffers of the read query.
+   * @return Status
+   */
+  Status array_compute_max_read_buffer_sizes(
+      const char* array_name,
+      const void* subarray,
+      const char** attributes,
+      unsigned int attribute_num,
+      uint64_t* buffer_sizes);
+
+  /**
+   * Computes the max read buffer sizes (see the overload above) on an open
+   * array, for the input attribute ids.
+   *
+   * @param array_metadata The array metadata.
+   * @param fragment_metadata The fragment metadata.
+   * @param subarray The subarray of the read (*nullptr* means the entire
+   *     domain).
+   * @param attribute_ids The ids of the attributes of the read.
+   * @param buffer_sizes The buffer sizes to be computed.
+   * @return Status
+   */
+  Status array_compute_max_read_buffer_sizes(
+      const ArrayMetadata* array_metadata,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      const void* subarray,
+      const std::vector<unsigned int>& attribute_ids,
+      uint64_t* buffer_sizes);
+
   /**
    * Consolidates the fragments of an array into a single one.
    *
@@ -138,6 +186,9 @@ class StorageManager {
    */
   Status async_push_query(Query* query, int i);
 
+  /** Returns the configuration parameters. */
+  const Config& config() const;
+
   /** Creates a directory with the input URI. */
   Status create_dir(const URI& uri);
 
@@ -165,11 +216,14 @@ class StorageManager {
    * Initializes the storage manager. It spawns two threads. The first is for
    * handling user asynchronous queries (submitted via the *query_submit_async*
    * function. The second handles internal asynchronous queries as part of some
-   * either sync or async query.
+   * either sync or async query. It also creates the thread pool that
+   * executes all internal parallel work.
    *
+   * @param config The configuration parameters. If it is *nullptr*, the
+   *     default configuration is used.
    * @return Status
    */
-  Status init();
+  Status init(Config* config);
 
   /** Returns true if the input URI is a fragment directory. */
   bool is_fragment(const URI& uri) const;
@@ -191,7 +245,9 @@ class StorageManager {
 
   /**
    * Loads the fragment metadata of an array from persistent storage into
-   * memory.
+   * memory. Only the footer of the fragment metadata is loaded, unless the
+   * fragment was written in the (unsectioned) format of earlier versions;
+   * the rest is loaded lazily (see FragmentMetadata::load_sections).
    *
    * @param metadata The fragment metadata to be loaded.
    * @return Status
@@ -321,6 +377,45 @@ class StorageManager {
   Status query_submit_async(
       Query* query, void* (*callback)(void*), void* callback_data);
 
+  /**
+   * Maps a file into memory as a read-only region.
+   *
+   * @param uri The URI of the file.
+   * @param nbytes The number of bytes to map, starting at the beginning of
+   *     the file.
+   * @param data The start of the mapped region.
+   * @return Status
+   */
+  Status map_file(const URI& uri, uint64_t nbytes, void** data) const;
+
+  /**
+   * Advises the filesystem about the expected access pattern of part of a
+   * region mapped with `map_file`.
+   *
+   * @param uri The URI of the mapped file.
+   * @param data The start of the mapped region.
+   * @param offset The offset of the advised range in the region.
+   * @param nbytes The size of the advised range.
+   * @param advice The access pattern.
+   * @return Status
+   */
+  Status advise_mapped(
+      const URI& uri,
+      void* data,
+      uint64_t offset,
+      uint64_t nbytes,
+      MmapAdvice advice) const;
+
+  /**
+   * Unmaps a region mapped with `map_file`.
+   *
+   * @param uri The URI of the mapped file.
+   * @param data The start of the mapped region.
+   * @param nbytes The size of the mapped region.
+   * @return Status
+   */
+  Status unmap_file(const URI& uri, void* data, uint64_t nbytes) const;
+
   /**
    * Reads from a file into the input buffer.
    *
@@ -334,6 +429,26 @@ class StorageManager {
   Status read_from_file(
       const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const;
 
+  /**
+   * Submits an asynchronous read from a file into the input buffer. The read
+   * must be completed with *wait_async*, before which the buffer must be
+   * neither accessed nor freed.
+   *
+   * @param uri The URI file to read from.
+   * @param offset The offset in the file the read will start from.
+   * @param buffer The buffer to write into. The function reallocates memory
+   *     for the buffer, sets its size to *nbytes* and resets its offset.
+   * @param nbytes The number of bytes to read.
+   * @param request_id The id of the submitted request.
+   * @return Status.
+   */
+  Status read_from_file_async(
+      const URI& uri,
+      uint64_t offset,
+      Buffer* buffer,
+      uint64_t nbytes,
+      uint64_t* request_id) const;
+
   /**
    * Stores an array metadata into persistent storage.
    *
@@ -343,7 +458,10 @@ class StorageManager {
   Status store(ArrayMetadata* array_metadata);
 
   /**
-   * Stores the fragment metadata into persistent storage.
+   * Stores the fragment metadata into persistent storage. Each section of
+   * the metadata is written as a separate generic tile, followed by the
+   * footer (also a generic tile) and a fixed-size trailer with the footer
+   * offset and a magic number.
    *
    * @param metadata The fragment metadata to be stored.
    * @return Status
@@ -356,6 +474,12 @@ class StorageManager {
    */
   Status sync(const URI& uri);
 
+  /** Returns the thread pool that executes internal parallel work. */
+  ThreadPool* thread_pool() const;
+
+  /** Returns the cache of decompressed tiles shared by all queries. */
+  TileCache* tile_cache() const;
+
   /**
    * Writes the contents of a buffer into a URI file.
    *
@@ -365,6 +489,31 @@ class StorageManager {
    */
   Status write_to_file(const URI& uri, Buffer* buffer) const;
 
+  /**
+   * Submits an asynchronous write of the contents of a buffer at an offset
+   * of a URI file. The write must be completed with *wait_async*, before
+   * which the buffer must be neither modified nor freed.
+   *
+   * @param uri The file to write into.
+   * @param offset The offset in the file the write will start from.
+   * @param buffer The buffer to write.
+   * @param request_id The id of the submitted request.
+   * @return Status.
+   */
+  Status write_to_file_async(
+      const URI& uri,
+      uint64_t offset,
+      Buffer* buffer,
+      uint64_t* request_id) const;
+
+  /**
+   * Waits for an asynchronous read or write to finish.
+   *
+   * @param request_id The id of the request.
+   * @return The status of the request.
+   */
+  Status wait_async(uint64_t request_id) const;
+
  private:
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
@@ -400,6 +549,9 @@ class StorageManager {
   /** Object that handles array consolidation. */
   Consolidator* consolidator_;
 
+  /** The configuration parameters. */
+  Config config_;
+
   /** Used for array shared and exclusive locking. */
   std::mutex locked_array_mtx_;
 
@@ -421,6 +573,15 @@ class StorageManager {
    */
   std::map<std::string, OpenArray*> open_arrays_;
 
+  /**
+   * Thread pool shared by all internal parallel work, such as compression
+   * and decompression of tile chunks.
+   */
+  ThreadPool* thread_pool_;
+
+  /** The cache of decompressed tiles shared by all queries. */
+  TileCache* tile_cache_;
+
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
    * filesystem backend. Note that this is stateful.
@@ -435,6 +596,26 @@ class StorageManager {
   Status array_close(
       URI array, const std::vector<FragmentMetadata*>& fragment_metadata);
 
+  /**
+   * Implements *array_compute_max_read_buffer_sizes* on an open array,
+   * resolving the input attribute names to their ids.
+   *
+   * @param array_metadata The array metadata.
+   * @param fragment_metadata The fragment metadata.
+   * @param subarray The subarray of the read.
+   * @param attributes The attributes of the read.
+   * @param attribute_num The number of attributes.
+   * @param buffer_sizes The buffer sizes to be computed.
+   * @return Status
+   */
+  Status array_compute_max_read_buffer_sizes(
+      const ArrayMetadata* array_metadata,
+      const std::vector<FragmentMetadata*>& fragment_metadata,
+      const void* subarray,
+      const char** attributes,
+      unsigned int attribute_num,
+      uint64_t* buffer_sizes);
+
   /**
    * Opens an array, retrieving its metadata and fragment metadata.
    *
@@ -513,6 +694,16 @@ class StorageManager {
    * ties using the process id.
    */
   void sort_fragment_uris(std::vector<URI>* fragment_uris) const;
+
+  /**
+   * Writes (appends) a buffer to a file as a generic tile.
+   *
+   * @param uri The URI of the file.
+   * @param buff The buffer to be written.
+   * @param nbytes The number of bytes written to the file.
+   * @return Status
+   */
+  Status write_generic_tile(const URI& uri, Buffer* buff, uint64_t* nbytes);
 };
 
 }  // namespace tiledb
@@ -137,6 +137,12 @@ class Tile {
   /** Returns the cell size. */
   uint64_t cell_size() const;
 
+  /**
+   * Returns the size of the chunks the tile is split into upon
+   * compression.
+   */
+  uint64_t chunk_size() const;
+
   /** Returns the tile compressor. */
   Compressor compressor() const;
 
@@ -155,6 +161,9 @@ class Tile {
   /** Checks if the tile is empty. */
   bool empty() const;
 
+  /** Returns the filter applied to the tile chunks before compression. */
+  Filter filter() const;
+
   /** Checks if the tile is full. */
   bool full() const;
 
@@ -173,6 +182,12 @@ class Tile {
   /** Resets the tile size. */
   void reset_size();
 
+  /** Sets the size of the chunks the tile is split into upon compression. */
+  void set_chunk_size(uint64_t chunk_size);
+
+  /** Sets the filter applied to the tile chunks before compression. */
+  void set_filter(Filter filter);
+
   /** Sets the tile offset. */
   void set_offset(uint64_t offset);
 
@@ -240,6 +255,9 @@ class Tile {
   /** The cell size. */
   uint64_t cell_size_;
 
+  /** The size of the chunks the tile is split into upon compression. */
+  uint64_t chunk_size_;
+
   /** The compression type. */
   Compressor compressor_;
 
@@ -252,6 +270,9 @@ class Tile {
    */
   unsigned int dim_num_;
 
+  /** The filter applied to the tile chunks before compression. */
+  Filter filter_;
+
   /**
    * If *true* the tile object will delete *buff* upon
    * destruction, otherwise it will not delete it.
@@ -0,0 +1,203 @@
+/**
+ * @file   tile_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileCache.
+ */
+
+#ifndef TILEDB_TILE_CACHE_H
+#define TILEDB_TILE_CACHE_H
+
+#include "buffer.h"
+#include "status.h"
+#include "uri.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace tiledb {
+
+/**
+ * A thread-safe LRU cache of decompressed tiles, shared by all the queries
+ * of a storage manager. A tile is identified by the URI of its fragment,
+ * its attribute id and its index in the fragment. The variable-sized values
+ * of an attribute tile are cached separately from its cell offsets.
+ *
+ * The cache is bounded by the total size of the cached tiles. The least
+ * recently used tiles are evicted when the bound is exceeded.
+ */
+class TileCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum total size of the cached tiles in bytes.
+   *     If it is 0, no tile is cached.
+   */
+  explicit TileCache(uint64_t max_size);
+
+  /** Destructor. */
+  ~TileCache();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of lookups that found the requested tile. */
+  uint64_t hits() const;
+
+  /**
+   * Inserts a copy of a tile into the cache, replacing any tile with the
+   * same identifier. The tile becomes the most recently used one. Tiles
+   * larger than the cache are not inserted.
+   *
+   * @param fragment_uri The URI of the fragment of the tile.
+   * @param attribute_id The id of the attribute of the tile.
+   * @param tile_idx The index of the tile in the fragment.
+   * @param var *true* for the variable-sized values of the tile and *false*
+   *     for its fixed-sized cells (or its cell offsets).
+   * @param buffer The tile data, of size `buffer->size()`.
+   * @return Status
+   */
+  Status insert(
+      const URI& fragment_uri,
+      unsigned int attribute_id,
+      uint64_t tile_idx,
+      bool var,
+      const Buffer* buffer);
+
+  /**
+   * Drops from the cache all the tiles of the fragments at or below the
+   * input URI (e.g., an array directory).
+   *
+   * @param uri The URI to be invalidated.
+   */
+  void invalidate(const URI& uri);
+
+  /** Returns the number of lookups that did not find the requested tile. */
+  uint64_t misses() const;
+
+  /**
+   * Looks up a tile and, if it is cached, copies it into the input buffer.
+   * The buffer is reallocated to the tile size, its size is set to the tile
+   * size and its offset is reset. The tile becomes the most recently used
+   * one.
+   *
+   * @param fragment_uri The URI of the fragment of the tile.
+   * @param attribute_id The id of the attribute of the tile.
+   * @param tile_idx The index of the tile in the fragment.
+   * @param var *true* for the variable-sized values of the tile and *false*
+   *     for its fixed-sized cells (or its cell offsets).
+   * @param buffer The buffer to copy the tile into.
+   * @param hit Set to *true* if the tile was found and *false* otherwise.
+   * @return Status
+   */
+  Status read(
+      const URI& fragment_uri,
+      unsigned int attribute_id,
+      uint64_t tile_idx,
+      bool var,
+      Buffer* buffer,
+      bool* hit);
+
+  /** Returns the total size of the cached tiles in bytes. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /**
+   * A cache key, i.e., a (fragment URI, attribute id, tile index, var)
+   * tuple.
+   */
+  typedef std::tuple<std::string, unsigned int, uint64_t, bool> Key;
+
+  /** A cache entry, i.e., a key along with a copy of the tile data. */
+  struct Entry {
+    /** The key of the tile. */
+    Key key_;
+
+    /** A copy of the tile data. */
+    Buffer* buffer_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The cached tiles, from the most to the least recently used. */
+  std::list<Entry> entries_;
+
+  /** The number of lookups that found the requested tile. */
+  uint64_t hits_;
+
+  /**
+   * Maps each key to its position in `entries_`. It is ordered, so that all
+   * the fragments below a URI can be found with a range scan.
+   */
+  std::map<Key, std::list<Entry>::iterator> index_;
+
+  /** The maximum total size of the cached tiles in bytes. */
+  uint64_t max_size_;
+
+  /** The number of lookups that did not find the requested tile. */
+  uint64_t misses_;
+
+  /** Protects the cache. */
+  mutable std::mutex mtx_;
+
+  /** The total size of the cached tiles in bytes. */
+  uint64_t size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Removes an entry from the cache, deallocating its data. The caller must
+   * hold `mtx_`.
+   *
+   * @param it The index position of the entry.
+   * @return The index position following the removed entry.
+   */
+  std::map<Key, std::list<Entry>::iterator>::iterator remove(
+      std::map<Key, std::list<Entry>::iterator>::iterator it);
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_CACHE_H
@@ -36,6 +36,9 @@
 #include "storage_manager.h"
 #include "tile.h"
 #include "uri.h"
+#include "zstd_dictionary.h"
+
+#include <vector>
 
 namespace tiledb {
 
@@ -75,9 +78,85 @@ class TileIO {
   /*                API                */
   /* ********************************* */
 
+  /**
+   * Appends the chunks of a tile to the samples a ZSTD dictionary is trained
+   * on for the file. Each chunk is a separate sample, filtered exactly as it
+   * is before its compression.
+   *
+   * @param tile The tile to be sampled.
+   * @param samples The buffer the samples are appended to.
+   * @param sample_sizes The sizes of the samples, where the sizes of the
+   *     appended samples are pushed.
+   * @return Status
+   */
+  Status append_dictionary_samples(
+      Tile* tile, Buffer* samples, std::vector<uint64_t>* sample_sizes);
+
+  /**
+   * Enables reading uncompressed tiles by referencing a read-only memory
+   * mapping of the whole file, instead of copying them into the tile
+   * buffers. The file is mapped upon the first such read. If mapping is
+   * not possible (e.g., the backend does not support it), the tiles are
+   * read as usual.
+   *
+   * Note that a tile read this way references the mapping until its next
+   * read, and hence it must not be modified nor outlive this object.
+   *
+   * @param sequential If *true*, the tiles are expected to be read mostly
+   *     in the order they appear in the file; otherwise the file is
+   *     accessed in random order. This is passed as a hint to the
+   *     filesystem.
+   * @return void
+   */
+  void enable_mmap(bool sequential);
+
+  /**
+   * Enables write-behind buffering. The tiles written with *write* are
+   * accumulated in memory and appended to the file asynchronously in
+   * batches of `constants::write_behind_buffer_size` bytes, so that the I/O
+   * of a batch overlaps with the preparation (e.g., compression) of the
+   * next tiles. The file is assumed to have `file_size()` bytes and no other
+   * writer. *flush* must be called before the file is synced or read.
+   * Only POSIX files are supported; for any other file, this is a no-op.
+   *
+   * @return void
+   */
+  void enable_write_behind();
+
   /** Returns the size of the file. */
   uint64_t file_size() const;
 
+  /**
+   * Writes the data buffered by write-behind buffering to the file and
+   * waits for all the pending writes to finish.
+   *
+   * @return Status
+   */
+  Status flush();
+
+  /**
+   * Checks if a region of the file lies entirely in the range most recently
+   * read with *read_range*.
+   *
+   * @param file_offset The offset of the region in the file.
+   * @param nbytes The size of the region.
+   * @return *true* if the region can be served from memory.
+   */
+  bool in_range(uint64_t file_offset, uint64_t nbytes) const;
+
+  /**
+   * Checks if a region of the file lies entirely in the range submitted with
+   * *read_range_async*.
+   *
+   * @param file_offset The offset of the region in the file.
+   * @param nbytes The size of the region.
+   * @return *true* if the region is being read ahead.
+   */
+  bool in_async_range(uint64_t file_offset, uint64_t nbytes) const;
+
+  /** Returns *true* if uncompressed tiles are read from a memory mapping. */
+  bool mmap_enabled() const;
+
   /**
    * Reads into a tile from the file.
    *
@@ -93,6 +172,37 @@ class TileIO {
       uint64_t compressed_size,
       uint64_t tile_size);
 
+  /**
+   * Reads a range of the file that spans multiple tiles with a single
+   * request. Subsequent *read* calls for tiles that lie entirely in the range
+   * are served from memory, until another range or a tile outside the range
+   * is read.
+   *
+   * @param file_offset The offset in the file to read from.
+   * @param nbytes The size of the range.
+   * @return Status
+   */
+  Status read_range(uint64_t file_offset, uint64_t nbytes);
+
+  /**
+   * Submits an asynchronous read of a range of the file, which is expected
+   * to be needed after the current one (see *read_range*). A range already
+   * being read ahead is discarded.
+   *
+   * @param file_offset The offset in the file to read from.
+   * @param nbytes The size of the range.
+   * @return Status
+   */
+  Status read_range_async(uint64_t file_offset, uint64_t nbytes);
+
+  /**
+   * Waits for the range submitted with *read_range_async* and makes it the
+   * current range, as if it had been read with *read_range*.
+   *
+   * @return Status
+   */
+  Status wait_range_async();
+
   /**
    * Reads a generic tile from the file. This means that there are not tile
    * metadata kept anywhere except for the file. Therefore, the function
@@ -125,6 +235,26 @@ class TileIO {
       uint64_t* compressed_size,
       uint64_t* header_size);
 
+  /**
+   * Sets the dictionary that primes the ZSTD compression and decompression
+   * of the tile chunks of the file. The dictionary is not owned by this
+   * object, and it must outlive it.
+   *
+   * @param dictionary The dictionary, or null for plain ZSTD compression.
+   * @return void
+   */
+  void set_dictionary(ZStdDictionary* dictionary);
+
+  /**
+   * Sets the version of the library that wrote the file, which determines
+   * the format of the compressed data of some compressors (e.g., RLE). It
+   * defaults to the current version.
+   *
+   * @param version The version in format { major, minor, revision }.
+   * @return void
+   */
+  void set_format_version(const int* version);
+
   /**
    * Writes (appends) a tile into the file.
    *
@@ -143,9 +273,11 @@ class TileIO {
    * other thant the file itself.
    *
    * @param tile The tile to be written.
+   * @param nbytes The number of bytes written to the file, including the
+   *     header.
    * @return Status
    */
-  Status write_generic(Tile* tile);
+  Status write_generic(Tile* tile, uint64_t* nbytes);
 
   /**
    * Writes the generic tile header to the file.
@@ -168,12 +300,60 @@ class TileIO {
    */
   Buffer* buffer_;
 
+  /** The buffer of the range being read ahead (see *read_range_async*). */
+  Buffer* async_buffer_;
+
+  /** The file offset of the range being read ahead. */
+  uint64_t async_range_offset_;
+
+  /** The size of the range being read ahead; 0 if there is no such range. */
+  uint64_t async_range_size_;
+
+  /** The id of the asynchronous read of the range being read ahead. */
+  uint64_t async_request_id_;
+
+  /** The dictionary of the ZSTD-compressed chunks (null if there is none). */
+  ZStdDictionary* dictionary_;
+
   /** The size of the file pointed by `uri_`. */
   uint64_t file_size_;
 
+  /** The version of the library that wrote the file. */
+  int format_version_[3];
+
+  /** The start of the memory mapping of the file (if mapped). */
+  void* mmap_data_;
+
+  /** If *true*, uncompressed tiles are read from a memory mapping. */
+  bool mmap_enabled_;
+
+  /** If *true*, the mapped file is expected to be read sequentially. */
+  bool mmap_sequential_;
+
+  /** The file offset of the range held in `buffer_` (see *read_range*). */
+  uint64_t range_offset_;
+
+  /** The size of the range held in `buffer_`; 0 if there is no range. */
+  uint64_t range_size_;
+
   /** The storage manager object. */
   StorageManager* storage_manager_;
 
+  /** If *true*, tiles are written via write-behind buffering. */
+  bool write_behind_;
+
+  /** Accumulates the tiles to be written by write-behind buffering. */
+  Buffer* write_buffer_;
+
+  /** The buffer of the batch being written asynchronously. */
+  Buffer* write_flush_buffer_;
+
+  /** *true* if a batch is being written asynchronously. */
+  bool write_pending_;
+
+  /** The id of the asynchronous write of the pending batch. */
+  uint64_t write_request_id_;
+
   /** The file URI. */
   URI uri_;
 
@@ -181,6 +361,26 @@ class TileIO {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Makes an uncompressed tile reference its data in the memory mapping of
+   * the file, mapping the file first if necessary. If the file cannot be
+   * mapped, memory mapping is disabled and the tile is read as usual.
+   *
+   * @param tile The tile to read into.
+   * @param file_offset The offset of the tile in the file.
+   * @param tile_size The size of the tile.
+   * @return Status
+   */
+  Status read_mapped(Tile* tile, uint64_t file_offset, uint64_t tile_size);
+
+  /**
+   * Submits the asynchronous write of the batch of tiles accumulated in
+   * `write_buffer_`, after waiting for the previously submitted batch.
+   *
+   * @return Status
+   */
+  Status flush_async();
+
   /**
    * Compresses a tile. The compressed data are written in buffer_.
    * Note that a coordinates tile must be split into one tile per
@@ -192,6 +392,47 @@ class TileIO {
    */
   Status compress_tile(Tile* tile);
 
+  /**
+   * Compresses a single chunk of a tile with the tile compressor, after
+   * applying the tile filter.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param input_buffer The chunk data to be compressed.
+   * @param output_buffer The buffer where the compressed data are written.
+   *     It must have enough free space for the compressed chunk.
+   * @return Status
+   */
+  Status compress_chunk(
+      Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const;
+
+  /**
+   * Compresses a single (filtered) chunk of an ADAPTIVE tile. A sample of
+   * the chunk is compressed with every candidate compressor of the
+   * configuration, and the chunk is compressed with the one of the best
+   * score (see `sm.adaptive_decode_weight` in Config). The compressed chunk
+   * is prefixed with a byte holding the selected compressor, which is
+   * NO_COMPRESSION if no candidate makes the chunk smaller.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param input_buffer The chunk data to be compressed.
+   * @param output_buffer The buffer where the compressed data are written.
+   *     It must have enough free space for the compressed chunk.
+   * @return Status
+   */
+  Status compress_chunk_adaptive(
+      Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const;
+
+  /**
+   * Compresses a single (filtered) chunk of a tile with the input
+   * compressor and compression level.
+   */
+  Status compress_chunk_with(
+      Compressor compressor,
+      int level,
+      Tile* tile,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer) const;
+
   /**
    * Compresses a single tile. The compressed data are written in buffer_.
    *
@@ -200,6 +441,20 @@ class TileIO {
    */
   Status compress_one_tile(Tile* tile);
 
+  /**
+   * Compresses a single tile consisting of multiple chunks. The chunks are
+   * compressed concurrently into separate buffers, which are then
+   * concatenated into buffer_ in the same layout as the one produced by
+   * a sequential compression.
+   *
+   * @param tile The tile to be compressed.
+   * @param chunk_num The number of chunks.
+   * @param max_chunk_size The maximum chunk size.
+   * @return Status
+   */
+  Status compress_one_tile_parallel(
+      Tile* tile, uint64_t chunk_num, uint64_t max_chunk_size);
+
   /**
    * Computes necessary info for chunking a tile upon compression.
    *
@@ -226,6 +481,36 @@ class TileIO {
    */
   Status decompress_tile(Tile* tile);
 
+  /**
+   * Decompresses a single chunk of a tile with the tile compressor, and
+   * reverses the tile filter.
+   *
+   * @param tile The tile the chunk belongs to.
+   * @param input_buffer The compressed chunk data.
+   * @param output_buffer The buffer where the decompressed data are written.
+   *     It must have enough free space for the decompressed chunk.
+   * @return Status
+   */
+  Status decompress_chunk(
+      Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const;
+
+  /**
+   * Decompresses a single chunk of a tile with the tile compressor, without
+   * reversing the tile filter.
+   */
+  Status decompress_chunk_unfiltered(
+      Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const;
+
+  /**
+   * Decompresses a single chunk of a tile with the input compressor,
+   * without reversing the tile filter.
+   */
+  Status decompress_chunk_with(
+      Compressor compressor,
+      Tile* tile,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer) const;
+
   /**
    * Decompresses buffer_ into a tile.
    *
@@ -234,8 +519,25 @@ class TileIO {
    */
   Status decompress_one_tile(Tile* tile);
 
+  /**
+   * Decompresses buffer_ into a tile consisting of multiple chunks. The
+   * chunk headers are scanned first, and then the chunks are decompressed
+   * concurrently directly into their final offsets in the tile.
+   *
+   * @param tile The tile where the decompressed data will be stored.
+   * @param chunk_num The number of chunks, already read from buffer_.
+   * @return Status
+   */
+  Status decompress_one_tile_parallel(Tile* tile, uint64_t chunk_num);
+
   /** Computes the compression overhead on *nbytes* of the input tile. */
   uint64_t overhead(Tile* tile, uint64_t nbytes) const;
+
+  /**
+   * Computes the overhead of the input compressor on *nbytes* of the input
+   * tile.
+   */
+  uint64_t overhead(Compressor compressor, Tile* tile, uint64_t nbytes) const;
 };
 
 }  // namespace tiledb
@@ -217,11 +217,30 @@ Status ArrayMetadata::check() const {
         "Array metadata check failed; Double delta compression can be used "
         "only with integer values"));
 
+  if (!check_gorilla_compressor())
+    return LOG_STATUS(Status::ArrayMetadataError(
+        "Array metadata check failed; Gorilla compression can be used only "
+        "with 32-bit and 64-bit values"));
+
+  if (!check_delta_filter())
+    return LOG_STATUS(Status::ArrayMetadataError(
+        "Array metadata check failed; Delta filter can be used only with "
+        "integer values"));
+
+  if (!check_dictionary_filter())
+    return LOG_STATUS(Status::ArrayMetadataError(
+        "Array metadata check failed; Dictionary filter can be used only "
+        "with variable-sized attributes"));
+
   if (!check_attribute_dimension_names())
     return LOG_STATUS(
         Status::ArrayMetadataError("Array metadata check failed; Attributes "
                                    "and dimensions must have unique names"));
 
+  if (!check_chunk_sizes())
+    return LOG_STATUS(Status::ArrayMetadataError(
+        "Array metadata check failed; Attribute chunk sizes must be positive"));
+
   // Success
   return Status::Ok();
 }
@@ -316,6 +335,16 @@ Status ArrayMetadata::get_attribute_ids(
   return Status::Ok();
 }
 
+bool ArrayMetadata::has_tile_stats(unsigned int attribute_id) const {
+  assert(attribute_id <= attribute_num_);
+
+  if (attribute_id == attribute_num_)
+    return false;
+
+  auto attr = attributes_[attribute_id];
+  return attr->cell_val_num() == 1 && attr->type() != Datatype::CHAR;
+}
+
 // ===== FORMAT =====
 // version (int[3])
 // array_type (char)
@@ -465,7 +494,7 @@ Status ArrayMetadata::deserialize(ConstBuffer* buff) {
   RETURN_NOT_OK(buff->read(&attribute_num_, sizeof(unsigned int)));
   for (unsigned int i = 0; i < attribute_num_; ++i) {
     auto attr = new Attribute();
-    attr->deserialize(buff);
+    attr->deserialize(buff, version_);
     attributes_.emplace_back(attr);
   }
 
@@ -541,18 +570,67 @@ bool ArrayMetadata::check_attribute_dimension_names() const {
   return (names.size() == attribute_num_ + dim_num);
 }
 
+bool ArrayMetadata::check_chunk_sizes() const {
+  for (auto attr : attributes_) {
+    if (attr->chunk_size() == 0)
+      return false;
+  }
+
+  return true;
+}
+
 bool ArrayMetadata::check_double_delta_compressor() const {
   // Check coordinates
   if ((domain_->type() == Datatype::FLOAT32 ||
        domain_->type() == Datatype::FLOAT64) &&
-      coords_compression_ == Compressor::DOUBLE_DELTA)
+      (coords_compression_ == Compressor::DOUBLE_DELTA ||
+       coords_compression_ == Compressor::BLOCK_DOUBLE_DELTA))
+    return false;
+
+  // Check attributes
+  for (auto attr : attributes_) {
+    if ((attr->type() == Datatype::FLOAT32 ||
+         attr->type() == Datatype::FLOAT64) &&
+        (attr->compressor() == Compressor::DOUBLE_DELTA ||
+         attr->compressor() == Compressor::BLOCK_DOUBLE_DELTA))
+      return false;
+  }
+
+  return true;
+}
+
+bool ArrayMetadata::check_gorilla_compressor() const {
+  // Check coordinates
+  uint64_t coords_type_size = datatype_size(domain_->type());
+  if (coords_compression_ == Compressor::GORILLA && coords_type_size != 4 &&
+      coords_type_size != 8)
     return false;
 
   // Check attributes
+  for (auto attr : attributes_) {
+    uint64_t type_size = datatype_size(attr->type());
+    if (attr->compressor() == Compressor::GORILLA && type_size != 4 &&
+        type_size != 8)
+      return false;
+  }
+
+  return true;
+}
+
+bool ArrayMetadata::check_delta_filter() const {
   for (auto attr : attributes_) {
     if ((attr->type() == Datatype::FLOAT32 ||
          attr->type() == Datatype::FLOAT64) &&
-        attr->compressor() == Compressor::DOUBLE_DELTA)
+        attr->filter() == Filter::DELTA)
+      return false;
+  }
+
+  return true;
+}
+
+bool ArrayMetadata::check_dictionary_filter() const {
+  for (auto attr : attributes_) {
+    if (!attr->var_size() && attr->filter() == Filter::DICTIONARY)
       return false;
   }
 
@@ -35,6 +35,7 @@
 #include "utils.h"
 
 #include <cassert>
+#include <cinttypes>
 
 namespace tiledb {
 
@@ -54,8 +55,11 @@ Attribute::Attribute(const char* name, Datatype type) {
 
   // Set default compressor and compression level
   cell_val_num_ = 1;
+  chunk_size_ = constants::default_tile_chunk_size;
   compressor_ = Compressor::NO_COMPRESSION;
   compression_level_ = -1;
+  compression_dictionary_size_ = constants::default_compression_dictionary_size;
+  filter_ = Filter::NO_FILTER;
 }
 
 Attribute::Attribute(const Attribute* attr) {
@@ -64,8 +68,11 @@ Attribute::Attribute(const Attribute* attr) {
   name_ = attr->name();
   type_ = attr->type();
   cell_val_num_ = attr->cell_val_num();
+  chunk_size_ = attr->chunk_size();
   compressor_ = attr->compressor();
   compression_level_ = attr->compression_level();
+  compression_dictionary_size_ = attr->compression_dictionary_size();
+  filter_ = attr->filter();
 }
 
 Attribute::~Attribute() = default;
@@ -85,6 +92,10 @@ unsigned int Attribute::cell_val_num() const {
   return cell_val_num_;
 }
 
+uint64_t Attribute::chunk_size() const {
+  return chunk_size_;
+}
+
 Compressor Attribute::compressor() const {
   return compressor_;
 }
@@ -93,6 +104,10 @@ int Attribute::compression_level() const {
   return compression_level_;
 }
 
+uint64_t Attribute::compression_dictionary_size() const {
+  return compression_dictionary_size_;
+}
+
 // ===== FORMAT =====
 // attribute_name_size (unsigned int)
 // attribute_name (string)
@@ -100,7 +115,10 @@ int Attribute::compression_level() const {
 // compressor (char)
 // compression_level (int)
 // cell_val_num (unsigned int)
-Status Attribute::deserialize(ConstBuffer* buff) {
+// chunk_size (uint64_t)
+// filter (char)
+// compression_dictionary_size (uint64_t)
+Status Attribute::deserialize(ConstBuffer* buff, const int* version) {
   // Load attribute name
   unsigned int attribute_name_size;
   RETURN_NOT_OK(buff->read(&attribute_name_size, sizeof(unsigned int)));
@@ -121,6 +139,26 @@ Status Attribute::deserialize(ConstBuffer* buff) {
   // Load cell_val_num_
   RETURN_NOT_OK(buff->read(&cell_val_num_, sizeof(unsigned int)));
 
+  // Earlier versions do not store the rest of the members
+  if (utils::is_older_version(
+          version, constants::attribute_options_min_version)) {
+    chunk_size_ = constants::default_tile_chunk_size;
+    filter_ = Filter::NO_FILTER;
+    compression_dictionary_size_ = 0;
+    return Status::Ok();
+  }
+
+  // Load chunk_size_
+  RETURN_NOT_OK(buff->read(&chunk_size_, sizeof(uint64_t)));
+
+  // Load filter
+  char filter;
+  RETURN_NOT_OK(buff->read(&filter, sizeof(char)));
+  filter_ = (Filter)filter;
+
+  // Load compression_dictionary_size_
+  RETURN_NOT_OK(buff->read(&compression_dictionary_size_, sizeof(uint64_t)));
+
   return Status::Ok();
 }
 
@@ -135,6 +173,12 @@ void Attribute::dump(FILE* out) const {
   fprintf(out, "- Type: %s\n", type_s);
   fprintf(out, "- Compressor: %s\n", compressor_s);
   fprintf(out, "- Compression level: %d\n", compression_level_);
+  fprintf(out, "- Filter: %s\n", filter_str(filter_));
+  if (compression_dictionary_size_ != 0)
+    fprintf(
+        out,
+        "- Compression dictionary size: %" PRIu64 "\n",
+        compression_dictionary_size_);
 
   if (!var_size())
     fprintf(out, "- Cell val num: %u\n", cell_val_num_);
@@ -142,6 +186,10 @@ void Attribute::dump(FILE* out) const {
     fprintf(out, "- Cell val num: var\n");
 }
 
+Filter Attribute::filter() const {
+  return filter_;
+}
+
 const std::string& Attribute::name() const {
   return name_;
 }
@@ -153,6 +201,9 @@ const std::string& Attribute::name() const {
 // compressor (char)
 // compression_level (int)
 // cell_val_num (unsigned int)
+// chunk_size (uint64_t)
+// filter (char)
+// compression_dictionary_size (uint64_t)
 Status Attribute::serialize(Buffer* buff) {
   // Write attribute name
   auto attribute_name_size = (unsigned int)name_.size();
@@ -171,6 +222,16 @@ Status Attribute::serialize(Buffer* buff) {
   // Write cell_val_num_
   RETURN_NOT_OK(buff->write(&cell_val_num_, sizeof(unsigned int)));
 
+  // Write chunk_size_
+  RETURN_NOT_OK(buff->write(&chunk_size_, sizeof(uint64_t)));
+
+  // Write filter
+  auto filter = (char)filter_;
+  RETURN_NOT_OK(buff->write(&filter, sizeof(char)));
+
+  // Write compression_dictionary_size_
+  RETURN_NOT_OK(buff->write(&compression_dictionary_size_, sizeof(uint64_t)));
+
   return Status::Ok();
 }
 
@@ -178,6 +239,10 @@ void Attribute::set_cell_val_num(unsigned int cell_val_num) {
   cell_val_num_ = cell_val_num;
 }
 
+void Attribute::set_chunk_size(uint64_t chunk_size) {
+  chunk_size_ = chunk_size;
+}
+
 void Attribute::set_compressor(Compressor compressor) {
   compressor_ = compressor;
 }
@@ -186,6 +251,15 @@ void Attribute::set_compression_level(int compression_level) {
   compression_level_ = compression_level;
 }
 
+void Attribute::set_compression_dictionary_size(
+    uint64_t compression_dictionary_size) {
+  compression_dictionary_size_ = compression_dictionary_size;
+}
+
+void Attribute::set_filter(Filter filter) {
+  filter_ = filter;
+}
+
 Datatype Attribute::type() const {
   return type_;
 }
@@ -33,6 +33,7 @@
 #include "domain.h"
 #include "const_buffer.h"
 #include "logger.h"
+#include "utils.h"
 
 #include <cassert>
 #include <iostream>
@@ -142,6 +143,44 @@ Status Domain::add_dimension(
   return Status::Ok();
 }
 
+uint64_t Domain::cell_num(const void* subarray) const {
+  switch (type_) {
+    case Datatype::INT32:
+      return utils::cell_num_in_subarray(
+          static_cast<const int*>(subarray), dim_num_);
+    case Datatype::INT64:
+      return utils::cell_num_in_subarray(
+          static_cast<const int64_t*>(subarray), dim_num_);
+    case Datatype::INT8:
+      return utils::cell_num_in_subarray(
+          static_cast<const int8_t*>(subarray), dim_num_);
+    case Datatype::UINT8:
+      return utils::cell_num_in_subarray(
+          static_cast<const uint8_t*>(subarray), dim_num_);
+    case Datatype::INT16:
+      return utils::cell_num_in_subarray(
+          static_cast<const int16_t*>(subarray), dim_num_);
+    case Datatype::UINT16:
+      return utils::cell_num_in_subarray(
+          static_cast<const uint16_t*>(subarray), dim_num_);
+    case Datatype::UINT32:
+      return utils::cell_num_in_subarray(
+          static_cast<const uint32_t*>(subarray), dim_num_);
+    case Datatype::UINT64:
+      return utils::cell_num_in_subarray(
+          static_cast<const uint64_t*>(subarray), dim_num_);
+    case Datatype::CHAR:
+      assert(false);
+      return 0;
+    case Datatype::FLOAT32:
+      assert(false);
+      return 0;
+    case Datatype::FLOAT64:
+      assert(false);
+      return 0;
+  }
+}
+
 uint64_t Domain::cell_num_per_tile() const {
   return cell_num_per_tile_;
 }
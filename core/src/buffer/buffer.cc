@@ -35,6 +35,7 @@
 #include "logger.h"
 
 #include <iostream>
+#include <utility>
 
 namespace tiledb {
 
@@ -61,7 +62,7 @@ Buffer::Buffer(void* data, uint64_t size, bool owns_data)
     , owns_data_(owns_data)
     , size_(size) {
   offset_ = 0;
-  alloced_size_ = 0;
+  alloced_size_ = size;
   owns_data_ = false;
 }
 
@@ -171,6 +172,22 @@ uint64_t Buffer::size() const {
   return size_;
 }
 
+void Buffer::swap(Buffer* buffer) {
+  std::swap(alloced_size_, buffer->alloced_size_);
+  std::swap(data_, buffer->data_);
+  std::swap(offset_, buffer->offset_);
+  std::swap(owns_data_, buffer->owns_data_);
+  std::swap(size_, buffer->size_);
+}
+
+void Buffer::wrap(void* data, uint64_t size) {
+  clear();
+  data_ = data;
+  owns_data_ = false;
+  size_ = size;
+  alloced_size_ = size;
+}
+
 void Buffer::write(ConstBuffer* buff) {
   uint64_t bytes_left_to_write = alloced_size_ - offset_;
   uint64_t bytes_left_to_read = buff->nbytes_left_to_read();
@@ -62,6 +62,10 @@ void tiledb_version(int* major, int* minor, int* rev) {
 /*           TILEDB TYPES            */
 /* ********************************* */
 
+struct tiledb_config_t {
+  tiledb::Config* config_;
+};
+
 struct tiledb_ctx_t {
   tiledb::StorageManager* storage_manager_;
   tiledb::Status* last_error_;
@@ -210,11 +214,55 @@ inline int sanity_check(tiledb_ctx_t* ctx, const tiledb_query_t* query) {
   return TILEDB_OK;
 }
 
+/* ****************************** */
+/*             CONFIG             */
+/* ****************************** */
+
+int tiledb_config_create(tiledb_config_t** config) {
+  // Create config struct
+  *config = (tiledb_config_t*)std::malloc(sizeof(tiledb_config_t));
+  if (*config == nullptr)
+    return TILEDB_OOM;
+
+  // Create config object
+  (*config)->config_ = new tiledb::Config();
+  if ((*config)->config_ == nullptr) {
+    std::free(*config);
+    *config = nullptr;
+    return TILEDB_OOM;
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
+int tiledb_config_free(tiledb_config_t* config) {
+  if (config != nullptr) {
+    delete config->config_;
+    std::free(config);
+  }
+
+  // Always succeeds
+  return TILEDB_OK;
+}
+
+int tiledb_config_set(
+    tiledb_config_t* config, const char* param, const char* value) {
+  if (config == nullptr || config->config_ == nullptr || param == nullptr ||
+      value == nullptr)
+    return TILEDB_ERR;
+
+  if (!config->config_->set(param, value).ok())
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*            CONTEXT             */
 /* ****************************** */
 
-int tiledb_ctx_create(tiledb_ctx_t** ctx) {
+int tiledb_ctx_create(tiledb_ctx_t** ctx, tiledb_config_t* config) {
   // Initialize context
   *ctx = (tiledb_ctx_t*)std::malloc(sizeof(struct tiledb_ctx_t));
   if (*ctx == nullptr)
@@ -237,7 +285,8 @@ int tiledb_ctx_create(tiledb_ctx_t** ctx) {
   (*ctx)->last_error_ = nullptr;
 
   // Initialize storage manager
-  if (save_error(*ctx, ((*ctx)->storage_manager_->init()))) {
+  tiledb::Config* sm_config = (config == nullptr) ? nullptr : config->config_;
+  if (save_error(*ctx, ((*ctx)->storage_manager_->init(sm_config)))) {
     delete (*ctx)->storage_manager_;
     (*ctx)->storage_manager_ = nullptr;
     return TILEDB_ERR;
@@ -259,6 +308,18 @@ int tiledb_ctx_free(tiledb_ctx_t* ctx) {
   return TILEDB_OK;
 }
 
+int tiledb_ctx_get_tile_cache_stats(
+    tiledb_ctx_t* ctx, uint64_t* hits, uint64_t* misses) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto tile_cache = ctx->storage_manager_->tile_cache();
+  *hits = tile_cache->hits();
+  *misses = tile_cache->misses();
+
+  return TILEDB_OK;
+}
+
 /* ********************************* */
 /*              ERROR                */
 /* ********************************* */
@@ -417,6 +478,37 @@ int tiledb_attribute_set_cell_val_num(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_set_chunk_size(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, uint64_t chunk_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  if (chunk_size == 0) {
+    save_error(
+        ctx,
+        tiledb::Status::Error("Cannot set chunk size; Chunk size must be "
+                              "positive"));
+    return TILEDB_ERR;
+  }
+  attr->attr_->set_chunk_size(chunk_size);
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_filter(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, tiledb_filter_t filter) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_filter(static_cast<tiledb::Filter>(filter));
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_set_compression_dictionary_size(
+    tiledb_ctx_t* ctx, tiledb_attribute_t* attr, uint64_t dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  attr->attr_->set_compression_dictionary_size(dictionary_size);
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_get_name(
     tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, const char** name) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
@@ -457,6 +549,34 @@ int tiledb_attribute_get_cell_val_num(
   return TILEDB_OK;
 }
 
+int tiledb_attribute_get_chunk_size(
+    tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, uint64_t* chunk_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *chunk_size = attr->attr_->chunk_size();
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_filter(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    tiledb_filter_t* filter) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *filter = static_cast<tiledb_filter_t>(attr->attr_->filter());
+  return TILEDB_OK;
+}
+
+int tiledb_attribute_get_compression_dictionary_size(
+    tiledb_ctx_t* ctx,
+    const tiledb_attribute_t* attr,
+    uint64_t* dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *dictionary_size = attr->attr_->compression_dictionary_size();
+  return TILEDB_OK;
+}
+
 int tiledb_attribute_dump(
     tiledb_ctx_t* ctx, const tiledb_attribute_t* attr, FILE* out) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, attr) == TILEDB_ERR)
@@ -1297,6 +1417,27 @@ int tiledb_query_reset_buffers(
   return TILEDB_OK;
 }
 
+int tiledb_query_add_predicate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_predicate_op_t op,
+    const void* value) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Add predicate
+  if (save_error(
+          ctx,
+          query->query_->add_predicate(
+              attribute, static_cast<tiledb::PredicateOp>(op), value)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
 int tiledb_query_get_status(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_query_status_t* status) {
   // Sanity check
@@ -1368,6 +1509,26 @@ int tiledb_array_consolidate(tiledb_ctx_t* ctx, const char* array_name) {
   return TILEDB_OK;
 }
 
+int tiledb_array_compute_max_read_buffer_sizes(
+    tiledb_ctx_t* ctx,
+    const char* array_name,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num,
+    uint64_t* buffer_sizes) {
+  // Sanity checks
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (save_error(
+          ctx,
+          ctx->storage_manager_->array_compute_max_read_buffer_sizes(
+              array_name, subarray, attributes, attribute_num, buffer_sizes)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*       RESOURCE  MANAGEMENT     */
 /* ****************************** */
@@ -0,0 +1,434 @@
+/**
+ * @file   block_dd_compressor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the block double delta compressor class.
+ */
+
+#include "block_dd_compressor.h"
+#include "logger.h"
+
+#include <cstring>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* ****************************** */
+/*             MACROS             */
+/* ****************************** */
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+namespace tiledb {
+
+const uint64_t BlockDoubleDelta::FRAME_SIZE = 128;
+
+const uint8_t BlockDoubleDelta::RAW_FRAME = 255;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status BlockDoubleDelta::compress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::CHAR:
+      return BlockDoubleDelta::compress<char>(input_buffer, output_buffer);
+    case Datatype::INT8:
+      return BlockDoubleDelta::compress<int8_t>(input_buffer, output_buffer);
+    case Datatype::UINT8:
+      return BlockDoubleDelta::compress<uint8_t>(input_buffer, output_buffer);
+    case Datatype::INT16:
+      return BlockDoubleDelta::compress<int16_t>(input_buffer, output_buffer);
+    case Datatype::UINT16:
+      return BlockDoubleDelta::compress<uint16_t>(input_buffer, output_buffer);
+    case Datatype::INT32:
+      return BlockDoubleDelta::compress<int>(input_buffer, output_buffer);
+    case Datatype::UINT32:
+      return BlockDoubleDelta::compress<uint32_t>(input_buffer, output_buffer);
+    case Datatype::INT64:
+      return BlockDoubleDelta::compress<int64_t>(input_buffer, output_buffer);
+    case Datatype::UINT64:
+      return BlockDoubleDelta::compress<uint64_t>(input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(
+          Status::CompressionError("Cannot compress tile with "
+                                   "BlockDoubleDelta; Not supported datatype"));
+  }
+}
+
+Status BlockDoubleDelta::decompress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::CHAR:
+      return BlockDoubleDelta::decompress<char>(input_buffer, output_buffer);
+    case Datatype::INT8:
+      return BlockDoubleDelta::decompress<int8_t>(input_buffer, output_buffer);
+    case Datatype::UINT8:
+      return BlockDoubleDelta::decompress<uint8_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT16:
+      return BlockDoubleDelta::decompress<int16_t>(
+          input_buffer, output_buffer);
+    case Datatype::UINT16:
+      return BlockDoubleDelta::decompress<uint16_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT32:
+      return BlockDoubleDelta::decompress<int>(input_buffer, output_buffer);
+    case Datatype::UINT32:
+      return BlockDoubleDelta::decompress<uint32_t>(
+          input_buffer, output_buffer);
+    case Datatype::INT64:
+      return BlockDoubleDelta::decompress<int64_t>(
+          input_buffer, output_buffer);
+    case Datatype::UINT64:
+      return BlockDoubleDelta::decompress<uint64_t>(
+          input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress tile with BlockDoubleDelta; Not supported "
+          "datatype"));
+  }
+}
+
+uint64_t BlockDoubleDelta::overhead(uint64_t nbytes) {
+  return sizeof(uint64_t) + nbytes / FRAME_SIZE + 1;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+Status BlockDoubleDelta::compress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // All arithmetic is done on the unsigned type of the same width
+  typedef typename std::make_unsigned<T>::type U;
+  const int type_bits = 8 * sizeof(T);
+
+  // Calculate number of values
+  uint64_t value_size = sizeof(T);
+  uint64_t num = input_buffer->size() / value_size;
+  if (input_buffer->size() % value_size != 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot compress with BlockDoubleDelta; Invalid input buffer size"));
+
+  // Make room for the worst case, so that the frames are written directly
+  uint64_t max_size = input_buffer->size() + overhead(input_buffer->size());
+  if (output_buffer->offset() + max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(output_buffer->offset() + max_size));
+  auto out = (unsigned char*)output_buffer->cur_data();
+  uint64_t out_size = 0;
+
+  // Write number of values, first value and first delta
+  auto in = (const U*)input_buffer->data();
+  std::memcpy(out, &num, sizeof(uint64_t));
+  out_size += sizeof(uint64_t);
+  U prev_delta = 0;
+  if (num > 0) {
+    std::memcpy(out + out_size, &in[0], value_size);
+    out_size += value_size;
+  }
+  if (num > 1) {
+    prev_delta = U(in[1] - in[0]);
+    std::memcpy(out + out_size, &prev_delta, value_size);
+    out_size += value_size;
+  }
+
+  // Write the double deltas frame by frame
+  uint32_t zigzag[FRAME_SIZE];
+  U zigzag_u[FRAME_SIZE];
+  for (uint64_t start = 2; start < num; start += FRAME_SIZE) {
+    uint64_t count = MIN(FRAME_SIZE, num - start);
+
+    // Compute the zigzag-encoded double deltas and their bitsize
+    U all_bits = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+      auto delta = U(in[start + i] - in[start + i - 1]);
+      auto dd = U(delta - prev_delta);
+      U sign = dd >> (type_bits - 1);
+      zigzag_u[i] = U(U(dd << 1) ^ U(0 - sign));
+      all_bits |= zigzag_u[i];
+      prev_delta = delta;
+    }
+    int bitsize = 0;
+    for (U bits = all_bits; bits != 0; bits >>= 1)
+      ++bitsize;
+
+    // Store the values as they are if packing does not pay off
+    if (bitsize > 32 || bitsize >= type_bits) {
+      out[out_size++] = RAW_FRAME;
+      std::memcpy(out + out_size, &in[start], count * value_size);
+      out_size += count * value_size;
+      continue;
+    }
+
+    // Pack the frame
+    out[out_size++] = (uint8_t)bitsize;
+    for (uint64_t i = 0; i < count; ++i)
+      zigzag[i] = (uint32_t)zigzag_u[i];
+    if (count == FRAME_SIZE) {
+      pack_frame(zigzag, bitsize, out + out_size);
+      out_size += FRAME_SIZE / 8 * bitsize;
+    } else {
+      pack_tail(zigzag, count, bitsize, out + out_size);
+      out_size += (count * bitsize + 7) / 8;
+    }
+  }
+
+  output_buffer->advance_offset(out_size);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+template <class T>
+Status BlockDoubleDelta::decompress(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // All arithmetic is done on the unsigned type of the same width
+  typedef typename std::make_unsigned<T>::type U;
+
+  // Read number of values
+  uint64_t num;
+  uint64_t value_size = sizeof(T);
+  RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+  if (num > UINT64_MAX / value_size)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with BlockDoubleDelta; Invalid number of values"));
+
+  // Make room for the values in the output buffer
+  uint64_t nbytes = num * value_size;
+  uint64_t end = output_buffer->offset() + nbytes;
+  if (end > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(end));
+  auto out = (U*)output_buffer->cur_data();
+
+  // Read first value and first delta
+  U prev_delta = 0;
+  if (num > 0)
+    RETURN_NOT_OK(input_buffer->read(&out[0], value_size));
+  if (num > 1) {
+    RETURN_NOT_OK(input_buffer->read(&prev_delta, value_size));
+    out[1] = U(out[0] + prev_delta);
+  }
+
+  // Decompress the frames
+  auto in = (const unsigned char*)input_buffer->data() + input_buffer->offset();
+  uint64_t in_size = input_buffer->nbytes_left_to_read();
+  uint64_t in_offset = 0;
+  uint32_t zigzag[FRAME_SIZE];
+  for (uint64_t start = 2; start < num; start += FRAME_SIZE) {
+    uint64_t count = MIN(FRAME_SIZE, num - start);
+
+    // Compute the size of the frame
+    if (in_offset == in_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with BlockDoubleDelta; Truncated input"));
+    int bitsize = in[in_offset++];
+    uint64_t frame_size;
+    if (bitsize == RAW_FRAME)
+      frame_size = count * value_size;
+    else if (bitsize > 32)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with BlockDoubleDelta; Invalid bitsize"));
+    else if (count == FRAME_SIZE)
+      frame_size = FRAME_SIZE / 8 * bitsize;
+    else
+      frame_size = (count * bitsize + 7) / 8;
+    if (in_size - in_offset < frame_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with BlockDoubleDelta; Truncated input"));
+
+    // Copy raw values
+    if (bitsize == RAW_FRAME) {
+      std::memcpy(&out[start], in + in_offset, frame_size);
+      in_offset += frame_size;
+      prev_delta = U(out[start + count - 1] - out[start + count - 2]);
+      continue;
+    }
+
+    // Unpack the double deltas and reconstruct the values
+    if (count == FRAME_SIZE)
+      unpack_frame(in + in_offset, bitsize, zigzag);
+    else
+      unpack_tail(in + in_offset, count, bitsize, zigzag);
+    in_offset += frame_size;
+    U prev = out[start - 1];
+    for (uint64_t i = 0; i < count; ++i) {
+      auto z = (U)zigzag[i];
+      auto dd = U(U(z >> 1) ^ U(0 - U(z & 1)));
+      prev_delta = U(prev_delta + dd);
+      prev = U(prev + prev_delta);
+      out[start + i] = prev;
+    }
+  }
+
+  input_buffer->advance_offset(in_offset);
+  output_buffer->advance_offset(nbytes);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+void BlockDoubleDelta::pack_frame(
+    const uint32_t* in, int bitsize, unsigned char* out) {
+  for (int lane = 0; lane < 4; ++lane) {
+    uint64_t acc = 0;
+    int acc_bits = 0;
+    uint64_t word = 0;
+    for (uint64_t j = 0; j < FRAME_SIZE / 4; ++j) {
+      acc |= ((uint64_t)in[4 * j + lane]) << acc_bits;
+      acc_bits += bitsize;
+      if (acc_bits >= 32) {
+        auto w = (uint32_t)acc;
+        std::memcpy(out + sizeof(uint32_t) * (4 * word + lane), &w, 4);
+        ++word;
+        acc >>= 32;
+        acc_bits -= 32;
+      }
+    }
+  }
+}
+
+void BlockDoubleDelta::pack_tail(
+    const uint32_t* in, uint64_t num, int bitsize, unsigned char* out) {
+  uint64_t acc = 0;
+  int acc_bits = 0;
+  for (uint64_t i = 0; i < num; ++i) {
+    acc |= ((uint64_t)in[i]) << acc_bits;
+    acc_bits += bitsize;
+    for (; acc_bits >= 8; acc_bits -= 8, acc >>= 8)
+      *(out++) = (unsigned char)acc;
+  }
+  if (acc_bits > 0)
+    *out = (unsigned char)acc;
+}
+
+void BlockDoubleDelta::unpack_frame(
+    const unsigned char* in, int bitsize, uint32_t* out) {
+#ifdef __SSE2__
+  // Each 128-bit word holds the next 32 bits of the four lanes
+  const __m128i mask = _mm_set1_epi32(
+      bitsize == 32 ? -1 : (int)((((uint32_t)1) << bitsize) - 1));
+  __m128i w = _mm_setzero_si128();
+  if (bitsize > 0)
+    w = _mm_loadu_si128((const __m128i*)in);
+  int word = 0;
+  int shift = 0;
+  for (uint64_t j = 0; j < FRAME_SIZE / 4; ++j) {
+    __m128i v = _mm_srl_epi32(w, _mm_cvtsi32_si128(shift));
+    if (shift + bitsize >= 32) {
+      if (++word < bitsize)
+        w = _mm_loadu_si128((const __m128i*)(in + 16 * word));
+      if (shift + bitsize > 32)
+        v = _mm_or_si128(v, _mm_sll_epi32(w, _mm_cvtsi32_si128(32 - shift)));
+      shift += bitsize - 32;
+    } else {
+      shift += bitsize;
+    }
+    _mm_storeu_si128((__m128i*)(out + 4 * j), _mm_and_si128(v, mask));
+  }
+#else
+  uint64_t mask = (((uint64_t)1) << bitsize) - 1;
+  for (int lane = 0; lane < 4; ++lane) {
+    uint64_t acc = 0;
+    int acc_bits = 0;
+    uint64_t word = 0;
+    for (uint64_t j = 0; j < FRAME_SIZE / 4; ++j) {
+      if (acc_bits < bitsize) {
+        uint32_t w;
+        std::memcpy(&w, in + sizeof(uint32_t) * (4 * word + lane), 4);
+        ++word;
+        acc |= ((uint64_t)w) << acc_bits;
+        acc_bits += 32;
+      }
+      out[4 * j + lane] = (uint32_t)(acc & mask);
+      acc >>= bitsize;
+      acc_bits -= bitsize;
+    }
+  }
+#endif
+}
+
+void BlockDoubleDelta::unpack_tail(
+    const unsigned char* in, uint64_t num, int bitsize, uint32_t* out) {
+  uint64_t mask = (((uint64_t)1) << bitsize) - 1;
+  uint64_t acc = 0;
+  int acc_bits = 0;
+  for (uint64_t i = 0; i < num; ++i) {
+    for (; acc_bits < bitsize; acc_bits += 8)
+      acc |= ((uint64_t) * (in++)) << acc_bits;
+    out[i] = (uint32_t)(acc & mask);
+    acc >>= bitsize;
+    acc_bits -= bitsize;
+  }
+}
+
+// Explicit template instantiations
+
+template Status BlockDoubleDelta::compress<char>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<int8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<uint8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<int16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<uint16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<int>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<int64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::compress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+template Status BlockDoubleDelta::decompress<char>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<int8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<uint8_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<int16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<uint16_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<int>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<int64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status BlockDoubleDelta::decompress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+}  // namespace tiledb
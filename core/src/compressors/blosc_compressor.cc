@@ -50,23 +50,20 @@ Status Blosc::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with Blosc; invalid buffer format"));
 
-  // Initialize Blosc compressor
-  if (blosc_set_compressor(compressor) < 0) {
-    return LOG_STATUS(Status::CompressionError(
-        std::string(
-            "Blosc compression error, failed to set Blosc compressor ") +
-        compressor));
-  }
-
-  // Compress
-  int rc = blosc_compress(
+  // Compress. The context variant is used because, contrary to
+  // blosc_compress, it keeps no global state and can thus be invoked
+  // concurrently on different chunks.
+  int rc = blosc_compress_ctx(
       level < 0 ? Blosc::default_level() : level,
       1,  // shuffle
       type_size,
       input_buffer->size(),
       input_buffer->data(),
       output_buffer->cur_data(),
-      output_buffer->free_space());
+      output_buffer->free_space(),
+      compressor,
+      0,   // automatic block size
+      1);  // number of internal threads
 
   // Handle error
   if (rc < 0)
@@ -86,10 +83,11 @@ Status Blosc::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
         "Failed decompressing with Blosc; invalid buffer format"));
 
   // Decompress
-  int rc = blosc_decompress(
+  int rc = blosc_decompress_ctx(
       input_buffer->data(),
       output_buffer->cur_data(),
-      output_buffer->free_space());
+      output_buffer->free_space(),
+      1);  // number of internal threads
 
   // Handle error
   if (rc <= 0)
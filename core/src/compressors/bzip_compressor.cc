@@ -34,9 +34,83 @@
 #include "logger.h"
 
 #include <bzlib.h>
+#include <cstdlib>
+#include <utility>
+#include <vector>
 
 namespace tiledb {
 
+/* ****************************** */
+/*        STATIC VARIABLES        */
+/* ****************************** */
+
+/**
+ * The memory blocks freed by the bzip2 streams of a thread, which are
+ * recycled by its subsequent streams. The bzip2 library cannot reset a
+ * stream, so instead of reusing the streams, their large work areas are
+ * reused through a custom allocator.
+ */
+struct BZipBlocks {
+  /** The maximum number of cached blocks. */
+  static const size_t max_block_num = 8;
+
+  /** The cached blocks, along with their sizes. */
+  std::vector<std::pair<size_t, void*>> blocks_;
+
+  /** Destructor. */
+  ~BZipBlocks() {
+    for (auto& block : blocks_)
+      std::free(block.second);
+  }
+};
+
+/** The recycled bzip2 memory blocks of the calling thread. */
+static thread_local BZipBlocks bzip_blocks;
+
+/** The size of the header storing the size of an allocated block. */
+static const size_t bzip_block_header_size = 16;
+
+/* ****************************** */
+/*        STATIC FUNCTIONS        */
+/* ****************************** */
+
+/** Allocates memory for bzip2, recycling a cached block if possible. */
+static void* bzip_alloc(void* opaque, int n, int m) {
+  (void)opaque;
+  size_t size = (size_t)n * (size_t)m;
+  auto& blocks = bzip_blocks.blocks_;
+  for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+    if (it->first == size) {
+      auto block = (char*)it->second;
+      blocks.erase(it);
+      return block + bzip_block_header_size;
+    }
+  }
+
+  auto block = (char*)std::malloc(bzip_block_header_size + size);
+  if (block == nullptr)
+    return nullptr;
+  *(size_t*)block = size;
+  return block + bzip_block_header_size;
+}
+
+/** Frees memory allocated by *bzip_alloc*, caching the block if possible. */
+static void bzip_free(void* opaque, void* p) {
+  (void)opaque;
+  if (p == nullptr)
+    return;
+  auto block = (char*)p - bzip_block_header_size;
+  auto& blocks = bzip_blocks.blocks_;
+  if (blocks.size() < BZipBlocks::max_block_num)
+    blocks.emplace_back(*(size_t*)block, block);
+  else
+    std::free(block);
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status BZip::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
@@ -44,17 +118,32 @@ Status BZip::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with BZip; invalid buffer format"));
 
-  // Compress
+  // Compress, as BZ2_bzBuffToBuffCompress() does, but recycling the memory
+  // of the stream
   auto in_size = (unsigned int)input_buffer->size();
   auto out_size = (unsigned int)output_buffer->free_space();
-  int rc = BZ2_bzBuffToBuffCompress(
-      static_cast<char*>(output_buffer->cur_data()),
-      &out_size,
-      (char*)input_buffer->data(),
-      in_size,
+  bz_stream strm;
+  strm.bzalloc = bzip_alloc;
+  strm.bzfree = bzip_free;
+  strm.opaque = nullptr;
+  int rc = BZ2_bzCompressInit(
+      &strm,
       level < 1 ? BZip::default_level() : level,  // block size 100k
       0,                                          // verbosity
       0);                                         // work factor
+  if (rc == BZ_OK) {
+    strm.next_in = (char*)input_buffer->data();
+    strm.avail_in = in_size;
+    strm.next_out = static_cast<char*>(output_buffer->cur_data());
+    strm.avail_out = out_size;
+    rc = BZ2_bzCompress(&strm, BZ_FINISH);
+    if (rc == BZ_FINISH_OK)
+      rc = BZ_OUTBUFF_FULL;
+    else if (rc == BZ_STREAM_END)
+      rc = BZ_OK;
+    out_size -= strm.avail_out;
+    BZ2_bzCompressEnd(&strm);
+  }
 
   // Handle error
   if (rc != BZ_OK) {
@@ -92,15 +181,30 @@ Status BZip::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with BZip; invalid buffer format"));
 
-  // Decompress
+  // Decompress, as BZ2_bzBuffToBuffDecompress() does, but recycling the
+  // memory of the stream
   auto out_size = (unsigned int)output_buffer->free_space();
-  int rc = BZ2_bzBuffToBuffDecompress(
-      static_cast<char*>(output_buffer->cur_data()),
-      &out_size,
-      (char*)input_buffer->data(),
-      (unsigned int)input_buffer->size(),
-      0,   // small bzip data format stream
-      0);  // verbositiy
+  bz_stream strm;
+  strm.bzalloc = bzip_alloc;
+  strm.bzfree = bzip_free;
+  strm.opaque = nullptr;
+  int rc = BZ2_bzDecompressInit(
+      &strm,
+      0,   // verbositiy
+      0);  // small bzip data format stream
+  if (rc == BZ_OK) {
+    strm.next_in = (char*)input_buffer->data();
+    strm.avail_in = (unsigned int)input_buffer->size();
+    strm.next_out = static_cast<char*>(output_buffer->cur_data());
+    strm.avail_out = out_size;
+    rc = BZ2_bzDecompress(&strm);
+    if (rc == BZ_OK)
+      rc = (strm.avail_out > 0) ? BZ_UNEXPECTED_EOF : BZ_OUTBUFF_FULL;
+    else if (rc == BZ_STREAM_END)
+      rc = BZ_OK;
+    out_size -= strm.avail_out;
+    BZ2_bzDecompressEnd(&strm);
+  }
 
   // Handle error
   if (rc != BZ_OK) {
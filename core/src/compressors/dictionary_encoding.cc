@@ -0,0 +1,293 @@
+/**
+ * @file   dictionary_encoding.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DictionaryEncoding.
+ */
+
+#include "dictionary_encoding.h"
+#include "logger.h"
+
+#include <cstring>
+#include <vector>
+
+namespace tiledb {
+
+const uint8_t DictionaryEncoding::RAW = 0;
+
+const uint8_t DictionaryEncoding::DICTIONARY = 1;
+
+/* ****************************** */
+/*        STATIC FUNCTIONS        */
+/* ****************************** */
+
+/** Returns the FNV-1a hash of the input bytes. */
+static inline uint64_t hash_bytes(const unsigned char* data, uint64_t nbytes) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint64_t i = 0; i < nbytes; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status DictionaryEncoding::encode(
+    const uint64_t* offsets,
+    uint64_t cell_num,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
+  // For easy reference
+  auto values = (const unsigned char*)input_buffer->data();
+  uint64_t values_size = input_buffer->size();
+  const uint64_t header_size = sizeof(uint8_t) + 3 * sizeof(uint64_t) +
+                               sizeof(uint8_t);
+
+  // Hash table from cell values to dictionary indexes (plus 1, so that 0
+  // marks an empty slot), with at most 50% load
+  uint64_t slot_num = 16;
+  while (slot_num < 2 * cell_num)
+    slot_num *= 2;
+  std::vector<uint32_t> slots;
+  std::vector<uint64_t> dict_starts;
+  std::vector<uint64_t> dict_lengths;
+  std::vector<uint32_t> codes;
+  uint64_t dict_size = 0;
+
+  // Build the dictionary, giving up as soon as it cannot pay off
+  bool pays_off = cell_num > 0 && values_size > header_size;
+  if (pays_off) {
+    slots.resize(slot_num, 0);
+    codes.resize(cell_num);
+  }
+  for (uint64_t i = 0; pays_off && i < cell_num; ++i) {
+    uint64_t start = offsets[i] - offsets[0];
+    uint64_t end =
+        (i + 1 < cell_num) ? offsets[i + 1] - offsets[0] : values_size;
+    if (start > end || end > values_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot encode with dictionary; Invalid cell offsets"));
+    uint64_t length = end - start;
+
+    // Look up the value
+    uint64_t slot = hash_bytes(values + start, length) & (slot_num - 1);
+    for (; slots[slot] != 0; slot = (slot + 1) & (slot_num - 1)) {
+      uint32_t j = slots[slot] - 1;
+      if (dict_lengths[j] == length &&
+          !std::memcmp(values + dict_starts[j], values + start, length))
+        break;
+    }
+
+    // Add a new value to the dictionary
+    if (slots[slot] == 0) {
+      dict_starts.push_back(start);
+      dict_lengths.push_back(length);
+      dict_size += length;
+      slots[slot] = (uint32_t)dict_starts.size();
+      if (header_size + dict_starts.size() * sizeof(uint64_t) + dict_size >=
+          values_size)
+        pays_off = false;
+    }
+    codes[i] = slots[slot] - 1;
+  }
+
+  // Compute the size of the encoded tile
+  uint64_t dict_num = dict_starts.size();
+  uint8_t code_size =
+      (dict_num <= 256) ? 1 : (dict_num <= 65536) ? 2 : sizeof(uint32_t);
+  uint64_t encoded_size = header_size + dict_num * sizeof(uint64_t) +
+                          dict_size + cell_num * code_size;
+  if (encoded_size >= values_size + sizeof(uint8_t))
+    pays_off = false;
+
+  // Store the values as they are
+  if (!pays_off) {
+    RETURN_NOT_OK(output_buffer->write(&RAW, sizeof(uint8_t)));
+    return output_buffer->write(input_buffer, values_size);
+  }
+
+  // Write the header
+  if (output_buffer->offset() + encoded_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(
+        output_buffer->realloc(output_buffer->offset() + encoded_size));
+  RETURN_NOT_OK(output_buffer->write(&DICTIONARY, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_buffer->write(&cell_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&dict_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&dict_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_buffer->write(&code_size, sizeof(uint8_t)));
+
+  // Write the dictionary
+  uint64_t dict_offset = 0;
+  for (uint64_t j = 0; j < dict_num; ++j) {
+    RETURN_NOT_OK(output_buffer->write(&dict_offset, sizeof(uint64_t)));
+    dict_offset += dict_lengths[j];
+  }
+  for (uint64_t j = 0; j < dict_num; ++j)
+    RETURN_NOT_OK(
+        output_buffer->write(values + dict_starts[j], dict_lengths[j]));
+
+  // Write the codes
+  auto out = (unsigned char*)output_buffer->cur_data();
+  if (code_size == 1)
+    write_codes<uint8_t>(codes.data(), cell_num, out);
+  else if (code_size == 2)
+    write_codes<uint16_t>(codes.data(), cell_num, out);
+  else
+    write_codes<uint32_t>(codes.data(), cell_num, out);
+  output_buffer->advance_offset(cell_num * code_size);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+Status DictionaryEncoding::decode(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // Read the encoding
+  uint8_t encoding;
+  RETURN_NOT_OK(input_buffer->read(&encoding, sizeof(uint8_t)));
+  if (encoding == RAW)
+    return output_buffer->write(
+        input_buffer, input_buffer->nbytes_left_to_read());
+  if (encoding != DICTIONARY)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decode with dictionary; Invalid encoding"));
+
+  // Read the header
+  uint64_t cell_num, dict_num, dict_size;
+  uint8_t code_size;
+  RETURN_NOT_OK(input_buffer->read(&cell_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&dict_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&dict_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&code_size, sizeof(uint8_t)));
+  uint64_t left = input_buffer->nbytes_left_to_read();
+  if ((code_size != 1 && code_size != 2 && code_size != 4) ||
+      dict_num > left / sizeof(uint64_t) ||
+      dict_size > left - dict_num * sizeof(uint64_t) ||
+      cell_num > (left - dict_num * sizeof(uint64_t) - dict_size) / code_size)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decode with dictionary; Invalid header"));
+
+  // Read the dictionary
+  std::vector<uint64_t> dict_offsets(dict_num);
+  std::vector<uint64_t> dict_lengths(dict_num);
+  RETURN_NOT_OK(
+      input_buffer->read(dict_offsets.data(), dict_num * sizeof(uint64_t)));
+  for (uint64_t j = 0; j < dict_num; ++j) {
+    uint64_t end = (j + 1 < dict_num) ? dict_offsets[j + 1] : dict_size;
+    if (dict_offsets[j] > end || end > dict_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decode with dictionary; Invalid dictionary offsets"));
+    dict_lengths[j] = end - dict_offsets[j];
+  }
+  auto in = (const unsigned char*)input_buffer->data() + input_buffer->offset();
+  input_buffer->advance_offset(dict_size + cell_num * code_size);
+
+  // Decode the cells
+  switch (code_size) {
+    case 1:
+      return decode<uint8_t>(
+          in + dict_size,
+          cell_num,
+          dict_offsets.data(),
+          dict_lengths.data(),
+          in,
+          dict_num,
+          output_buffer);
+    case 2:
+      return decode<uint16_t>(
+          in + dict_size,
+          cell_num,
+          dict_offsets.data(),
+          dict_lengths.data(),
+          in,
+          dict_num,
+          output_buffer);
+    default:
+      return decode<uint32_t>(
+          in + dict_size,
+          cell_num,
+          dict_offsets.data(),
+          dict_lengths.data(),
+          in,
+          dict_num,
+          output_buffer);
+  }
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+Status DictionaryEncoding::decode(
+    const unsigned char* codes,
+    uint64_t cell_num,
+    const uint64_t* dict_offsets,
+    const uint64_t* dict_lengths,
+    const unsigned char* dict_values,
+    uint64_t dict_num,
+    Buffer* output_buffer) {
+  // Compute the size of the cell values
+  uint64_t nbytes = 0;
+  T code;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    std::memcpy(&code, codes + i * sizeof(T), sizeof(T));
+    if (code >= dict_num)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decode with dictionary; Invalid code"));
+    nbytes += dict_lengths[code];
+  }
+
+  // Copy the cell values
+  if (output_buffer->offset() + nbytes > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(output_buffer->offset() + nbytes));
+  auto out = (unsigned char*)output_buffer->cur_data();
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    std::memcpy(&code, codes + i * sizeof(T), sizeof(T));
+    std::memcpy(out, dict_values + dict_offsets[code], dict_lengths[code]);
+    out += dict_lengths[code];
+  }
+  output_buffer->advance_offset(nbytes);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+template <class T>
+void DictionaryEncoding::write_codes(
+    const uint32_t* codes, uint64_t cell_num, unsigned char* output) {
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    auto code = (T)codes[i];
+    std::memcpy(output + i * sizeof(T), &code, sizeof(T));
+  }
+}
+
+}  // namespace tiledb
@@ -0,0 +1,414 @@
+/**
+ * @file   filter_kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FilterKernels.
+ */
+
+#include "filter_kernels.h"
+#include "logger.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace tiledb {
+
+/* ****************************** */
+/*        STATIC FUNCTIONS        */
+/* ****************************** */
+
+/**
+ * Transposes an 8x8 bit matrix, whose rows are the bytes of the input
+ * (first row in the least significant byte).
+ */
+static inline uint64_t transpose8(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x = x ^ t ^ (t << 28);
+  return x;
+}
+
+#ifdef __SSE2__
+/**
+ * Interleaves the bytes of register *j* with those of register *j + n/2*,
+ * for *n* registers. Four rounds transpose *n* registers holding 16 values
+ * of *n* bytes into *n* registers holding the 16 bytes of each position,
+ * and log2(n) rounds do the opposite.
+ */
+static inline void interleave_bytes(__m128i* regs, uint64_t n) {
+  __m128i tmp[16];
+  for (uint64_t j = 0; j < n / 2; ++j) {
+    tmp[2 * j] = _mm_unpacklo_epi8(regs[j], regs[j + n / 2]);
+    tmp[2 * j + 1] = _mm_unpackhi_epi8(regs[j], regs[j + n / 2]);
+  }
+  for (uint64_t j = 0; j < n; ++j)
+    regs[j] = tmp[j];
+}
+
+/** Prefix sum of 32-bit values, returning the number of values summed. */
+static uint64_t prefix_sum_simd(
+    const uint32_t* input, uint64_t num, uint32_t* output) {
+  __m128i carry = _mm_setzero_si128();
+  uint64_t i = 0;
+  for (; i + 4 <= num; i += 4) {
+    __m128i x = _mm_loadu_si128((const __m128i*)(input + i));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi32(x, carry);
+    _mm_storeu_si128((__m128i*)(output + i), x);
+    carry = _mm_shuffle_epi32(x, 0xFF);
+  }
+  return i;
+}
+
+/** Prefix sum of 64-bit values, returning the number of values summed. */
+static uint64_t prefix_sum_simd(
+    const uint64_t* input, uint64_t num, uint64_t* output) {
+  __m128i carry = _mm_setzero_si128();
+  uint64_t i = 0;
+  for (; i + 2 <= num; i += 2) {
+    __m128i x = _mm_loadu_si128((const __m128i*)(input + i));
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, carry);
+    _mm_storeu_si128((__m128i*)(output + i), x);
+    carry = _mm_unpackhi_epi64(x, x);
+  }
+  return i;
+}
+#endif
+
+/** Fallback for the types without a SIMD prefix sum. */
+template <class U>
+static uint64_t prefix_sum_simd(const U*, uint64_t, U*) {
+  return 0;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status FilterKernels::apply(
+    Filter filter,
+    Datatype type,
+    const void* input,
+    uint64_t nbytes,
+    void* output) {
+  auto in = (const unsigned char*)input;
+  auto out = (unsigned char*)output;
+  uint64_t type_size = datatype_size(type);
+  uint64_t num = nbytes / type_size;
+  uint64_t num8 = num / 8 * 8;
+
+  switch (filter) {
+    case Filter::NO_FILTER:
+      std::memcpy(out, in, num * type_size);
+      break;
+    case Filter::BYTESHUFFLE:
+      byteshuffle(in, num, type_size, out);
+      break;
+    case Filter::BITSHUFFLE:
+      bitshuffle(in, num8, type_size, out);
+      byteshuffle(
+          in + num8 * type_size,
+          num - num8,
+          type_size,
+          out + num8 * type_size);
+      break;
+    case Filter::DELTA:
+      RETURN_NOT_OK(delta(true, type, input, num, output));
+      break;
+    default:
+      return LOG_STATUS(
+          Status::CompressionError("Cannot apply filter; Unknown filter"));
+  }
+
+  // Copy any trailing bytes
+  std::memcpy(
+      out + num * type_size, in + num * type_size, nbytes - num * type_size);
+
+  return Status::Ok();
+}
+
+Status FilterKernels::reverse(
+    Filter filter,
+    Datatype type,
+    const void* input,
+    uint64_t nbytes,
+    void* output) {
+  auto in = (const unsigned char*)input;
+  auto out = (unsigned char*)output;
+  uint64_t type_size = datatype_size(type);
+  uint64_t num = nbytes / type_size;
+  uint64_t num8 = num / 8 * 8;
+
+  switch (filter) {
+    case Filter::NO_FILTER:
+      std::memcpy(out, in, num * type_size);
+      break;
+    case Filter::BYTESHUFFLE:
+      byteunshuffle(in, num, type_size, out);
+      break;
+    case Filter::BITSHUFFLE:
+      bitunshuffle(in, num8, type_size, out);
+      byteunshuffle(
+          in + num8 * type_size,
+          num - num8,
+          type_size,
+          out + num8 * type_size);
+      break;
+    case Filter::DELTA:
+      RETURN_NOT_OK(delta(false, type, input, num, output));
+      break;
+    default:
+      return LOG_STATUS(
+          Status::CompressionError("Cannot reverse filter; Unknown filter"));
+  }
+
+  // Copy any trailing bytes
+  std::memcpy(
+      out + num * type_size, in + num * type_size, nbytes - num * type_size);
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void FilterKernels::byteshuffle(
+    const unsigned char* input,
+    uint64_t num,
+    uint64_t type_size,
+    unsigned char* output) {
+  if (type_size == 1) {
+    std::memcpy(output, input, num);
+    return;
+  }
+
+  uint64_t i = 0;
+#ifdef __SSE2__
+  // Transpose 16 values at a time
+  if (type_size == 2 || type_size == 4 || type_size == 8 || type_size == 16) {
+    __m128i regs[16];
+    for (; i + 16 <= num; i += 16) {
+      for (uint64_t k = 0; k < type_size; ++k)
+        regs[k] =
+            _mm_loadu_si128((const __m128i*)(input + i * type_size + 16 * k));
+      for (int round = 0; round < 4; ++round)
+        interleave_bytes(regs, type_size);
+      for (uint64_t k = 0; k < type_size; ++k)
+        _mm_storeu_si128((__m128i*)(output + k * num + i), regs[k]);
+    }
+  }
+#endif
+
+  for (; i < num; ++i) {
+    for (uint64_t k = 0; k < type_size; ++k)
+      output[k * num + i] = input[i * type_size + k];
+  }
+}
+
+void FilterKernels::byteunshuffle(
+    const unsigned char* input,
+    uint64_t num,
+    uint64_t type_size,
+    unsigned char* output) {
+  if (type_size == 1) {
+    std::memcpy(output, input, num);
+    return;
+  }
+
+  uint64_t i = 0;
+#ifdef __SSE2__
+  // Transpose 16 values at a time
+  if (type_size == 2 || type_size == 4 || type_size == 8 || type_size == 16) {
+    int rounds = 0;
+    for (uint64_t n = type_size; n > 1; n >>= 1)
+      ++rounds;
+    __m128i regs[16];
+    for (; i + 16 <= num; i += 16) {
+      for (uint64_t k = 0; k < type_size; ++k)
+        regs[k] = _mm_loadu_si128((const __m128i*)(input + k * num + i));
+      for (int round = 0; round < rounds; ++round)
+        interleave_bytes(regs, type_size);
+      for (uint64_t k = 0; k < type_size; ++k)
+        _mm_storeu_si128((__m128i*)(output + i * type_size + 16 * k), regs[k]);
+    }
+  }
+#endif
+
+  for (; i < num; ++i) {
+    for (uint64_t k = 0; k < type_size; ++k)
+      output[i * type_size + k] = input[k * num + i];
+  }
+}
+
+void FilterKernels::bitshuffle(
+    const unsigned char* input,
+    uint64_t num,
+    uint64_t type_size,
+    unsigned char* output) {
+  // Byte-shuffle, and then transpose the bits of each group of 8 bytes in
+  // every byte position
+  std::vector<unsigned char> bytes(num * type_size);
+  byteshuffle(input, num, type_size, bytes.data());
+
+  uint64_t group_num = num / 8;
+  for (uint64_t k = 0; k < type_size; ++k) {
+    const unsigned char* in = bytes.data() + k * num;
+    unsigned char* out = output + k * num;
+    uint64_t i = 0;
+#ifdef __SSE2__
+    // Extract each bit of 16 bytes at a time, starting from the highest
+    for (; i + 16 <= num; i += 16) {
+      __m128i x = _mm_loadu_si128((const __m128i*)(in + i));
+      for (int bit = 7; bit >= 0; --bit) {
+        auto mask = (uint16_t)_mm_movemask_epi8(x);
+        std::memcpy(out + bit * group_num + i / 8, &mask, sizeof(uint16_t));
+        x = _mm_slli_epi16(x, 1);
+      }
+    }
+#endif
+    for (; i < num; i += 8) {
+      uint64_t x;
+      std::memcpy(&x, in + i, sizeof(uint64_t));
+      x = transpose8(x);
+      for (int bit = 0; bit < 8; ++bit)
+        out[bit * group_num + i / 8] = (unsigned char)(x >> (8 * bit));
+    }
+  }
+}
+
+void FilterKernels::bitunshuffle(
+    const unsigned char* input,
+    uint64_t num,
+    uint64_t type_size,
+    unsigned char* output) {
+  // Transpose the bits back in every byte position, and then byte-unshuffle
+  std::vector<unsigned char> bytes(num * type_size);
+  uint64_t group_num = num / 8;
+  for (uint64_t k = 0; k < type_size; ++k) {
+    const unsigned char* in = input + k * num;
+    unsigned char* out = bytes.data() + k * num;
+    for (uint64_t i = 0; i < num; i += 8) {
+      uint64_t x = 0;
+      for (int bit = 0; bit < 8; ++bit)
+        x |= ((uint64_t)in[bit * group_num + i / 8]) << (8 * bit);
+      x = transpose8(x);
+      std::memcpy(out + i, &x, sizeof(uint64_t));
+    }
+  }
+
+  byteunshuffle(bytes.data(), num, type_size, output);
+}
+
+template <class T>
+void FilterKernels::delta_encode(const T* input, uint64_t num, T* output) {
+  typedef typename std::make_unsigned<T>::type U;
+  auto in = (const U*)input;
+  auto out = (U*)output;
+  if (num == 0)
+    return;
+  out[0] = in[0];
+  for (uint64_t i = 1; i < num; ++i)
+    out[i] = U(in[i] - in[i - 1]);
+}
+
+template <class T>
+void FilterKernels::delta_decode(const T* input, uint64_t num, T* output) {
+  // Decoding is a prefix sum of the deltas
+  typedef typename std::make_unsigned<T>::type U;
+  auto in = (const U*)input;
+  auto out = (U*)output;
+  uint64_t i = prefix_sum_simd(in, num, out);
+  U sum = (i == 0) ? 0 : out[i - 1];
+  for (; i < num; ++i) {
+    sum = U(sum + in[i]);
+    out[i] = sum;
+  }
+}
+
+Status FilterKernels::delta(
+    bool forward,
+    Datatype type,
+    const void* input,
+    uint64_t num,
+    void* output) {
+  switch (type) {
+    case Datatype::CHAR:
+      delta<char>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::INT8:
+      delta<int8_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::UINT8:
+      delta<uint8_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::INT16:
+      delta<int16_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::UINT16:
+      delta<uint16_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::INT32:
+      delta<int>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::UINT32:
+      delta<uint32_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::INT64:
+      delta<int64_t>(forward, input, num, output);
+      return Status::Ok();
+    case Datatype::UINT64:
+      delta<uint64_t>(forward, input, num, output);
+      return Status::Ok();
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot apply delta filter; Not supported datatype"));
+  }
+}
+
+template <class T>
+void FilterKernels::delta(
+    bool forward, const void* input, uint64_t num, void* output) {
+  if (forward)
+    delta_encode<T>((const T*)input, num, (T*)output);
+  else
+    delta_decode<T>((const T*)input, num, (T*)output);
+}
+
+}  // namespace tiledb
@@ -0,0 +1,367 @@
+/**
+ * @file   gorilla_compressor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements the Gorilla compressor class.
+ */
+
+#include "gorilla_compressor.h"
+#include "logger.h"
+
+#include <cstring>
+
+namespace tiledb {
+
+const uint8_t Gorilla::RAW = 0;
+
+const uint8_t Gorilla::XOR = 1;
+
+/* ****************************** */
+/*         BIT STREAM I/O         */
+/* ****************************** */
+
+namespace {
+
+/** Writes a bitstream, most significant bit first. */
+class BitWriter {
+ public:
+  explicit BitWriter(unsigned char* out)
+      : out_(out)
+      , size_(0)
+      , acc_(0)
+      , acc_bits_(0) {
+  }
+
+  /** Writes the *n* (at most 32) low bits of *bits*; the rest must be 0. */
+  void write(uint64_t bits, int n) {
+    acc_ = (acc_ << n) | bits;
+    acc_bits_ += n;
+    for (; acc_bits_ >= 8; acc_bits_ -= 8)
+      out_[size_++] = (unsigned char)(acc_ >> (acc_bits_ - 8));
+  }
+
+  /** Writes the *n* (at most 64) low bits of *bits*; the rest must be 0. */
+  void write_long(uint64_t bits, int n) {
+    if (n > 32) {
+      write(bits >> 32, n - 32);
+      write(bits & 0xffffffff, 32);
+    } else {
+      write(bits, n);
+    }
+  }
+
+  /** Pads the last byte with zeros and returns the bytes written. */
+  uint64_t finish() {
+    if (acc_bits_ > 0)
+      out_[size_++] = (unsigned char)(acc_ << (8 - acc_bits_));
+    acc_bits_ = 0;
+    return size_;
+  }
+
+ private:
+  unsigned char* out_;
+  uint64_t size_;
+  uint64_t acc_;
+  int acc_bits_;
+};
+
+/** Reads a bitstream written by BitWriter. */
+class BitReader {
+ public:
+  BitReader(const unsigned char* in, uint64_t size)
+      : in_(in)
+      , size_(size)
+      , offset_(0)
+      , acc_(0)
+      , acc_bits_(0) {
+  }
+
+  /**
+   * Reads *n* (at most 32) bits into *bits*. Returns *false* if the
+   * stream ends before.
+   */
+  bool read(int n, uint64_t* bits) {
+    for (; acc_bits_ < n; acc_bits_ += 8) {
+      if (offset_ == size_)
+        return false;
+      acc_ = (acc_ << 8) | in_[offset_++];
+    }
+    acc_bits_ -= n;
+    *bits = (acc_ >> acc_bits_) & ((((uint64_t)1) << n) - 1);
+    return true;
+  }
+
+  /** Reads *n* (at most 64) bits into *bits*. */
+  bool read_long(int n, uint64_t* bits) {
+    if (n <= 32)
+      return read(n, bits);
+    uint64_t high, low;
+    if (!read(n - 32, &high) || !read(32, &low))
+      return false;
+    *bits = (high << 32) | low;
+    return true;
+  }
+
+  /** Returns the number of bytes consumed. */
+  uint64_t offset() const {
+    return offset_;
+  }
+
+ private:
+  const unsigned char* in_;
+  uint64_t size_;
+  uint64_t offset_;
+  uint64_t acc_;
+  int acc_bits_;
+};
+
+inline int leading_zeros(uint32_t x) {
+  return __builtin_clz(x);
+}
+
+inline int leading_zeros(uint64_t x) {
+  return __builtin_clzll(x);
+}
+
+inline int trailing_zeros(uint32_t x) {
+  return __builtin_ctz(x);
+}
+
+inline int trailing_zeros(uint64_t x) {
+  return __builtin_ctzll(x);
+}
+
+}  // namespace
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status Gorilla::compress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::FLOAT32:
+      return Gorilla::compress<uint32_t>(input_buffer, output_buffer);
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT64:
+      return Gorilla::compress<uint64_t>(input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot compress tile with Gorilla; Not supported datatype"));
+  }
+}
+
+Status Gorilla::decompress(
+    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  switch (type) {
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::FLOAT32:
+      return Gorilla::decompress<uint32_t>(input_buffer, output_buffer);
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT64:
+      return Gorilla::decompress<uint64_t>(input_buffer, output_buffer);
+    default:
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress tile with Gorilla; Not supported datatype"));
+  }
+}
+
+uint64_t Gorilla::overhead(uint64_t nbytes) {
+  (void)nbytes;
+  return sizeof(uint64_t) + sizeof(uint8_t);
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+Status Gorilla::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  const int type_bits = 8 * sizeof(T);
+  const int lead_bits = (type_bits == 64) ? 5 : 4;
+  const int len_bits = (type_bits == 64) ? 6 : 5;
+  const int max_lead = (1 << lead_bits) - 1;
+
+  // Calculate number of values
+  uint64_t value_size = sizeof(T);
+  uint64_t num = input_buffer->size() / value_size;
+  if (input_buffer->size() % value_size != 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot compress with Gorilla; Invalid input buffer size"));
+
+  // Make room for the worst case, so that the bitstream is written directly
+  uint64_t max_bits = type_bits + num * (2 + lead_bits + len_bits + type_bits);
+  uint64_t max_size = overhead(input_buffer->size()) + max_bits / 8 + 1;
+  if (output_buffer->offset() + max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(output_buffer->offset() + max_size));
+  auto out = (unsigned char*)output_buffer->cur_data();
+  std::memcpy(out, &num, sizeof(uint64_t));
+  uint64_t out_size = sizeof(uint64_t) + sizeof(uint8_t);
+
+  // Encode the XOR of each value with the previous one
+  auto in = (const T*)input_buffer->data();
+  BitWriter writer(out + out_size);
+  if (num > 0)
+    writer.write_long(in[0], type_bits);
+  int prev_lead = type_bits;  // No meaningful bits window yet
+  int prev_trail = 0;
+  for (uint64_t i = 1; i < num; ++i) {
+    T x = in[i] ^ in[i - 1];
+    if (x == 0) {
+      writer.write(0, 1);
+      continue;
+    }
+
+    int lead = leading_zeros(x);
+    if (lead > max_lead)
+      lead = max_lead;
+    int trail = trailing_zeros(x);
+    if (lead >= prev_lead && trail >= prev_trail) {
+      writer.write(2, 2);
+      writer.write_long(x >> prev_trail, type_bits - prev_lead - prev_trail);
+    } else {
+      int len = type_bits - lead - trail;
+      uint64_t header = (3 << (lead_bits + len_bits)) |
+                        (lead << len_bits) | (uint64_t)(len - 1);
+      writer.write(header, 2 + lead_bits + len_bits);
+      writer.write_long(x >> trail, len);
+      prev_lead = lead;
+      prev_trail = trail;
+    }
+  }
+  uint64_t payload_size = writer.finish();
+
+  // Store the values as they are if encoding does not pay off
+  if (payload_size >= input_buffer->size()) {
+    out[sizeof(uint64_t)] = RAW;
+    std::memcpy(out + out_size, in, input_buffer->size());
+    out_size += input_buffer->size();
+  } else {
+    out[sizeof(uint64_t)] = XOR;
+    out_size += payload_size;
+  }
+
+  output_buffer->advance_offset(out_size);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Gorilla::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  const int type_bits = 8 * sizeof(T);
+  const int lead_bits = (type_bits == 64) ? 5 : 4;
+  const int len_bits = (type_bits == 64) ? 6 : 5;
+
+  // Read number of values and encoding
+  uint64_t num;
+  uint8_t encoding;
+  uint64_t value_size = sizeof(T);
+  RETURN_NOT_OK(input_buffer->read(&num, sizeof(uint64_t)));
+  RETURN_NOT_OK(input_buffer->read(&encoding, sizeof(uint8_t)));
+  if (num > UINT64_MAX / value_size)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with Gorilla; Invalid number of values"));
+  if (encoding != RAW && encoding != XOR)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot decompress with Gorilla; Invalid encoding"));
+
+  // Make room for the values in the output buffer
+  uint64_t nbytes = num * value_size;
+  uint64_t end = output_buffer->offset() + nbytes;
+  if (end > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(end));
+  auto out = (T*)output_buffer->cur_data();
+
+  if (encoding == RAW) {
+    RETURN_NOT_OK(input_buffer->read(out, nbytes));
+  } else {
+    // Decode the bitstream
+    auto in =
+        (const unsigned char*)input_buffer->data() + input_buffer->offset();
+    BitReader reader(in, input_buffer->nbytes_left_to_read());
+    uint64_t bits = 0;
+    bool ok = (num == 0) || reader.read_long(type_bits, &bits);
+    T prev = (T)bits;
+    if (num > 0)
+      out[0] = prev;
+    int lead = -1;  // No meaningful bits window yet
+    int trail = 0;
+    int len = 0;
+    for (uint64_t i = 1; ok && i < num; ++i) {
+      ok = reader.read(1, &bits);
+      if (ok && bits == 1) {
+        ok = reader.read(1, &bits);
+        if (ok && bits == 1) {
+          // New meaningful bits window
+          ok = reader.read(lead_bits + len_bits, &bits);
+          lead = (int)(bits >> len_bits);
+          len = (int)(bits & ((1 << len_bits) - 1)) + 1;
+          trail = type_bits - lead - len;
+          if (trail < 0)
+            return LOG_STATUS(Status::CompressionError(
+                "Cannot decompress with Gorilla; Invalid input"));
+        } else if (ok && lead < 0) {
+          return LOG_STATUS(Status::CompressionError(
+              "Cannot decompress with Gorilla; Invalid input"));
+        }
+        ok = ok && reader.read_long(len, &bits);
+        prev ^= ((T)bits) << trail;
+      }
+      out[i] = prev;
+    }
+    if (!ok)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot decompress with Gorilla; Truncated input"));
+    input_buffer->advance_offset(reader.offset());
+  }
+
+  output_buffer->advance_offset(nbytes);
+  output_buffer->set_size(output_buffer->offset());
+
+  return Status::Ok();
+}
+
+// Explicit template instantiations
+
+template Status Gorilla::compress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status Gorilla::compress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+template Status Gorilla::decompress<uint32_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+template Status Gorilla::decompress<uint64_t>(
+    ConstBuffer* input_buffer, Buffer* output_buffer);
+
+}  // namespace tiledb
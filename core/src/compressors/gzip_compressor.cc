@@ -38,6 +38,47 @@
 
 namespace tiledb {
 
+/* ****************************** */
+/*        STATIC VARIABLES        */
+/* ****************************** */
+
+/**
+ * The zlib streams of a thread. They are initialized upon their first use
+ * and reset for all the subsequent calls of the thread, so that the zlib
+ * state is not allocated and freed for every compressed chunk.
+ */
+struct GZipStreams {
+  /** The deflate stream. */
+  z_stream deflate_strm_;
+
+  /** Set if the deflate stream is initialized. */
+  bool deflate_init_ = false;
+
+  /** The compression level of the deflate stream. */
+  int deflate_level_ = 0;
+
+  /** The inflate stream. */
+  z_stream inflate_strm_;
+
+  /** Set if the inflate stream is initialized. */
+  bool inflate_init_ = false;
+
+  /** Destructor. */
+  ~GZipStreams() {
+    if (deflate_init_)
+      (void)deflateEnd(&deflate_strm_);
+    if (inflate_init_)
+      (void)inflateEnd(&inflate_strm_);
+  }
+};
+
+/** The zlib streams of the calling thread. */
+static thread_local GZipStreams gzip_streams;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status GZip::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
@@ -46,35 +87,46 @@ Status GZip::compress(
         "Failed compressing with GZip; invalid buffer format"));
 
   ssize_t ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, level < 0 ? GZip::default_level() : level);
-
-  if (ret != Z_OK) {
-    (void)deflateEnd(&strm);
-    return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
+  z_stream* strm = &gzip_streams.deflate_strm_;
+  level = level < 0 ? GZip::default_level() : level;
+
+  // Initialize the deflate state of the thread, or reset it. The state is
+  // initialized anew upon a level change, since deflateParams() may flush
+  // pending output.
+  if (gzip_streams.deflate_init_ && level != gzip_streams.deflate_level_) {
+    (void)deflateEnd(strm);
+    gzip_streams.deflate_init_ = false;
+  }
+  if (!gzip_streams.deflate_init_) {
+    strm->zalloc = Z_NULL;
+    strm->zfree = Z_NULL;
+    strm->opaque = Z_NULL;
+    ret = deflateInit(strm, level);
+    if (ret != Z_OK) {
+      (void)deflateEnd(strm);
+      return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
+    }
+    gzip_streams.deflate_init_ = true;
+    gzip_streams.deflate_level_ = level;
+  } else {
+    ret = deflateReset(strm);
+    if (ret != Z_OK)
+      return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
   }
 
   // Compress
-  strm.next_in = (unsigned char*)input_buffer->data();
-  strm.next_out = (unsigned char*)output_buffer->cur_data();
-  strm.avail_in = (uInt)input_buffer->size();
-  strm.avail_out = (uInt)output_buffer->free_space();
-  ret = deflate(&strm, Z_FINISH);
-
-  // Clean up
-  (void)deflateEnd(&strm);
-
-  // Return
-  if (ret == Z_STREAM_ERROR || strm.avail_in != 0)
+  strm->next_in = (unsigned char*)input_buffer->data();
+  strm->next_out = (unsigned char*)output_buffer->cur_data();
+  strm->avail_in = (uInt)input_buffer->size();
+  strm->avail_out = (uInt)output_buffer->free_space();
+  ret = deflate(strm, Z_FINISH);
+
+  // Return. The stream does not end if the output buffer is too small.
+  if (ret != Z_STREAM_END)
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
 
   // Set size of compressed data
-  uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
+  uint64_t compressed_size = output_buffer->free_space() - strm->avail_out;
   output_buffer->advance_size(compressed_size);
   output_buffer->advance_offset(compressed_size);
 
@@ -88,26 +140,31 @@ Status GZip::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
         "Failed decompressing with GZip; invalid buffer format"));
 
   int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = inflateInit(&strm);
-
-  if (ret != Z_OK) {
-    return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
+  z_stream* strm = &gzip_streams.inflate_strm_;
+
+  // Initialize the inflate state of the thread, or reset it
+  if (!gzip_streams.inflate_init_) {
+    strm->zalloc = Z_NULL;
+    strm->zfree = Z_NULL;
+    strm->opaque = Z_NULL;
+    strm->avail_in = 0;
+    strm->next_in = Z_NULL;
+    ret = inflateInit(strm);
+    if (ret != Z_OK)
+      return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
+    gzip_streams.inflate_init_ = true;
+  } else {
+    ret = inflateReset(strm);
+    if (ret != Z_OK)
+      return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
   }
 
   // Decompress
-  strm.next_in = (unsigned char*)input_buffer->data();
-  strm.next_out = (unsigned char*)output_buffer->cur_data();
-  strm.avail_in = (uInt)input_buffer->size();
-  strm.avail_out = (uInt)output_buffer->free_space();
-  ret = inflate(&strm, Z_FINISH);
+  strm->next_in = (unsigned char*)input_buffer->data();
+  strm->next_out = (unsigned char*)output_buffer->cur_data();
+  strm->avail_in = (uInt)input_buffer->size();
+  strm->avail_out = (uInt)output_buffer->free_space();
+  ret = inflate(strm, Z_FINISH);
 
   if (ret != Z_STREAM_END) {
     return LOG_STATUS(
@@ -115,13 +172,10 @@ Status GZip::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
   }
 
   // Set size of decompressed data
-  uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
+  uint64_t compressed_size = output_buffer->free_space() - strm->avail_out;
   output_buffer->advance_size(compressed_size);
   output_buffer->advance_offset(compressed_size);
 
-  // Clean up
-  (void)inflateEnd(&strm);
-
   // Success
   return Status::Ok();
 }
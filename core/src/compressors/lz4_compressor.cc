@@ -31,6 +31,7 @@
  */
 
 #include <lz4.h>
+#include <cstdlib>
 #include <limits>
 
 #include "logger.h"
@@ -38,6 +39,34 @@
 
 namespace tiledb {
 
+/* ****************************** */
+/*        STATIC VARIABLES        */
+/* ****************************** */
+
+#if LZ4_VERSION_NUMBER >= 10705
+/**
+ * The lz4 compression state of a thread. It is allocated upon its first
+ * use and reused by all the subsequent calls of the thread, instead of
+ * being allocated on the stack (or heap) for every compressed chunk.
+ */
+struct LZ4State {
+  /** The state, of size LZ4_sizeofState(). */
+  void* state_ = nullptr;
+
+  /** Destructor. */
+  ~LZ4State() {
+    std::free(state_);
+  }
+};
+
+/** The lz4 compression state of the calling thread. */
+static thread_local LZ4State lz4_state;
+#endif
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status LZ4::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
@@ -49,11 +78,18 @@ Status LZ4::compress(
 
     // Compress
 #if LZ4_VERSION_NUMBER >= 10705
-  int ret = LZ4_compress_default(
+  if (lz4_state.state_ == nullptr)
+    lz4_state.state_ = std::malloc(LZ4_sizeofState());
+  if (lz4_state.state_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with LZ4; cannot allocate state"));
+  int ret = LZ4_compress_fast_extState(
+      lz4_state.state_,
       (char*)input_buffer->data(),
       (char*)output_buffer->cur_data(),
       (int)input_buffer->size(),
-      (int)output_buffer->free_space());
+      (int)output_buffer->free_space(),
+      1);
 #else
   // deprecated lz4 api
   int ret = LZ4_compress(
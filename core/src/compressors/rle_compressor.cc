@@ -30,26 +30,134 @@
  * This file implements the rle compressor class.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
+#include "constants.h"
 #include "logger.h"
 #include "rle_compressor.h"
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TILEDB_RLE_X86
+#include <immintrin.h>
+#endif
+
 namespace tiledb {
 
+/**
+ * Returns the number of leading bytes that are equal in two buffers of
+ * `nbytes` bytes (`nbytes` if the buffers are equal).
+ */
+typedef uint64_t (*MismatchFunc)(
+    const unsigned char* a, const unsigned char* b, uint64_t nbytes);
+
+/** Portable mismatch search, comparing a word at a time. */
+static uint64_t mismatch_scalar(
+    const unsigned char* a, const unsigned char* b, uint64_t nbytes) {
+  uint64_t i = 0;
+  for (; i + sizeof(uint64_t) <= nbytes; i += sizeof(uint64_t)) {
+    uint64_t word_a, word_b;
+    std::memcpy(&word_a, a + i, sizeof(uint64_t));
+    std::memcpy(&word_b, b + i, sizeof(uint64_t));
+    if (word_a != word_b)
+      break;
+  }
+  for (; i < nbytes; ++i) {
+    if (a[i] != b[i])
+      break;
+  }
+  return i;
+}
+
+#ifdef TILEDB_RLE_X86
+/** Mismatch search comparing 16 bytes at a time. */
+__attribute__((target("sse2"))) static uint64_t mismatch_sse2(
+    const unsigned char* a, const unsigned char* b, uint64_t nbytes) {
+  uint64_t i = 0;
+  for (; i + 16 <= nbytes; i += 16) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+    auto mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+    if (mask != 0xffff)
+      return i + __builtin_ctz(~mask);
+  }
+  return i + mismatch_scalar(a + i, b + i, nbytes - i);
+}
+
+/** Mismatch search comparing 32 bytes at a time. */
+__attribute__((target("avx2"))) static uint64_t mismatch_avx2(
+    const unsigned char* a, const unsigned char* b, uint64_t nbytes) {
+  uint64_t i = 0;
+  for (; i + 32 <= nbytes; i += 32) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+    __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+    auto mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+    if (mask != 0xffffffff)
+      return i + __builtin_ctz(~mask);
+  }
+  return i + mismatch_sse2(a + i, b + i, nbytes - i);
+}
+#endif
+
+/** Returns the fastest mismatch search supported by the CPU. */
+static MismatchFunc mismatch_func() {
+#ifdef TILEDB_RLE_X86
+  static const MismatchFunc func = []() -> MismatchFunc {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return mismatch_avx2;
+    return mismatch_sse2;
+  }();
+  return func;
+#else
+  return mismatch_scalar;
+#endif
+}
+
+/** Writes a varint and returns the number of bytes written. */
+static uint64_t write_varint(uint64_t value, unsigned char* output) {
+  uint64_t nbytes = 0;
+  while (value >= 0x80) {
+    output[nbytes++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  output[nbytes++] = (unsigned char)value;
+  return nbytes;
+}
+
+/**
+ * Reads a varint starting at `*offset` in the input, and advances the
+ * offset past it. Returns *false* if the varint is truncated or too long.
+ */
+static bool read_varint(
+    const unsigned char* input,
+    uint64_t input_size,
+    uint64_t* offset,
+    uint64_t* value) {
+  uint64_t ret = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    if (*offset >= input_size)
+      return false;
+    unsigned char byte = input[(*offset)++];
+    ret |= ((uint64_t)(byte & 0x7f)) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = ret;
+      return true;
+    }
+  }
+  return false;
+}
+
 Status RLE::compress(
     uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with RLE; null input buffer"));
-  unsigned int cur_run_len = 1;
-  unsigned int max_run_len = 65535;
-  auto input_cur = (const unsigned char*)input_buffer->data() + value_size;
-  auto input_prev = (const unsigned char*)input_buffer->data();
+  auto input = (const unsigned char*)input_buffer->data();
   uint64_t value_num = input_buffer->size() / value_size;
-  unsigned char byte;
 
   // Trivial case
   if (value_num == 0)
@@ -61,34 +169,31 @@ Status RLE::compress(
         "Failed compressing with RLE; invalid input buffer format"));
   }
 
-  // Make runs
-  for (uint64_t i = 1; i < value_num; ++i) {
-    if (std::memcmp(input_cur, input_prev, value_size) == 0 &&
-        cur_run_len < max_run_len) {  // Expand the run
-      ++cur_run_len;
-    } else {  // Save the run
-      // Copy to output buffer
-      RETURN_NOT_OK(output_buffer->write(input_prev, value_size));
-      byte = (unsigned char)(cur_run_len >> 8);
-      RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-      byte = (unsigned char)(cur_run_len % 256);
-      RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-
-      // Reset current run length
-      cur_run_len = 1;
-    }
+  // Make room for the worst case, so that the runs are written directly
+  uint64_t max_size =
+      input_buffer->size() + overhead(input_buffer->size(), value_size);
+  if (output_buffer->offset() + max_size > output_buffer->alloced_size())
+    RETURN_NOT_OK(output_buffer->realloc(output_buffer->offset() + max_size));
+  auto output = (unsigned char*)output_buffer->cur_data();
+  uint64_t output_size = 0;
+  output[output_size++] = constants::rle_format_version;
 
-    // Update run info
-    input_prev = input_cur;
-    input_cur = input_prev + value_size;
+  // Make runs. The end of each run is the first byte where the input
+  // differs from itself shifted by one value.
+  auto mismatch = mismatch_func();
+  for (uint64_t i = 0; i < value_num;) {
+    auto run = input + i * value_size;
+    uint64_t run_len =
+        1 + mismatch(run, run + value_size, (value_num - 1 - i) * value_size) /
+                value_size;
+    std::memcpy(output + output_size, run, value_size);
+    output_size += value_size;
+    output_size += write_varint(run_len, output + output_size);
+    i += run_len;
   }
 
-  // Save final run
-  RETURN_NOT_OK(output_buffer->write(input_prev, value_size));
-  byte = (unsigned char)(cur_run_len >> 8);
-  RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
-  byte = (unsigned char)(cur_run_len % 256);
-  RETURN_NOT_OK(output_buffer->write(&byte, sizeof(char)));
+  output_buffer->advance_offset(output_size);
+  output_buffer->set_size(output_buffer->offset());
 
   return Status::Ok();
 }
@@ -100,11 +205,71 @@ Status RLE::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with RLE; null input buffer"));
 
+  auto input = static_cast<const unsigned char*>(input_buffer->data());
+  uint64_t input_size = input_buffer->size();
+
+  // Trivial case
+  if (input_size == 0)
+    return Status::Ok();
+
+  // Check the format version
+  if (input[0] != constants::rle_format_version)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; unsupported format version"));
+
+  // Decompress runs
+  uint64_t input_offset = 1;
+  while (input_offset < input_size) {
+    // Retrieve the current value and run length
+    if (input_size - input_offset < value_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with RLE; invalid input buffer format"));
+    auto value = input + input_offset;
+    input_offset += value_size;
+    uint64_t run_len;
+    if (!read_varint(input, input_size, &input_offset, &run_len) ||
+        run_len == 0 || run_len > UINT64_MAX / value_size)
+      return LOG_STATUS(Status::CompressionError(
+          "Failed decompressing with RLE; invalid input buffer format"));
+
+    // Make room for the run in the output buffer
+    uint64_t run_size = run_len * value_size;
+    uint64_t end = output_buffer->offset() + run_size;
+    if (end > output_buffer->alloced_size())
+      RETURN_NOT_OK(output_buffer->realloc(
+          std::max(end, 2 * output_buffer->alloced_size())));
+
+    // Copy the value once, and then double the copied part until the run
+    // is complete
+    auto output = (unsigned char*)output_buffer->cur_data();
+    if (value_size == 1) {
+      std::memset(output, *value, run_size);
+    } else {
+      std::memcpy(output, value, value_size);
+      for (uint64_t copied = value_size; copied < run_size;) {
+        uint64_t nbytes = std::min(copied, run_size - copied);
+        std::memcpy(output + copied, output, nbytes);
+        copied += nbytes;
+      }
+    }
+    output_buffer->advance_offset(run_size);
+    output_buffer->set_size(output_buffer->offset());
+  }
+
+  return Status::Ok();
+}
+
+Status RLE::decompress_legacy(
+    uint64_t value_size, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  // Sanity check
+  if (input_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with RLE; null input buffer"));
+
   auto input_cur = static_cast<const unsigned char*>(input_buffer->data());
   uint64_t run_len;
   uint64_t run_size = value_size + 2 * sizeof(char);
   uint64_t run_num = input_buffer->size() / run_size;
-  unsigned char byte;
 
   // Trivial case
   if (run_num == 0)
@@ -119,14 +284,12 @@ Status RLE::decompress(
   // Decompress runs
   for (uint64_t i = 0; i < run_num; ++i) {
     // Retrieve the current run length
-    std::memcpy(&byte, input_cur + value_size, sizeof(char));
-    run_len = (((uint64_t)byte) << 8);
-    std::memcpy(&byte, input_cur + value_size + sizeof(char), sizeof(char));
-    run_len += (uint64_t)byte;
+    run_len = (((uint64_t)input_cur[value_size]) << 8) +
+              (uint64_t)input_cur[value_size + 1];
 
     // Copy to output buffer
     for (uint64_t j = 0; j < run_len; ++j)
-      RETURN_NOT_OK(output_buffer->write(input_cur, value_size))
+      RETURN_NOT_OK(output_buffer->write(input_cur, value_size));
 
     // Update input/output tracking info
     input_cur += run_size;
@@ -136,9 +299,10 @@ Status RLE::decompress(
 }
 
 uint64_t RLE::overhead(uint64_t nbytes, uint64_t value_size) {
-  // In the worst case, RLE adds two bytes per every value in the buffer.
+  // In the worst case, RLE adds one byte per every value in the buffer, plus
+  // the format version.
   uint64_t value_num = nbytes / value_size;
-  return value_num * 2;
+  return value_num + 1;
 }
 
 }  // namespace tiledb
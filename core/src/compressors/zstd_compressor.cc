@@ -38,20 +38,81 @@
 
 namespace tiledb {
 
+/* ****************************** */
+/*        STATIC VARIABLES        */
+/* ****************************** */
+
+/**
+ * The zstd contexts of a thread. They are created upon their first use and
+ * reused by all the subsequent calls of the thread, so that the zstd state
+ * is not allocated and freed for every compressed chunk.
+ */
+struct ZStdContexts {
+  /** The compression context. */
+  ZSTD_CCtx* cctx_ = nullptr;
+
+  /** The decompression context. */
+  ZSTD_DCtx* dctx_ = nullptr;
+
+  /** Destructor. */
+  ~ZStdContexts() {
+    ZSTD_freeCCtx(cctx_);
+    ZSTD_freeDCtx(dctx_);
+  }
+};
+
+/** The zstd contexts of the calling thread. */
+static thread_local ZStdContexts zstd_contexts;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status ZStd::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
+  return compress(level, nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::compress(
+    int level,
+    ZStdDictionary* dictionary,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
+  // Get the compression context of the thread
+  if (zstd_contexts.cctx_ == nullptr)
+    zstd_contexts.cctx_ = ZSTD_createCCtx();
+  if (zstd_contexts.cctx_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with ZStd; cannot create context"));
+
   // Compress
-  uint64_t zstd_ret = ZSTD_compress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size(),
-      level < 0 ? ZStd::default_level() : level);
+  if (level < 0)
+    level = ZStd::default_level();
+  uint64_t zstd_ret;
+  if (dictionary == nullptr) {
+    zstd_ret = ZSTD_compressCCtx(
+        zstd_contexts.cctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        level);
+  } else {
+    const ZSTD_CDict* cdict;
+    RETURN_NOT_OK(dictionary->cdict(level, &cdict));
+    zstd_ret = ZSTD_compress_usingCDict(
+        zstd_contexts.cctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        cdict);
+  }
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -68,17 +129,45 @@ Status ZStd::compress(
 }
 
 Status ZStd::decompress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+  return decompress(nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::decompress(
+    ZStdDictionary* dictionary,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
+  // Get the decompression context of the thread
+  if (zstd_contexts.dctx_ == nullptr)
+    zstd_contexts.dctx_ = ZSTD_createDCtx();
+  if (zstd_contexts.dctx_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with ZStd; cannot create context"));
+
   // Decompress
-  uint64_t zstd_ret = ZSTD_decompress(
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size());
+  uint64_t zstd_ret;
+  if (dictionary == nullptr) {
+    zstd_ret = ZSTD_decompressDCtx(
+        zstd_contexts.dctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size());
+  } else {
+    const ZSTD_DDict* ddict;
+    RETURN_NOT_OK(dictionary->ddict(&ddict));
+    zstd_ret = ZSTD_decompress_usingDDict(
+        zstd_contexts.dctx_,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        ddict);
+  }
 
   // Check error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -0,0 +1,144 @@
+/**
+ * @file   zstd_dictionary.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file implements class ZStdDictionary.
+ */
+
+#include "zstd_dictionary.h"
+#include "logger.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+namespace tiledb {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ZStdDictionary::ZStdDictionary() {
+  data_ = new Buffer();
+  ddict_ = nullptr;
+}
+
+ZStdDictionary::~ZStdDictionary() {
+  clear();
+  delete data_;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status ZStdDictionary::cdict(int level, const ZSTD_CDict_s** cdict) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto it = cdicts_.find(level);
+  if (it == cdicts_.end()) {
+    ZSTD_CDict* new_cdict =
+        ZSTD_createCDict(data_->data(), data_->size(), level);
+    if (new_cdict == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot prepare ZStd dictionary; Dictionary creation failed"));
+    it = cdicts_.emplace(level, new_cdict).first;
+  }
+  *cdict = it->second;
+
+  return Status::Ok();
+}
+
+const void* ZStdDictionary::data() const {
+  return data_->data();
+}
+
+Status ZStdDictionary::ddict(const ZSTD_DDict_s** ddict) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (ddict_ == nullptr) {
+    ddict_ = ZSTD_createDDict(data_->data(), data_->size());
+    if (ddict_ == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "Cannot prepare ZStd dictionary; Dictionary creation failed"));
+  }
+  *ddict = ddict_;
+
+  return Status::Ok();
+}
+
+Status ZStdDictionary::init(const void* data, uint64_t size) {
+  clear();
+  data_->reset_offset();
+  data_->reset_size();
+  return data_->write(data, size);
+}
+
+uint64_t ZStdDictionary::size() const {
+  return data_->size();
+}
+
+Status ZStdDictionary::train(
+    const Buffer* samples,
+    const std::vector<uint64_t>& sample_sizes,
+    uint64_t capacity) {
+  clear();
+  data_->reset_offset();
+  data_->reset_size();
+  if (samples->size() == 0 || capacity == 0)
+    return Status::Ok();
+
+  // Train the dictionary directly into its buffer
+  std::vector<size_t> sizes(sample_sizes.begin(), sample_sizes.end());
+  RETURN_NOT_OK(data_->realloc(capacity));
+  size_t ret = ZDICT_trainFromBuffer(
+      data_->data(),
+      capacity,
+      samples->data(),
+      sizes.data(),
+      (unsigned int)sizes.size());
+
+  // Training fails if there is not enough content to learn from
+  if (ZDICT_isError(ret) != 0)
+    return Status::Ok();
+  data_->set_size(ret);
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void ZStdDictionary::clear() {
+  for (auto& cdict : cdicts_)
+    ZSTD_freeCDict(cdict.second);
+  cdicts_.clear();
+  ZSTD_freeDDict(ddict_);
+  ddict_ = nullptr;
+}
+
+}  // namespace tiledb
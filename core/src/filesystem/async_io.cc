@@ -0,0 +1,539 @@
+/**
+ * @file   async_io.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class AsyncIO.
+ */
+
+#include "async_io.h"
+#include "constants.h"
+#include "logger.h"
+#include "posix_filesystem.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tiledb {
+
+#ifdef HAVE_IO_URING
+
+/** An io_uring instance along with its memory-mapped rings. */
+struct AsyncIO::Ring {
+  /** The io_uring file descriptor. */
+  int fd_;
+
+  /** The number of submission queue entries. */
+  unsigned int entries_;
+
+  /** The mapping of the submission queue ring. */
+  void* sq_ptr_;
+
+  /** The size of the submission queue ring mapping. */
+  size_t sq_size_;
+
+  /** The mapping of the completion queue ring (may equal `sq_ptr_`). */
+  void* cq_ptr_;
+
+  /** The size of the completion queue ring mapping. */
+  size_t cq_size_;
+
+  /** The submission queue entries. */
+  struct io_uring_sqe* sqes_;
+
+  /** The size of the submission queue entries mapping. */
+  size_t sqes_size_;
+
+  /* Pointers into the submission queue ring. */
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+
+  /* Pointers into the completion queue ring. */
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  struct io_uring_cqe* cqes_;
+};
+
+#else
+
+/** Placeholder for builds without io_uring support. */
+struct AsyncIO::Ring {
+  /** The number of submission queue entries. */
+  unsigned int entries_;
+};
+
+#endif
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+AsyncIO::AsyncIO() {
+  inflight_ = 0;
+  next_request_id_ = 1;
+  ring_ = nullptr;
+  ring_failed_ = false;
+  initialized_ = false;
+  thread_num_ = 0;
+  thread_pool_ = nullptr;
+}
+
+AsyncIO::~AsyncIO() {
+  if (ring_ != nullptr) {
+    bool joinable = ring_failed_;
+    if (!ring_failed_) {
+      // Wait for the requests in flight, and then wake up the completion
+      // thread with a no-op so that it terminates
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_.wait(lck, [this]() { return inflight_ == 0; });
+      joinable = ring_submit(0, nullptr).ok();
+    }
+    if (joinable)
+      completion_thread_.join();
+    else
+      completion_thread_.detach();
+    ring_destroy();
+  }
+
+  // This waits for the tasks of the thread pool
+  delete thread_pool_;
+
+  for (auto& request : requests_)
+    delete request.second;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status AsyncIO::init(bool use_io_uring, unsigned int thread_num) {
+  if (thread_num == 0)
+    return LOG_STATUS(Status::IOError(
+        "Cannot initialize asynchronous I/O; The number of threads must be "
+        "positive"));
+  thread_num_ = thread_num;
+
+  // Fall back to the thread pool if io_uring is not available. The pool is
+  // created upon the first request that needs it.
+  if (use_io_uring && ring_create(constants::async_io_queue_depth).ok())
+    completion_thread_ = std::thread(&AsyncIO::reap_completions, this);
+
+  initialized_ = true;
+  return Status::Ok();
+}
+
+Status AsyncIO::submit_read(
+    const std::shared_ptr<FileHandle>& handle,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* request_id) {
+  auto request = new Request();
+  request->done_ = false;
+  request->handle_ = handle;
+  request->in_ring_ = false;
+  request->iov_.iov_base = buffer;
+  request->iov_.iov_len = nbytes;
+  request->offset_ = offset;
+  request->write_ = false;
+
+  return submit(request, request_id);
+}
+
+Status AsyncIO::submit_task(
+    const std::function<Status()>& task, uint64_t* request_id) {
+  if (!initialized_)
+    return LOG_STATUS(Status::IOError(
+        "Cannot submit task; Asynchronous I/O is not initialized"));
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  RETURN_NOT_OK(create_thread_pool());
+
+  auto request = new Request();
+  request->done_ = false;
+  request->in_ring_ = false;
+  request->iov_.iov_base = nullptr;
+  request->iov_.iov_len = 0;
+  request->offset_ = 0;
+  request->write_ = false;
+
+  *request_id = register_request(request);
+  lck.unlock();
+
+  thread_pool_->enqueue([this, request, task]() {
+    Status st = task();
+    std::unique_lock<std::mutex> lck(mtx_);
+    finish(request, st);
+    return st;
+  });
+
+  return Status::Ok();
+}
+
+Status AsyncIO::submit_write(
+    const std::shared_ptr<FileHandle>& handle,
+    uint64_t offset,
+    const void* buffer,
+    uint64_t nbytes,
+    uint64_t* request_id) {
+  auto request = new Request();
+  request->done_ = false;
+  request->handle_ = handle;
+  request->in_ring_ = false;
+  request->iov_.iov_base = const_cast<void*>(buffer);
+  request->iov_.iov_len = nbytes;
+  request->offset_ = offset;
+  request->write_ = true;
+
+  return submit(request, request_id);
+}
+
+bool AsyncIO::uses_io_uring() const {
+  return ring_ != nullptr && !ring_failed_;
+}
+
+Status AsyncIO::wait(uint64_t request_id) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = requests_.find(request_id);
+  if (it == requests_.end())
+    return LOG_STATUS(
+        Status::IOError("Cannot wait for request; Unknown request id"));
+
+  auto request = it->second;
+  cv_.wait(lck, [request]() { return request->done_; });
+  Status st = request->st_;
+  requests_.erase(request_id);
+  delete request;
+
+  return st;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+Status AsyncIO::create_thread_pool() {
+  if (thread_pool_ != nullptr)
+    return Status::Ok();
+
+  // The requests block their threads in system calls, while their waiters
+  // may themselves be tasks of the storage manager pool (e.g., when fetching
+  // tiles concurrently). Queueing the requests behind their waiters in that
+  // pool could exhaust its threads and deadlock, hence the separate pool.
+  auto thread_pool = new ThreadPool();
+  Status st = thread_pool->init(thread_num_);
+  if (!st.ok()) {
+    delete thread_pool;
+    return st;
+  }
+  thread_pool_ = thread_pool;
+
+  return Status::Ok();
+}
+
+void AsyncIO::fail_inflight(const Status& st) {
+  for (auto& request : requests_) {
+    if (request.second->in_ring_ && !request.second->done_)
+      finish(request.second, st);
+  }
+  inflight_ = 0;
+}
+
+void AsyncIO::finish(Request* request, const Status& st) {
+  request->st_ = st;
+  request->done_ = true;
+  if (request->in_ring_)
+    --inflight_;
+  cv_.notify_all();
+}
+
+void AsyncIO::reap_completions() {
+#ifdef HAVE_IO_URING
+  for (;;) {
+    // Block until at least one request completes
+    int rc = (int)syscall(
+        __NR_io_uring_enter, ring_->fd_, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+    int err = errno;
+
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (rc < 0 && err != EINTR && err != EAGAIN) {
+      ring_failed_ = true;
+      fail_inflight(LOG_STATUS(Status::IOError(
+          std::string("Cannot complete request; ") + strerror(err))));
+      return;
+    }
+
+    bool terminate = false;
+    unsigned head = *ring_->cq_head_;
+    unsigned tail = __atomic_load_n(ring_->cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      auto cqe = &ring_->cqes_[head & *ring_->cq_mask_];
+      uint64_t request_id = cqe->user_data;
+      int res = cqe->res;
+      if (request_id == 0) {
+        terminate = true;
+        continue;
+      }
+
+      auto it = requests_.find(request_id);
+      if (it == requests_.end())
+        continue;
+      auto request = it->second;
+
+      if (res < 0) {
+        finish(
+            request,
+            LOG_STATUS(Status::IOError(
+                std::string(
+                    request->write_ ? "Cannot write to file; " :
+                                      "Cannot read from file; ") +
+                strerror(-res))));
+      } else if ((uint64_t)res >= request->iov_.iov_len) {
+        finish(request, Status::Ok());
+      } else if (res == 0) {
+        finish(
+            request,
+            LOG_STATUS(Status::IOError(
+                "Cannot read from file; Unexpected end of file")));
+      } else {
+        // Partial read or write - submit the rest
+        request->iov_.iov_base = (char*)request->iov_.iov_base + res;
+        request->iov_.iov_len -= res;
+        request->offset_ += res;
+        Status st = ring_submit(request_id, request);
+        if (!st.ok())
+          finish(request, st);
+      }
+    }
+    __atomic_store_n(ring_->cq_head_, head, __ATOMIC_RELEASE);
+
+    if (terminate)
+      return;
+  }
+#endif
+}
+
+uint64_t AsyncIO::register_request(Request* request) {
+  uint64_t request_id = next_request_id_++;
+  requests_[request_id] = request;
+  return request_id;
+}
+
+Status AsyncIO::ring_create(unsigned int entries) {
+#ifdef HAVE_IO_URING
+  struct io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+  if (fd < 0)
+    return Status::IOError(
+        std::string("Cannot create io_uring instance; ") + strerror(errno));
+
+  ring_ = new Ring();
+  ring_->fd_ = fd;
+  ring_->entries_ = params.sq_entries;
+  ring_->sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring_->cq_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  ring_->sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  // Map the rings, which may share a single mapping
+  bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+  single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+  if (single_mmap) {
+    if (ring_->cq_size_ > ring_->sq_size_)
+      ring_->sq_size_ = ring_->cq_size_;
+    ring_->cq_size_ = ring_->sq_size_;
+  }
+  int prot = PROT_READ | PROT_WRITE;
+  int flags = MAP_SHARED | MAP_POPULATE;
+  ring_->sq_ptr_ =
+      mmap(nullptr, ring_->sq_size_, prot, flags, fd, IORING_OFF_SQ_RING);
+  ring_->cq_ptr_ =
+      single_mmap ?
+          ring_->sq_ptr_ :
+          mmap(nullptr, ring_->cq_size_, prot, flags, fd, IORING_OFF_CQ_RING);
+  void* sqes =
+      mmap(nullptr, ring_->sqes_size_, prot, flags, fd, IORING_OFF_SQES);
+  ring_->sqes_ =
+      (sqes == MAP_FAILED) ? nullptr : static_cast<struct io_uring_sqe*>(sqes);
+  if (ring_->sq_ptr_ == MAP_FAILED || ring_->cq_ptr_ == MAP_FAILED ||
+      ring_->sqes_ == nullptr) {
+    ring_destroy();
+    return Status::IOError("Cannot create io_uring instance; Mapping error");
+  }
+
+  auto sq = static_cast<char*>(ring_->sq_ptr_);
+  ring_->sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  ring_->sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  ring_->sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  ring_->sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  auto cq = static_cast<char*>(ring_->cq_ptr_);
+  ring_->cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  ring_->cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  ring_->cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  ring_->cqes_ =
+      reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  return Status::Ok();
+#else
+  (void)entries;
+  return Status::IOError(
+      "Cannot create io_uring instance; TileDB was built without io_uring "
+      "support");
+#endif
+}
+
+void AsyncIO::ring_destroy() {
+#ifdef HAVE_IO_URING
+  if (ring_->sqes_ != nullptr)
+    munmap(ring_->sqes_, ring_->sqes_size_);
+  if (ring_->cq_ptr_ != MAP_FAILED && ring_->cq_ptr_ != ring_->sq_ptr_)
+    munmap(ring_->cq_ptr_, ring_->cq_size_);
+  if (ring_->sq_ptr_ != MAP_FAILED)
+    munmap(ring_->sq_ptr_, ring_->sq_size_);
+  close(ring_->fd_);
+#endif
+  delete ring_;
+  ring_ = nullptr;
+}
+
+Status AsyncIO::ring_submit(uint64_t request_id, Request* request) {
+#ifdef HAVE_IO_URING
+  // Fill in the next submission queue entry
+  unsigned tail = *ring_->sq_tail_;
+  unsigned index = tail & *ring_->sq_mask_;
+  auto sqe = &ring_->sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  if (request == nullptr) {
+    sqe->opcode = IORING_OP_NOP;
+  } else {
+    sqe->opcode = request->write_ ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = request->handle_->fd();
+    sqe->off = request->offset_;
+    sqe->addr = (uint64_t)(uintptr_t)&request->iov_;
+    sqe->len = 1;
+    request->in_ring_ = true;
+  }
+  sqe->user_data = request_id;
+  ring_->sq_array_[index] = index;
+  __atomic_store_n(ring_->sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  // Submit it
+  for (;;) {
+    int rc = (int)syscall(__NR_io_uring_enter, ring_->fd_, 1, 0, 0, NULL, 0);
+    if (rc >= 0)
+      return Status::Ok();
+    if (errno != EINTR && errno != EAGAIN)
+      break;
+  }
+
+  // Withdraw the entry if the kernel has not consumed it
+  int err = errno;
+  if (__atomic_load_n(ring_->sq_head_, __ATOMIC_ACQUIRE) == tail)
+    __atomic_store_n(ring_->sq_tail_, tail, __ATOMIC_RELEASE);
+  if (request != nullptr)
+    request->in_ring_ = false;
+  return LOG_STATUS(Status::IOError(
+      std::string("Cannot submit request to io_uring; ") + strerror(err)));
+#else
+  (void)request_id;
+  (void)request;
+  return LOG_STATUS(Status::IOError(
+      "Cannot submit request to io_uring; TileDB was built without io_uring "
+      "support"));
+#endif
+}
+
+Status AsyncIO::submit(Request* request, uint64_t* request_id) {
+  if (!initialized_) {
+    delete request;
+    return LOG_STATUS(Status::IOError(
+        "Cannot submit request; Asynchronous I/O is not initialized"));
+  }
+
+  std::unique_lock<std::mutex> lck(mtx_);
+
+  // Submit to io_uring, keeping at most as many requests in flight as the
+  // submission queue entries
+  if (ring_ != nullptr && !ring_failed_) {
+    cv_.wait(lck, [this]() {
+      return ring_failed_ || inflight_ < ring_->entries_;
+    });
+    if (!ring_failed_) {
+      Status st = ring_submit(next_request_id_, request);
+      if (!st.ok()) {
+        delete request;
+        return st;
+      }
+      *request_id = register_request(request);
+      ++inflight_;
+      return Status::Ok();
+    }
+  }
+
+  // Submit to the thread pool
+  Status st = create_thread_pool();
+  if (!st.ok()) {
+    delete request;
+    return st;
+  }
+  *request_id = register_request(request);
+  lck.unlock();
+  thread_pool_->enqueue([this, request]() {
+    int fd = request->handle_->fd();
+    Status st = request->write_ ?
+                    posix::write_to_file(
+                        fd,
+                        request->offset_,
+                        request->iov_.iov_base,
+                        request->iov_.iov_len) :
+                    posix::read_from_file(
+                        fd,
+                        request->offset_,
+                        request->iov_.iov_base,
+                        request->iov_.iov_len);
+    std::unique_lock<std::mutex> lck(mtx_);
+    finish(request, st);
+    return st;
+  });
+
+  return Status::Ok();
+}
+
+}  // namespace tiledb
@@ -0,0 +1,168 @@
+/**
+ * @file   file_handle_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FileHandleCache.
+ */
+
+#include "file_handle_cache.h"
+#include "posix_filesystem.h"
+
+#include <climits>
+
+namespace tiledb {
+
+/* ****************************** */
+/*           FileHandle           */
+/* ****************************** */
+
+FileHandle::FileHandle(int fd)
+    : fd_(fd) {
+}
+
+FileHandle::~FileHandle() {
+  posix::close_file(fd_);
+}
+
+int FileHandle::fd() const {
+  return fd_;
+}
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+FileHandleCache::FileHandleCache(uint64_t max_handles)
+    : max_handles_(max_handles) {
+}
+
+FileHandleCache::~FileHandleCache() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status FileHandleCache::get(
+    const std::string& path, int flags, std::shared_ptr<FileHandle>* handle) {
+  Key key(path, flags);
+
+  // Cache hit
+  std::shared_ptr<FileHandle> cached_handle;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      cached_handle = it->second->second;
+    }
+  }
+
+  // Revalidate the hit outside the lock, since the file may have been
+  // removed or replaced behind the back of the cache
+  if (cached_handle != nullptr) {
+    if (posix::is_same_file(cached_handle->fd(), path)) {
+      *handle = cached_handle;
+      return Status::Ok();
+    }
+
+    // Drop the stale handle, unless another thread already replaced it
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = index_.find(key);
+    if (it != index_.end() && it->second->second == cached_handle) {
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+  }
+
+  // Cache miss - open the file outside the lock
+  int fd;
+  RETURN_NOT_OK(posix::open_file(path, flags, &fd));
+  std::shared_ptr<FileHandle> new_handle(new FileHandle(fd));
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Another thread may have opened the same file in the meantime
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *handle = it->second->second;
+    return Status::Ok();
+  }
+
+  *handle = new_handle;
+  if (max_handles_ == 0)
+    return Status::Ok();
+
+  // Insert and evict the least recently used handles
+  entries_.emplace_front(key, new_handle);
+  index_[key] = entries_.begin();
+  while (entries_.size() > max_handles_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+
+  return Status::Ok();
+}
+
+void FileHandleCache::invalidate(const std::string& path) {
+  std::string prefix = path;
+  while (prefix.size() > 1 && prefix.back() == '/')
+    prefix.pop_back();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // All the paths that start with the prefix are consecutive in the index
+  auto it = index_.lower_bound(Key(prefix, INT_MIN));
+  while (it != index_.end() &&
+         it->first.first.compare(0, prefix.size(), prefix) == 0) {
+    const std::string& cached_path = it->first.first;
+    if (cached_path.size() == prefix.size() || prefix.back() == '/' ||
+        cached_path[prefix.size()] == '/') {
+      entries_.erase(it->second);
+      it = index_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FileHandleCache::release(const std::string& path, int flags) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = index_.find(Key(path, flags));
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+uint64_t FileHandleCache::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return entries_.size();
+}
+
+}  // namespace tiledb
@@ -36,12 +36,19 @@
 #include "utils.h"
 
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 
 #include <ftw.h>
 
 #include <fstream>
 #include <iostream>
 
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
 namespace tiledb {
 
 namespace posix {
@@ -229,6 +236,13 @@ bool is_file(const std::string& path) {
   return (stat(path.c_str(), &st) == 0) && !S_ISDIR(st.st_mode);
 }
 
+bool is_same_file(int fd, const std::string& path) {
+  struct stat fd_st = {};
+  struct stat path_st = {};
+  return fstat(fd, &fd_st) == 0 && stat(path.c_str(), &path_st) == 0 &&
+         fd_st.st_dev == path_st.st_dev && fd_st.st_ino == path_st.st_ino;
+}
+
 Status ls(const std::string& path, std::vector<std::string>* paths) {
   struct dirent* next_path = nullptr;
   DIR* dir = opendir(path.c_str());
@@ -311,6 +325,74 @@ void purge_dots_from_path(std::string* path) {
     *path += std::string("/") + t;
 }
 
+Status open_file(const std::string& path, int flags, int* fd) {
+  *fd = open(path.c_str(), flags, S_IRWXU);
+  if (*fd == -1) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot open file '") + path + "'; " + strerror(errno)));
+  }
+  return Status::Ok();
+}
+
+Status close_file(int fd) {
+  if (close(fd) != 0) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot close file; ") + strerror(errno)));
+  }
+  return Status::Ok();
+}
+
+Status map_file(int fd, uint64_t nbytes, void** data) {
+  *data = mmap(nullptr, nbytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (*data == MAP_FAILED) {
+    *data = nullptr;
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot map file; ") + strerror(errno)));
+  }
+  return Status::Ok();
+}
+
+Status unmap_file(void* data, uint64_t nbytes) {
+  if (munmap(data, nbytes) != 0) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot unmap file; ") + strerror(errno)));
+  }
+  return Status::Ok();
+}
+
+Status advise_mapped(void* data, uint64_t offset, uint64_t nbytes, int advice) {
+  // The advised range must start at a page boundary
+  static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+  uint64_t aligned_offset = offset - offset % page_size;
+  nbytes += offset - aligned_offset;
+  int rc = posix_madvise((char*)data + aligned_offset, nbytes, advice);
+  if (rc != 0) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot advise mapped file; ") + strerror(rc)));
+  }
+  return Status::Ok();
+}
+
+Status read_from_file(int fd, uint64_t offset, void* buffer, uint64_t nbytes) {
+  // Read in batches of constants::max_write_bytes bytes at a time, since
+  // pread may return fewer bytes than requested
+  auto buffer_c = static_cast<char*>(buffer);
+  while (nbytes > 0) {
+    uint64_t batch = MIN(nbytes, (uint64_t)constants::max_write_bytes);
+    ssize_t bytes_read = pread(fd, buffer_c, batch, offset);
+    if (bytes_read == -1 && errno == EINTR)
+      continue;
+    if (bytes_read <= 0) {
+      return LOG_STATUS(
+          Status::IOError("Cannot read from file; File reading error"));
+    }
+    buffer_c += bytes_read;
+    offset += bytes_read;
+    nbytes -= bytes_read;
+  }
+  return Status::Ok();
+}
+
 Status read_from_file(
     const std::string& path, uint64_t offset, void* buffer, uint64_t nbytes) {
   // Open file
@@ -320,9 +402,9 @@ Status read_from_file(
         Status::IOError("Cannot read from file; File opening error"));
   }
   // Read
-  lseek(fd, offset, SEEK_SET);
-  int64_t bytes_read = ::read(fd, buffer, nbytes);
-  if (bytes_read != int64_t(nbytes)) {
+  Status st = read_from_file(fd, offset, buffer, nbytes);
+  if (!st.ok()) {
+    close(fd);
     return LOG_STATUS(Status::IOError(
         std::string("Cannot read from file '") + path.c_str() +
         "'; File reading error"));
@@ -367,6 +449,46 @@ Status sync(const std::string& path) {
   return Status::Ok();
 }
 
+Status write_to_file(int fd, const void* buffer, uint64_t buffer_size) {
+  // Append data to the file in batches of constants::max_write_bytes
+  // bytes at a time
+  auto buffer_c = static_cast<const char*>(buffer);
+  while (buffer_size > 0) {
+    uint64_t batch = MIN(buffer_size, (uint64_t)constants::max_write_bytes);
+    ssize_t bytes_written = ::write(fd, buffer_c, batch);
+    if (bytes_written == -1 && errno == EINTR)
+      continue;
+    if (bytes_written <= 0) {
+      return LOG_STATUS(
+          Status::IOError("Cannot write to file; File writing error"));
+    }
+    buffer_c += bytes_written;
+    buffer_size -= bytes_written;
+  }
+  return Status::Ok();
+}
+
+Status write_to_file(
+    int fd, uint64_t offset, const void* buffer, uint64_t buffer_size) {
+  // Write in batches of constants::max_write_bytes bytes at a time, since
+  // pwrite may write fewer bytes than requested
+  auto buffer_c = static_cast<const char*>(buffer);
+  while (buffer_size > 0) {
+    uint64_t batch = MIN(buffer_size, (uint64_t)constants::max_write_bytes);
+    ssize_t bytes_written = pwrite(fd, buffer_c, batch, offset);
+    if (bytes_written == -1 && errno == EINTR)
+      continue;
+    if (bytes_written <= 0) {
+      return LOG_STATUS(
+          Status::IOError("Cannot write to file; File writing error"));
+    }
+    buffer_c += bytes_written;
+    offset += bytes_written;
+    buffer_size -= bytes_written;
+  }
+  return Status::Ok();
+}
+
 Status write_to_file(
     const std::string& path, const void* buffer, uint64_t buffer_size) {
   // Open file
@@ -377,20 +499,10 @@ Status write_to_file(
         "'; File opening error"));
   }
 
-  // Append data to the file in batches of constants::max_write_bytes
-  // bytes at a time
-  int64_t bytes_written;
-  while (buffer_size > constants::max_write_bytes) {
-    bytes_written = ::write(fd, buffer, constants::max_write_bytes);
-    if (bytes_written != constants::max_write_bytes) {
-      return LOG_STATUS(Status::IOError(
-          std::string("Cannot write to file '") + path +
-          "'; File writing error"));
-    }
-    buffer_size -= constants::max_write_bytes;
-  }
-  bytes_written = ::write(fd, buffer, buffer_size);
-  if (bytes_written != int64_t(buffer_size)) {
+  // Write
+  Status st = write_to_file(fd, buffer, buffer_size);
+  if (!st.ok()) {
+    close(fd);
     return LOG_STATUS(Status::IOError(
         std::string("Cannot write to file '") + path +
         "'; File writing error"));
@@ -31,10 +31,13 @@
  */
 
 #include "vfs.h"
+#include "constants.h"
 #include "hdfs_filesystem.h"
 #include "logger.h"
 #include "posix_filesystem.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <iostream>
 
 namespace tiledb {
@@ -43,13 +46,26 @@ namespace tiledb {
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
 
+/** The flags of the cached descriptors used in reads. */
+static const int read_flags = O_RDONLY;
+
+/** The flags of the cached descriptors used in writes. */
+static const int write_flags = O_WRONLY | O_APPEND | O_CREAT;
+
+/** The flags of the cached descriptors used in asynchronous writes. */
+static const int async_write_flags = O_WRONLY | O_CREAT;
+
 VFS::VFS() {
+  async_io_ = new AsyncIO();
+  handle_cache_ = new FileHandleCache(constants::vfs_max_open_files);
 #ifdef HAVE_HDFS
   Status st = hdfs::connect(hdfs_);
 #endif
 }
 
 VFS::~VFS() {
+  delete async_io_;
+  delete handle_cache_;
 #ifdef HAVE_HDFS
   if (hdfs_ != nullptr) {
     // Status st = hdfs::disconnect(hdfs_);
@@ -72,6 +88,7 @@ std::string VFS::abs_path(const std::string& path) {
 
 Status VFS::create_dir(const URI& uri) const {
   if (uri.is_posix()) {
+    handle_cache_->invalidate(uri.to_path());
     return posix::create_dir(uri.to_path());
   }
   if (uri.is_hdfs()) {
@@ -87,6 +104,7 @@ Status VFS::create_dir(const URI& uri) const {
 
 Status VFS::create_file(const URI& uri) const {
   if (uri.is_posix()) {
+    handle_cache_->invalidate(uri.to_path());
     return posix::create_file(uri.to_path());
   }
   if (uri.is_hdfs()) {
@@ -102,6 +120,7 @@ Status VFS::create_file(const URI& uri) const {
 
 Status VFS::remove_path(const URI& uri) const {
   if (uri.is_posix()) {
+    handle_cache_->invalidate(uri.to_path());
     return posix::remove_path(uri.to_path());
   } else if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
@@ -116,6 +135,7 @@ Status VFS::remove_path(const URI& uri) const {
 
 Status VFS::remove_file(const URI& uri) const {
   if (uri.is_posix()) {
+    handle_cache_->invalidate(uri.to_path());
     return posix::remove_file(uri.to_path());
   }
   if (uri.is_hdfs()) {
@@ -169,6 +189,58 @@ Status VFS::file_size(const URI& uri, uint64_t* size) const {
   return Status::VFSError("Unsupported URI scheme: " + uri.to_string());
 }
 
+Status VFS::init(const Config& config) {
+  delete handle_cache_;
+  handle_cache_ = new FileHandleCache(config.vfs_max_open_files());
+
+  delete async_io_;
+  async_io_ = new AsyncIO();
+  RETURN_NOT_OK(
+      async_io_->init(config.vfs_io_uring(), config.vfs_async_threads()));
+
+  return Status::Ok();
+}
+
+Status VFS::map_file(const URI& uri, uint64_t nbytes, void** data) const {
+  if (uri.is_posix()) {
+    std::shared_ptr<FileHandle> handle;
+    RETURN_NOT_OK(handle_cache_->get(uri.to_path(), read_flags, &handle));
+    return posix::map_file(handle->fd(), nbytes, data);
+  }
+  return Status::VFSError(
+      "Cannot map file; Memory mapping is not supported for URI " +
+      uri.to_string());
+}
+
+Status VFS::advise_mapped(
+    const URI& uri,
+    void* data,
+    uint64_t offset,
+    uint64_t nbytes,
+    MmapAdvice advice) const {
+  if (uri.is_posix()) {
+    int posix_advice = POSIX_MADV_NORMAL;
+    if (advice == MmapAdvice::SEQUENTIAL)
+      posix_advice = POSIX_MADV_SEQUENTIAL;
+    else if (advice == MmapAdvice::RANDOM)
+      posix_advice = POSIX_MADV_RANDOM;
+    else if (advice == MmapAdvice::WILLNEED)
+      posix_advice = POSIX_MADV_WILLNEED;
+    return posix::advise_mapped(data, offset, nbytes, posix_advice);
+  }
+  return Status::VFSError(
+      "Cannot advise mapped file; Memory mapping is not supported for URI " +
+      uri.to_string());
+}
+
+Status VFS::unmap_file(const URI& uri, void* data, uint64_t nbytes) const {
+  if (uri.is_posix())
+    return posix::unmap_file(data, nbytes);
+  return Status::VFSError(
+      "Cannot unmap file; Memory mapping is not supported for URI " +
+      uri.to_string());
+}
+
 bool VFS::is_dir(const URI& uri) const {
   if (uri.is_posix()) {
     return posix::is_dir(uri.to_path());
@@ -217,6 +289,11 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
 }
 
 Status VFS::move_path(const URI& old_uri, const URI& new_uri) {
+  if (old_uri.is_posix())
+    handle_cache_->invalidate(old_uri.to_path());
+  if (new_uri.is_posix())
+    handle_cache_->invalidate(new_uri.to_path());
+
   if (old_uri.is_posix()) {
     if (new_uri.is_posix()) {
       return posix::move_path(old_uri.to_path(), new_uri.to_path());
@@ -245,7 +322,16 @@ Status VFS::move_path(const URI& old_uri, const URI& new_uri) {
 Status VFS::read_from_file(
     const URI& uri, uint64_t offset, void* buffer, uint64_t nbytes) const {
   if (uri.is_posix()) {
-    return posix::read_from_file(uri.to_path(), offset, buffer, nbytes);
+    std::shared_ptr<FileHandle> handle;
+    RETURN_NOT_OK(handle_cache_->get(uri.to_path(), read_flags, &handle));
+    Status st = posix::read_from_file(handle->fd(), offset, buffer, nbytes);
+    if (!st.ok()) {
+      handle_cache_->release(uri.to_path(), read_flags);
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot read from file '") + uri.to_path() +
+          "'; File reading error"));
+    }
+    return st;
   }
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
@@ -257,8 +343,35 @@ Status VFS::read_from_file(
   return Status::VFSError("Unsupported URI schemes: " + uri.to_string());
 }
 
+Status VFS::read_from_file_async(
+    const URI& uri,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    uint64_t* request_id) const {
+  if (uri.is_posix()) {
+    std::shared_ptr<FileHandle> handle;
+    RETURN_NOT_OK(handle_cache_->get(uri.to_path(), read_flags, &handle));
+    return async_io_->submit_read(handle, offset, buffer, nbytes, request_id);
+  }
+  if (uri.is_hdfs()) {
+#ifdef HAVE_HDFS
+    return async_io_->submit_task(
+        [=]() { return read_from_file(uri, offset, buffer, nbytes); },
+        request_id);
+#else
+    return Status::VFSError("TileDB was built without HDFS support");
+#endif
+  }
+  return Status::VFSError("Unsupported URI schemes: " + uri.to_string());
+}
+
 Status VFS::sync(const URI& uri) const {
   if (uri.is_posix()) {
+    // The written data is synced below; the write descriptor is not needed
+    // any more
+    handle_cache_->release(uri.to_path(), write_flags);
+    handle_cache_->release(uri.to_path(), async_write_flags);
     return posix::sync(uri.to_path());
   }
   if (uri.is_hdfs()) {
@@ -274,7 +387,16 @@ Status VFS::sync(const URI& uri) const {
 Status VFS::write_to_file(
     const URI& uri, const void* buffer, uint64_t buffer_size) const {
   if (uri.is_posix()) {
-    return posix::write_to_file(uri.to_path(), buffer, buffer_size);
+    std::shared_ptr<FileHandle> handle;
+    RETURN_NOT_OK(handle_cache_->get(uri.to_path(), write_flags, &handle));
+    Status st = posix::write_to_file(handle->fd(), buffer, buffer_size);
+    if (!st.ok()) {
+      handle_cache_->release(uri.to_path(), write_flags);
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot write to file '") + uri.to_path() +
+          "'; File writing error"));
+    }
+    return st;
   }
   if (uri.is_hdfs()) {
 #ifdef HAVE_HDFS
@@ -286,4 +408,26 @@ Status VFS::write_to_file(
   return Status::VFSError("Unsupported URI schemes: " + uri.to_string());
 }
 
+Status VFS::wait_async(uint64_t request_id) const {
+  return async_io_->wait(request_id);
+}
+
+Status VFS::write_to_file_async(
+    const URI& uri,
+    uint64_t offset,
+    const void* buffer,
+    uint64_t buffer_size,
+    uint64_t* request_id) const {
+  if (uri.is_posix()) {
+    std::shared_ptr<FileHandle> handle;
+    RETURN_NOT_OK(
+        handle_cache_->get(uri.to_path(), async_write_flags, &handle));
+    return async_io_->submit_write(
+        handle, offset, buffer, buffer_size, request_id);
+  }
+  return Status::VFSError(
+      "Cannot write to file asynchronously; Unsupported URI scheme: " +
+      uri.to_string());
+}
+
 }  // namespace tiledb
@@ -180,6 +180,14 @@ Status Fragment::init(const URI& uri, FragmentMetadata* metadata) {
   metadata_ = metadata;
   dense_ = metadata_->dense();
 
+  // Load the metadata needed to read the query attributes and to evaluate
+  // the query predicates
+  std::vector<unsigned int> attribute_ids = query_->attribute_ids();
+  for (auto& predicate : query_->predicates())
+    attribute_ids.push_back(predicate.attribute_id());
+  RETURN_NOT_OK(
+      metadata_->load_sections(query_->storage_manager(), attribute_ids));
+
   read_state_ = new ReadState(this, query_, metadata_);
 
   // Success
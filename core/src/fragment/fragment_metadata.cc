@@ -34,6 +34,9 @@
 #include "fragment_metadata.h"
 #include "const_buffer.h"
 #include "logger.h"
+#include "storage_manager.h"
+#include "tile_io.h"
+#include "utils.h"
 
 #include <cassert>
 #include <iostream>
@@ -51,6 +54,15 @@ FragmentMetadata::FragmentMetadata(
     , fragment_uri_(fragment_uri) {
   domain_ = nullptr;
   non_empty_domain_ = nullptr;
+  sparse_tile_num_ = 0;
+  bounding_coords_ = new Buffer();
+  mbrs_.resize(2 * array_metadata_->dim_num());
+  for (auto& mbr_bounds : mbrs_)
+    mbr_bounds = new Buffer();
+  tile_stats_.resize(2 * array_metadata_->attribute_num());
+  for (auto& tile_stats : tile_stats_)
+    tile_stats = new Buffer();
+  tile_var_encoded_sizes_.resize(array_metadata_->attribute_num());
   std::memcpy(version_, constants::version, sizeof(version_));
 }
 
@@ -61,39 +73,121 @@ FragmentMetadata::~FragmentMetadata() {
   if (non_empty_domain_ != nullptr)
     std::free(non_empty_domain_);
 
-  auto mbr_num = (uint64_t)mbrs_.size();
-  for (int64_t i = 0; i < mbr_num; ++i)
-    if (mbrs_[i] != nullptr)
-      std::free(mbrs_[i]);
+  for (auto mbr_bounds : mbrs_)
+    delete mbr_bounds;
 
-  auto bounding_coords_num = (uint64_t)bounding_coords_.size();
-  for (int64_t i = 0; i < bounding_coords_num; ++i)
-    if (bounding_coords_[i] != nullptr)
-      std::free(bounding_coords_[i]);
+  for (auto tile_stats : tile_stats_)
+    delete tile_stats;
+
+  delete bounding_coords_;
+
+  for (auto dictionary : dictionaries_)
+    delete dictionary;
+
+  for (auto dictionary_var : dictionaries_var_)
+    delete dictionary_var;
 }
 
 /* ****************************** */
 /*             ACCESSORS          */
 /* ****************************** */
 
-void FragmentMetadata::append_bounding_coords(const void* bounding_coords) {
-  // For easy reference
-  uint64_t bounding_coords_size = 2 * array_metadata_->coords_size();
+Status FragmentMetadata::add_max_read_buffer_sizes(
+    StorageManager* storage_manager,
+    const void* subarray,
+    const std::vector<unsigned int>& attribute_ids,
+    uint64_t* buffer_sizes) {
+  // Only the attribute sections are needed for dense fragments
+  std::vector<unsigned int> section_ids;
+  for (auto attribute_id : attribute_ids) {
+    if (attribute_id < array_metadata_->attribute_num())
+      section_ids.push_back(attribute_id);
+  }
+  RETURN_NOT_OK(load_sections(storage_manager, section_ids));
+
+  // Invoke the proper templated function
+  Datatype coords_type = array_metadata_->coords_type();
+  if (dense_) {
+    if (coords_type == Datatype::INT32) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const int*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT64) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const int64_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT8) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const int8_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT8) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const uint8_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT16) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const int16_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT16) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const uint16_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT32) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const uint32_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT64) {
+      add_max_read_buffer_sizes_dense(
+          static_cast<const uint64_t*>(subarray), attribute_ids, buffer_sizes);
+    } else {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot compute read buffer sizes; Invalid coordinates type"));
+    }
+  } else {
+    if (coords_type == Datatype::INT32) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const int*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT64) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const int64_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::FLOAT32) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const float*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::FLOAT64) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const double*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT8) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const int8_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT8) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const uint8_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::INT16) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const int16_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT16) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const uint16_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT32) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const uint32_t*>(subarray), attribute_ids, buffer_sizes);
+    } else if (coords_type == Datatype::UINT64) {
+      add_max_read_buffer_sizes_sparse(
+          static_cast<const uint64_t*>(subarray), attribute_ids, buffer_sizes);
+    } else {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot compute read buffer sizes; Invalid coordinates type"));
+    }
+  }
 
-  // Copy and append MBR
-  void* new_bounding_coords = std::malloc(bounding_coords_size);
-  std::memcpy(new_bounding_coords, bounding_coords, bounding_coords_size);
-  bounding_coords_.push_back(new_bounding_coords);
+  return Status::Ok();
 }
 
-void FragmentMetadata::append_mbr(const void* mbr) {
-  // For easy reference
-  uint64_t mbr_size = 2 * array_metadata_->coords_size();
+void FragmentMetadata::append_bounding_coords(const void* bounding_coords) {
+  bounding_coords_->write(bounding_coords, 2 * array_metadata_->coords_size());
+}
 
-  // Copy and append MBR
-  void* new_mbr = std::malloc(mbr_size);
-  std::memcpy(new_mbr, mbr, mbr_size);
-  mbrs_.push_back(new_mbr);
+void FragmentMetadata::append_mbr(const void* mbr) {
+  // Append each bound to its column
+  uint64_t coord_size =
+      array_metadata_->coords_size() / array_metadata_->dim_num();
+  auto column_num = (unsigned int)mbrs_.size();
+  for (unsigned int i = 0; i < column_num; ++i)
+    mbrs_[i]->write((const char*)mbr + i * coord_size, coord_size);
+  ++sparse_tile_num_;
 }
 
 void FragmentMetadata::append_tile_offset(
@@ -116,8 +210,20 @@ void FragmentMetadata::append_tile_var_size(
   tile_var_sizes_[attribute_id].push_back(size);
 }
 
-const std::vector<void*>& FragmentMetadata::bounding_coords() const {
-  return bounding_coords_;
+void FragmentMetadata::append_tile_var_encoded_size(
+    unsigned int attribute_id, uint64_t size) {
+  tile_var_encoded_sizes_[attribute_id].push_back(size);
+}
+
+void FragmentMetadata::append_tile_stats(
+    unsigned int attribute_id, const void* min, const void* max) {
+  uint64_t type_size = array_metadata_->type_size(attribute_id);
+  tile_stats_[2 * attribute_id]->write(min, type_size);
+  tile_stats_[2 * attribute_id + 1]->write(max, type_size);
+}
+
+const void* FragmentMetadata::bounding_coords(uint64_t tile_pos) const {
+  return bounding_coords_->data(tile_pos * 2 * array_metadata_->coords_size());
 }
 
 uint64_t FragmentMetadata::cell_num(uint64_t tile_pos) const {
@@ -138,7 +244,7 @@ bool FragmentMetadata::dense() const {
 Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_version(buf));
   RETURN_NOT_OK(load_non_empty_domain(buf));
-  RETURN_NOT_OK(load_mbrs(buf));
+  RETURN_NOT_OK(load_mbrs_interleaved(buf));
   RETURN_NOT_OK(load_bounding_coords(buf));
   RETURN_NOT_OK(load_tile_offsets(buf));
   RETURN_NOT_OK(load_tile_var_offsets(buf));
@@ -146,10 +252,62 @@ Status FragmentMetadata::deserialize(ConstBuffer* buf) {
   RETURN_NOT_OK(load_last_tile_cell_num(buf));
   RETURN_NOT_OK(load_file_sizes(buf));
   RETURN_NOT_OK(load_file_var_sizes(buf));
+  RETURN_NOT_OK(load_dictionaries(buf));
+
+  // All the sections are loaded
+  section_loaded_.assign(section_num(), true);
 
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// version (int[3])
+// non_empty_domain_size (uint64_t) non_empty_domain (void*)
+// last_tile_cell_num (uint64_t)
+// file_sizes_attr#0 (uint64_t) ... file_sizes_attr#attribute_num (uint64_t)
+// file_var_sizes_attr#0 (uint64_t) ...
+//     file_var_sizes_attr#attribute_num (uint64_t)
+// sparse_tile_num (uint64_t)
+// section_num (uint64_t)
+// section_offset#0 (uint64_t) ... section_offset#<section_num-1> (uint64_t)
+Status FragmentMetadata::deserialize_footer(ConstBuffer* buf) {
+  unsigned int attribute_num = array_metadata_->attribute_num();
+
+  RETURN_NOT_OK(load_version(buf));
+  RETURN_NOT_OK(load_non_empty_domain(buf));
+  RETURN_NOT_OK(load_last_tile_cell_num(buf));
+  RETURN_NOT_OK(load_file_sizes(buf));
+  RETURN_NOT_OK(load_file_var_sizes(buf));
+  Status st = buf->read(&sparse_tile_num_, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tiles failed"));
+  }
+  RETURN_NOT_OK(load_section_offsets(buf));
+
+  // The sections are loaded on demand
+  tile_offsets_.resize(attribute_num + 1);
+  tile_var_offsets_.resize(attribute_num);
+  tile_var_sizes_.resize(attribute_num);
+  dictionaries_.resize(attribute_num, nullptr);
+  dictionaries_var_.resize(attribute_num, nullptr);
+  section_loaded_.assign(section_num(), false);
+
+  return Status::Ok();
+}
+
+ZStdDictionary* FragmentMetadata::dictionary(unsigned int attribute_id) const {
+  return (attribute_id < dictionaries_.size()) ? dictionaries_[attribute_id] :
+                                                 nullptr;
+}
+
+ZStdDictionary* FragmentMetadata::dictionary_var(
+    unsigned int attribute_id) const {
+  return (attribute_id < dictionaries_var_.size()) ?
+             dictionaries_var_[attribute_id] :
+             nullptr;
+}
+
 const void* FragmentMetadata::domain() const {
   return domain_;
 }
@@ -199,15 +357,23 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   for (unsigned int i = 0; i < attribute_num + 1; ++i)
     next_tile_offsets_[i] = 0;
 
-  // Initialize variable tile offsets
+  // Initialize variable tile offsets (the extra entry is the unused one
+  // of the coordinates, which is serialized along with the file sizes)
   tile_var_offsets_.resize(attribute_num);
-  next_tile_var_offsets_.resize(attribute_num);
-  for (unsigned int i = 0; i < attribute_num; ++i)
+  next_tile_var_offsets_.resize(attribute_num + 1);
+  for (unsigned int i = 0; i < attribute_num + 1; ++i)
     next_tile_var_offsets_[i] = 0;
 
   // Initialize variable tile sizes
   tile_var_sizes_.resize(attribute_num);
 
+  // Initialize dictionaries
+  dictionaries_.resize(attribute_num, nullptr);
+  dictionaries_var_.resize(attribute_num, nullptr);
+
+  // All the sections are in memory
+  section_loaded_.assign(section_num(), true);
+
   return Status::Ok();
 }
 
@@ -215,29 +381,117 @@ uint64_t FragmentMetadata::last_tile_cell_num() const {
   return last_tile_cell_num_;
 }
 
-const std::vector<void*>& FragmentMetadata::mbrs() const {
-  return mbrs_;
+Status FragmentMetadata::load_sections(
+    StorageManager* storage_manager,
+    const std::vector<unsigned int>& attribute_ids) {
+  unsigned int attribute_num = array_metadata_->attribute_num();
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto attribute_id : attribute_ids)
+    RETURN_NOT_OK(load_section(storage_manager, attribute_id));
+  if (!dense_) {
+    RETURN_NOT_OK(load_section(storage_manager, attribute_num));
+    RETURN_NOT_OK(load_section(storage_manager, attribute_num + 1));
+    RETURN_NOT_OK(load_section(storage_manager, attribute_num + 2));
+  }
+
+  return Status::Ok();
+}
+
+void FragmentMetadata::get_mbr(uint64_t tile_pos, void* mbr) const {
+  uint64_t coord_size =
+      array_metadata_->coords_size() / array_metadata_->dim_num();
+  auto column_num = (unsigned int)mbrs_.size();
+  for (unsigned int i = 0; i < column_num; ++i) {
+    std::memcpy(
+        (char*)mbr + i * coord_size,
+        mbrs_[i]->data(tile_pos * coord_size),
+        coord_size);
+  }
+}
+
+const void* FragmentMetadata::mbr_bounds(unsigned int dim, bool upper) const {
+  return mbrs_[2 * dim + (upper ? 1 : 0)]->data();
+}
+
+uint64_t FragmentMetadata::mbr_num() const {
+  uint64_t coord_size =
+      array_metadata_->coords_size() / array_metadata_->dim_num();
+  return mbrs_[0]->size() / coord_size;
 }
 
 const void* FragmentMetadata::non_empty_domain() const {
   return non_empty_domain_;
 }
 
-Status FragmentMetadata::serialize(Buffer* buf) {
+unsigned int FragmentMetadata::section_num() const {
+  return array_metadata_->attribute_num() + 3;
+}
+
+// ===== FORMAT =====
+// See deserialize_footer
+Status FragmentMetadata::serialize_footer(
+    const std::vector<uint64_t>& section_offsets, Buffer* buf) {
   RETURN_NOT_OK(write_version(buf));
   RETURN_NOT_OK(write_non_empty_domain(buf));
-  RETURN_NOT_OK(write_mbrs(buf));
-  RETURN_NOT_OK(write_bounding_coords(buf));
-  RETURN_NOT_OK(write_tile_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_offsets(buf));
-  RETURN_NOT_OK(write_tile_var_sizes(buf));
   RETURN_NOT_OK(write_last_tile_cell_num(buf));
   RETURN_NOT_OK(write_file_sizes(buf));
   RETURN_NOT_OK(write_file_var_sizes(buf));
+  Status st = buf->write(&sparse_tile_num_, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of tiles failed"));
+  }
+  RETURN_NOT_OK(write_section_offsets(section_offsets, buf));
 
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// Section attr#<i>, for i in [0, attribute_num):
+//     tile_offsets_attr#<i> tile_var_offsets_attr#<i>
+//     tile_var_sizes_attr#<i> dictionary_attr#<i> dictionary_var_attr#<i>
+//     tile_stats_attr#<i> tile_var_encoded_sizes_attr#<i>
+// Section attr#<attribute_num> (coordinates):
+//     tile_offsets_attr#<attribute_num>
+// Section attr#<attribute_num>+1: mbrs
+// Section attr#<attribute_num>+2: bounding_coords
+Status FragmentMetadata::serialize_section(unsigned int section, Buffer* buf) {
+  unsigned int attribute_num = array_metadata_->attribute_num();
+  assert(section < section_num());
+
+  if (section == attribute_num + 1)
+    return write_mbrs(buf);
+  if (section == attribute_num + 2)
+    return write_bounding_coords(buf);
+
+  RETURN_NOT_OK(write_tile_offsets(section, buf));
+  if (section == attribute_num)
+    return Status::Ok();
+  RETURN_NOT_OK(write_tile_var_offsets(section, buf));
+  RETURN_NOT_OK(write_tile_var_sizes(section, buf));
+  RETURN_NOT_OK(write_dictionary(dictionaries_[section], buf));
+  RETURN_NOT_OK(write_dictionary(dictionaries_var_[section], buf));
+  RETURN_NOT_OK(write_tile_stats(section, buf));
+  RETURN_NOT_OK(write_tile_var_encoded_sizes(section, buf));
+
+  return Status::Ok();
+}
+
+void FragmentMetadata::set_dictionary(
+    unsigned int attribute_id, ZStdDictionary* dictionary) {
+  assert(attribute_id < dictionaries_.size());
+  delete dictionaries_[attribute_id];
+  dictionaries_[attribute_id] = dictionary;
+}
+
+void FragmentMetadata::set_dictionary_var(
+    unsigned int attribute_id, ZStdDictionary* dictionary) {
+  assert(attribute_id < dictionaries_var_.size());
+  delete dictionaries_var_[attribute_id];
+  dictionaries_var_[attribute_id] = dictionary;
+}
+
 void FragmentMetadata::set_last_tile_cell_num(uint64_t cell_num) {
   last_tile_cell_num_ = cell_num;
 }
@@ -246,7 +500,7 @@ uint64_t FragmentMetadata::tile_num() const {
   if (dense_)
     return array_metadata_->domain()->tile_num(domain_);
 
-  return (uint64_t)mbrs_.size();
+  return sparse_tile_num_;
 }
 
 const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_offsets()
@@ -254,6 +508,16 @@ const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_offsets()
   return tile_offsets_;
 }
 
+const void* FragmentMetadata::tile_stats(
+    unsigned int attribute_id, bool upper) const {
+  return tile_stats_[2 * attribute_id + (upper ? 1 : 0)]->data();
+}
+
+uint64_t FragmentMetadata::tile_stats_num(unsigned int attribute_id) const {
+  return tile_stats_[2 * attribute_id]->size() /
+         array_metadata_->type_size(attribute_id);
+}
+
 const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_var_offsets()
     const {
   return tile_var_offsets_;
@@ -264,10 +528,155 @@ const std::vector<std::vector<uint64_t>>& FragmentMetadata::tile_var_sizes()
   return tile_var_sizes_;
 }
 
+const std::vector<std::vector<uint64_t>>&
+FragmentMetadata::tile_var_encoded_sizes() const {
+  return tile_var_encoded_sizes_;
+}
+
+const int* FragmentMetadata::version() const {
+  return version_;
+}
+
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
 
+template <class T>
+void FragmentMetadata::add_max_read_buffer_sizes_dense(
+    const T* subarray,
+    const std::vector<unsigned int>& attribute_ids,
+    uint64_t* buffer_sizes) const {
+  // For easy reference
+  unsigned int dim_num = array_metadata_->dim_num();
+  auto domain = array_metadata_->domain();
+  auto tile_extents = static_cast<const T*>(domain->tile_extents());
+  auto metadata_domain = static_cast<const T*>(domain_);
+  auto non_empty_domain = static_cast<const T*>(non_empty_domain_);
+  uint64_t tile_num = this->tile_num();
+
+  // Compute overlap of the subarray with the non-empty fragment domain
+  auto overlap = new T[2 * dim_num];
+  if (!domain->subarray_overlap(subarray, non_empty_domain, overlap)) {
+    delete[] overlap;
+    return;
+  }
+  uint64_t cell_num = utils::cell_num_in_subarray(overlap, dim_num);
+
+  // Compute the tile domain of the overlap, normalized to the fragment
+  // domain
+  auto tile_domain = new T[2 * dim_num];
+  auto tile_coords = new T[dim_num];
+  for (unsigned int i = 0; i < dim_num; ++i) {
+    tile_domain[2 * i] =
+        (overlap[2 * i] - metadata_domain[2 * i]) / tile_extents[i];
+    tile_domain[2 * i + 1] =
+        (overlap[2 * i + 1] - metadata_domain[2 * i]) / tile_extents[i];
+    tile_coords[i] = tile_domain[2 * i];
+  }
+
+  // Add the sizes of the cells in the overlap, and the sizes of the
+  // overlapping variable tiles
+  uint64_t b = 0;
+  for (auto attribute_id : attribute_ids) {
+    if (!array_metadata_->var_size(attribute_id)) {
+      buffer_sizes[b++] += cell_num * array_metadata_->cell_size(attribute_id);
+      continue;
+    }
+
+    buffer_sizes[b++] += cell_num * constants::cell_var_offset_size;
+    const auto& tile_var_sizes = tile_var_sizes_[attribute_id];
+    for (unsigned int i = 0; i < dim_num; ++i)
+      tile_coords[i] = tile_domain[2 * i];
+    for (;;) {
+      uint64_t pos = domain->get_tile_pos(metadata_domain, tile_coords);
+      if (pos < tile_num && pos < tile_var_sizes.size())
+        buffer_sizes[b] += tile_var_sizes[pos];
+
+      unsigned int i = 0;
+      for (; i < dim_num; ++i) {
+        if (tile_coords[i] < tile_domain[2 * i + 1]) {
+          ++tile_coords[i];
+          break;
+        }
+        tile_coords[i] = tile_domain[2 * i];
+      }
+      if (i == dim_num)
+        break;
+    }
+    ++b;
+  }
+
+  // Clean up
+  delete[] overlap;
+  delete[] tile_domain;
+  delete[] tile_coords;
+}
+
+template <class T>
+void FragmentMetadata::add_max_read_buffer_sizes_sparse(
+    const T* subarray,
+    const std::vector<unsigned int>& attribute_ids,
+    uint64_t* buffer_sizes) const {
+  // For easy reference
+  unsigned int dim_num = array_metadata_->dim_num();
+  uint64_t tile_num = this->tile_num();
+
+  // Find the tiles whose MBR overlaps the subarray
+  std::vector<uint8_t> overlaps(tile_num, 1);
+  for (unsigned int d = 0; d < dim_num; ++d) {
+    auto lows = static_cast<const T*>(mbr_bounds(d, false));
+    auto highs = static_cast<const T*>(mbr_bounds(d, true));
+    T low = subarray[2 * d];
+    T high = subarray[2 * d + 1];
+    for (uint64_t i = 0; i < tile_num; ++i)
+      overlaps[i] &= (uint8_t)((lows[i] <= high) & (highs[i] >= low));
+  }
+
+  // Add the sizes of all the cells of the overlapping tiles
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    if (!overlaps[i])
+      continue;
+    uint64_t cell_num = this->cell_num(i);
+    uint64_t b = 0;
+    for (auto attribute_id : attribute_ids) {
+      if (!array_metadata_->var_size(attribute_id)) {
+        buffer_sizes[b++] +=
+            cell_num * array_metadata_->cell_size(attribute_id);
+        continue;
+      }
+      buffer_sizes[b++] += cell_num * constants::cell_var_offset_size;
+      const auto& tile_var_sizes = tile_var_sizes_[attribute_id];
+      if (i < tile_var_sizes.size())
+        buffer_sizes[b] += tile_var_sizes[i];
+      ++b;
+    }
+  }
+}
+
+// ===== FORMAT =====
+// See serialize_section
+Status FragmentMetadata::deserialize_section(
+    unsigned int section, ConstBuffer* buff) {
+  unsigned int attribute_num = array_metadata_->attribute_num();
+
+  if (section == attribute_num + 1)
+    return load_mbrs(buff);
+  if (section == attribute_num + 2)
+    return load_bounding_coords(buff);
+
+  RETURN_NOT_OK(load_tile_offsets(section, buff));
+  if (section == attribute_num)
+    return Status::Ok();
+  RETURN_NOT_OK(load_tile_var_offsets(section, buff));
+  RETURN_NOT_OK(load_tile_var_sizes(section, buff));
+  RETURN_NOT_OK(load_dictionary(buff, &dictionaries_[section]));
+  RETURN_NOT_OK(load_dictionary(buff, &dictionaries_var_[section]));
+  RETURN_NOT_OK(load_tile_stats(section, buff));
+  RETURN_NOT_OK(load_tile_var_encoded_sizes(section, buff));
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 //  bounding_coords_num (uint64_t)
 //  bounding_coords_#1 (void*) bounding_coords_#2 (void*) ...
@@ -282,20 +691,79 @@ Status FragmentMetadata::load_bounding_coords(ConstBuffer* buff) {
         "Cannot load fragment metadata; Reading number of "
         "bounding coordinates failed"));
   }
+
   // Get bounding coordinates
-  void* bounding_coords;
-  bounding_coords_.resize(bounding_coords_num);
-  for (uint64_t i = 0; i < bounding_coords_num; ++i) {
-    bounding_coords = std::malloc(bounding_coords_size);
-    st = buff->read(bounding_coords, bounding_coords_size);
-    if (!st.ok()) {
-      std::free(bounding_coords);
-      return LOG_STATUS(
-          Status::FragmentMetadataError("Cannot load fragment metadata; "
-                                        "Reading bounding coordinates failed"));
-    }
-    bounding_coords_[i] = bounding_coords;
+  uint64_t nbytes = bounding_coords_num * bounding_coords_size;
+  bounding_coords_->reset_size();
+  bounding_coords_->reset_offset();
+  if (nbytes > buff->nbytes_left_to_read() ||
+      !bounding_coords_->write(buff, nbytes).ok()) {
+    return LOG_STATUS(
+        Status::FragmentMetadataError("Cannot load fragment metadata; "
+                                      "Reading bounding coordinates failed"));
+  }
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// dictionary_size_attr#0 (uint64_t) dictionary_attr#0 (void*)
+// ...
+// dictionary_size_attr#<attribute_num-1> (uint64_t)
+//     dictionary_attr#<attribute_num-1> (void*)
+// dictionary_var_size_attr#0 (uint64_t) dictionary_var_attr#0 (void*)
+// ...
+// dictionary_var_size_attr#<attribute_num-1> (uint64_t)
+//     dictionary_var_attr#<attribute_num-1> (void*)
+Status FragmentMetadata::load_dictionaries(ConstBuffer* buff) {
+  unsigned int attribute_num = array_metadata_->attribute_num();
+  dictionaries_.resize(attribute_num, nullptr);
+  dictionaries_var_.resize(attribute_num, nullptr);
+
+  // The fragments of earlier versions have no dictionaries
+  if (buff->end())
+    return Status::Ok();
+
+  for (unsigned int i = 0; i < attribute_num; ++i)
+    RETURN_NOT_OK(load_dictionary(buff, &dictionaries_[i]));
+  for (unsigned int i = 0; i < attribute_num; ++i)
+    RETURN_NOT_OK(load_dictionary(buff, &dictionaries_var_[i]));
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// dictionary_size (uint64_t) dictionary (void*)
+Status FragmentMetadata::load_dictionary(
+    ConstBuffer* buff, ZStdDictionary** dictionary) {
+  // Get dictionary size
+  uint64_t dictionary_size;
+  Status st = buff->read(&dictionary_size, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading dictionary size failed"));
+  }
+
+  if (dictionary_size == 0)
+    return Status::Ok();
+
+  // Get dictionary
+  if (dictionary_size > buff->nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading dictionary failed"));
   }
+  auto new_dictionary = new ZStdDictionary();
+  st = new_dictionary->init(
+      (const char*)buff->data() + buff->offset(), dictionary_size);
+  if (!st.ok()) {
+    delete new_dictionary;
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading dictionary failed"));
+  }
+  buff->advance_offset(dictionary_size);
+  delete *dictionary;
+  *dictionary = new_dictionary;
+
   return Status::Ok();
 }
 
@@ -349,9 +817,10 @@ Status FragmentMetadata::load_last_tile_cell_num(ConstBuffer* buff) {
 
 // ===== FORMAT =====
 // mbr_num (uint64_t)
-// mbr_#1 (void*)
-// mbr_#2 (void*)
+// mbr_low_dim#0_#1 (void*) mbr_low_dim#0_#2 (void*) ...
+// mbr_high_dim#0_#1 (void*) mbr_high_dim#0_#2 (void*) ...
 // ...
+// mbr_high_dim#<dim_num-1>_#1 (void*) mbr_high_dim#<dim_num-1>_#2 (void*) ...
 Status FragmentMetadata::load_mbrs(ConstBuffer* buff) {
   // Get number of MBRs
   uint64_t mbr_num = 0;
@@ -361,20 +830,56 @@ Status FragmentMetadata::load_mbrs(ConstBuffer* buff) {
         "Cannot load fragment metadata; Reading number of MBRs failed"));
   }
 
-  // Get MBRs
-  uint64_t mbr_size = 2 * array_metadata_->coords_size();
-  void* mbr = nullptr;
-  mbrs_.resize(mbr_num);
-  for (uint64_t i = 0; i < mbr_num; ++i) {
-    mbr = std::malloc(mbr_size);
-    st = buff->read(mbr, mbr_size);
-    if (!st.ok()) {
-      std::free(mbr);
+  // Get MBRs, one column at a time
+  uint64_t coord_size =
+      array_metadata_->coords_size() / array_metadata_->dim_num();
+  uint64_t nbytes = mbr_num * coord_size;
+  for (auto mbr_bounds : mbrs_) {
+    mbr_bounds->reset_size();
+    mbr_bounds->reset_offset();
+    if (nbytes > buff->nbytes_left_to_read() ||
+        !mbr_bounds->write(buff, nbytes).ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading MBR failed"));
+          "Cannot load fragment metadata; Reading MBRs failed"));
     }
-    mbrs_[i] = mbr;
   }
+  sparse_tile_num_ = mbr_num;
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// mbr_num (uint64_t)
+// mbr_#1 (void*)
+// mbr_#2 (void*)
+// ...
+Status FragmentMetadata::load_mbrs_interleaved(ConstBuffer* buff) {
+  // Get number of MBRs
+  uint64_t mbr_num = 0;
+  Status st = buff->read(&mbr_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of MBRs failed"));
+  }
+
+  // Get MBRs, distributing their bounds to the columns
+  uint64_t coord_size =
+      array_metadata_->coords_size() / array_metadata_->dim_num();
+  if (mbr_num * mbrs_.size() * coord_size > buff->nbytes_left_to_read()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading MBR failed"));
+  }
+  for (auto mbr_bounds : mbrs_) {
+    mbr_bounds->reset_size();
+    mbr_bounds->reset_offset();
+    RETURN_NOT_OK(mbr_bounds->realloc(mbr_num * coord_size));
+  }
+  for (uint64_t i = 0; i < mbr_num; ++i) {
+    for (auto mbr_bounds : mbrs_)
+      RETURN_NOT_OK(mbr_bounds->write(buff, coord_size));
+  }
+  sparse_tile_num_ = mbr_num;
+
   return Status::Ok();
 }
 
@@ -415,6 +920,58 @@ Status FragmentMetadata::load_non_empty_domain(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_section(
+    StorageManager* storage_manager, unsigned int section) {
+  assert(section < section_loaded_.size());
+  if (section_loaded_[section])
+    return Status::Ok();
+
+  // Read from file
+  URI fragment_metadata_uri = fragment_uri_.join_path(
+      std::string(constants::fragment_metadata_filename));
+  auto tile = (Tile*)nullptr;
+  auto tile_io = new TileIO(storage_manager, fragment_metadata_uri);
+  RETURN_NOT_OK_ELSE(
+      tile_io->read_generic(&tile, section_offsets_[section]), delete tile_io);
+
+  // Deserialize
+  tile->reset_offset();
+  auto cbuff = new ConstBuffer(tile->buffer());
+  Status st = deserialize_section(section, cbuff);
+
+  delete cbuff;
+  delete tile;
+  delete tile_io;
+
+  if (st.ok())
+    section_loaded_[section] = true;
+
+  return st;
+}
+
+// ===== FORMAT =====
+// section_num (uint64_t)
+// section_offset#0 (uint64_t) ... section_offset#<section_num-1> (uint64_t)
+Status FragmentMetadata::load_section_offsets(ConstBuffer* buff) {
+  // Get number of sections
+  uint64_t section_num = 0;
+  Status st = buff->read(&section_num, sizeof(uint64_t));
+  if (!st.ok() || section_num != this->section_num()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of sections failed"));
+  }
+
+  // Get section offsets
+  section_offsets_.resize(section_num);
+  st = buff->read(&section_offsets_[0], section_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading section offsets failed"));
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // tile_offsets_attr#0_num (uint64_t)
 // tile_offsets_attr#0_#1 (uint64_t) tile_offsets_attr#0_#2 (uint64_t) ...
@@ -423,34 +980,116 @@ Status FragmentMetadata::load_non_empty_domain(ConstBuffer* buff) {
 // tile_offsets_attr#<attribute_num>_#1 (uint64_t)
 // tile_offsets_attr#<attribute_num>_#2 (uint64_t) ...
 Status FragmentMetadata::load_tile_offsets(ConstBuffer* buff) {
-  Status st;
-  uint64_t tile_offsets_num = 0;
   unsigned int attribute_num = array_metadata_->attribute_num();
 
   // Allocate tile offsets
   tile_offsets_.resize(attribute_num + 1);
 
   // For all attributes, get the tile offsets
-  for (unsigned int i = 0; i < attribute_num + 1; ++i) {
-    // Get number of tile offsets
-    st = buff->read(&tile_offsets_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading number of tile offsets "
-          "failed"));
-    }
+  for (unsigned int i = 0; i < attribute_num + 1; ++i)
+    RETURN_NOT_OK(load_tile_offsets(i, buff));
 
-    if (tile_offsets_num == 0)
-      continue;
+  return Status::Ok();
+}
 
-    // Get tile offsets
-    tile_offsets_[i].resize(tile_offsets_num);
-    st = buff->read(&tile_offsets_[i][0], tile_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
+// ===== FORMAT =====
+// tile_offsets_num (uint64_t)
+// tile_offsets_#1 (uint64_t) tile_offsets_#2 (uint64_t) ...
+Status FragmentMetadata::load_tile_offsets(
+    unsigned int attribute_id, ConstBuffer* buff) {
+  // Get number of tile offsets
+  uint64_t tile_offsets_num = 0;
+  Status st = buff->read(&tile_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tile offsets "
+        "failed"));
+  }
+
+  if (tile_offsets_num == 0)
+    return Status::Ok();
+
+  // Get tile offsets
+  auto& tile_offsets = tile_offsets_[attribute_id];
+  tile_offsets.resize(tile_offsets_num);
+  st = buff->read(&tile_offsets[0], tile_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading tile offsets failed"));
+  }
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// tile_stats_num (uint64_t)
+// tile_stats_min_#1 (void*) tile_stats_min_#2 (void*) ...
+// tile_stats_max_#1 (void*) tile_stats_max_#2 (void*) ...
+Status FragmentMetadata::load_tile_stats(
+    unsigned int attribute_id, ConstBuffer* buff) {
+  // The fragments of earlier versions have no statistics
+  if (buff->end())
+    return Status::Ok();
+
+  // Get number of tile statistics
+  uint64_t tile_stats_num = 0;
+  Status st = buff->read(&tile_stats_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tile statistics "
+        "failed"));
+  }
+
+  // Get the minimum and then the maximum values
+  uint64_t nbytes = tile_stats_num * array_metadata_->type_size(attribute_id);
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto tile_stats = tile_stats_[2 * attribute_id + i];
+    tile_stats->reset_size();
+    tile_stats->reset_offset();
+    if (nbytes > buff->nbytes_left_to_read() ||
+        !tile_stats->write(buff, nbytes).ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading tile offsets failed"));
+          "Cannot load fragment metadata; Reading tile statistics failed"));
     }
   }
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// tile_var_encoded_sizes_num (uint64_t)
+// tile_var_encoded_sizes_#1 (uint64_t) tile_var_encoded_sizes_#2 (uint64_t)
+// ...
+Status FragmentMetadata::load_tile_var_encoded_sizes(
+    unsigned int attribute_id, ConstBuffer* buff) {
+  // The earlier fragments have no encoded sizes
+  if (buff->end())
+    return Status::Ok();
+
+  // Get number of encoded sizes
+  uint64_t tile_var_encoded_sizes_num = 0;
+  Status st = buff->read(&tile_var_encoded_sizes_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of encoded variable "
+        "tile sizes failed"));
+  }
+
+  if (tile_var_encoded_sizes_num == 0)
+    return Status::Ok();
+
+  // Get encoded sizes
+  auto& tile_var_encoded_sizes = tile_var_encoded_sizes_[attribute_id];
+  tile_var_encoded_sizes.resize(tile_var_encoded_sizes_num);
+  st = buff->read(
+      &tile_var_encoded_sizes[0],
+      tile_var_encoded_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading encoded variable tile sizes "
+        "failed"));
+  }
+
   return Status::Ok();
 }
 
@@ -463,36 +1102,46 @@ Status FragmentMetadata::load_tile_offsets(ConstBuffer* buff) {
 // tile_var_offsets_attr#<attribute_num-1>_#1 (uint64_t)
 //     tile_ver_offsets_attr#<attribute_num-1>_#2 (uint64_t) ...
 Status FragmentMetadata::load_tile_var_offsets(ConstBuffer* buff) {
-  Status st;
   unsigned int attribute_num = array_metadata_->attribute_num();
-  uint64_t tile_var_offsets_num = 0;
 
   // Allocate tile offsets
   tile_var_offsets_.resize(attribute_num);
 
   // For all attributes, get the variable tile offsets
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Get number of tile offsets
-    st = buff->read(&tile_var_offsets_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading number of variable tile "
-          "offsets failed"));
-    }
+  for (unsigned int i = 0; i < attribute_num; ++i)
+    RETURN_NOT_OK(load_tile_var_offsets(i, buff));
 
-    if (tile_var_offsets_num == 0)
-      continue;
+  return Status::Ok();
+}
 
-    // Get variable tile offsets
-    tile_var_offsets_[i].resize(tile_var_offsets_num);
-    st = buff->read(
-        &tile_var_offsets_[i][0], tile_var_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading variable tile offsets "
-          "failed"));
-    }
+// ===== FORMAT =====
+// tile_var_offsets_num (uint64_t)
+// tile_var_offsets_#1 (uint64_t) tile_var_offsets_#2 (uint64_t) ...
+Status FragmentMetadata::load_tile_var_offsets(
+    unsigned int attribute_id, ConstBuffer* buff) {
+  // Get number of tile offsets
+  uint64_t tile_var_offsets_num = 0;
+  Status st = buff->read(&tile_var_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "offsets failed"));
   }
+
+  if (tile_var_offsets_num == 0)
+    return Status::Ok();
+
+  // Get variable tile offsets
+  auto& tile_var_offsets = tile_var_offsets_[attribute_id];
+  tile_var_offsets.resize(tile_var_offsets_num);
+  st = buff->read(
+      &tile_var_offsets[0], tile_var_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile offsets "
+        "failed"));
+  }
+
   return Status::Ok();
 }
 
@@ -504,35 +1153,44 @@ Status FragmentMetadata::load_tile_var_offsets(ConstBuffer* buff) {
 // tile_var_sizes__attr#<attribute_num-1>_#1 (uint64_t)
 //     tile_var_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
 Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
-  Status st;
   unsigned int attribute_num = array_metadata_->attribute_num();
-  uint64_t tile_var_sizes_num = 0;
 
   // Allocate tile sizes
   tile_var_sizes_.resize(attribute_num);
 
   // For all attributes, get the variable tile sizes
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Get number of tile sizes
-    st = buff->read(&tile_var_sizes_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading number of variable tile "
-          "sizes failed"));
-    }
+  for (unsigned int i = 0; i < attribute_num; ++i)
+    RETURN_NOT_OK(load_tile_var_sizes(i, buff));
 
-    if (tile_var_sizes_num == 0)
-      continue;
+  return Status::Ok();
+}
 
-    // Get variable tile sizes
-    tile_var_sizes_[i].resize(tile_var_sizes_num);
-    st = buff->read(
-        &tile_var_sizes_[i][0], tile_var_sizes_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot load fragment metadata; Reading variable tile sizes failed"));
-    }
+// ===== FORMAT =====
+// tile_var_sizes_num (uint64_t)
+// tile_var_sizes_#1 (uint64_t) tile_var_sizes_#2 (uint64_t) ...
+Status FragmentMetadata::load_tile_var_sizes(
+    unsigned int attribute_id, ConstBuffer* buff) {
+  // Get number of tile sizes
+  uint64_t tile_var_sizes_num = 0;
+  Status st = buff->read(&tile_var_sizes_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of variable tile "
+        "sizes failed"));
+  }
+
+  if (tile_var_sizes_num == 0)
+    return Status::Ok();
+
+  // Get variable tile sizes
+  auto& tile_var_sizes = tile_var_sizes_[attribute_id];
+  tile_var_sizes.resize(tile_var_sizes_num);
+  st = buff->read(&tile_var_sizes[0], tile_var_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading variable tile sizes failed"));
   }
+
   return Status::Ok();
 }
 
@@ -549,7 +1207,8 @@ Status FragmentMetadata::load_version(ConstBuffer* buff) {
 Status FragmentMetadata::write_bounding_coords(Buffer* buff) {
   Status st;
   uint64_t bounding_coords_size = 2 * array_metadata_->coords_size();
-  auto bounding_coords_num = (uint64_t)bounding_coords_.size();
+  uint64_t bounding_coords_num =
+      bounding_coords_->size() / bounding_coords_size;
   // Write number of bounding coordinates
   st = buff->write(&bounding_coords_num, sizeof(uint64_t));
   if (!st.ok()) {
@@ -559,17 +1218,40 @@ Status FragmentMetadata::write_bounding_coords(Buffer* buff) {
   }
 
   // Write bounding coordinates
-  for (uint64_t i = 0; i < bounding_coords_num; ++i) {
-    st = buff->write(bounding_coords_[i], bounding_coords_size);
-    if (!st.ok()) {
-      return LOG_STATUS(
-          Status::FragmentMetadataError("Cannot serialize fragment metadata; "
-                                        "Writing bounding coordinates failed"));
-    }
+  st = buff->write(bounding_coords_->data(), bounding_coords_->size());
+  if (!st.ok()) {
+    return LOG_STATUS(
+        Status::FragmentMetadataError("Cannot serialize fragment metadata; "
+                                      "Writing bounding coordinates failed"));
   }
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// dictionary_size (uint64_t) dictionary (void*)
+Status FragmentMetadata::write_dictionary(
+    const ZStdDictionary* dictionary, Buffer* buff) {
+  // Write dictionary size
+  uint64_t dictionary_size = (dictionary == nullptr) ? 0 : dictionary->size();
+  Status st = buff->write(&dictionary_size, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing dictionary size failed"));
+  }
+
+  if (dictionary_size == 0)
+    return Status::Ok();
+
+  // Write dictionary
+  st = buff->write(dictionary->data(), dictionary_size);
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing dictionary failed"));
+  }
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 // file_sizes_attr#0 (uint64_t)
 // ...
@@ -621,12 +1303,10 @@ Status FragmentMetadata::write_last_tile_cell_num(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// mbr_num(uint64_t)
-// mbr_#1(void*) mbr_#2(void*) ...
+// See load_mbrs
 Status FragmentMetadata::write_mbrs(Buffer* buff) {
   Status st;
-  uint64_t mbr_size = 2 * array_metadata_->coords_size();
-  uint64_t mbr_num = mbrs_.size();
+  uint64_t mbr_num = this->mbr_num();
 
   // Write number of MBRs
   st = buff->write(&mbr_num, sizeof(uint64_t));
@@ -635,9 +1315,9 @@ Status FragmentMetadata::write_mbrs(Buffer* buff) {
         "Cannot serialize fragment metadata; Writing number of MBRs failed"));
   }
 
-  // Write MBRs
-  for (uint64_t i = 0; i < mbr_num; ++i) {
-    st = buff->write(mbrs_[i], mbr_size);
+  // Write MBRs, one column at a time
+  for (auto mbr_bounds : mbrs_) {
+    st = buff->write(mbr_bounds->data(), mbr_bounds->size());
     if (!st.ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
           "Cannot serialize fragment metadata; Writing MBR failed"));
@@ -673,114 +1353,174 @@ Status FragmentMetadata::write_non_empty_domain(Buffer* buff) {
 }
 
 // ===== FORMAT =====
-// tile_offsets_attr#0_num(uint64_t)
-// tile_offsets_attr#0_#1 (uint64_t) tile_offsets_attr#0_#2 (uint64_t) ...
-// ...
-// tile_offsets_attr#<attribute_num>_num(uint64_t)
-// tile_offsets_attr#<attribute_num>_#1 (uint64_t)
-// tile_offsets_attr#<attribute_num>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_offsets(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_metadata_->attribute_num();
+// section_num (uint64_t)
+// section_offset#0 (uint64_t) ... section_offset#<section_num-1> (uint64_t)
+Status FragmentMetadata::write_section_offsets(
+    const std::vector<uint64_t>& section_offsets, Buffer* buff) {
+  // Write number of sections
+  uint64_t section_num = section_offsets.size();
+  Status st = buff->write(&section_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of sections "
+        "failed"));
+  }
 
-  // Write tile offsets for each attribute
-  for (unsigned int i = 0; i < attribute_num + 1; ++i) {
-    // Write number of tile offsets
-    uint64_t tile_offsets_num = tile_offsets_[i].size();
-    st = buff->write(&tile_offsets_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of tile offsets "
-          "failed"));
-    }
+  // Write section offsets
+  st = buff->write(&section_offsets[0], section_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing section offsets failed"));
+  }
 
-    if (tile_offsets_num == 0)
-      continue;
+  return Status::Ok();
+}
 
-    // Write tile offsets
-    st = buff->write(&tile_offsets_[i][0], tile_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing tile offsets failed"));
-    }
+// ===== FORMAT =====
+// tile_offsets_num (uint64_t)
+// tile_offsets_#1 (uint64_t) tile_offsets_#2 (uint64_t) ...
+Status FragmentMetadata::write_tile_offsets(
+    unsigned int attribute_id, Buffer* buff) {
+  auto& tile_offsets = tile_offsets_[attribute_id];
+
+  // Write number of tile offsets
+  uint64_t tile_offsets_num = tile_offsets.size();
+  Status st = buff->write(&tile_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of tile offsets "
+        "failed"));
+  }
+
+  if (tile_offsets_num == 0)
+    return Status::Ok();
+
+  // Write tile offsets
+  st = buff->write(&tile_offsets[0], tile_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing tile offsets failed"));
   }
 
   return Status::Ok();
 }
 
 // ===== FORMAT =====
-// tile_var_offsets_attr#0_num(uint64_t)
-// tile_var_offsets_attr#0_#1 (uint64_t) tile_var_offsets_attr#0_#2 (uint64_t)
-// ...
-// ...
-// tile_var_offsets_attr#<attribute_num-1>_num(uint64_t)
-// tile_var_offsets_attr#<attribute_num-1>_#1 (uint64_t)
-//     tile_var_offsets_attr#<attribute_num-1>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_var_offsets(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_metadata_->attribute_num();
+// See load_tile_stats
+Status FragmentMetadata::write_tile_stats(
+    unsigned int attribute_id, Buffer* buff) {
+  // Write number of tile statistics
+  uint64_t tile_stats_num = this->tile_stats_num(attribute_id);
+  Status st = buff->write(&tile_stats_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of tile "
+        "statistics failed"));
+  }
 
-  // Write tile offsets for each attribute
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of offsets
-    uint64_t tile_var_offsets_num = tile_var_offsets_[i].size();
-    st = buff->write(&tile_var_offsets_num, sizeof(uint64_t));
+  // Write the minimum and then the maximum values
+  for (unsigned int i = 0; i < 2; ++i) {
+    auto tile_stats = tile_stats_[2 * attribute_id + i];
+    st = buff->write(tile_stats->data(), tile_stats->size());
     if (!st.ok()) {
       return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of "
-          "variable tile offsets failed"));
+          "Cannot serialize fragment metadata; Writing tile statistics "
+          "failed"));
     }
+  }
 
-    if (tile_var_offsets_num == 0)
-      continue;
+  return Status::Ok();
+}
 
-    // Write tile offsets
-    st = buff->write(
-        &tile_var_offsets_[i][0], tile_var_offsets_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing "
-          "variable tile offsets failed"));
-    }
+// ===== FORMAT =====
+// See load_tile_var_encoded_sizes
+Status FragmentMetadata::write_tile_var_encoded_sizes(
+    unsigned int attribute_id, Buffer* buff) {
+  auto& tile_var_encoded_sizes = tile_var_encoded_sizes_[attribute_id];
+
+  // Write number of encoded sizes
+  uint64_t tile_var_encoded_sizes_num = tile_var_encoded_sizes.size();
+  Status st = buff->write(&tile_var_encoded_sizes_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of encoded "
+        "variable tile sizes failed"));
+  }
+
+  if (tile_var_encoded_sizes_num == 0)
+    return Status::Ok();
+
+  // Write encoded sizes
+  st = buff->write(
+      &tile_var_encoded_sizes[0],
+      tile_var_encoded_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing encoded variable tile "
+        "sizes failed"));
   }
 
   return Status::Ok();
 }
 
 // ===== FORMAT =====
-// tile_var_sizes_attr#0_num(uint64_t)
-// tile_var_sizes_attr#0_#1 (uint64_t) tile_sizes_attr#0_#2 (uint64_t) ...
-// ...
-// tile_var_sizes_attr#<attribute_num-1>_num(uint64_t)
-// tile_var_sizes__attr#<attribute_num-1>_#1(uint64_t)
-//     tile_var_sizes_attr#<attribute_num-1>_#2 (uint64_t) ...
-Status FragmentMetadata::write_tile_var_sizes(Buffer* buff) {
-  Status st;
-  unsigned int attribute_num = array_metadata_->attribute_num();
+// tile_var_offsets_num (uint64_t)
+// tile_var_offsets_#1 (uint64_t) tile_var_offsets_#2 (uint64_t) ...
+Status FragmentMetadata::write_tile_var_offsets(
+    unsigned int attribute_id, Buffer* buff) {
+  auto& tile_var_offsets = tile_var_offsets_[attribute_id];
+
+  // Write number of offsets
+  uint64_t tile_var_offsets_num = tile_var_offsets.size();
+  Status st = buff->write(&tile_var_offsets_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of "
+        "variable tile offsets failed"));
+  }
 
-  // Write tile sizes for each attribute
-  for (unsigned int i = 0; i < attribute_num; ++i) {
-    // Write number of sizes
-    uint64_t tile_var_sizes_num = tile_var_sizes_[i].size();
-    st = buff->write(&tile_var_sizes_num, sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(Status::FragmentMetadataError(
-          "Cannot serialize fragment metadata; Writing number of "
-          "variable tile sizes failed"));
-    }
+  if (tile_var_offsets_num == 0)
+    return Status::Ok();
 
-    if (tile_var_sizes_num == 0)
-      continue;
+  // Write tile offsets
+  st = buff->write(
+      &tile_var_offsets[0], tile_var_offsets_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing "
+        "variable tile offsets failed"));
+  }
 
-    // Write tile sizes
-    st = buff->write(
-        &tile_var_sizes_[i][0], tile_var_sizes_num * sizeof(uint64_t));
-    if (!st.ok()) {
-      return LOG_STATUS(
-          Status::FragmentMetadataError("Cannot serialize fragment metadata; "
-                                        "Writing variable tile sizes failed"));
-    }
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// tile_var_sizes_num (uint64_t)
+// tile_var_sizes_#1 (uint64_t) tile_var_sizes_#2 (uint64_t) ...
+Status FragmentMetadata::write_tile_var_sizes(
+    unsigned int attribute_id, Buffer* buff) {
+  auto& tile_var_sizes = tile_var_sizes_[attribute_id];
+
+  // Write number of sizes
+  uint64_t tile_var_sizes_num = tile_var_sizes.size();
+  Status st = buff->write(&tile_var_sizes_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of "
+        "variable tile sizes failed"));
+  }
+
+  if (tile_var_sizes_num == 0)
+    return Status::Ok();
+
+  // Write tile sizes
+  st = buff->write(&tile_var_sizes[0], tile_var_sizes_num * sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(
+        Status::FragmentMetadataError("Cannot serialize fragment metadata; "
+                                      "Writing variable tile sizes failed"));
   }
+
   return Status::Ok();
 }
 
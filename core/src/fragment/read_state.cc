@@ -31,11 +31,14 @@
  * This file implements the ReadState class.
  */
 
+#include "dictionary_encoding.h"
 #include "logger.h"
 #include "posix_filesystem.h"
 #include "query.h"
 #include "utils.h"
 
+#include <algorithm>
+
 /* ****************************** */
 /*             MACROS             */
 /* ****************************** */
@@ -65,8 +68,13 @@ ReadState::ReadState(
   coords_size_ = array_metadata_->coords_size();
   done_ = false;
   last_tile_coords_ = nullptr;
+  mbr_ = std::malloc(2 * coords_size_);
+  mbr_overlaps_ = new uint8_t[constants::mbr_overlap_batch_size];
+  mbr_overlaps_range_[0] = INVALID_UINT64;
+  mbr_overlaps_range_[1] = INVALID_UINT64;
   search_tile_overlap_subarray_ = std::malloc(2 * coords_size_);
   search_tile_pos_ = INVALID_UINT64;
+  skip_tiles_ = false;
 
   tile_coords_aux_ = std::malloc(coords_size_);
 
@@ -76,12 +84,18 @@ ReadState::ReadState(
   init_fetched_tiles();
   init_empty_attributes();
   compute_tile_search_range();
+  init_predicates();
 }
 
 ReadState::~ReadState() {
   if (last_tile_coords_ != nullptr)
     std::free(last_tile_coords_);
 
+  if (mbr_ != nullptr)
+    std::free(mbr_);
+
+  delete[] mbr_overlaps_;
+
   if (tile_coords_aux_ != nullptr)
     std::free(tile_coords_aux_);
 
@@ -97,6 +111,12 @@ ReadState::~ReadState() {
   for (auto& tile_io_var : tile_io_var_)
     delete tile_io_var;
 
+  for (auto& predicate_tile : predicate_tiles_)
+    delete predicate_tile;
+
+  for (auto& predicate_tile_io : predicate_tile_io_)
+    delete predicate_tile_io;
+
   if (search_tile_overlap_subarray_ != nullptr)
     std::free(search_tile_overlap_subarray_);
 }
@@ -105,6 +125,54 @@ ReadState::~ReadState() {
 /*              API               */
 /* ****************************** */
 
+Status ReadState::apply_predicates(
+    const FragmentCellPosRange& fragment_cell_pos_range,
+    std::vector<FragmentCellPosRange>* fragment_cell_pos_ranges) {
+  // Trivial case
+  auto& predicates = query_->predicates();
+  if (predicates.empty()) {
+    fragment_cell_pos_ranges->push_back(fragment_cell_pos_range);
+    return Status::Ok();
+  }
+
+  // For easy reference
+  uint64_t tile_i = fragment_cell_pos_range.first.second;
+  uint64_t start = fragment_cell_pos_range.second.first;
+  uint64_t num = fragment_cell_pos_range.second.second - start + 1;
+
+  // Evaluate the predicates on the cells of the range
+  predicate_matches_.assign(num, 1);
+  auto predicate_num = (unsigned int)predicates.size();
+  for (unsigned int i = 0; i < predicate_num; ++i) {
+    // An empty attribute has no values that could satisfy the predicate
+    unsigned int attribute_id = predicates[i].attribute_id();
+    if (is_empty_attribute(attribute_id))
+      return Status::Ok();
+
+    RETURN_NOT_OK(read_predicate_tile(i, tile_i));
+    const void* values = (const char*)predicate_tiles_[i]->data() +
+                         start * array_metadata_->cell_size(attribute_id);
+    predicates[i].check_cells(values, num, &predicate_matches_[0]);
+  }
+
+  // Append the maximal runs of satisfying cells
+  uint64_t i = 0;
+  while (i < num) {
+    while (i < num && !predicate_matches_[i])
+      ++i;
+    if (i == num)
+      break;
+    uint64_t run_start = i;
+    while (i < num && predicate_matches_[i])
+      ++i;
+    fragment_cell_pos_ranges->emplace_back(
+        fragment_cell_pos_range.first,
+        CellPosRange(start + run_start, start + i - 1));
+  }
+
+  return Status::Ok();
+}
+
 Status ReadState::copy_cells(
     unsigned int attribute_id,
     uint64_t tile_i,
@@ -201,7 +269,7 @@ Status ReadState::copy_cells_var(
   // Compute actual cells to copy
   uint64_t start_cell_pos = tile->offset() / cell_size;
   uint64_t end_cell_pos = start_cell_pos + bytes_to_copy / cell_size - 1;
-  uint64_t tile_var_size = metadata_->tile_var_sizes()[attribute_id][tile_i];
+  uint64_t tile_var_size = tile_var->size();
 
   RETURN_NOT_OK(compute_bytes_to_copy(
       attribute_id,
@@ -256,12 +324,23 @@ bool ReadState::done() const {
   return done_;
 }
 
+Status ReadState::fetch_tile(unsigned int attribute_id, uint64_t tile_i) {
+  // Trivial case
+  if (is_empty_attribute(attribute_id))
+    return Status::Ok();
+
+  if (attribute_id < attribute_num_ && array_metadata_->var_size(attribute_id))
+    return read_tile_var(attribute_id, tile_i);
+
+  return read_tile(attribute_id, tile_i);
+}
+
 void ReadState::get_bounding_coords(void* bounding_coords) const {
   // For easy reference
   uint64_t pos = search_tile_pos_;
   assert(pos != INVALID_UINT64);
   std::memcpy(
-      bounding_coords, metadata_->bounding_coords()[pos], 2 * coords_size_);
+      bounding_coords, metadata_->bounding_coords(pos), 2 * coords_size_);
 }
 
 template <class T>
@@ -714,7 +793,6 @@ void ReadState::get_next_overlapping_tile_sparse() {
     return;
 
   // For easy reference
-  const std::vector<void*>& mbrs = metadata_->mbrs();
   auto subarray = static_cast<const T*>(query_->subarray());
 
   // Update the search tile position
@@ -723,23 +801,40 @@ void ReadState::get_next_overlapping_tile_sparse() {
   else
     ++search_tile_pos_;
 
-  // Find the position to the next overlapping tile with the query range
-  for (;;) {
-    // No overlap - exit
-    if (search_tile_pos_ > tile_search_range_[1]) {
-      done_ = true;
-      return;
+  // Find the position to the next overlapping tile with the query range,
+  // checking the MBRs in batches
+  search_tile_overlap_ = 0;
+  while (search_tile_pos_ <= tile_search_range_[1]) {
+    // Compute the overlaps of a new batch if the position left the last one
+    if (mbr_overlaps_range_[0] == INVALID_UINT64 ||
+        search_tile_pos_ < mbr_overlaps_range_[0] ||
+        search_tile_pos_ > mbr_overlaps_range_[1]) {
+      uint64_t num = std::min(
+          tile_search_range_[1] - search_tile_pos_ + 1,
+          constants::mbr_overlap_batch_size);
+      compute_mbr_overlaps<T>(search_tile_pos_, num, mbr_overlaps_);
+      mbr_overlaps_range_[0] = search_tile_pos_;
+      mbr_overlaps_range_[1] = search_tile_pos_ + num - 1;
     }
 
-    auto mbr = static_cast<const T*>(mbrs[search_tile_pos_]);
-    search_tile_overlap_ = array_metadata_->domain()->subarray_overlap(
-        subarray, mbr, static_cast<T*>(search_tile_overlap_subarray_));
-
-    if (!search_tile_overlap_)
+    while (search_tile_pos_ <= mbr_overlaps_range_[1] &&
+           !mbr_overlaps_[search_tile_pos_ - mbr_overlaps_range_[0]])
       ++search_tile_pos_;
-    else
-      return;
+    if (search_tile_pos_ <= mbr_overlaps_range_[1])
+      break;
   }
+
+  // No overlap - exit
+  if (search_tile_pos_ > tile_search_range_[1]) {
+    done_ = true;
+    return;
+  }
+
+  // Compute the overlap of the found MBR with the query range
+  auto mbr = static_cast<T*>(mbr_);
+  metadata_->get_mbr(search_tile_pos_, mbr);
+  search_tile_overlap_ = array_metadata_->domain()->subarray_overlap(
+      subarray, mbr, static_cast<T*>(search_tile_overlap_subarray_));
 }
 
 template <class T>
@@ -750,11 +845,11 @@ void ReadState::get_next_overlapping_tile_sparse(const T* tile_coords) {
 
   // For easy reference
   unsigned int dim_num = array_metadata_->dim_num();
-  const std::vector<void*>& mbrs = metadata_->mbrs();
   auto subarray = static_cast<const T*>(query_->subarray());
   auto domain = array_metadata_->domain();
 
   // Compute the tile subarray
+  auto mbr = new T[2 * dim_num];
   auto tile_subarray = new T[2 * dim_num];
   auto mbr_tile_overlap_subarray = new T[2 * dim_num];
   auto tile_subarray_end = new T[dim_num];
@@ -778,13 +873,14 @@ void ReadState::get_next_overlapping_tile_sparse(const T* tile_coords) {
     if (!std::memcmp(last_tile_coords_, tile_coords, coords_size_)) {
       // Advance only if the MBR does not exceed the tile
       auto bounding_coords =
-          static_cast<const T*>(metadata_->bounding_coords()[search_tile_pos_]);
+          static_cast<const T*>(metadata_->bounding_coords(search_tile_pos_));
       if (domain->tile_cell_order_cmp(
               &bounding_coords[dim_num],
               tile_subarray_end,
               (T*)tile_coords_aux_) <= 0) {
         ++search_tile_pos_;
       } else {
+        delete[] mbr;
         delete[] tile_subarray;
         delete[] tile_subarray_end;
         delete[] mbr_tile_overlap_subarray;
@@ -804,7 +900,7 @@ void ReadState::get_next_overlapping_tile_sparse(const T* tile_coords) {
     }
 
     // Get overlap between MBR and tile subarray
-    auto mbr = static_cast<const T*>(mbrs[search_tile_pos_]);
+    metadata_->get_mbr(search_tile_pos_, mbr);
     mbr_tile_overlap_ =
         domain->subarray_overlap(tile_subarray, mbr, mbr_tile_overlap_subarray);
 
@@ -812,7 +908,7 @@ void ReadState::get_next_overlapping_tile_sparse(const T* tile_coords) {
     if (!mbr_tile_overlap_) {
       // Check if we need to break or continue
       auto bounding_coords =
-          static_cast<const T*>(metadata_->bounding_coords()[search_tile_pos_]);
+          static_cast<const T*>(metadata_->bounding_coords(search_tile_pos_));
       if (domain->tile_cell_order_cmp(
               &bounding_coords[dim_num],
               tile_subarray_end,
@@ -842,11 +938,48 @@ void ReadState::get_next_overlapping_tile_sparse(const T* tile_coords) {
   }
 
   // Clean up
+  delete[] mbr;
   delete[] tile_subarray;
   delete[] tile_subarray_end;
   delete[] mbr_tile_overlap_subarray;
 }
 
+void ReadState::init_predicates() {
+  // Discard the structures of the previous predicates
+  for (auto& predicate_tile : predicate_tiles_)
+    delete predicate_tile;
+  for (auto& predicate_tile_io : predicate_tile_io_)
+    delete predicate_tile_io;
+  predicate_tiles_.clear();
+  predicate_tile_io_.clear();
+
+  // The attributes of the predicates have a single value per cell, and
+  // they are never dictionary-encoded
+  bool mmap = query_->storage_manager()->config().vfs_mmap_reads();
+  bool sequential = (query_->layout() == Layout::GLOBAL_ORDER);
+  for (auto& predicate : query_->predicates()) {
+    unsigned int attribute_id = predicate.attribute_id();
+    const Attribute* attr = array_metadata_->attribute(attribute_id);
+    predicate_tiles_.emplace_back(
+        new Tile(attr->type(), attr->compressor(), attr->cell_size(), 0));
+    predicate_tiles_.back()->set_filter(attr->filter());
+    predicate_tile_io_.emplace_back(new TileIO(
+        query_->storage_manager(),
+        fragment_->attr_uri(attribute_id),
+        fragment_->file_size(attribute_id)));
+    predicate_tile_io_.back()->set_dictionary(
+        metadata_->dictionary(attribute_id));
+    predicate_tile_io_.back()->set_format_version(metadata_->version());
+    if (mmap)
+      predicate_tile_io_.back()->enable_mmap(sequential);
+  }
+  fetched_predicate_tile_.assign(predicate_tiles_.size(), INVALID_UINT64);
+
+  // The tiles that may be skipped depend on the predicates
+  needed_tiles_.clear();
+  compute_needed_tiles();
+}
+
 bool ReadState::mbr_overlaps_tile() const {
   return (bool)mbr_tile_overlap_;
 }
@@ -868,6 +1001,68 @@ bool ReadState::subarray_area_covered() const {
 /*         PRIVATE METHODS        */
 /* ****************************** */
 
+Status ReadState::coalesce_tile_reads(
+    TileIO* tile_io,
+    Tile* tile,
+    unsigned int attribute_id,
+    uint64_t tile_i,
+    bool var) {
+  // Memory-mapped tiles are not read through the TileIO buffer
+  if (tile->compressor() == Compressor::NO_COMPRESSION &&
+      tile_io->mmap_enabled())
+    return Status::Ok();
+
+  // For easy reference
+  const std::vector<uint64_t>& tile_offsets =
+      var ? metadata_->tile_var_offsets()[attribute_id] :
+            metadata_->tile_offsets()[attribute_id];
+  uint64_t file_size = tile_io->file_size();
+  uint64_t tile_num = metadata_->tile_num();
+  auto tile_end = [&](uint64_t i) {
+    return (i == tile_num - 1) ? file_size : tile_offsets[i + 1];
+  };
+
+  // Nothing to do if the tile was already read along with its neighbors
+  uint64_t start = tile_offsets[tile_i];
+  uint64_t end = tile_end(tile_i);
+  if (tile_io->in_range(start, end - start))
+    return Status::Ok();
+
+  auto it =
+      std::lower_bound(needed_tiles_.begin(), needed_tiles_.end(), tile_i);
+  if (it == needed_tiles_.end() || *it != tile_i)
+    return Status::Ok();
+
+  // Use the range read ahead, or read the range starting at the tile. A
+  // single tile is read as usual.
+  if (tile_io->in_async_range(start, end - start)) {
+    RETURN_NOT_OK(tile_io->wait_range_async());
+  } else {
+    uint64_t range_end =
+        compute_coalesced_range_end(tile_offsets, file_size, it);
+    if (range_end != end)
+      RETURN_NOT_OK(tile_io->read_range(start, range_end - start));
+  }
+
+  // Find the first needed tile after the current range
+  auto next = it + 1;
+  while (next != needed_tiles_.end() &&
+         tile_io->in_range(
+             tile_offsets[*next], tile_end(*next) - tile_offsets[*next]))
+    ++next;
+  if (next == needed_tiles_.end())
+    return Status::Ok();
+
+  // Read the subsequent range ahead, so that its I/O overlaps with the
+  // processing of the current range
+  uint64_t next_start = tile_offsets[*next];
+  if (tile_io->in_async_range(next_start, tile_end(*next) - next_start))
+    return Status::Ok();
+  uint64_t next_end =
+      compute_coalesced_range_end(tile_offsets, file_size, next);
+  return tile_io->read_range_async(next_start, next_end - next_start);
+}
+
 Status ReadState::compute_bytes_to_copy(
     unsigned int attribute_id,
     uint64_t tile_var_size,
@@ -956,6 +1151,30 @@ Status ReadState::compute_bytes_to_copy(
   return Status::Ok();
 }
 
+uint64_t ReadState::compute_coalesced_range_end(
+    const std::vector<uint64_t>& tile_offsets,
+    uint64_t file_size,
+    std::vector<uint64_t>::const_iterator it) const {
+  // For easy reference
+  uint64_t tile_num = metadata_->tile_num();
+  uint64_t start = tile_offsets[*it];
+  uint64_t range_end =
+      (*it == tile_num - 1) ? file_size : tile_offsets[*it + 1];
+
+  // Extend the range over the subsequent needed tiles that are close enough
+  for (++it; it != needed_tiles_.end(); ++it) {
+    uint64_t next_start = tile_offsets[*it];
+    uint64_t next_end =
+        (*it == tile_num - 1) ? file_size : tile_offsets[*it + 1];
+    if (next_start - range_end > constants::coalesced_read_max_gap ||
+        next_end - start > constants::coalesced_read_max_size)
+      break;
+    range_end = next_end;
+  }
+
+  return range_end;
+}
+
 Status ReadState::compute_tile_compressed_size(
     uint64_t tile_i,
     unsigned int attribute_id,
@@ -995,6 +1214,174 @@ Status ReadState::compute_tile_compressed_var_size(
   return Status::Ok();
 }
 
+void ReadState::compute_needed_tiles() {
+  // For easy reference
+  Datatype coords_type = array_metadata_->coords_type();
+
+  // Dense fragments
+  if (fragment_->dense()) {
+    if (coords_type == Datatype::INT32) {
+      compute_needed_tiles_dense<int>();
+    } else if (coords_type == Datatype::INT64) {
+      compute_needed_tiles_dense<int64_t>();
+    } else if (coords_type == Datatype::INT8) {
+      compute_needed_tiles_dense<int8_t>();
+    } else if (coords_type == Datatype::UINT8) {
+      compute_needed_tiles_dense<uint8_t>();
+    } else if (coords_type == Datatype::INT16) {
+      compute_needed_tiles_dense<int16_t>();
+    } else if (coords_type == Datatype::UINT16) {
+      compute_needed_tiles_dense<uint16_t>();
+    } else if (coords_type == Datatype::UINT32) {
+      compute_needed_tiles_dense<uint32_t>();
+    } else if (coords_type == Datatype::UINT64) {
+      compute_needed_tiles_dense<uint64_t>();
+    }
+    return;
+  }
+
+  // Sparse fragments
+  if (coords_type == Datatype::INT32) {
+    compute_needed_tiles_sparse<int>();
+  } else if (coords_type == Datatype::INT64) {
+    compute_needed_tiles_sparse<int64_t>();
+  } else if (coords_type == Datatype::FLOAT32) {
+    compute_needed_tiles_sparse<float>();
+  } else if (coords_type == Datatype::FLOAT64) {
+    compute_needed_tiles_sparse<double>();
+  } else if (coords_type == Datatype::INT8) {
+    compute_needed_tiles_sparse<int8_t>();
+  } else if (coords_type == Datatype::UINT8) {
+    compute_needed_tiles_sparse<uint8_t>();
+  } else if (coords_type == Datatype::INT16) {
+    compute_needed_tiles_sparse<int16_t>();
+  } else if (coords_type == Datatype::UINT16) {
+    compute_needed_tiles_sparse<uint16_t>();
+  } else if (coords_type == Datatype::UINT32) {
+    compute_needed_tiles_sparse<uint32_t>();
+  } else if (coords_type == Datatype::UINT64) {
+    compute_needed_tiles_sparse<uint64_t>();
+  } else {
+    // The code should never reach here
+    assert(0);
+  }
+}
+
+template <class T>
+void ReadState::compute_needed_tiles_dense() {
+  // For easy reference
+  unsigned int dim_num = array_metadata_->dim_num();
+  auto domain = array_metadata_->domain();
+  auto tile_extents = static_cast<const T*>(domain->tile_extents());
+  auto subarray = static_cast<const T*>(query_->subarray());
+  auto metadata_domain = static_cast<const T*>(metadata_->domain());
+  auto non_empty_domain = static_cast<const T*>(metadata_->non_empty_domain());
+  uint64_t tile_num = metadata_->tile_num();
+
+  // Compute overlap of the subarray with the non-empty fragment domain
+  auto overlap = new T[2 * dim_num];
+  if (!domain->subarray_overlap(subarray, non_empty_domain, overlap)) {
+    delete[] overlap;
+    return;
+  }
+
+  // Compute the tile domain of the overlap, normalized to the fragment
+  // domain
+  auto tile_domain = new T[2 * dim_num];
+  auto tile_coords = new T[dim_num];
+  for (unsigned int i = 0; i < dim_num; ++i) {
+    tile_domain[2 * i] =
+        (overlap[2 * i] - metadata_domain[2 * i]) / tile_extents[i];
+    tile_domain[2 * i + 1] =
+        (overlap[2 * i + 1] - metadata_domain[2 * i]) / tile_extents[i];
+    tile_coords[i] = tile_domain[2 * i];
+  }
+
+  // Collect the positions of all the tiles in the tile domain
+  for (;;) {
+    uint64_t pos = domain->get_tile_pos(metadata_domain, tile_coords);
+    if (pos < tile_num)
+      needed_tiles_.push_back(pos);
+
+    unsigned int i = 0;
+    for (; i < dim_num; ++i) {
+      if (tile_coords[i] < tile_domain[2 * i + 1]) {
+        ++tile_coords[i];
+        break;
+      }
+      tile_coords[i] = tile_domain[2 * i];
+    }
+    if (i == dim_num)
+      break;
+  }
+  std::sort(needed_tiles_.begin(), needed_tiles_.end());
+
+  // Clean up
+  delete[] overlap;
+  delete[] tile_domain;
+  delete[] tile_coords;
+}
+
+template <class T>
+void ReadState::compute_needed_tiles_sparse() {
+  // Handle no overlap
+  if (done_)
+    return;
+
+  // The tiles whose statistics do not satisfy the query predicates are
+  // skipped, unless an older fragment overlaps this one, since the skipped
+  // cells may overwrite older cells that satisfy the predicates
+  skip_tiles_ =
+      !query_->predicates().empty() && !overlaps_older_fragments<T>();
+
+  // Collect the tiles whose MBR overlaps the subarray
+  uint64_t first = tile_search_range_[0];
+  uint64_t num = tile_search_range_[1] - first + 1;
+  auto overlaps = new uint8_t[num];
+  compute_mbr_overlaps<T>(first, num, overlaps);
+  for (uint64_t i = 0; i < num; ++i) {
+    if (overlaps[i])
+      needed_tiles_.push_back(first + i);
+  }
+
+  // Clean up
+  delete[] overlaps;
+}
+
+template <class T>
+void ReadState::compute_mbr_overlaps(
+    uint64_t first, uint64_t num, uint8_t* overlaps) const {
+  // For easy reference
+  unsigned int dim_num = array_metadata_->dim_num();
+  auto subarray = static_cast<const T*>(query_->subarray());
+
+  std::memset(overlaps, 1, num);
+  for (unsigned int d = 0; d < dim_num; ++d) {
+    auto lows = static_cast<const T*>(metadata_->mbr_bounds(d, false)) + first;
+    auto highs = static_cast<const T*>(metadata_->mbr_bounds(d, true)) + first;
+    T low = subarray[2 * d];
+    T high = subarray[2 * d + 1];
+    for (uint64_t i = 0; i < num; ++i)
+      overlaps[i] &= (uint8_t)((lows[i] <= high) & (highs[i] >= low));
+  }
+
+  // Exclude the tiles whose statistics do not satisfy the predicates. The
+  // fragments of earlier versions have no statistics.
+  if (!skip_tiles_)
+    return;
+  for (auto& predicate : query_->predicates()) {
+    unsigned int attribute_id = predicate.attribute_id();
+    if (metadata_->tile_stats_num(attribute_id) != metadata_->tile_num())
+      continue;
+    uint64_t offset = first * array_metadata_->type_size(attribute_id);
+    const void* mins =
+        (const char*)metadata_->tile_stats(attribute_id, false) + offset;
+    const void* maxs =
+        (const char*)metadata_->tile_stats(attribute_id, true) + offset;
+    predicate.check_tiles(mins, maxs, num, overlaps);
+  }
+}
+
 void ReadState::compute_tile_search_range() {
   // For easy reference
   Datatype coords_type = array_metadata_->coords_type();
@@ -1047,7 +1434,6 @@ void ReadState::compute_tile_search_range_col_or_row() {
   unsigned int dim_num = array_metadata_->dim_num();
   auto subarray = static_cast<const T*>(query_->subarray());
   uint64_t tile_num = metadata_->tile_num();
-  auto& bounding_coords = metadata_->bounding_coords();
   auto domain = array_metadata_->domain();
 
   // Calculate subarray coordinates
@@ -1072,8 +1458,8 @@ void ReadState::compute_tile_search_range_col_or_row() {
     med = min + ((max - min) / 2);
 
     // Get info for bounding coordinates
-    tile_start_coords = static_cast<const T*>(bounding_coords[med]);
-    tile_end_coords = &(static_cast<const T*>(bounding_coords[med])[dim_num]);
+    tile_start_coords = static_cast<const T*>(metadata_->bounding_coords(med));
+    tile_end_coords = &tile_start_coords[dim_num];
 
     // Calculate precedence
     if (domain->tile_cell_order_cmp(
@@ -1113,8 +1499,9 @@ void ReadState::compute_tile_search_range_col_or_row() {
       med = min + ((max - min) / 2);
 
       // Get info for bounding coordinates
-      tile_start_coords = static_cast<const T*>(bounding_coords[med]);
-      tile_end_coords = &(static_cast<const T*>(bounding_coords[med])[dim_num]);
+      tile_start_coords =
+          static_cast<const T*>(metadata_->bounding_coords(med));
+      tile_end_coords = &tile_start_coords[dim_num];
 
       // Calculate precedence
       if (domain->tile_cell_order_cmp(
@@ -1335,11 +1722,15 @@ void ReadState::init_tiles() {
         (var_size) ? constants::cell_var_offset_size : attr->cell_size(),
         0));
 
-    if (var_size)
+    if (var_size) {
       tiles_var_.emplace_back(new Tile(
           attr->type(), attr->compressor(), datatype_size(attr->type()), 0));
-    else
+      if (attr->filter() != Filter::DICTIONARY)
+        tiles_var_.back()->set_filter(attr->filter());
+    } else {
+      tiles_.back()->set_filter(attr->filter());
       tiles_var_.emplace_back(nullptr);
+    }
   }
   tiles_.emplace_back(new Tile(
       array_metadata_->coords_type(),
@@ -1368,6 +1759,11 @@ void ReadState::init_tile_io() {
           fragment_->file_var_size(i)));
     else
       tile_io_var_.emplace_back(nullptr);
+
+    // The ZSTD dictionaries the fragment files were compressed with
+    tile_io_.back()->set_dictionary(metadata_->dictionary(i));
+    if (var_size)
+      tile_io_var_.back()->set_dictionary(metadata_->dictionary_var(i));
   }
   tile_io_.emplace_back(new TileIO(
       query_->storage_manager(),
@@ -1377,6 +1773,31 @@ void ReadState::init_tile_io() {
       query_->storage_manager(),
       fragment_->coords_uri(),
       fragment_->file_coords_size()));
+
+  // The compressed data are in the format of the fragment version
+  for (auto tile_io : tile_io_)
+    tile_io->set_format_version(metadata_->version());
+  for (auto tile_io : tile_io_var_) {
+    if (tile_io != nullptr)
+      tile_io->set_format_version(metadata_->version());
+  }
+
+  // Read uncompressed tiles via memory mapping. The variable cell offset
+  // tiles are excluded, since they are shifted in place after every read,
+  // and so are the dictionary-encoded tiles, which are decoded in place.
+  if (!query_->storage_manager()->config().vfs_mmap_reads())
+    return;
+  bool sequential = (query_->layout() == Layout::GLOBAL_ORDER);
+  for (unsigned int i = 0; i < attribute_num_; ++i) {
+    if (array_metadata_->var_size(i)) {
+      if (array_metadata_->attribute(i)->filter() != Filter::DICTIONARY)
+        tile_io_var_[i]->enable_mmap(sequential);
+    } else {
+      tile_io_[i]->enable_mmap(sequential);
+    }
+  }
+  tile_io_[attribute_num_]->enable_mmap(sequential);
+  tile_io_[attribute_num_ + 1]->enable_mmap(sequential);
 }
 
 bool ReadState::is_empty_attribute(unsigned int attribute_id) const {
@@ -1387,6 +1808,32 @@ bool ReadState::is_empty_attribute(unsigned int attribute_id) const {
   return is_empty_attribute_[attribute_id];
 }
 
+template <class T>
+bool ReadState::overlaps_older_fragments() const {
+  // For easy reference
+  unsigned int dim_num = array_metadata_->dim_num();
+  auto non_empty_domain = static_cast<const T*>(metadata_->non_empty_domain());
+
+  // The fragments are ordered from the oldest to the newest
+  for (auto metadata : query_->fragment_metadata()) {
+    if (metadata == metadata_)
+      break;
+    auto older_domain = static_cast<const T*>(metadata->non_empty_domain());
+    bool overlap = true;
+    for (unsigned int d = 0; d < dim_num; ++d) {
+      if (older_domain[2 * d] > non_empty_domain[2 * d + 1] ||
+          older_domain[2 * d + 1] < non_empty_domain[2 * d]) {
+        overlap = false;
+        break;
+      }
+    }
+    if (overlap)
+      return true;
+  }
+
+  return false;
+}
+
 Status ReadState::read_from_tile(
     unsigned int attribute_id,
     void* buffer,
@@ -1399,6 +1846,39 @@ Status ReadState::read_from_tile(
   return Status::Ok();
 }
 
+Status ReadState::read_predicate_tile(
+    unsigned int predicate_i, uint64_t tile_i) {
+  // Return if the tile has already been fetched
+  if (tile_i == fetched_predicate_tile_[predicate_i])
+    return Status::Ok();
+
+  auto tile = predicate_tiles_[predicate_i];
+  auto tile_io = predicate_tile_io_[predicate_i];
+  unsigned int attribute_id = query_->predicates()[predicate_i].attribute_id();
+
+  uint64_t tile_compressed_size;
+  RETURN_NOT_OK(compute_tile_compressed_size(
+      tile_i, attribute_id, tile_io->file_size(), &tile_compressed_size));
+  uint64_t file_offset = metadata_->tile_offsets()[attribute_id][tile_i];
+  uint64_t tile_size =
+      metadata_->cell_num(tile_i) * array_metadata_->cell_size(attribute_id);
+
+  RETURN_NOT_OK(read_tile_cached(
+      tile_io,
+      tile,
+      attribute_id,
+      tile_i,
+      false,
+      file_offset,
+      tile_compressed_size,
+      tile_size));
+
+  // Mark as fetched
+  fetched_predicate_tile_[predicate_i] = tile_i;
+
+  return Status::Ok();
+}
+
 Status ReadState::read_tile(unsigned int attribute_id, uint64_t tile_i) {
   // Return if the tile has already been fetched
   if (tile_i == fetched_tile_[attribute_id])
@@ -1420,7 +1900,15 @@ Status ReadState::read_tile(unsigned int attribute_id, uint64_t tile_i) {
   uint64_t tile_size = metadata_->cell_num(tile_i) *
                        array_metadata_->cell_size(attribute_id_real);
 
-  Status st = tile_io->read(tile, file_offset, tile_compressed_size, tile_size);
+  Status st = read_tile_cached(
+      tile_io,
+      tile,
+      attribute_id_real,
+      tile_i,
+      false,
+      file_offset,
+      tile_compressed_size,
+      tile_size);
 
   // Mark as fetched
   if (st.ok())
@@ -1448,8 +1936,15 @@ Status ReadState::read_tile_var(unsigned int attribute_id, uint64_t tile_i) {
   uint64_t tile_size =
       metadata_->cell_num(tile_i) * constants::cell_var_offset_size;
 
-  RETURN_NOT_OK(
-      tile_io->read(tile, file_offset, tile_compressed_size, tile_size));
+  RETURN_NOT_OK(read_tile_cached(
+      tile_io,
+      tile,
+      attribute_id,
+      tile_i,
+      false,
+      file_offset,
+      tile_compressed_size,
+      tile_size));
 
   auto tile_var = tiles_var_[attribute_id];
   auto tile_io_var = tile_io_var_[attribute_id];
@@ -1461,12 +1956,37 @@ Status ReadState::read_tile_var(unsigned int attribute_id, uint64_t tile_i) {
       attribute_id,
       tile_io_var->file_size(),
       &tile_compressed_var_size));
-  uint64_t tile_var_size = metadata_->tile_var_sizes()[attribute_id][tile_i];
+  // The dictionary-encoded tiles are read with their encoded size, which
+  // earlier fragments recorded in place of the decoded one
+  auto attr = array_metadata_->attribute(attribute_id);
+  bool encoded = attr->filter() == Filter::DICTIONARY;
+  const auto& tile_var_sizes =
+      (encoded && !metadata_->tile_var_encoded_sizes()[attribute_id].empty()) ?
+          metadata_->tile_var_encoded_sizes()[attribute_id] :
+          metadata_->tile_var_sizes()[attribute_id];
+  uint64_t tile_var_size = tile_var_sizes[tile_i];
   uint64_t file_var_offset =
       metadata_->tile_var_offsets()[attribute_id][tile_i];
 
-  RETURN_NOT_OK(tile_io_var->read(
-      tile_var, file_var_offset, tile_compressed_var_size, tile_var_size));
+  RETURN_NOT_OK(read_tile_cached(
+      tile_io_var,
+      tile_var,
+      attribute_id,
+      tile_i,
+      true,
+      file_var_offset,
+      tile_compressed_var_size,
+      tile_var_size));
+
+  // Decode the values of a dictionary-encoded tile. The tiles of several
+  // attributes may be fetched concurrently, hence the local buffer.
+  if (encoded) {
+    ConstBuffer encoded_values(tile_var->data(), tile_var->size());
+    Buffer decoded;
+    RETURN_NOT_OK(DictionaryEncoding::decode(&encoded_values, &decoded));
+    tile_var->buffer()->swap(&decoded);
+    tile_var->reset_offset();
+  }
 
   // Shift variable cell offsets
   shift_var_offsets(attribute_id);
@@ -1478,6 +1998,36 @@ Status ReadState::read_tile_var(unsigned int attribute_id, uint64_t tile_i) {
   return Status::Ok();
 }
 
+Status ReadState::read_tile_cached(
+    TileIO* tile_io,
+    Tile* tile,
+    unsigned int attribute_id,
+    uint64_t tile_i,
+    bool var,
+    uint64_t file_offset,
+    uint64_t compressed_size,
+    uint64_t tile_size) {
+  if (tile->compressor() == Compressor::NO_COMPRESSION) {
+    RETURN_NOT_OK(
+        coalesce_tile_reads(tile_io, tile, attribute_id, tile_i, var));
+    return tile_io->read(tile, file_offset, compressed_size, tile_size);
+  }
+
+  auto tile_cache = query_->storage_manager()->tile_cache();
+  const URI& fragment_uri = fragment_->fragment_uri();
+  bool hit;
+  RETURN_NOT_OK(tile_cache->read(
+      fragment_uri, attribute_id, tile_i, var, tile->buffer(), &hit));
+  if (hit)
+    return Status::Ok();
+
+  RETURN_NOT_OK(
+      coalesce_tile_reads(tile_io, tile, attribute_id, tile_i, var));
+  RETURN_NOT_OK(tile_io->read(tile, file_offset, compressed_size, tile_size));
+  return tile_cache->insert(
+      fragment_uri, attribute_id, tile_i, var, tile->buffer());
+}
+
 void ReadState::shift_var_offsets(unsigned int attribute_id) {
   // For easy reference
   uint64_t cell_num =
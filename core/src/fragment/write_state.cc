@@ -36,9 +36,11 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <limits>
 
 #include "comparators.h"
 #include "const_buffer.h"
+#include "dictionary_encoding.h"
 #include "logger.h"
 #include "posix_filesystem.h"
 #include "query.h"
@@ -58,6 +60,7 @@ WriteState::WriteState(const Fragment* fragment)
 
   init_tiles();
   init_tile_io();
+  init_dictionary_training();
 
   // For easy reference
   auto array_metadata = fragment_->query()->array_metadata();
@@ -77,6 +80,7 @@ WriteState::WriteState(const Fragment* fragment)
   mbr_ = std::malloc(2 * coords_size);
   bounding_coords_ = std::malloc(2 * coords_size);
   tile_coords_aux_ = std::malloc(coords_size);
+  encoded_tile_var_ = new Buffer();
 }
 
 WriteState::~WriteState() {
@@ -92,6 +96,24 @@ WriteState::~WriteState() {
   for (auto& tile_io_var : tile_io_var_)
     delete tile_io_var;
 
+  for (auto training : dictionary_training_) {
+    if (training != nullptr) {
+      for (auto tile : training->tiles_)
+        delete tile;
+      delete training;
+    }
+  }
+
+  for (auto training : dictionary_training_var_) {
+    if (training != nullptr) {
+      for (auto tile : training->tiles_)
+        delete tile;
+      delete training;
+    }
+  }
+
+  delete encoded_tile_var_;
+
   if (mbr_ != nullptr)
     std::free(mbr_);
 
@@ -115,6 +137,9 @@ Status WriteState::finalize() {
   if (!tiles_[attribute_num]->empty())
     RETURN_NOT_OK(write_last_tile());
 
+  // Write the tiles withheld for dictionary training
+  RETURN_NOT_OK(train_dictionaries());
+
   // Sync all attributes
   RETURN_NOT_OK(sync());
 
@@ -131,6 +156,11 @@ Status WriteState::sync() {
 
   // Sync all attributes
   for (auto attribute_id : attribute_ids) {
+    // Write the tiles still buffered
+    RETURN_NOT_OK(tile_io_[attribute_id]->flush());
+    if (array_metadata->var_size(attribute_id))
+      RETURN_NOT_OK(tile_io_var_[attribute_id]->flush());
+
     // For all attributes
     if (attribute_id == attribute_num) {
       RETURN_NOT_OK(storage_manager->sync(fragment_->coords_uri()));
@@ -220,6 +250,22 @@ void WriteState::expand_mbr(const T* coords) {
   }
 }
 
+void WriteState::init_dictionary_training() {
+  auto array_metadata = fragment_->query()->array_metadata();
+  auto attribute_num = array_metadata->attribute_num();
+  dictionary_training_.resize(attribute_num + 1, nullptr);
+  dictionary_training_var_.resize(attribute_num, nullptr);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    if (array_metadata->attribute(i)->compression_dictionary_size() == 0)
+      continue;
+    if (tiles_[i]->compressor() == Compressor::ZSTD)
+      dictionary_training_[i] = new DictionaryTraining{0, {}};
+    if (tiles_var_[i] != nullptr &&
+        tiles_var_[i]->compressor() == Compressor::ZSTD)
+      dictionary_training_var_[i] = new DictionaryTraining{0, {}};
+  }
+}
+
 void WriteState::init_tiles() {
   auto array_metadata = fragment_->query()->array_metadata();
   auto attribute_num = array_metadata->attribute_num();
@@ -236,6 +282,9 @@ void WriteState::init_tiles() {
         fragment_->tile_size(i),
         (var_size) ? constants::cell_var_offset_size : attr->cell_size(),
         0));
+    tiles_.back()->set_chunk_size(attr->chunk_size());
+    if (!var_size)
+      tiles_.back()->set_filter(attr->filter());
 
     if (var_size) {
       tiles_var_.emplace_back(new Tile(
@@ -245,6 +294,9 @@ void WriteState::init_tiles() {
           fragment_->tile_size(i),
           datatype_size(attr->type()),
           0));
+      tiles_var_.back()->set_chunk_size(attr->chunk_size());
+      if (attr->filter() != Filter::DICTIONARY)
+        tiles_var_.back()->set_filter(attr->filter());
     } else {
       tiles_var_.emplace_back(nullptr);
     }
@@ -276,6 +328,14 @@ void WriteState::init_tile_io() {
   }
   tile_io_.emplace_back(
       new TileIO(query->storage_manager(), fragment_->coords_uri()));
+
+  // The tiles are written in the background, in large batches
+  for (auto tile_io : tile_io_)
+    tile_io->enable_write_behind();
+  for (auto tile_io_var : tile_io_var_) {
+    if (tile_io_var != nullptr)
+      tile_io_var->enable_write_behind();
+  }
 }
 
 void WriteState::sort_cell_pos(
@@ -447,6 +507,111 @@ void WriteState::update_bookkeeping(const void* buffer, uint64_t buffer_size) {
   }
 }
 
+void WriteState::update_tile_stats(
+    unsigned int attribute_id, const Tile* tile) {
+  // Invoke the proper templated function
+  switch (fragment_->query()->array_metadata()->type(attribute_id)) {
+    case Datatype::INT32:
+      return update_tile_stats<int>(attribute_id, tile);
+    case Datatype::INT64:
+      return update_tile_stats<int64_t>(attribute_id, tile);
+    case Datatype::FLOAT32:
+      return update_tile_stats<float>(attribute_id, tile);
+    case Datatype::FLOAT64:
+      return update_tile_stats<double>(attribute_id, tile);
+    case Datatype::INT8:
+      return update_tile_stats<int8_t>(attribute_id, tile);
+    case Datatype::UINT8:
+      return update_tile_stats<uint8_t>(attribute_id, tile);
+    case Datatype::INT16:
+      return update_tile_stats<int16_t>(attribute_id, tile);
+    case Datatype::UINT16:
+      return update_tile_stats<uint16_t>(attribute_id, tile);
+    case Datatype::UINT32:
+      return update_tile_stats<uint32_t>(attribute_id, tile);
+    case Datatype::UINT64:
+      return update_tile_stats<uint64_t>(attribute_id, tile);
+    default:
+      assert(0);
+  }
+}
+
+template <class T>
+void WriteState::update_tile_stats(
+    unsigned int attribute_id, const Tile* tile) {
+  // A tile without values gets an empty range (min > max)
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  auto values = static_cast<const T*>(tile->data());
+  uint64_t cell_num = tile->size() / sizeof(T);
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    if (values[i] < min)
+      min = values[i];
+    if (values[i] > max)
+      max = values[i];
+  }
+
+  metadata_->append_tile_stats(attribute_id, &min, &max);
+}
+
+Status WriteState::train_dictionary(unsigned int attribute_id, bool var) {
+  // For easy reference
+  auto attr = fragment_->query()->array_metadata()->attribute(attribute_id);
+  auto& training = var ? dictionary_training_var_[attribute_id] :
+                         dictionary_training_[attribute_id];
+  auto tile_io = var ? tile_io_var_[attribute_id] : tile_io_[attribute_id];
+  std::vector<Tile*> tiles;
+  tiles.swap(training->tiles_);
+  delete training;
+  training = nullptr;
+
+  // Train the dictionary on the chunks of the withheld tiles
+  Buffer samples;
+  std::vector<uint64_t> sample_sizes;
+  Status st;
+  for (auto tile : tiles) {
+    st = tile_io->append_dictionary_samples(tile, &samples, &sample_sizes);
+    if (!st.ok())
+      break;
+  }
+  auto dictionary = new ZStdDictionary();
+  if (st.ok())
+    st = dictionary->train(
+        &samples, sample_sizes, attr->compression_dictionary_size());
+  if (st.ok() && dictionary->size() != 0) {
+    if (var)
+      metadata_->set_dictionary_var(attribute_id, dictionary);
+    else
+      metadata_->set_dictionary(attribute_id, dictionary);
+    tile_io->set_dictionary(dictionary);
+  } else {
+    delete dictionary;
+  }
+
+  // Write the withheld tiles, now compressed with the dictionary
+  for (auto tile : tiles) {
+    if (st.ok())
+      st = write_tile(attribute_id, var, tile);
+    delete tile;
+  }
+
+  return st;
+}
+
+Status WriteState::train_dictionaries() {
+  for (unsigned int i = 0; i < dictionary_training_.size(); ++i) {
+    if (dictionary_training_[i] != nullptr)
+      RETURN_NOT_OK(train_dictionary(i, false));
+  }
+
+  for (unsigned int i = 0; i < dictionary_training_var_.size(); ++i) {
+    if (dictionary_training_var_[i] != nullptr)
+      RETURN_NOT_OK(train_dictionary(i, true));
+  }
+
+  return Status::Ok();
+}
+
 Status WriteState::write_attr(
     unsigned int attribute_id, void* buffer, uint64_t buffer_size) {
   // Trivial case
@@ -460,15 +625,12 @@ Status WriteState::write_attr(
   // Preparation
   auto buf = new ConstBuffer(buffer, buffer_size);
   auto tile = tiles_[attribute_id];
-  auto tile_io = tile_io_[attribute_id];
 
   // Fill tiles and dispatch them for writing
-  uint64_t bytes_written = 0;
   do {
     RETURN_NOT_OK(tile->write(buf));
     if (tile->full()) {
-      RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-      metadata_->append_tile_offset(attribute_id, bytes_written);
+      RETURN_NOT_OK(write_tile(attribute_id, false, tile));
       tile->reset_offset();
       tile->set_size(0);
     }
@@ -483,12 +645,9 @@ Status WriteState::write_attr(
 Status WriteState::write_attr_last(unsigned int attribute_id) {
   auto tile = tiles_[attribute_id];
   assert(!tile->empty());
-  auto tile_io = tile_io_[attribute_id];
 
   // Fill tiles and dispatch them for writing
-  uint64_t bytes_written;
-  RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-  metadata_->append_tile_offset(attribute_id, bytes_written);
+  RETURN_NOT_OK(write_tile(attribute_id, false, tile));
   tile->reset_offset();
 
   return Status::Ok();
@@ -512,11 +671,9 @@ Status WriteState::write_attr_var(
 
   auto tile = tiles_[attribute_id];
   auto tile_var = tiles_var_[attribute_id];
-  auto tile_io = tile_io_[attribute_id];
-  auto tile_io_var = tile_io_var_[attribute_id];
 
   // Fill tiles and dispatch them for writing
-  uint64_t bytes_written, bytes_written_var, bytes_to_write_var;
+  uint64_t bytes_to_write_var;
   do {
     RETURN_NOT_OK(tile->write_with_shift(buf, buffer_var_offset));
 
@@ -529,11 +686,8 @@ Status WriteState::write_attr_var(
     RETURN_NOT_OK(tile_var->write(buf_var, bytes_to_write_var));
 
     if (tile->full()) {
-      RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-      RETURN_NOT_OK(tile_io_var->write(tile_var, &bytes_written_var));
-      metadata_->append_tile_offset(attribute_id, bytes_written);
-      metadata_->append_tile_var_offset(attribute_id, bytes_written_var);
-      metadata_->append_tile_var_size(attribute_id, tile_var->size());
+      RETURN_NOT_OK(write_tile(attribute_id, false, tile));
+      RETURN_NOT_OK(write_tile_var(attribute_id));
       tile->reset_offset();
       tile->set_size(0);
       tile_var->reset_offset();
@@ -553,16 +707,10 @@ Status WriteState::write_attr_var(
 Status WriteState::write_attr_var_last(unsigned int attribute_id) {
   auto tile = tiles_[attribute_id];
   auto tile_var = tiles_var_[attribute_id];
-  auto tile_io = tile_io_[attribute_id];
-  auto tile_io_var = tile_io_var_[attribute_id];
 
   // Fill tiles and dispatch them for writing
-  uint64_t bytes_written, bytes_written_var;
-  RETURN_NOT_OK(tile_io->write(tile, &bytes_written));
-  RETURN_NOT_OK(tile_io_var->write(tile_var, &bytes_written_var));
-  metadata_->append_tile_offset(attribute_id, bytes_written);
-  metadata_->append_tile_var_offset(attribute_id, bytes_written_var);
-  metadata_->append_tile_var_size(attribute_id, tile_var->size());
+  RETURN_NOT_OK(write_tile(attribute_id, false, tile));
+  RETURN_NOT_OK(write_tile_var(attribute_id));
   tile->reset_offset();
   tile_var->reset_offset();
 
@@ -768,4 +916,83 @@ Status WriteState::write_sparse_unsorted_attr_var(
   return st;
 }
 
+Status WriteState::write_tile(
+    unsigned int attribute_id, bool var, Tile* tile) {
+  // Withhold a copy of the tile while the dictionary is being trained
+  auto training = var ? dictionary_training_var_[attribute_id] :
+                        dictionary_training_[attribute_id];
+  if (training != nullptr) {
+    auto tile_copy = new Tile(
+        tile->type(),
+        tile->compressor(),
+        tile->compression_level(),
+        tile->size(),
+        tile->cell_size(),
+        tile->dim_num());
+    tile_copy->set_chunk_size(tile->chunk_size());
+    tile_copy->set_filter(tile->filter());
+    RETURN_NOT_OK_ELSE(
+        tile_copy->buffer()->write(tile->data(), tile->size()),
+        delete tile_copy);
+    training->tiles_.push_back(tile_copy);
+    training->size_ += tile->size();
+
+    // Train the dictionary once the sample is large enough
+    auto attr = fragment_->query()->array_metadata()->attribute(attribute_id);
+    if (training->size_ >= attr->compression_dictionary_size() *
+                               constants::compression_dictionary_sample_ratio)
+      return train_dictionary(attribute_id, var);
+    return Status::Ok();
+  }
+
+  uint64_t bytes_written;
+  if (var) {
+    RETURN_NOT_OK(tile_io_var_[attribute_id]->write(tile, &bytes_written));
+    metadata_->append_tile_var_offset(attribute_id, bytes_written);
+    auto attr = fragment_->query()->array_metadata()->attribute(attribute_id);
+    if (attr->filter() == Filter::DICTIONARY)
+      metadata_->append_tile_var_encoded_size(attribute_id, tile->size());
+    else
+      metadata_->append_tile_var_size(attribute_id, tile->size());
+  } else {
+    if (fragment_->query()->array_metadata()->has_tile_stats(attribute_id))
+      update_tile_stats(attribute_id, tile);
+    RETURN_NOT_OK(tile_io_[attribute_id]->write(tile, &bytes_written));
+    metadata_->append_tile_offset(attribute_id, bytes_written);
+  }
+
+  return Status::Ok();
+}
+
+Status WriteState::write_tile_var(unsigned int attribute_id) {
+  // For easy reference
+  auto attr = fragment_->query()->array_metadata()->attribute(attribute_id);
+  auto tile = tiles_[attribute_id];
+  auto tile_var = tiles_var_[attribute_id];
+
+  // Swap the tile contents with their dictionary encoding for the write,
+  // recording the decoded size (the encoded one is recorded on the write,
+  // which may be withheld while a dictionary is trained)
+  bool encoded = attr->filter() == Filter::DICTIONARY;
+  if (encoded) {
+    metadata_->append_tile_var_size(attribute_id, tile_var->size());
+    ConstBuffer values(tile_var->data(), tile_var->size());
+    encoded_tile_var_->reset_offset();
+    encoded_tile_var_->reset_size();
+    RETURN_NOT_OK(DictionaryEncoding::encode(
+        (const uint64_t*)tile->data(),
+        tile->size() / constants::cell_var_offset_size,
+        &values,
+        encoded_tile_var_));
+    tile_var->buffer()->swap(encoded_tile_var_);
+  }
+
+  Status st = write_tile(attribute_id, true, tile_var);
+
+  if (encoded)
+    tile_var->buffer()->swap(encoded_tile_var_);
+
+  return st;
+}
+
 }  // namespace tiledb
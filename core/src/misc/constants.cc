@@ -49,6 +49,12 @@ const char* array_metadata_filename = "__array_metadata.tdb";
 /** The fragment metadata file name. */
 const char* fragment_metadata_filename = "__fragment_metadata.tdb";
 
+/**
+ * The magic number at the end of a fragment metadata file, which marks that
+ * its metadata are stored in separately loaded sections.
+ */
+const uint64_t fragment_metadata_magic = 0x544453434D474654;
+
 /** The default tile capacity. */
 const uint64_t capacity = 10000;
 
@@ -193,6 +199,30 @@ const char* bzip2_str = "BZIP2";
 /** String describing DOUBLE_DELTA. */
 const char* double_delta_str = "DOUBLE_DELTA";
 
+/** String describing BLOCK_DOUBLE_DELTA. */
+const char* block_double_delta_str = "BLOCK_DOUBLE_DELTA";
+
+/** String describing GORILLA. */
+const char* gorilla_str = "GORILLA";
+
+/** String describing ADAPTIVE. */
+const char* adaptive_str = "ADAPTIVE";
+
+/** String describing NO_FILTER. */
+const char* no_filter_str = "NO_FILTER";
+
+/** String describing BYTESHUFFLE. */
+const char* byteshuffle_str = "BYTESHUFFLE";
+
+/** String describing BITSHUFFLE. */
+const char* bitshuffle_str = "BITSHUFFLE";
+
+/** String describing DELTA. */
+const char* delta_str = "DELTA";
+
+/** String describing DICTIONARY. */
+const char* dictionary_str = "DICTIONARY";
+
 /** The string representation for type int32. */
 const char* int32_str = "INT32";
 
@@ -248,11 +278,89 @@ const char* unordered_str = "unordered";
 const char* null_str = "null";
 
 /** The version in format { major, minor, revision }. */
-const int version[3] = {1, 2, 0};
+const int version[3] = {1, 2, 2};
 
-/** The size of a tile chunk. */
+/**
+ * The first library version that stores the chunk size, the filter and the
+ * compression dictionary size of the attributes in the array metadata.
+ */
+const int attribute_options_min_version[3] = {1, 2, 1};
+
+/**
+ * The maximum size of a tile chunk. This is bounded by the largest input
+ * the compression libraries accept in a single call.
+ */
 const uint64_t tile_chunk_size = INT_MAX;
 
+/** The default size of a tile chunk upon compression. */
+const uint64_t default_tile_chunk_size = 1048576;
+
+/**
+ * The default capacity of the ZSTD dictionaries of an attribute (0 means
+ * that no dictionaries are trained).
+ */
+const uint64_t default_compression_dictionary_size = 0;
+
+/**
+ * The tiles of an attribute file are sampled for training its ZSTD
+ * dictionary until they amount to this many times the dictionary capacity.
+ */
+const uint64_t compression_dictionary_sample_ratio = 100;
+
+/**
+ * The default number of threads of the storage manager thread pool, used if
+ * the number of hardware threads cannot be determined.
+ */
+const unsigned int num_threads = 1;
+
+/** The default size of the storage manager tile cache in bytes. */
+const uint64_t tile_cache_size = 10000000;
+
+/** The default maximum number of file descriptors the VFS keeps open. */
+const uint64_t vfs_max_open_files = 256;
+
+/** The default number of threads that execute asynchronous VFS requests. */
+const unsigned int vfs_async_threads = 4;
+
+/** The default candidate compressors of the ADAPTIVE compressor. */
+const char* adaptive_compressors = "RLE,DOUBLE_DELTA,LZ4,ZSTD:1,ZSTD:9";
+
+/**
+ * The maximum number of bytes of a tile chunk the ADAPTIVE compressor
+ * trial-compresses with every candidate compressor.
+ */
+const uint64_t adaptive_sample_size = 65536;
+
+/** The number of evenly spaced blocks an ADAPTIVE sample consists of. */
+const uint64_t adaptive_sample_block_num = 8;
+
+/** The maximum number of asynchronous requests in flight in io_uring. */
+const unsigned int async_io_queue_depth = 64;
+
+/**
+ * The maximum number of bytes between two tiles of a file, for their reads
+ * to be coalesced into a single read.
+ */
+const uint64_t coalesced_read_max_gap = 65536;
+
+/** The maximum size of a single coalesced read of multiple tiles. */
+const uint64_t coalesced_read_max_size = 4194304;
+
+/** The size of the batches of tiles written with write-behind buffering. */
+const uint64_t write_behind_buffer_size = 4194304;
+
+/** The version of the format of the RLE-compressed data. */
+const uint8_t rle_format_version = 2;
+
+/**
+ * The first library version whose fragments store RLE-compressed data in
+ * the versioned format. Earlier fragments use two-byte run lengths.
+ */
+const int rle_format_min_version[3] = {1, 2, 2};
+
+/** The number of MBRs checked together for overlap with a subarray. */
+const uint64_t mbr_overlap_batch_size = 256;
+
 }  // namespace constants
 
 }  // namespace tiledb
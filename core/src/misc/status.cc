@@ -158,6 +158,12 @@ std::string Status::code_to_string() const {
     case StatusCode::Consolidation:
       type = "[TileDB::Consolidation] Error";
       break;
+    case StatusCode::Config:
+      type = "[TileDB::Config] Error";
+      break;
+    case StatusCode::ThreadPool:
+      type = "[TileDB::ThreadPool] Error";
+      break;
     default:
       type = "[TileDB::?] Error:";
   }
@@ -0,0 +1,201 @@
+/**
+ * @file   thread_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ThreadPool.
+ */
+
+#include "thread_pool.h"
+#include "logger.h"
+
+namespace tiledb {
+
+/* ****************************** */
+/*        THREAD-LOCAL STATE      */
+/* ****************************** */
+
+/** The pool the calling thread is a worker of (nullptr if none). */
+static thread_local ThreadPool* worker_pool = nullptr;
+
+/** The index of the queue owned by the calling worker thread. */
+static thread_local uint64_t worker_queue_idx = 0;
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+ThreadPool::ThreadPool() {
+  next_queue_ = 0;
+  should_terminate_ = false;
+  task_num_ = 0;
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    should_terminate_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto& thread : threads_)
+    thread.join();
+
+  for (auto& queue : queues_)
+    delete queue;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+std::future<Status> ThreadPool::enqueue(
+    const std::function<Status()>& function) {
+  std::packaged_task<Status()> task(function);
+  auto future = task.get_future();
+
+  // Execute the task inline if there are no workers
+  if (queues_.empty()) {
+    task();
+    return future;
+  }
+
+  // Workers push to their own queue, any other thread round-robin
+  uint64_t queue_idx = (worker_pool == this) ?
+                           worker_queue_idx :
+                           next_queue_++ % queues_.size();
+  {
+    std::unique_lock<std::mutex> lck(queues_[queue_idx]->mtx_);
+    queues_[queue_idx]->tasks_.push_back(std::move(task));
+  }
+
+  // Wake up an idle worker
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    ++task_num_;
+  }
+  cv_.notify_one();
+
+  return future;
+}
+
+Status ThreadPool::init(unsigned int thread_num) {
+  if (thread_num == 0)
+    return LOG_STATUS(Status::ThreadPoolError(
+        "Cannot initialize thread pool; The number of threads must be "
+        "positive"));
+
+  if (!threads_.empty())
+    return LOG_STATUS(Status::ThreadPoolError(
+        "Cannot initialize thread pool; Thread pool already initialized"));
+
+  for (unsigned int i = 0; i < thread_num; ++i)
+    queues_.push_back(new TaskQueue());
+
+  for (unsigned int i = 0; i < thread_num; ++i)
+    threads_.emplace_back(&ThreadPool::worker, this, i);
+
+  return Status::Ok();
+}
+
+unsigned int ThreadPool::thread_num() const {
+  return (unsigned int)threads_.size();
+}
+
+Status ThreadPool::wait_all(std::vector<std::future<Status>>& tasks) {
+  uint64_t queue_idx = (worker_pool == this) ? worker_queue_idx : 0;
+  std::packaged_task<Status()> task;
+  Status ret;
+
+  for (auto& future : tasks) {
+    // Help with pending tasks until the awaited task completes
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (pop_task(queue_idx, &task))
+        task();
+      else
+        future.wait();
+    }
+
+    Status st = future.get();
+    if (ret.ok() && !st.ok())
+      ret = st;
+  }
+
+  return ret;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+bool ThreadPool::pop_task(
+    uint64_t queue_idx, std::packaged_task<Status()>* task) {
+  auto queue_num = queues_.size();
+  for (uint64_t i = 0; i < queue_num; ++i) {
+    auto queue = queues_[(queue_idx + i) % queue_num];
+    std::unique_lock<std::mutex> lck(queue->mtx_);
+    if (queue->tasks_.empty())
+      continue;
+
+    // Serve the own queue from the back (most recent tasks first, which
+    // favors the subtasks of the task being waited on) and steal from the
+    // front
+    if (i == 0) {
+      *task = std::move(queue->tasks_.back());
+      queue->tasks_.pop_back();
+    } else {
+      *task = std::move(queue->tasks_.front());
+      queue->tasks_.pop_front();
+    }
+    --task_num_;
+
+    return true;
+  }
+
+  return false;
+}
+
+void ThreadPool::worker(uint64_t queue_idx) {
+  worker_pool = this;
+  worker_queue_idx = queue_idx;
+
+  std::packaged_task<Status()> task;
+  for (;;) {
+    if (pop_task(queue_idx, &task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lck(mtx_);
+    cv_.wait(lck, [this]() { return should_terminate_ || task_num_ > 0; });
+    if (should_terminate_ && task_num_ <= 0)
+      return;
+  }
+}
+
+}  // namespace tiledb
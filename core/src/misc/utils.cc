@@ -43,6 +43,10 @@
 #include <set>
 #include <sstream>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace tiledb {
 
 namespace utils {
@@ -168,6 +172,114 @@ int cmp_row_order(
   return 0;
 }
 
+/**
+ * Implements *copy_strided* for blocks of a size known at compile time,
+ * so that each block copy is a single load and store.
+ */
+template <uint64_t N>
+static void copy_strided(
+    char* dst, const char* src, uint64_t block_num, uint64_t src_stride) {
+  for (uint64_t i = 0; i < block_num; ++i, dst += N, src += src_stride)
+    std::memcpy(dst, src, N);
+}
+
+#ifdef __SSE2__
+/** Loads a 4-byte block into the low lane of a register. */
+static inline __m128i load_block4(const char* src) {
+  int32_t block;
+  std::memcpy(&block, src, sizeof(block));
+  return _mm_cvtsi32_si128(block);
+}
+
+/**
+ * Gathers 4-byte blocks four at a time into a single store, returning the
+ * number of blocks copied.
+ */
+static uint64_t copy_strided_simd4(
+    char* dst, const char* src, uint64_t block_num, uint64_t src_stride) {
+  uint64_t i = 0;
+  for (; i + 4 <= block_num; i += 4, dst += 16, src += 4 * src_stride) {
+    __m128i lo = _mm_unpacklo_epi32(
+        load_block4(src), load_block4(src + src_stride));
+    __m128i hi = _mm_unpacklo_epi32(
+        load_block4(src + 2 * src_stride), load_block4(src + 3 * src_stride));
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(lo, hi));
+  }
+  return i;
+}
+
+/**
+ * Gathers 8-byte blocks two at a time into a single store, returning the
+ * number of blocks copied.
+ */
+static uint64_t copy_strided_simd8(
+    char* dst, const char* src, uint64_t block_num, uint64_t src_stride) {
+  uint64_t i = 0;
+  for (; i + 2 <= block_num; i += 2, dst += 16, src += 2 * src_stride) {
+    __m128i lo = _mm_loadl_epi64((const __m128i*)src);
+    __m128i hi = _mm_loadl_epi64((const __m128i*)(src + src_stride));
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi64(lo, hi));
+  }
+  return i;
+}
+#endif
+
+void copy_strided(
+    void* dst,
+    const void* src,
+    uint64_t block_size,
+    uint64_t block_num,
+    uint64_t src_stride) {
+  auto dst_c = static_cast<char*>(dst);
+  auto src_c = static_cast<const char*>(src);
+
+  // Contiguous blocks
+  if (src_stride == block_size) {
+    std::memcpy(dst_c, src_c, block_size * block_num);
+    return;
+  }
+
+  // Blocks gathered with SIMD, the rest are copied below
+  uint64_t done = 0;
+  switch (block_size) {
+    case 1:
+      copy_strided<1>(dst_c, src_c, block_num, src_stride);
+      break;
+    case 2:
+      copy_strided<2>(dst_c, src_c, block_num, src_stride);
+      break;
+    case 4:
+#ifdef __SSE2__
+      done = copy_strided_simd4(dst_c, src_c, block_num, src_stride);
+#endif
+      copy_strided<4>(
+          dst_c + 4 * done,
+          src_c + done * src_stride,
+          block_num - done,
+          src_stride);
+      break;
+    case 8:
+#ifdef __SSE2__
+      done = copy_strided_simd8(dst_c, src_c, block_num, src_stride);
+#endif
+      copy_strided<8>(
+          dst_c + 8 * done,
+          src_c + done * src_stride,
+          block_num - done,
+          src_stride);
+      break;
+    case 16:
+      copy_strided<16>(dst_c, src_c, block_num, src_stride);
+      break;
+    default:
+      for (uint64_t i = 0; i < block_num; ++i) {
+        std::memcpy(dst_c, src_c, block_size);
+        dst_c += block_size;
+        src_c += src_stride;
+      }
+  }
+}
+
 std::string domain_str(const void* domain, Datatype type) {
   std::stringstream ss;
 
@@ -329,6 +441,14 @@ bool is_contained(const T* range_A, const T* range_B, unsigned int dim_num) {
   return true;
 }
 
+bool is_older_version(const int* version, const int* other) {
+  for (int i = 0; i < 3; ++i) {
+    if (version[i] != other[i])
+      return version[i] < other[i];
+  }
+  return false;
+}
+
 bool is_positive_integer(const char* s) {
   int i = 0;
 
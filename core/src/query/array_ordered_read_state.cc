@@ -643,7 +643,12 @@ Status ArrayOrderedReadState::async_submit_query(unsigned int id) {
       query_->attribute_ids(),
       buffers_[id],
       buffer_sizes_tmp_[id],
-      true));
+      // The coordinates are needed only for sorting the cells of sparse
+      // arrays, and they have no buffer in the dense case
+      !query_->array_metadata()->dense()));
+  // The tile slabs are small and read in the background anyway
+  async_query_[id]->set_parallel_reads(false);
+  async_query_[id]->set_predicates(query_->predicates());
   async_query_[id]->set_callback(async_done, &(async_data_[id]));
 
   // Send the async query
@@ -1140,6 +1145,7 @@ void ArrayOrderedReadState::calculate_tile_slab_info_row(unsigned int id) {
   }
 }
 
+template <class T>
 void ArrayOrderedReadState::copy_tile_slab_dense() {
   // For easy reference
   auto array_metadata = query_->array_metadata();
@@ -1147,15 +1153,16 @@ void ArrayOrderedReadState::copy_tile_slab_dense() {
   // Copy tile slab for each attribute separately
   for (unsigned int i = 0, b = 0; i < (int)attribute_ids_.size(); ++i) {
     if (!array_metadata->var_size(attribute_ids_[i])) {
-      copy_tile_slab_dense(i, b);
+      copy_tile_slab_dense<T>(i, b);
       ++b;
     } else {
-      copy_tile_slab_dense_var(i, b);
+      copy_tile_slab_dense_var<T>(i, b);
       b += 2;
     }
   }
 }
 
+template <class T>
 void ArrayOrderedReadState::copy_tile_slab_dense(
     unsigned int aid, unsigned int bid) {
   // Exit if copy is done for this attribute
@@ -1170,6 +1177,9 @@ void ArrayOrderedReadState::copy_tile_slab_dense(
   uint64_t buffer_size = copy_state_.buffer_sizes_[bid];
   auto buffer = (char*)copy_state_.buffers_[bid];
   auto local_buffer = (char*)buffers_[copy_id_][bid];
+  auto current_coords = (T*)tile_slab_state_.current_coords_[aid];
+  unsigned int d =
+      (query_->layout() == Layout::COL_MAJOR) ? 0 : dim_num_ - 1;
   ASRS_Data asrs_data = {aid, 0, this};
 
   // Iterate over the tile slab cells
@@ -1177,24 +1187,41 @@ void ArrayOrderedReadState::copy_tile_slab_dense(
     // For easy reference
     uint64_t cell_slab_size =
         tile_slab_info_[copy_id_].cell_slab_size_[aid][tid];
+    uint64_t cell_slab_num = tile_slab_info_[copy_id_].cell_slab_num_[tid];
+    auto range_overlap =
+        (const T*)tile_slab_info_[copy_id_].range_overlap_[tid];
     uint64_t& local_buffer_offset = tile_slab_state_.current_offsets_[aid];
 
+    // Number of consecutive cell slabs along the advancing dimension that
+    // fall in the current tile and fit in the user buffer
+    auto slab_num =
+        (uint64_t)(range_overlap[2 * d + 1] - current_coords[d]) /
+            cell_slab_num +
+        1;
+    slab_num = MIN(slab_num, (buffer_size - buffer_offset) / cell_slab_size);
+
     // Handle overflow
-    if (buffer_offset + cell_slab_size > buffer_size) {
+    if (slab_num == 0) {
       overflow_[aid] = true;
       break;
     }
 
-    // Copy cell slab
-    std::memcpy(
+    // Copy the cell slabs, which are strided in the local buffer
+    uint64_t stride = cell_slab_num *
+                      tile_slab_info_[copy_id_].cell_offset_per_dim_[tid][d] *
+                      attribute_sizes_[aid];
+    utils::copy_strided(
         buffer + buffer_offset,
         local_buffer + local_buffer_offset,
-        cell_slab_size);
+        cell_slab_size,
+        slab_num,
+        stride);
 
     // Update buffer offset
-    buffer_offset += cell_slab_size;
+    buffer_offset += slab_num * cell_slab_size;
 
     // Prepare for new cell slab
+    current_coords[d] += (slab_num - 1) * cell_slab_num;
     (*advance_cell_slab_)(&asrs_data);
 
     // Terminating condition
@@ -1203,6 +1230,7 @@ void ArrayOrderedReadState::copy_tile_slab_dense(
   }
 }
 
+template <class T>
 void ArrayOrderedReadState::copy_tile_slab_dense_var(
     unsigned int aid, unsigned int bid) {
   // Exit if copy is done for this attribute
@@ -1227,6 +1255,9 @@ void ArrayOrderedReadState::copy_tile_slab_dense_var(
   auto local_buffer_s = (uint64_t*)buffers_[copy_id_][bid];
   uint64_t cell_num_in_buffer = local_buffer_size / sizeof(uint64_t);
   uint64_t var_offset = buffer_offset_var;
+  auto current_coords = (T*)tile_slab_state_.current_coords_[aid];
+  unsigned int d =
+      (query_->layout() == Layout::COL_MAJOR) ? 0 : dim_num_ - 1;
   ASRS_Data asrs_data = {aid, 0, this};
 
   // For all overlapping tiles, in a round-robin fashion
@@ -1234,50 +1265,73 @@ void ArrayOrderedReadState::copy_tile_slab_dense_var(
     // For easy reference
     uint64_t cell_slab_size =
         tile_slab_info_[copy_id_].cell_slab_size_[aid][tid];
+    uint64_t cell_slab_num = tile_slab_info_[copy_id_].cell_slab_num_[tid];
     uint64_t cell_num_in_slab = cell_slab_size / sizeof(uint64_t);
+    auto range_overlap =
+        (const T*)tile_slab_info_[copy_id_].range_overlap_[tid];
     uint64_t& local_buffer_offset = tile_slab_state_.current_offsets_[aid];
 
-    // Handle overflow
-    if (buffer_offset + cell_slab_size > buffer_size) {
-      overflow_[aid] = true;
-      break;
-    }
+    // Number of consecutive cell slabs along the advancing dimension that
+    // fall in the current tile
+    auto slab_num =
+        (uint64_t)(range_overlap[2 * d + 1] - current_coords[d]) /
+            cell_slab_num +
+        1;
+    uint64_t stride = cell_slab_num *
+                      tile_slab_info_[copy_id_].cell_offset_per_dim_[tid][d] *
+                      attribute_sizes_[aid];
+
+    // Copy the cell slabs one by one, stopping upon overflow
+    uint64_t slab_copied = 0;
+    for (; slab_copied < slab_num; ++slab_copied) {
+      // Handle overflow
+      if (buffer_offset + cell_slab_size > buffer_size) {
+        overflow_[aid] = true;
+        break;
+      }
 
-    // Calculate variable cell slab size
-    uint64_t cell_start = local_buffer_offset / sizeof(uint64_t);
-    uint64_t cell_end = cell_start + cell_num_in_slab;
-    cell_slab_size_var =
-        (cell_end == cell_num_in_buffer) ?
-            local_buffer_var_size - local_buffer_s[cell_start] :
-            local_buffer_s[cell_end] - local_buffer_s[cell_start];
+      // Calculate variable cell slab size
+      uint64_t cell_start =
+          (local_buffer_offset + slab_copied * stride) / sizeof(uint64_t);
+      uint64_t cell_end = cell_start + cell_num_in_slab;
+      cell_slab_size_var =
+          (cell_end == cell_num_in_buffer) ?
+              local_buffer_var_size - local_buffer_s[cell_start] :
+              local_buffer_s[cell_end] - local_buffer_s[cell_start];
+
+      // Handle overflow for the the variable-length buffer
+      if (buffer_offset_var + cell_slab_size_var > buffer_size_var) {
+        overflow_[aid] = true;
+        break;
+      }
 
-    // Handle overflow for the the variable-length buffer
-    if (buffer_offset_var + cell_slab_size_var > buffer_size_var) {
-      overflow_[aid] = true;
-      break;
-    }
+      // Copy fixed-sized offsets
+      for (uint64_t i = cell_start; i < cell_end; ++i) {
+        std::memcpy(buffer + buffer_offset, &var_offset, sizeof(uint64_t));
+        buffer_offset += sizeof(uint64_t);
+        var_offset += (i == cell_num_in_buffer - 1) ?
+                          local_buffer_var_size - local_buffer_s[i] :
+                          local_buffer_s[i + 1] - local_buffer_s[i];
+      }
 
-    // Copy fixed-sized offsets
-    for (uint64_t i = cell_start; i < cell_end; ++i) {
-      std::memcpy(buffer + buffer_offset, &var_offset, sizeof(uint64_t));
-      buffer_offset += sizeof(uint64_t);
-      var_offset += (i == cell_num_in_buffer - 1) ?
-                        local_buffer_var_size - local_buffer_s[i] :
-                        local_buffer_s[i + 1] - local_buffer_s[i];
+      // Copy variable-sized values
+      std::memcpy(
+          buffer_var + buffer_offset_var,
+          local_buffer_var + local_buffer_s[cell_start],
+          cell_slab_size_var);
+      buffer_offset_var += cell_slab_size_var;
     }
 
-    // Copy variable-sized values
-    std::memcpy(
-        buffer_var + buffer_offset_var,
-        local_buffer_var + local_buffer_s[cell_start],
-        cell_slab_size_var);
-    buffer_offset_var += cell_slab_size_var;
+    // Nothing more to do if no cell slab could be copied
+    if (slab_copied == 0)
+      break;
 
     // Prepare for new cell slab
+    current_coords[d] += (slab_copied - 1) * cell_slab_num;
     (*advance_cell_slab_)(&asrs_data);
 
     // Terminating condition
-    if (tile_slab_state_.copy_tile_slab_done_[aid])
+    if (overflow_[aid] || tile_slab_state_.copy_tile_slab_done_[aid])
       break;
   }
 }
@@ -2172,7 +2226,7 @@ Status ArrayOrderedReadState::read_dense_sorted_col() {
 
   copy_label_1:  // Resume from the point the copy led to overflow
     resume_copy_ = false;
-    copy_tile_slab_dense();
+    copy_tile_slab_dense<T>();
 
     if (overflow()) {
       resume_copy_ = true;
@@ -2189,7 +2243,7 @@ Status ArrayOrderedReadState::read_dense_sorted_col() {
 
   copy_label_2:  // Resume from the point the copy led to overflow
     resume_copy_2_ = false;
-    copy_tile_slab_dense();
+    copy_tile_slab_dense<T>();
 
     if (overflow())
       resume_copy_2_ = true;
@@ -2243,7 +2297,7 @@ Status ArrayOrderedReadState::read_dense_sorted_row() {
 
   copy_label_1:  // Resume from the point the copy led to overflow
     resume_copy_ = false;
-    copy_tile_slab_dense();
+    copy_tile_slab_dense<T>();
 
     // Handle overflow here
     if (overflow()) {
@@ -2260,7 +2314,7 @@ Status ArrayOrderedReadState::read_dense_sorted_row() {
 
   copy_label_2:  // Resume from the point the copy led to overflow
     resume_copy_2_ = false;
-    copy_tile_slab_dense();
+    copy_tile_slab_dense<T>();
 
     if (overflow())
       resume_copy_2_ = true;
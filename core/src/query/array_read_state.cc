@@ -71,6 +71,8 @@ ArrayReadState::ArrayReadState(Query* query)
   empty_cells_written_.resize(attribute_num_ + 1);
   fragment_cell_pos_ranges_vec_pos_.resize(attribute_num_ + 1);
   min_bounding_coords_end_ = nullptr;
+  parallel_read_done_ = false;
+  parallel_read_tried_ = false;
   read_round_done_.resize(attribute_num_);
   subarray_tile_coords_ = nullptr;
   subarray_tile_domain_ = nullptr;
@@ -145,6 +147,29 @@ Status ArrayReadState::read(void** buffers, uint64_t* buffer_sizes) {
   for (unsigned int i = 0; i < fragment_num_; ++i)
     fragment_read_states_[i]->reset_overflow();
 
+  // All the results were retrieved by a previous parallel read
+  if (parallel_read_done_) {
+    auto& attribute_ids = query_->attribute_ids();
+    unsigned int buffer_i = 0;
+    for (auto attribute_id : attribute_ids) {
+      buffer_sizes[buffer_i++] = 0;
+      if (array_metadata_->var_size(attribute_id))
+        buffer_sizes[buffer_i++] = 0;
+    }
+    return Status::Ok();
+  }
+
+  // Attempt to retrieve all the results in parallel upon the first read,
+  // falling back to the serial read below if that is not possible
+  if (!parallel_read_tried_) {
+    parallel_read_tried_ = true;
+    if (query_->parallel_reads()) {
+      RETURN_NOT_OK(read_parallel(buffers, buffer_sizes, &parallel_read_done_));
+      if (parallel_read_done_)
+        return Status::Ok();
+    }
+  }
+
   if (array_metadata_->dense())  // DENSE
     return read_dense(buffers, buffer_sizes);
   return read_sparse(buffers, buffer_sizes);  // SPARSE
@@ -220,9 +245,15 @@ Status ArrayReadState::compute_fragment_cell_pos_ranges(
       if (!st.ok())
         break;
 
-      // Insert into the result only valid fragment cell position ranges
-      if (fragment_cell_pos_range.second.first != INVALID_UINT64)
-        fragment_cell_pos_ranges->push_back(fragment_cell_pos_range);
+      // Insert into the result only valid fragment cell position ranges,
+      // restricted to the cells that satisfy the query predicates
+      if (fragment_cell_pos_range.second.first != INVALID_UINT64) {
+        st = fragment_read_states_[(*fragment_cell_ranges)[i].first.first]
+                 ->apply_predicates(
+                     fragment_cell_pos_range, fragment_cell_pos_ranges);
+        if (!st.ok())
+          break;
+      }
     }
 
     // Clean up corresponding input cell range
@@ -277,6 +308,50 @@ void ArrayReadState::compute_min_bounding_coords_end() {
   }
 }
 
+template <class T>
+void ArrayReadState::compute_read_blocks(
+    uint64_t max_block_num, std::vector<std::vector<T>>* blocks) const {
+  // For easy reference
+  auto dim_num = array_metadata_->dim_num();
+  auto domain = array_metadata_->domain();
+  auto domain_lo = static_cast<const T*>(domain->domain());
+  auto tile_extents = static_cast<const T*>(domain->tile_extents());
+  auto subarray = static_cast<const T*>(query_->subarray());
+  Layout order = (tile_extents != nullptr) ? array_metadata_->tile_order() :
+                                             array_metadata_->cell_order();
+
+  // Find the most significant dimension that spans more than one tile. The
+  // tile positions are computed in uint64_t, which is exact for all the
+  // integer coordinate types.
+  for (unsigned int i = 0; i < dim_num; ++i) {
+    unsigned int d = (order == Layout::COL_MAJOR) ? dim_num - 1 - i : i;
+    auto lo = (uint64_t)domain_lo[2 * d];
+    auto extent = (tile_extents != nullptr) ? (uint64_t)tile_extents[d] : 1;
+    uint64_t first = ((uint64_t)subarray[2 * d] - lo) / extent;
+    uint64_t last = ((uint64_t)subarray[2 * d + 1] - lo) / extent;
+    if (first == last)
+      continue;
+
+    // Split the tiles of the dimension evenly across the blocks
+    uint64_t tile_num = last - first + 1;
+    uint64_t block_num = MIN(max_block_num, tile_num);
+    uint64_t block_start = first;
+    for (uint64_t b = 0; b < block_num; ++b) {
+      uint64_t block_end = block_start + tile_num / block_num - 1 +
+                           ((b < tile_num % block_num) ? 1 : 0);
+      std::vector<T> block(subarray, subarray + 2 * dim_num);
+      if (b != 0)
+        block[2 * d] = (T)(lo + block_start * extent);
+      if (b != block_num - 1)
+        block[2 * d + 1] = (T)(lo + (block_end + 1) * extent - 1);
+      blocks->push_back(block);
+      block_start = block_end + 1;
+    }
+
+    return;
+  }
+}
+
 template <class T>
 Status ArrayReadState::compute_unsorted_fragment_cell_ranges_dense(
     std::vector<FragmentCellRanges>* unsorted_fragment_cell_ranges) {
@@ -1083,6 +1158,9 @@ Status ArrayReadState::get_next_fragment_cell_ranges_dense() {
   // Clean up processed overlapping tiles
   clean_up_processed_fragment_cell_pos_ranges();
 
+  // Fetch the tiles of all attributes in parallel
+  RETURN_NOT_OK(prefetch_tiles());
+
   // Success
   return Status::Ok();
 }
@@ -1124,6 +1202,9 @@ Status ArrayReadState::get_next_fragment_cell_ranges_sparse() {
   // Clean up processed overlapping tiles
   clean_up_processed_fragment_cell_pos_ranges();
 
+  // Fetch the tiles of all attributes in parallel
+  RETURN_NOT_OK(prefetch_tiles());
+
   return Status::Ok();
 }
 
@@ -1319,6 +1400,50 @@ void ArrayReadState::get_next_subarray_tile_coords() {
   }
 }
 
+Status ArrayReadState::prefetch_tiles() {
+  // For easy reference
+  auto& attribute_ids = query_->attribute_ids();
+  auto pos = (uint64_t)fragment_cell_pos_ranges_vec_.size() - 1;
+  FragmentCellPosRanges& fragment_cell_pos_ranges =
+      *fragment_cell_pos_ranges_vec_[pos];
+
+  // Only the attributes that will process the new ranges next are
+  // prefetched, since the rest are still reading from their current tiles
+  std::vector<unsigned int> prefetch_attribute_ids;
+  for (auto attribute_id : attribute_ids) {
+    if (fragment_cell_pos_ranges_vec_pos_[attribute_id] == pos)
+      prefetch_attribute_ids.push_back(attribute_id);
+  }
+  if (prefetch_attribute_ids.empty())
+    return Status::Ok();
+
+  // Find the first tile each fragment is read from in the new ranges
+  std::vector<bool> fragment_found(fragment_read_states_.size(), false);
+  std::vector<FragmentInfo> fragment_tiles;
+  for (const auto& fragment_cell_pos_range : fragment_cell_pos_ranges) {
+    unsigned int fragment_id = fragment_cell_pos_range.first.first;
+    if (fragment_id == INVALID_UINT || fragment_found[fragment_id])
+      continue;
+    fragment_found[fragment_id] = true;
+    fragment_tiles.push_back(fragment_cell_pos_range.first);
+  }
+
+  // Fetch a tile per fragment and attribute concurrently
+  auto thread_pool = query_->storage_manager()->thread_pool();
+  std::vector<std::future<Status>> tasks;
+  for (const auto& fragment_tile : fragment_tiles) {
+    auto read_state = fragment_read_states_[fragment_tile.first];
+    auto tile_pos = fragment_tile.second;
+    for (auto attribute_id : prefetch_attribute_ids) {
+      tasks.push_back(thread_pool->enqueue([=]() {
+        return read_state->fetch_tile(attribute_id, tile_pos);
+      }));
+    }
+  }
+
+  return thread_pool->wait_all(tasks);
+}
+
 Status ArrayReadState::read_dense(void** buffers, uint64_t* buffer_sizes) {
   // For easy reference
   auto& attribute_ids = query_->attribute_ids();
@@ -1527,6 +1652,314 @@ Status ArrayReadState::read_dense_attr_var(
   return Status::Ok();
 }
 
+Status ArrayReadState::read_block(
+    const void* block,
+    void** direct_buffers,
+    const uint64_t* direct_buffer_sizes,
+    Buffer** block_buffers,
+    const uint64_t* max_buffer_sizes,
+    std::vector<std::atomic<uint64_t>>* result_sizes,
+    std::atomic<bool>* fits) {
+  // For easy reference
+  auto& attribute_ids = query_->attribute_ids();
+  auto buffer_num = (unsigned int)result_sizes->size();
+
+  // Prepare an internal query on the block, which must not be split again
+  std::vector<void*> buffers(buffer_num);
+  std::vector<uint64_t> buffer_sizes(buffer_num);
+  std::vector<uint64_t> direct_offsets(buffer_num, 0);
+  Query query;
+  RETURN_NOT_OK(query.init(
+      query_->storage_manager(),
+      array_metadata_,
+      query_->fragment_metadata(),
+      QueryType::READ,
+      Layout::GLOBAL_ORDER,
+      block,
+      attribute_ids,
+      &buffers[0],
+      &buffer_sizes[0]));
+  query.set_parallel_reads(false);
+  query.set_predicates(query_->predicates());
+
+  // Read until the block is done, growing the block buffers upon overflow
+  do {
+    if (!*fits)
+      return Status::Ok();
+
+    // Continue writing where the previous read round stopped
+    for (unsigned int i = 0; i < buffer_num; ++i) {
+      if (direct_buffers[i] != nullptr) {
+        buffers[i] = (char*)direct_buffers[i] + direct_offsets[i];
+        buffer_sizes[i] = direct_buffer_sizes[i] - direct_offsets[i];
+      } else {
+        buffers[i] = block_buffers[i]->data(block_buffers[i]->size());
+        buffer_sizes[i] = block_buffers[i]->free_space();
+      }
+    }
+
+    RETURN_NOT_OK(query.async_process());
+
+    // The offsets of the variable-sized cells of this round are relative to
+    // the values of this round, which follow those of the previous rounds
+    unsigned int buffer_i = 0;
+    for (auto attribute_id : attribute_ids) {
+      if (array_metadata_->var_size(attribute_id)) {
+        uint64_t shift = block_buffers[buffer_i + 1]->size();
+        if (shift != 0) {
+          auto offsets = static_cast<uint64_t*>(buffers[buffer_i]);
+          uint64_t offset_num =
+              buffer_sizes[buffer_i] / constants::cell_var_offset_size;
+          for (uint64_t j = 0; j < offset_num; ++j)
+            offsets[j] += shift;
+        }
+        buffer_i += 2;
+      } else {
+        ++buffer_i;
+      }
+    }
+
+    // Account for the results of this round
+    for (unsigned int i = 0; i < buffer_num; ++i) {
+      if (direct_buffers[i] != nullptr) {
+        direct_offsets[i] += buffer_sizes[i];
+      } else {
+        block_buffers[i]->advance_size(buffer_sizes[i]);
+        if (((*result_sizes)[i] += buffer_sizes[i]) > max_buffer_sizes[i])
+          *fits = false;
+      }
+    }
+
+    // Grow the block buffers of the attributes that overflowed. The results
+    // do not fit if an overflowed attribute is written directly.
+    if (query.status() == QueryStatus::INCOMPLETE) {
+      buffer_i = 0;
+      for (auto attribute_id : attribute_ids) {
+        unsigned int attr_buffer_num =
+            array_metadata_->var_size(attribute_id) ? 2 : 1;
+        if (query.overflow(attribute_id)) {
+          bool grown = false;
+          for (unsigned int i = 0; i < attr_buffer_num; ++i) {
+            auto block_buffer = block_buffers[buffer_i + i];
+            if (block_buffer == nullptr)
+              continue;
+            RETURN_NOT_OK(block_buffer->realloc(MAX(
+                2 * block_buffer->alloced_size(),
+                constants::cell_var_offset_size)));
+            grown = true;
+          }
+          if (!grown)
+            *fits = false;
+        }
+        buffer_i += attr_buffer_num;
+      }
+    }
+  } while (query.status() == QueryStatus::INCOMPLETE);
+
+  return query.finalize();
+}
+
+Status ArrayReadState::read_parallel(
+    void** buffers, uint64_t* buffer_sizes, bool* done) {
+  // For easy reference
+  Datatype coords_type = array_metadata_->coords_type();
+
+  // Invoke the proper templated function. Only integer coordinates can be
+  // split into disjoint blocks at tile boundaries.
+  if (coords_type == Datatype::INT32)
+    return read_parallel<int>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::INT64)
+    return read_parallel<int64_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::INT8)
+    return read_parallel<int8_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::UINT8)
+    return read_parallel<uint8_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::INT16)
+    return read_parallel<int16_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::UINT16)
+    return read_parallel<uint16_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::UINT32)
+    return read_parallel<uint32_t>(buffers, buffer_sizes, done);
+  if (coords_type == Datatype::UINT64)
+    return read_parallel<uint64_t>(buffers, buffer_sizes, done);
+
+  *done = false;
+  return Status::Ok();
+}
+
+template <class T>
+Status ArrayReadState::read_parallel(
+    void** buffers, uint64_t* buffer_sizes, bool* done) {
+  // For easy reference
+  auto dim_num = array_metadata_->dim_num();
+  auto& attribute_ids = query_->attribute_ids();
+  auto storage_manager = query_->storage_manager();
+  auto thread_pool = storage_manager->thread_pool();
+  *done = false;
+
+  // The blocks cannot be merged into the user buffers unless all the
+  // results fit, which is certain only if their upper bounds fit
+  uint64_t user_buffer_num = 0;
+  for (auto attribute_id : attribute_ids)
+    user_buffer_num += array_metadata_->var_size(attribute_id) ? 2 : 1;
+  std::vector<uint64_t> max_buffer_sizes(user_buffer_num);
+  RETURN_NOT_OK(storage_manager->array_compute_max_read_buffer_sizes(
+      array_metadata_,
+      query_->fragment_metadata(),
+      query_->subarray(),
+      attribute_ids,
+      &max_buffer_sizes[0]));
+  for (uint64_t i = 0; i < max_buffer_sizes.size(); ++i) {
+    if (max_buffer_sizes[i] > buffer_sizes[i])
+      return Status::Ok();
+  }
+
+  // Split the subarray into blocks
+  uint64_t max_block_num = storage_manager->config().parallel_read_blocks();
+  if (max_block_num == 0)
+    max_block_num = thread_pool->thread_num();
+  std::vector<std::vector<T>> blocks;
+  compute_read_blocks<T>(max_block_num, &blocks);
+  auto block_num = (uint64_t)blocks.size();
+  if (block_num < 2)
+    return Status::Ok();
+
+  // The fixed-sized results of dense arrays (including the offsets of the
+  // variable-sized cells) are known in advance, one per cell of the block
+  std::vector<uint64_t> direct_cell_sizes;
+  for (auto attribute_id : attribute_ids) {
+    bool var_size = array_metadata_->var_size(attribute_id);
+    if (!array_metadata_->dense())
+      direct_cell_sizes.push_back(0);
+    else if (var_size)
+      direct_cell_sizes.push_back(constants::cell_var_offset_size);
+    else
+      direct_cell_sizes.push_back(array_metadata_->cell_size(attribute_id));
+    if (var_size)
+      direct_cell_sizes.push_back(0);
+  }
+  auto buffer_num = (unsigned int)direct_cell_sizes.size();
+  std::vector<uint64_t> block_cell_starts(block_num + 1, 0);
+  if (array_metadata_->dense()) {
+    for (uint64_t b = 0; b < block_num; ++b) {
+      uint64_t cell_num = 1;
+      for (unsigned int i = 0; i < dim_num; ++i)
+        cell_num *=
+            (uint64_t)blocks[b][2 * i + 1] - (uint64_t)blocks[b][2 * i] + 1;
+      block_cell_starts[b + 1] = block_cell_starts[b] + cell_num;
+    }
+  }
+
+  // Prepare the locations the results of each block are written to. The
+  // block buffers initially assume that the results are spread evenly.
+  Status st;
+  std::vector<void*> direct_buffers(block_num * buffer_num, nullptr);
+  std::vector<uint64_t> direct_buffer_sizes(block_num * buffer_num, 0);
+  std::vector<Buffer*> block_buffers(block_num * buffer_num, nullptr);
+  for (uint64_t b = 0; b < block_num; ++b) {
+    for (unsigned int i = 0; i < buffer_num; ++i) {
+      uint64_t pos = b * buffer_num + i;
+      if (direct_cell_sizes[i] != 0) {
+        direct_buffers[pos] = static_cast<char*>(buffers[i]) +
+                              block_cell_starts[b] * direct_cell_sizes[i];
+        direct_buffer_sizes[pos] =
+            (block_cell_starts[b + 1] - block_cell_starts[b]) *
+            direct_cell_sizes[i];
+      } else {
+        block_buffers[pos] = new Buffer();
+        uint64_t buffer_size = buffer_sizes[i] / block_num;
+        if (st.ok() && buffer_size != 0)
+          st = block_buffers[pos]->realloc(buffer_size);
+      }
+    }
+  }
+
+  // Read the blocks in parallel
+  std::vector<std::atomic<uint64_t>> result_sizes(buffer_num);
+  std::atomic<bool> fits(true);
+  std::vector<std::future<Status>> tasks;
+  if (st.ok()) {
+    for (uint64_t b = 0; b < block_num; ++b) {
+      uint64_t pos = b * buffer_num;
+      tasks.push_back(thread_pool->enqueue([&, b, pos]() {
+        return read_block(
+            &blocks[b][0],
+            &direct_buffers[pos],
+            &direct_buffer_sizes[pos],
+            &block_buffers[pos],
+            buffer_sizes,
+            &result_sizes,
+            &fits);
+      }));
+    }
+    st = thread_pool->wait_all(tasks);
+  }
+
+  // Copy the gathered results of each block after those of the previous
+  // blocks, shifting the offsets of the variable-sized cells accordingly
+  if (st.ok() && fits) {
+    std::vector<uint64_t> block_offsets(block_num * buffer_num);
+    std::vector<uint64_t> result_buffer_sizes(buffer_num, 0);
+    for (uint64_t b = 0; b < block_num; ++b) {
+      for (unsigned int i = 0; i < buffer_num; ++i) {
+        uint64_t pos = b * buffer_num + i;
+        block_offsets[pos] = result_buffer_sizes[i];
+        result_buffer_sizes[i] += (block_buffers[pos] != nullptr) ?
+                                      block_buffers[pos]->size() :
+                                      direct_buffer_sizes[pos];
+      }
+    }
+
+    tasks.clear();
+    for (uint64_t b = 0; b < block_num; ++b) {
+      tasks.push_back(thread_pool->enqueue([&, b]() {
+        uint64_t pos = b * buffer_num;
+        unsigned int buffer_i = 0;
+        for (auto attribute_id : attribute_ids) {
+          unsigned int attr_buffer_num =
+              array_metadata_->var_size(attribute_id) ? 2 : 1;
+          for (unsigned int i = buffer_i; i < buffer_i + attr_buffer_num;
+               ++i) {
+            if (block_buffers[pos + i] != nullptr)
+              std::memcpy(
+                  static_cast<char*>(buffers[i]) + block_offsets[pos + i],
+                  block_buffers[pos + i]->data(),
+                  block_buffers[pos + i]->size());
+          }
+          uint64_t shift =
+              (attr_buffer_num == 2) ? block_offsets[pos + buffer_i + 1] : 0;
+          if (shift != 0) {
+            auto offsets = reinterpret_cast<uint64_t*>(
+                static_cast<char*>(buffers[buffer_i]) +
+                block_offsets[pos + buffer_i]);
+            uint64_t offset_num = ((block_buffers[pos + buffer_i] != nullptr) ?
+                                       block_buffers[pos + buffer_i]->size() :
+                                       direct_buffer_sizes[pos + buffer_i]) /
+                                  constants::cell_var_offset_size;
+            for (uint64_t j = 0; j < offset_num; ++j)
+              offsets[j] += shift;
+          }
+          buffer_i += attr_buffer_num;
+        }
+        return Status::Ok();
+      }));
+    }
+    st = thread_pool->wait_all(tasks);
+
+    if (st.ok()) {
+      for (unsigned int i = 0; i < buffer_num; ++i)
+        buffer_sizes[i] = result_buffer_sizes[i];
+      *done = true;
+    }
+  }
+
+  // Clean up
+  for (auto block_buffer : block_buffers)
+    delete block_buffer;
+
+  return st;
+}
+
 Status ArrayReadState::read_sparse(void** buffers, uint64_t* buffer_sizes) {
   // For easy reference
   auto attribute_ids = query_->attribute_ids();
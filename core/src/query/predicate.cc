@@ -0,0 +1,207 @@
+/**
+ * @file   predicate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class Predicate.
+ */
+
+#include "predicate.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace tiledb {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Predicate::Predicate(
+    unsigned int attribute_id,
+    Datatype type,
+    PredicateOp op,
+    const void* value)
+    : attribute_id_(attribute_id)
+    , op_(op)
+    , type_(type) {
+  value_.resize(datatype_size(type_));
+  std::memcpy(&value_[0], value, value_.size());
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+unsigned int Predicate::attribute_id() const {
+  return attribute_id_;
+}
+
+void Predicate::check_cells(
+    const void* values, uint64_t num, uint8_t* matches) const {
+  // Invoke the proper templated function
+  switch (type_) {
+    case Datatype::INT32:
+      return check_cells<int>((const int*)values, num, matches);
+    case Datatype::INT64:
+      return check_cells<int64_t>((const int64_t*)values, num, matches);
+    case Datatype::FLOAT32:
+      return check_cells<float>((const float*)values, num, matches);
+    case Datatype::FLOAT64:
+      return check_cells<double>((const double*)values, num, matches);
+    case Datatype::INT8:
+      return check_cells<int8_t>((const int8_t*)values, num, matches);
+    case Datatype::UINT8:
+      return check_cells<uint8_t>((const uint8_t*)values, num, matches);
+    case Datatype::INT16:
+      return check_cells<int16_t>((const int16_t*)values, num, matches);
+    case Datatype::UINT16:
+      return check_cells<uint16_t>((const uint16_t*)values, num, matches);
+    case Datatype::UINT32:
+      return check_cells<uint32_t>((const uint32_t*)values, num, matches);
+    case Datatype::UINT64:
+      return check_cells<uint64_t>((const uint64_t*)values, num, matches);
+    default:
+      assert(0);
+  }
+}
+
+void Predicate::check_tiles(
+    const void* mins,
+    const void* maxs,
+    uint64_t num,
+    uint8_t* overlaps) const {
+  // Invoke the proper templated function
+  switch (type_) {
+    case Datatype::INT32:
+      return check_tiles<int>(
+          (const int*)mins, (const int*)maxs, num, overlaps);
+    case Datatype::INT64:
+      return check_tiles<int64_t>(
+          (const int64_t*)mins, (const int64_t*)maxs, num, overlaps);
+    case Datatype::FLOAT32:
+      return check_tiles<float>(
+          (const float*)mins, (const float*)maxs, num, overlaps);
+    case Datatype::FLOAT64:
+      return check_tiles<double>(
+          (const double*)mins, (const double*)maxs, num, overlaps);
+    case Datatype::INT8:
+      return check_tiles<int8_t>(
+          (const int8_t*)mins, (const int8_t*)maxs, num, overlaps);
+    case Datatype::UINT8:
+      return check_tiles<uint8_t>(
+          (const uint8_t*)mins, (const uint8_t*)maxs, num, overlaps);
+    case Datatype::INT16:
+      return check_tiles<int16_t>(
+          (const int16_t*)mins, (const int16_t*)maxs, num, overlaps);
+    case Datatype::UINT16:
+      return check_tiles<uint16_t>(
+          (const uint16_t*)mins, (const uint16_t*)maxs, num, overlaps);
+    case Datatype::UINT32:
+      return check_tiles<uint32_t>(
+          (const uint32_t*)mins, (const uint32_t*)maxs, num, overlaps);
+    case Datatype::UINT64:
+      return check_tiles<uint64_t>(
+          (const uint64_t*)mins, (const uint64_t*)maxs, num, overlaps);
+    default:
+      assert(0);
+  }
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+template <class T>
+void Predicate::check_cells(
+    const T* values, uint64_t num, uint8_t* matches) const {
+  // Each operator gets its own loop, so that the compiler can vectorize it
+  T v;
+  std::memcpy(&v, &value_[0], sizeof(T));
+  switch (op_) {
+    case PredicateOp::LT:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] < v);
+      break;
+    case PredicateOp::LE:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] <= v);
+      break;
+    case PredicateOp::GT:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] > v);
+      break;
+    case PredicateOp::GE:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] >= v);
+      break;
+    case PredicateOp::EQ:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] == v);
+      break;
+    case PredicateOp::NE:
+      for (uint64_t i = 0; i < num; ++i)
+        matches[i] &= (uint8_t)(values[i] != v);
+      break;
+  }
+}
+
+template <class T>
+void Predicate::check_tiles(
+    const T* mins, const T* maxs, uint64_t num, uint8_t* overlaps) const {
+  // NaN attribute values are not part of the statistics, and satisfy only
+  // NE, which therefore never excludes a tile
+  T v;
+  std::memcpy(&v, &value_[0], sizeof(T));
+  switch (op_) {
+    case PredicateOp::LT:
+      for (uint64_t i = 0; i < num; ++i)
+        overlaps[i] &= (uint8_t)(mins[i] < v);
+      break;
+    case PredicateOp::LE:
+      for (uint64_t i = 0; i < num; ++i)
+        overlaps[i] &= (uint8_t)(mins[i] <= v);
+      break;
+    case PredicateOp::GT:
+      for (uint64_t i = 0; i < num; ++i)
+        overlaps[i] &= (uint8_t)(maxs[i] > v);
+      break;
+    case PredicateOp::GE:
+      for (uint64_t i = 0; i < num; ++i)
+        overlaps[i] &= (uint8_t)(maxs[i] >= v);
+      break;
+    case PredicateOp::EQ:
+      for (uint64_t i = 0; i < num; ++i)
+        overlaps[i] &= (uint8_t)((mins[i] <= v) & (maxs[i] >= v));
+      break;
+    case PredicateOp::NE:
+      break;
+  }
+}
+
+}  // namespace tiledb
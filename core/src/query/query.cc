@@ -35,6 +35,7 @@
 #include "utils.h"
 
 #include <sys/time.h>
+#include <atomic>
 #include <sstream>
 
 /* ****************************** */
@@ -55,6 +56,7 @@ Query::Query() {
   storage_manager_ = nullptr;
   fragments_borrowed_ = false;
   consolidation_fragment_uri_ = URI();
+  parallel_reads_ = true;
 }
 
 Query::Query(Query* common_query) {
@@ -73,6 +75,7 @@ Query::Query(Query* common_query) {
   layout_ = common_query->layout();
   status_ = QueryStatus::INPROGRESS;
   consolidation_fragment_uri_ = common_query->consolidation_fragment_uri_;
+  parallel_reads_ = true;
 }
 
 Query::~Query() {
@@ -90,6 +93,42 @@ Query::~Query() {
 /*               API              */
 /* ****************************** */
 
+Status Query::add_predicate(
+    const char* attribute, PredicateOp op, const void* value) {
+  // Sanity checks
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add predicate; Predicates apply only to read queries"));
+  if (array_metadata_->dense())
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add predicate; Predicates apply only to sparse arrays"));
+  if (attribute == nullptr || value == nullptr)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add predicate; Invalid attribute or value"));
+
+  unsigned int attribute_id;
+  RETURN_NOT_OK(array_metadata_->attribute_id(attribute, &attribute_id));
+  if (!array_metadata_->has_tile_stats(attribute_id))
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add predicate; The attribute must store a single numeric "
+        "value per cell"));
+
+  predicates_.emplace_back(
+      attribute_id, array_metadata_->type(attribute_id), op, value);
+
+  // The fragments that are already initialized must load the statistics of
+  // the attribute and recompute the tiles they need
+  if (fragments_init_) {
+    for (auto fragment : fragments_) {
+      RETURN_NOT_OK(fragment->metadata()->load_sections(
+          storage_manager_, {attribute_id}));
+      fragment->read_state()->init_predicates();
+    }
+  }
+
+  return Status::Ok();
+}
+
 const ArrayMetadata* Query::array_metadata() const {
   return array_metadata_;
 }
@@ -327,6 +366,14 @@ Status Query::overflow(
   return Status::Ok();
 }
 
+bool Query::parallel_reads() const {
+  return parallel_reads_;
+}
+
+const std::vector<Predicate>& Query::predicates() const {
+  return predicates_;
+}
+
 Status Query::read() {
   // Handle case of no fragments
   if (fragments_.empty()) {
@@ -377,6 +424,14 @@ void Query::set_callback(void* (*callback)(void*), void* callback_data) {
   callback_data_ = callback_data;
 }
 
+void Query::set_parallel_reads(bool parallel_reads) {
+  parallel_reads_ = parallel_reads;
+}
+
+void Query::set_predicates(const std::vector<Predicate>& predicates) {
+  predicates_ = predicates;
+}
+
 void Query::set_status(QueryStatus status) {
   status_ = status;
 }
@@ -530,6 +585,15 @@ std::string Query::new_fragment_name() const {
   struct timeval tp = {};
   gettimeofday(&tp, nullptr);
   uint64_t ms = (uint64_t)tp.tv_sec * 1000L + tp.tv_usec / 1000;
+
+  // Fragments are ordered by their timestamps, which must hence be unique
+  // even if several fragments are created within the same millisecond
+  static std::atomic<uint64_t> last_ms(0);
+  uint64_t prev_ms = last_ms.load();
+  do {
+    if (ms <= prev_ms)
+      ms = prev_ms + 1;
+  } while (!last_ms.compare_exchange_weak(prev_ms, ms));
   char fragment_name[constants::name_max_len];
 
   std::stringstream ss;
@@ -0,0 +1,243 @@
+/**
+ * @file   config.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class Config.
+ */
+
+#include "config.h"
+#include "constants.h"
+#include "logger.h"
+#include "utils.h"
+
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace tiledb {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Config::Config() {
+  parse_compressors(
+      "sm.adaptive_compressors",
+      constants::adaptive_compressors,
+      &adaptive_compressors_);
+  adaptive_decode_weight_ = 0;
+  num_threads_ = std::thread::hardware_concurrency();
+  if (num_threads_ == 0)
+    num_threads_ = constants::num_threads;
+  parallel_read_blocks_ = 0;
+  tile_cache_size_ = constants::tile_cache_size;
+  vfs_max_open_files_ = constants::vfs_max_open_files;
+  vfs_mmap_reads_ = false;
+  vfs_io_uring_ = true;
+  vfs_async_threads_ = constants::vfs_async_threads;
+}
+
+Config::~Config() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+const std::vector<std::pair<Compressor, int>>& Config::adaptive_compressors()
+    const {
+  return adaptive_compressors_;
+}
+
+uint64_t Config::adaptive_decode_weight() const {
+  return adaptive_decode_weight_;
+}
+
+unsigned int Config::num_threads() const {
+  return num_threads_;
+}
+
+uint64_t Config::parallel_read_blocks() const {
+  return parallel_read_blocks_;
+}
+
+Status Config::set(const std::string& param, const std::string& value) {
+  uint64_t v;
+  if (param == "sm.adaptive_compressors") {
+    RETURN_NOT_OK(parse_compressors(param, value, &adaptive_compressors_));
+  } else if (param == "sm.adaptive_decode_weight") {
+    RETURN_NOT_OK(
+        parse_non_negative_integer(param, value, &adaptive_decode_weight_));
+  } else if (param == "sm.num_threads") {
+    RETURN_NOT_OK(parse_positive_integer(param, value, &v));
+    if (v > UINT_MAX)
+      return LOG_STATUS(Status::ConfigError(
+          "Cannot set parameter 'sm.num_threads'; Value out of range"));
+    num_threads_ = (unsigned int)v;
+  } else if (param == "sm.parallel_read_blocks") {
+    RETURN_NOT_OK(
+        parse_non_negative_integer(param, value, &parallel_read_blocks_));
+  } else if (param == "sm.tile_cache_size") {
+    RETURN_NOT_OK(parse_non_negative_integer(param, value, &tile_cache_size_));
+  } else if (param == "vfs.max_open_files") {
+    RETURN_NOT_OK(
+        parse_non_negative_integer(param, value, &vfs_max_open_files_));
+  } else if (param == "vfs.mmap_reads") {
+    RETURN_NOT_OK(parse_bool(param, value, &vfs_mmap_reads_));
+  } else if (param == "vfs.io_uring") {
+    RETURN_NOT_OK(parse_bool(param, value, &vfs_io_uring_));
+  } else if (param == "vfs.async_threads") {
+    RETURN_NOT_OK(parse_positive_integer(param, value, &v));
+    if (v > UINT_MAX)
+      return LOG_STATUS(Status::ConfigError(
+          "Cannot set parameter 'vfs.async_threads'; Value out of range"));
+    vfs_async_threads_ = (unsigned int)v;
+  } else {
+    return LOG_STATUS(
+        Status::ConfigError("Cannot set parameter; Unknown parameter '" +
+                            param + "'"));
+  }
+
+  return Status::Ok();
+}
+
+uint64_t Config::tile_cache_size() const {
+  return tile_cache_size_;
+}
+
+unsigned int Config::vfs_async_threads() const {
+  return vfs_async_threads_;
+}
+
+bool Config::vfs_io_uring() const {
+  return vfs_io_uring_;
+}
+
+uint64_t Config::vfs_max_open_files() const {
+  return vfs_max_open_files_;
+}
+
+bool Config::vfs_mmap_reads() const {
+  return vfs_mmap_reads_;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+Status Config::parse_bool(
+    const std::string& param, const std::string& value, bool* result) const {
+  if (value == "true") {
+    *result = true;
+  } else if (value == "false") {
+    *result = false;
+  } else {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter '" + param + "'; Value must be 'true' or "
+        "'false'"));
+  }
+
+  return Status::Ok();
+}
+
+Status Config::parse_compressors(
+    const std::string& param,
+    const std::string& value,
+    std::vector<std::pair<Compressor, int>>* result) const {
+  std::vector<std::pair<Compressor, int>> compressors;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    // Split the compression level
+    std::string name = item.substr(0, item.find(':'));
+    int level = -1;
+    if (name.size() < item.size()) {
+      std::string level_str = item.substr(name.size() + 1);
+      if (level_str.empty() ||
+          !utils::is_positive_integer(level_str.c_str()) ||
+          std::strtoull(level_str.c_str(), nullptr, 10) > INT_MAX)
+        return LOG_STATUS(Status::ConfigError(
+            "Cannot set parameter '" + param + "'; Invalid compression "
+            "level in '" + item + "'"));
+      level = (int)std::strtoull(level_str.c_str(), nullptr, 10);
+    }
+
+    // Look up the compressor name
+    bool found = false;
+    for (int c = 0; c < (int)Compressor::ADAPTIVE && !found; ++c) {
+      if (name == compressor_str((Compressor)c)) {
+        compressors.emplace_back((Compressor)c, level);
+        found = true;
+      }
+    }
+    if (!found)
+      return LOG_STATUS(Status::ConfigError(
+          "Cannot set parameter '" + param + "'; Unknown compressor '" +
+          name + "'"));
+  }
+
+  if (compressors.empty())
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter '" + param + "'; Value must be a "
+        "comma-separated list of compressors"));
+
+  *result = std::move(compressors);
+
+  return Status::Ok();
+}
+
+Status Config::parse_non_negative_integer(
+    const std::string& param,
+    const std::string& value,
+    uint64_t* result) const {
+  if (value == "0") {
+    *result = 0;
+    return Status::Ok();
+  }
+
+  return parse_positive_integer(param, value, result);
+}
+
+Status Config::parse_positive_integer(
+    const std::string& param,
+    const std::string& value,
+    uint64_t* result) const {
+  if (value.empty() || !utils::is_positive_integer(value.c_str()))
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter '" + param + "'; Value must be a positive "
+        "integer"));
+
+  *result = std::strtoull(value.c_str(), nullptr, 10);
+  if (*result == 0 || *result == ULLONG_MAX)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter '" + param + "'; Value out of range"));
+
+  return Status::Ok();
+}
+
+}  // namespace tiledb
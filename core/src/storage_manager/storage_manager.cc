@@ -33,6 +33,7 @@
 
 #include <blosc.h>
 #include <algorithm>
+#include <cstring>
 
 #include "logger.h"
 #include "storage_manager.h"
@@ -49,6 +50,8 @@ StorageManager::StorageManager() {
   async_thread_[0] = nullptr;
   async_thread_[1] = nullptr;
   consolidator_ = new Consolidator(this);
+  thread_pool_ = nullptr;
+  tile_cache_ = nullptr;
   vfs_ = nullptr;
   blosc_init();
 }
@@ -57,6 +60,8 @@ StorageManager::~StorageManager() {
   async_stop();
   delete async_thread_[0];
   delete async_thread_[1];
+  delete thread_pool_;
+  delete tile_cache_;
   delete vfs_;
   blosc_destroy();
 }
@@ -65,6 +70,80 @@ StorageManager::~StorageManager() {
 /*               API              */
 /* ****************************** */
 
+Status StorageManager::array_compute_max_read_buffer_sizes(
+    const char* array_name,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num,
+    uint64_t* buffer_sizes) {
+  // Open the array
+  std::vector<FragmentMetadata*> fragment_metadata;
+  auto array_metadata = (const ArrayMetadata*)nullptr;
+  RETURN_NOT_OK(array_open(
+      URI(array_name),
+      QueryType::READ,
+      subarray,
+      &array_metadata,
+      &fragment_metadata));
+
+  // Compute the buffer sizes
+  Status st = array_compute_max_read_buffer_sizes(
+      array_metadata,
+      fragment_metadata,
+      subarray,
+      attributes,
+      attribute_num,
+      buffer_sizes);
+
+  // Close the array
+  Status st_close =
+      array_close(array_metadata->array_uri(), fragment_metadata);
+
+  return st.ok() ? st_close : st;
+}
+
+Status StorageManager::array_compute_max_read_buffer_sizes(
+    const ArrayMetadata* array_metadata,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    const void* subarray,
+    const std::vector<unsigned int>& attribute_ids,
+    uint64_t* buffer_sizes) {
+  // The subarray defaults to the entire domain
+  auto domain = array_metadata->domain();
+  if (subarray == nullptr)
+    subarray = domain->domain();
+
+  // Add the contribution of every fragment
+  uint64_t buffer_num = 0;
+  for (auto attribute_id : attribute_ids)
+    buffer_num += array_metadata->var_size(attribute_id) ? 2 : 1;
+  std::memset(buffer_sizes, 0, buffer_num * sizeof(uint64_t));
+  for (auto metadata : fragment_metadata)
+    RETURN_NOT_OK(metadata->add_max_read_buffer_sizes(
+        this, subarray, attribute_ids, buffer_sizes));
+
+  // A dense read returns every cell of the subarray, which is either found
+  // in some fragment or empty
+  if (array_metadata->dense()) {
+    uint64_t cell_num = domain->cell_num(subarray);
+    uint64_t b = 0;
+    for (auto attribute_id : attribute_ids) {
+      if (!array_metadata->var_size(attribute_id)) {
+        buffer_sizes[b++] = cell_num * array_metadata->cell_size(attribute_id);
+        continue;
+      }
+      buffer_sizes[b++] = cell_num * constants::cell_var_offset_size;
+      // The free space for each empty value is checked in units of at least
+      // an int (see ArrayReadState::copy_cells_with_empty_var_generic)
+      uint64_t empty_size = std::max<uint64_t>(
+          datatype_size(array_metadata->type(attribute_id)), sizeof(int));
+      buffer_sizes[b++] += cell_num * empty_size;
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status StorageManager::array_consolidate(const char* array_name) {
   // Check array URI
   URI array_uri(array_name);
@@ -182,6 +261,10 @@ Status StorageManager::async_push_query(Query* query, int i) {
   return Status::Ok();
 }
 
+const Config& StorageManager::config() const {
+  return config_;
+}
+
 Status StorageManager::create_dir(const URI& uri) {
   return vfs_->create_dir(uri);
 }
@@ -196,6 +279,7 @@ Status StorageManager::delete_fragment(const URI& uri) const {
         "Cannot delete fragment directory; '" + uri.to_string() +
         "' is not a TileDB fragment"));
   }
+  tile_cache_->invalidate(uri);
   return vfs_->remove_path(uri);
 }
 
@@ -204,6 +288,7 @@ Status StorageManager::remove_path(const URI& uri) const {
     return LOG_STATUS(Status::StorageManagerError(
         "Not a valid TileDB object: " + uri.to_string()));
   }
+  tile_cache_->invalidate(uri);
   return vfs_->remove_path(uri);
 }
 
@@ -214,6 +299,8 @@ Status StorageManager::move(
         "Not a valid TileDB object: " + old_uri.to_string()));
   }
 
+  tile_cache_->invalidate(old_uri);
+  tile_cache_->invalidate(new_uri);
   return vfs_->move_path(old_uri, new_uri);
 }
 
@@ -234,10 +321,17 @@ Status StorageManager::group_create(const std::string& group) const {
   return Status::Ok();
 }
 
-Status StorageManager::init() {
+Status StorageManager::init(Config* config) {
+  if (config != nullptr)
+    config_ = *config;
+
+  thread_pool_ = new ThreadPool();
+  RETURN_NOT_OK(thread_pool_->init(config_.num_threads()));
+  tile_cache_ = new TileCache(config_.tile_cache_size());
   async_thread_[0] = new std::thread(async_start, this, 0);
   async_thread_[1] = new std::thread(async_start, this, 1);
   vfs_ = new VFS();
+  RETURN_NOT_OK(vfs_->init(config_));
 
   return Status::Ok();
 }
@@ -291,15 +385,37 @@ Status StorageManager::load(FragmentMetadata* fragment_metadata) {
   URI fragment_metadata_uri = fragment_uri.join_path(
       std::string(constants::fragment_metadata_filename));
 
+  // Read the trailer, which holds the footer offset and the magic number
+  // (the files of earlier versions consist of a single generic tile)
+  uint64_t file_size;
+  RETURN_NOT_OK(vfs_->file_size(fragment_metadata_uri, &file_size));
+  uint64_t trailer[2] = {0, 0};
+  if (file_size >= sizeof(trailer)) {
+    auto buff = new Buffer();
+    RETURN_NOT_OK_ELSE(
+        read_from_file(
+            fragment_metadata_uri,
+            file_size - sizeof(trailer),
+            buff,
+            sizeof(trailer)),
+        delete buff);
+    RETURN_NOT_OK_ELSE(buff->read(trailer, sizeof(trailer)), delete buff);
+    delete buff;
+  }
+  bool sectioned = (trailer[1] == constants::fragment_metadata_magic);
+
   // Read from file
   auto tile = (Tile*)nullptr;
   auto tile_io = new TileIO(this, fragment_metadata_uri);
-  RETURN_NOT_OK_ELSE(tile_io->read_generic(&tile, 0), delete tile_io);
+  RETURN_NOT_OK_ELSE(
+      tile_io->read_generic(&tile, sectioned ? trailer[0] : 0),
+      delete tile_io);
 
   // Deserialize
   tile->reset_offset();
   auto cbuff = new ConstBuffer(tile->buffer());
-  Status st = fragment_metadata->deserialize(cbuff);
+  Status st = sectioned ? fragment_metadata->deserialize_footer(cbuff) :
+                          fragment_metadata->deserialize(cbuff);
 
   delete cbuff;
   delete tile;
@@ -310,6 +426,8 @@ Status StorageManager::load(FragmentMetadata* fragment_metadata) {
 
 Status StorageManager::move_path(
     const URI& old_uri, const URI& new_uri, bool force) {
+  tile_cache_->invalidate(old_uri);
+  tile_cache_->invalidate(new_uri);
   return vfs_->move_path(old_uri, new_uri);
 }
 
@@ -491,6 +609,25 @@ Status StorageManager::query_submit_async(
   return async_push_query(query, 0);
 }
 
+Status StorageManager::map_file(
+    const URI& uri, uint64_t nbytes, void** data) const {
+  return vfs_->map_file(uri, nbytes, data);
+}
+
+Status StorageManager::advise_mapped(
+    const URI& uri,
+    void* data,
+    uint64_t offset,
+    uint64_t nbytes,
+    MmapAdvice advice) const {
+  return vfs_->advise_mapped(uri, data, offset, nbytes, advice);
+}
+
+Status StorageManager::unmap_file(
+    const URI& uri, void* data, uint64_t nbytes) const {
+  return vfs_->unmap_file(uri, data, nbytes);
+}
+
 Status StorageManager::read_from_file(
     const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const {
   RETURN_NOT_OK(buffer->realloc(nbytes));
@@ -501,6 +638,21 @@ Status StorageManager::read_from_file(
   return Status::Ok();
 }
 
+Status StorageManager::read_from_file_async(
+    const URI& uri,
+    uint64_t offset,
+    Buffer* buffer,
+    uint64_t nbytes,
+    uint64_t* request_id) const {
+  RETURN_NOT_OK(buffer->realloc(nbytes));
+  RETURN_NOT_OK(vfs_->read_from_file_async(
+      uri, offset, buffer->data(), nbytes, request_id));
+  buffer->set_size(nbytes);
+  buffer->reset_offset();
+
+  return Status::Ok();
+}
+
 Status StorageManager::store(ArrayMetadata* array_metadata) {
   URI array_metadata_uri =
       array_metadata->array_uri().join_path(constants::array_metadata_filename);
@@ -524,7 +676,8 @@ Status StorageManager::store(ArrayMetadata* array_metadata) {
       buff,
       false);
   auto tile_io = new TileIO(this, array_metadata_uri);
-  Status st = tile_io->write_generic(tile);
+  uint64_t nbytes;
+  Status st = tile_io->write_generic(tile, &nbytes);
 
   delete tile;
   delete tile_io;
@@ -539,28 +692,40 @@ Status StorageManager::store(FragmentMetadata* metadata) {
   if (!vfs_->is_dir(fragment_uri))
     return Status::Ok();
 
-  // Serialize
-  auto buff = new Buffer();
-  RETURN_NOT_OK_ELSE(metadata->serialize(buff), delete buff);
-
-  // Write to file
   URI fragment_metadata_uri = fragment_uri.join_path(
       std::string(constants::fragment_metadata_filename));
-  buff->reset_offset();
-  auto tile = new Tile(
-      constants::generic_tile_datatype,
-      constants::generic_tile_compressor,
-      constants::generic_tile_compression_level,
-      constants::generic_tile_cell_size,
-      0,
-      buff,
-      false);
 
-  auto tile_io = new TileIO(this, fragment_metadata_uri);
-  Status st = tile_io->write_generic(tile);
+  // Serialize and write the sections
+  unsigned int section_num = metadata->section_num();
+  std::vector<uint64_t> section_offsets(section_num);
+  uint64_t offset = 0;
+  uint64_t nbytes;
+  for (unsigned int i = 0; i < section_num; ++i) {
+    auto buff = new Buffer();
+    RETURN_NOT_OK_ELSE(metadata->serialize_section(i, buff), delete buff);
+    RETURN_NOT_OK_ELSE(
+        write_generic_tile(fragment_metadata_uri, buff, &nbytes), delete buff);
+    delete buff;
+    section_offsets[i] = offset;
+    offset += nbytes;
+  }
+
+  // Serialize and write the footer
+  auto buff = new Buffer();
+  RETURN_NOT_OK_ELSE(
+      metadata->serialize_footer(section_offsets, buff), delete buff);
+  RETURN_NOT_OK_ELSE(
+      write_generic_tile(fragment_metadata_uri, buff, &nbytes), delete buff);
+
+  // Write the trailer
+  buff->reset_size();
+  buff->reset_offset();
+  RETURN_NOT_OK_ELSE(buff->write(&offset, sizeof(uint64_t)), delete buff);
+  RETURN_NOT_OK_ELSE(
+      buff->write(&constants::fragment_metadata_magic, sizeof(uint64_t)),
+      delete buff);
+  Status st = write_to_file(fragment_metadata_uri, buff);
 
-  delete tile;
-  delete tile_io;
   delete buff;
 
   return st;
@@ -570,10 +735,31 @@ Status StorageManager::sync(const URI& uri) {
   return vfs_->sync(uri);
 }
 
+ThreadPool* StorageManager::thread_pool() const {
+  return thread_pool_;
+}
+
+TileCache* StorageManager::tile_cache() const {
+  return tile_cache_;
+}
+
+Status StorageManager::wait_async(uint64_t request_id) const {
+  return vfs_->wait_async(request_id);
+}
+
 Status StorageManager::write_to_file(const URI& uri, Buffer* buffer) const {
   return vfs_->write_to_file(uri, buffer->data(), buffer->size());
 }
 
+Status StorageManager::write_to_file_async(
+    const URI& uri,
+    uint64_t offset,
+    Buffer* buffer,
+    uint64_t* request_id) const {
+  return vfs_->write_to_file_async(
+      uri, offset, buffer->data(), buffer->size(), request_id);
+}
+
 /* ****************************** */
 /*         PRIVATE METHODS        */
 /* ****************************** */
@@ -626,6 +812,39 @@ Status StorageManager::array_close(
   return Status::Ok();
 }
 
+Status StorageManager::array_compute_max_read_buffer_sizes(
+    const ArrayMetadata* array_metadata,
+    const std::vector<FragmentMetadata*>& fragment_metadata,
+    const void* subarray,
+    const char** attributes,
+    unsigned int attribute_num,
+    uint64_t* buffer_sizes) {
+  // Get the attributes, as in the read queries
+  std::vector<std::string> attributes_vec;
+  if (attributes == nullptr) {
+    attributes_vec = array_metadata->attribute_names();
+    if (array_metadata->dense())
+      attributes_vec.pop_back();
+  } else {
+    for (unsigned int i = 0; i < attribute_num; ++i) {
+      if (attributes[i] == nullptr ||
+          strlen(attributes[i]) > constants::name_max_len)
+        return LOG_STATUS(Status::StorageManagerError(
+            "Cannot compute read buffer sizes; Invalid attribute name length"));
+      attributes_vec.emplace_back(attributes[i]);
+    }
+    if (utils::has_duplicates(attributes_vec))
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot compute read buffer sizes; Duplicate attributes"));
+  }
+  std::vector<unsigned int> attribute_ids;
+  RETURN_NOT_OK(
+      array_metadata->get_attribute_ids(attributes_vec, attribute_ids));
+
+  return array_compute_max_read_buffer_sizes(
+      array_metadata, fragment_metadata, subarray, attribute_ids, buffer_sizes);
+}
+
 Status StorageManager::array_open(
     const URI& array_uri,
     QueryType type,
@@ -836,4 +1055,24 @@ void StorageManager::sort_fragment_uris(std::vector<URI>* fragment_uris) const {
   *fragment_uris = fragment_uris_sorted;
 }
 
+Status StorageManager::write_generic_tile(
+    const URI& uri, Buffer* buff, uint64_t* nbytes) {
+  buff->reset_offset();
+  auto tile = new Tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_compressor,
+      constants::generic_tile_compression_level,
+      constants::generic_tile_cell_size,
+      0,
+      buff,
+      false);
+  auto tile_io = new TileIO(this, uri);
+  Status st = tile_io->write_generic(tile, nbytes);
+
+  delete tile;
+  delete tile_io;
+
+  return st;
+}
+
 }  // namespace tiledb
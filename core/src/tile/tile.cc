@@ -31,6 +31,7 @@
  */
 
 #include "tile.h"
+#include "constants.h"
 #include "logger.h"
 
 #include <iostream>
@@ -44,9 +45,11 @@ namespace tiledb {
 Tile::Tile(unsigned int dim_num) {
   buffer_ = nullptr;
   cell_size_ = 0;
+  chunk_size_ = constants::default_tile_chunk_size;
   compressor_ = Compressor::NO_COMPRESSION;
   compression_level_ = -1;
   dim_num_ = dim_num;
+  filter_ = Filter::NO_FILTER;
   owns_buff_ = true;
   type_ = Datatype::INT32;
 }
@@ -61,9 +64,11 @@ Tile::Tile(
     bool owns_buff)
     : buffer_(buff)
     , cell_size_(cell_size)
+    , chunk_size_(constants::default_tile_chunk_size)
     , compressor_(compressor)
     , compression_level_(compression_level)
     , dim_num_(dim_num)
+    , filter_(Filter::NO_FILTER)
     , owns_buff_(owns_buff)
     , type_(type) {
 }
@@ -76,9 +81,11 @@ Tile::Tile(
     uint64_t cell_size,
     unsigned int dim_num)
     : cell_size_(cell_size)
+    , chunk_size_(constants::default_tile_chunk_size)
     , compressor_(compressor)
     , compression_level_(compression_level)
     , dim_num_(dim_num)
+    , filter_(Filter::NO_FILTER)
     , type_(type) {
   buffer_ = new Buffer();
   buffer_->realloc(tile_size);
@@ -91,8 +98,10 @@ Tile::Tile(
     uint64_t cell_size,
     unsigned int dim_num)
     : cell_size_(cell_size)
+    , chunk_size_(constants::default_tile_chunk_size)
     , compressor_(compressor)
     , dim_num_(dim_num)
+    , filter_(Filter::NO_FILTER)
     , type_(type) {
   buffer_ = new Buffer();
   compression_level_ = -1;
@@ -120,6 +129,10 @@ uint64_t Tile::cell_size() const {
   return cell_size_;
 }
 
+uint64_t Tile::chunk_size() const {
+  return chunk_size_;
+}
+
 Compressor Tile::compressor() const {
   return compressor_;
 }
@@ -144,6 +157,10 @@ bool Tile::empty() const {
   return buffer_->size() == 0;
 }
 
+Filter Tile::filter() const {
+  return filter_;
+}
+
 bool Tile::full() const {
   return (buffer_->size() != 0) &&
          (buffer_->offset() == buffer_->alloced_size());
@@ -171,6 +188,14 @@ void Tile::reset_size() {
   buffer_->reset_size();
 }
 
+void Tile::set_chunk_size(uint64_t chunk_size) {
+  chunk_size_ = chunk_size;
+}
+
+void Tile::set_filter(Filter filter) {
+  filter_ = filter;
+}
+
 void Tile::set_offset(uint64_t offset) {
   buffer_->set_offset(offset);
 }
@@ -0,0 +1,169 @@
+/**
+ * @file   tile_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileCache.
+ */
+
+#include "tile_cache.h"
+
+#include <cstring>
+
+namespace tiledb {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TileCache::TileCache(uint64_t max_size)
+    : hits_(0)
+    , max_size_(max_size)
+    , misses_(0)
+    , size_(0) {
+}
+
+TileCache::~TileCache() {
+  for (auto& entry : entries_)
+    delete entry.buffer_;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+uint64_t TileCache::hits() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return hits_;
+}
+
+Status TileCache::insert(
+    const URI& fragment_uri,
+    unsigned int attribute_id,
+    uint64_t tile_idx,
+    bool var,
+    const Buffer* buffer) {
+  uint64_t nbytes = buffer->size();
+  if (nbytes == 0 || nbytes > max_size_)
+    return Status::Ok();
+
+  // Copy the tile outside the lock
+  auto copy = new Buffer();
+  RETURN_NOT_OK_ELSE(copy->write(buffer->data(), nbytes), delete copy);
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Replace any older copy of the tile
+  Key key(fragment_uri.to_string(), attribute_id, tile_idx, var);
+  auto it = index_.find(key);
+  if (it != index_.end())
+    remove(it);
+
+  // Insert and evict the least recently used tiles
+  entries_.push_front(Entry{key, copy});
+  index_[key] = entries_.begin();
+  size_ += nbytes;
+  while (size_ > max_size_)
+    remove(index_.find(entries_.back().key_));
+
+  return Status::Ok();
+}
+
+void TileCache::invalidate(const URI& uri) {
+  std::string prefix = uri.to_string();
+  while (!prefix.empty() && prefix.back() == '/')
+    prefix.pop_back();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // All the fragment URIs that start with the prefix are consecutive in
+  // the index
+  auto it = index_.lower_bound(Key(prefix, 0, 0, false));
+  while (it != index_.end() &&
+         std::get<0>(it->first).compare(0, prefix.size(), prefix) == 0) {
+    const std::string& fragment_uri = std::get<0>(it->first);
+    if (fragment_uri.size() == prefix.size() ||
+        fragment_uri[prefix.size()] == '/')
+      it = remove(it);
+    else
+      ++it;
+  }
+}
+
+uint64_t TileCache::misses() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return misses_;
+}
+
+Status TileCache::read(
+    const URI& fragment_uri,
+    unsigned int attribute_id,
+    uint64_t tile_idx,
+    bool var,
+    Buffer* buffer,
+    bool* hit) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto it =
+      index_.find(Key(fragment_uri.to_string(), attribute_id, tile_idx, var));
+  if (it == index_.end()) {
+    ++misses_;
+    *hit = false;
+    return Status::Ok();
+  }
+
+  // Copy the tile and make it the most recently used one
+  const Buffer* cached = it->second->buffer_;
+  RETURN_NOT_OK(buffer->realloc(cached->size()));
+  std::memcpy(buffer->data(), cached->data(), cached->size());
+  buffer->set_size(cached->size());
+  buffer->reset_offset();
+  entries_.splice(entries_.begin(), entries_, it->second);
+
+  ++hits_;
+  *hit = true;
+  return Status::Ok();
+}
+
+uint64_t TileCache::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return size_;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+std::map<TileCache::Key, std::list<TileCache::Entry>::iterator>::iterator
+TileCache::remove(std::map<Key, std::list<Entry>::iterator>::iterator it) {
+  size_ -= it->second->buffer_->size();
+  delete it->second->buffer_;
+  entries_.erase(it->second);
+  return index_.erase(it);
+}
+
+}  // namespace tiledb
@@ -31,16 +31,24 @@
  */
 
 #include "tile_io.h"
+#include "block_dd_compressor.h"
 #include "blosc_compressor.h"
 #include "bzip_compressor.h"
 #include "dd_compressor.h"
+#include "filter_kernels.h"
+#include "gorilla_compressor.h"
 #include "gzip_compressor.h"
 #include "logger.h"
 #include "lz4_compressor.h"
 #include "rle_compressor.h"
+#include "utils.h"
 #include "zstd_compressor.h"
 
+#include <cstring>
+#include <future>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 /* ****************************** */
 /*             MACROS             */
@@ -50,6 +58,89 @@
 
 namespace tiledb {
 
+/* ****************************** */
+/*        STATIC FUNCTIONS        */
+/* ****************************** */
+
+/**
+ * Returns the rough relative cost of decompressing 100 bytes with the input
+ * compressor, which ADAPTIVE compression weighs against the compressed size.
+ */
+static uint64_t adaptive_decode_cost(Compressor compressor) {
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      return 0;
+    case Compressor::LZ4:
+    case Compressor::RLE:
+    case Compressor::BLOSC:
+    case Compressor::BLOSC_LZ4:
+    case Compressor::BLOSC_LZ4HC:
+    case Compressor::BLOSC_SNAPPY:
+      return 1;
+    case Compressor::BLOCK_DOUBLE_DELTA:
+      return 2;
+    case Compressor::ZSTD:
+    case Compressor::BLOSC_ZSTD:
+    case Compressor::GORILLA:
+      return 3;
+    case Compressor::DOUBLE_DELTA:
+      return 4;
+    case Compressor::GZIP:
+    case Compressor::BLOSC_ZLIB:
+      return 6;
+    case Compressor::BZIP2:
+      return 30;
+    case Compressor::ADAPTIVE:
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * Returns *true* if the input byte, read in front of an ADAPTIVE chunk, names
+ * a compressor that ADAPTIVE compression may have selected for the chunk.
+ */
+static bool adaptive_chunk_compressor_valid(uint8_t compressor) {
+  switch ((Compressor)compressor) {
+    case Compressor::NO_COMPRESSION:
+    case Compressor::GZIP:
+    case Compressor::ZSTD:
+    case Compressor::LZ4:
+    case Compressor::BLOSC:
+    case Compressor::BLOSC_LZ4:
+    case Compressor::BLOSC_LZ4HC:
+    case Compressor::BLOSC_SNAPPY:
+    case Compressor::BLOSC_ZLIB:
+    case Compressor::BLOSC_ZSTD:
+    case Compressor::RLE:
+    case Compressor::BZIP2:
+    case Compressor::DOUBLE_DELTA:
+    case Compressor::BLOCK_DOUBLE_DELTA:
+    case Compressor::GORILLA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Returns *true* if ADAPTIVE compression may try the input compressor. */
+static bool adaptive_candidate_applies(Compressor compressor, Tile* tile) {
+  auto type = tile->type();
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+    case Compressor::ADAPTIVE:
+      return false;
+    case Compressor::DOUBLE_DELTA:
+    case Compressor::BLOCK_DOUBLE_DELTA:
+      return type != Datatype::FLOAT32 && type != Datatype::FLOAT64;
+    case Compressor::GORILLA:
+      return datatype_size(type) == 4 || datatype_size(type) == 8;
+    default:
+      return true;
+  }
+}
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -59,6 +150,22 @@ TileIO::TileIO(StorageManager* storage_manager, const URI& uri)
     , uri_(uri) {
   file_size_ = 0;
   buffer_ = new Buffer();
+  dictionary_ = nullptr;
+  std::memcpy(format_version_, constants::version, sizeof(format_version_));
+  mmap_data_ = nullptr;
+  mmap_enabled_ = false;
+  mmap_sequential_ = false;
+  range_offset_ = 0;
+  range_size_ = 0;
+  async_buffer_ = new Buffer();
+  async_range_offset_ = 0;
+  async_range_size_ = 0;
+  async_request_id_ = 0;
+  write_behind_ = false;
+  write_buffer_ = new Buffer();
+  write_flush_buffer_ = new Buffer();
+  write_pending_ = false;
+  write_request_id_ = 0;
 }
 
 TileIO::TileIO(
@@ -67,38 +174,141 @@ TileIO::TileIO(
     , storage_manager_(storage_manager)
     , uri_(uri) {
   buffer_ = new Buffer();
+  dictionary_ = nullptr;
+  std::memcpy(format_version_, constants::version, sizeof(format_version_));
+  mmap_data_ = nullptr;
+  mmap_enabled_ = false;
+  mmap_sequential_ = false;
+  range_offset_ = 0;
+  range_size_ = 0;
+  async_buffer_ = new Buffer();
+  async_range_offset_ = 0;
+  async_range_size_ = 0;
+  async_request_id_ = 0;
+  write_behind_ = false;
+  write_buffer_ = new Buffer();
+  write_flush_buffer_ = new Buffer();
+  write_pending_ = false;
+  write_request_id_ = 0;
 }
 
 TileIO::~TileIO() {
+  // The buffer of a pending read must outlive it
+  if (async_range_size_ != 0)
+    storage_manager_->wait_async(async_request_id_);
+  if (write_pending_)
+    storage_manager_->wait_async(write_request_id_);
+  delete async_buffer_;
   delete buffer_;
+  delete write_buffer_;
+  delete write_flush_buffer_;
+  if (mmap_data_ != nullptr)
+    storage_manager_->unmap_file(uri_, mmap_data_, file_size_);
 }
 
 /* ****************************** */
 /*               API              */
 /* ****************************** */
 
+Status TileIO::append_dictionary_samples(
+    Tile* tile, Buffer* samples, std::vector<uint64_t>* sample_sizes) {
+  // For easy reference
+  auto tile_size = tile->size();
+  auto tile_data = (const char*)tile->data();
+
+  // The samples are the tile chunks, as they are handed to the compressor
+  uint64_t chunk_num, max_chunk_size, overhead;
+  RETURN_NOT_OK(
+      compute_chunking_info(tile, &chunk_num, &max_chunk_size, &overhead));
+  Buffer filtered;
+  for (uint64_t i = 0; i < chunk_num; ++i) {
+    uint64_t chunk_offset = i * max_chunk_size;
+    uint64_t chunk_size = MIN(tile_size - chunk_offset, max_chunk_size);
+    const char* chunk = tile_data + chunk_offset;
+    if (tile->filter() != Filter::NO_FILTER) {
+      RETURN_NOT_OK(filtered.realloc(chunk_size));
+      RETURN_NOT_OK(FilterKernels::apply(
+          tile->filter(), tile->type(), chunk, chunk_size, filtered.data()));
+      chunk = (const char*)filtered.data();
+    }
+    RETURN_NOT_OK(samples->write(chunk, chunk_size));
+    sample_sizes->push_back(chunk_size);
+  }
+
+  return Status::Ok();
+}
+
+void TileIO::enable_mmap(bool sequential) {
+  mmap_enabled_ = true;
+  mmap_sequential_ = sequential;
+}
+
+void TileIO::enable_write_behind() {
+  write_behind_ = uri_.is_posix();
+}
+
 uint64_t TileIO::file_size() const {
   return file_size_;
 }
 
+Status TileIO::flush() {
+  RETURN_NOT_OK(flush_async());
+  if (write_pending_) {
+    write_pending_ = false;
+    RETURN_NOT_OK(storage_manager_->wait_async(write_request_id_));
+  }
+
+  return Status::Ok();
+}
+
+bool TileIO::in_range(uint64_t file_offset, uint64_t nbytes) const {
+  return range_size_ != 0 && file_offset >= range_offset_ &&
+         file_offset + nbytes <= range_offset_ + range_size_;
+}
+
+bool TileIO::in_async_range(uint64_t file_offset, uint64_t nbytes) const {
+  return async_range_size_ != 0 && file_offset >= async_range_offset_ &&
+         file_offset + nbytes <= async_range_offset_ + async_range_size_;
+}
+
+bool TileIO::mmap_enabled() const {
+  return mmap_enabled_;
+}
+
 Status TileIO::read(
     Tile* tile,
     uint64_t file_offset,
     uint64_t compressed_size,
     uint64_t tile_size) {
   // No compression
-  if (tile->compressor() == Compressor::NO_COMPRESSION)
-    return storage_manager_->read_from_file(
-        uri_, file_offset, tile->buffer(), tile_size);
+  if (tile->compressor() == Compressor::NO_COMPRESSION && mmap_enabled_)
+    return read_mapped(tile, file_offset, tile_size);
+  bool staged = in_range(file_offset, compressed_size);
+  if (tile->compressor() == Compressor::NO_COMPRESSION) {
+    if (!staged)
+      return storage_manager_->read_from_file(
+          uri_, file_offset, tile->buffer(), tile_size);
+    RETURN_NOT_OK(tile->realloc(tile_size));
+    std::memcpy(
+        tile->data(), buffer_->data(file_offset - range_offset_), tile_size);
+    tile->set_size(tile_size);
+    tile->reset_offset();
+    return Status::Ok();
+  }
 
   // Compression
-  RETURN_NOT_OK(storage_manager_->read_from_file(
-      uri_, file_offset, buffer_, compressed_size));
+  if (staged) {
+    buffer_->set_offset(file_offset - range_offset_);
+  } else {
+    range_size_ = 0;
+    RETURN_NOT_OK(storage_manager_->read_from_file(
+        uri_, file_offset, buffer_, compressed_size));
+    buffer_->reset_offset();
+  }
 
   // Decompress tile
   tile->reset_offset();
   tile->reset_size();
-  buffer_->reset_offset();
   RETURN_NOT_OK(tile->realloc(tile_size));
   RETURN_NOT_OK(decompress_tile(tile));
   tile->reset_offset();
@@ -106,6 +316,48 @@ Status TileIO::read(
   return Status::Ok();
 }
 
+Status TileIO::read_range(uint64_t file_offset, uint64_t nbytes) {
+  range_size_ = 0;
+  RETURN_NOT_OK(
+      storage_manager_->read_from_file(uri_, file_offset, buffer_, nbytes));
+  range_offset_ = file_offset;
+  range_size_ = nbytes;
+
+  return Status::Ok();
+}
+
+Status TileIO::read_range_async(uint64_t file_offset, uint64_t nbytes) {
+  // Discard the range currently read ahead, whatever its outcome
+  if (async_range_size_ != 0) {
+    async_range_size_ = 0;
+    storage_manager_->wait_async(async_request_id_);
+  }
+
+  RETURN_NOT_OK(storage_manager_->read_from_file_async(
+      uri_, file_offset, async_buffer_, nbytes, &async_request_id_));
+  async_range_offset_ = file_offset;
+  async_range_size_ = nbytes;
+
+  return Status::Ok();
+}
+
+Status TileIO::wait_range_async() {
+  if (async_range_size_ == 0)
+    return Status::Ok();
+
+  uint64_t nbytes = async_range_size_;
+  async_range_size_ = 0;
+  range_size_ = 0;
+  RETURN_NOT_OK(storage_manager_->wait_async(async_request_id_));
+
+  // The buffer read ahead becomes the current range
+  std::swap(buffer_, async_buffer_);
+  range_offset_ = async_range_offset_;
+  range_size_ = nbytes;
+
+  return Status::Ok();
+}
+
 Status TileIO::read_generic(Tile** tile, uint64_t file_offset) {
   uint64_t tile_size;
   uint64_t compressed_size;
@@ -161,9 +413,18 @@ Status TileIO::read_generic_tile_header(
   return Status::Ok();
 }
 
+void TileIO::set_dictionary(ZStdDictionary* dictionary) {
+  dictionary_ = dictionary;
+}
+
+void TileIO::set_format_version(const int* version) {
+  std::memcpy(format_version_, version, sizeof(format_version_));
+}
+
 Status TileIO::write(Tile* tile, uint64_t* bytes_written) {
   // Reset the tile and buffer offset
   tile->reset_offset();
+  range_size_ = 0;
   buffer_->reset_size();
   buffer_->reset_offset();
 
@@ -177,14 +438,23 @@ Status TileIO::write(Tile* tile, uint64_t* bytes_written) {
       (compressor == Compressor::NO_COMPRESSION) ? tile->buffer() : buffer_;
   *bytes_written = buffer->size();
 
-  RETURN_NOT_OK(storage_manager_->write_to_file(uri_, buffer));
+  if (!write_behind_)
+    return storage_manager_->write_to_file(uri_, buffer);
+
+  // Buffer the tile, and write the batch if it is large enough
+  if (write_buffer_->alloced_size() < constants::write_behind_buffer_size)
+    RETURN_NOT_OK(write_buffer_->realloc(constants::write_behind_buffer_size));
+  RETURN_NOT_OK(write_buffer_->write(buffer->data(), buffer->size()));
+  if (write_buffer_->size() >= constants::write_behind_buffer_size)
+    RETURN_NOT_OK(flush_async());
 
   return Status::Ok();
 }
 
-Status TileIO::write_generic(Tile* tile) {
+Status TileIO::write_generic(Tile* tile, uint64_t* nbytes) {
   // Reset the tile and buffer offset
   tile->reset_offset();
+  range_size_ = 0;
   buffer_->reset_size();
   buffer_->reset_offset();
 
@@ -198,6 +468,8 @@ Status TileIO::write_generic(Tile* tile) {
 
   RETURN_NOT_OK(write_generic_tile_header(tile, buffer->size()));
   RETURN_NOT_OK(storage_manager_->write_to_file(uri_, buffer));
+  *nbytes = 3 * sizeof(uint64_t) + 2 * sizeof(char) + sizeof(int) +
+            buffer->size();
 
   return Status::Ok();
 }
@@ -232,6 +504,60 @@ Status TileIO::write_generic_tile_header(Tile* tile, uint64_t compressed_size) {
 /*          PRIVATE METHODS       */
 /* ****************************** */
 
+Status TileIO::read_mapped(
+    Tile* tile, uint64_t file_offset, uint64_t tile_size) {
+  // Map the file upon the first read
+  if (mmap_data_ == nullptr) {
+    if (file_size_ == 0 ||
+        !storage_manager_->map_file(uri_, file_size_, &mmap_data_).ok()) {
+      mmap_data_ = nullptr;
+      mmap_enabled_ = false;
+      return storage_manager_->read_from_file(
+          uri_, file_offset, tile->buffer(), tile_size);
+    }
+    storage_manager_->advise_mapped(
+        uri_,
+        mmap_data_,
+        0,
+        file_size_,
+        mmap_sequential_ ? MmapAdvice::SEQUENTIAL : MmapAdvice::RANDOM);
+  }
+
+  if (file_offset + tile_size > file_size_)
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot read tile; Tile exceeds the mapped file size"));
+
+  // Random access defeats the kernel read-ahead, so the tile pages are
+  // requested explicitly
+  if (!mmap_sequential_)
+    storage_manager_->advise_mapped(
+        uri_, mmap_data_, file_offset, tile_size, MmapAdvice::WILLNEED);
+
+  tile->buffer()->wrap((char*)mmap_data_ + file_offset, tile_size);
+
+  return Status::Ok();
+}
+
+Status TileIO::flush_async() {
+  // The buffer of the previous batch is reused
+  if (write_pending_) {
+    write_pending_ = false;
+    RETURN_NOT_OK(storage_manager_->wait_async(write_request_id_));
+  }
+  if (write_buffer_->size() == 0)
+    return Status::Ok();
+
+  std::swap(write_buffer_, write_flush_buffer_);
+  write_buffer_->reset_size();
+  write_buffer_->reset_offset();
+  RETURN_NOT_OK(storage_manager_->write_to_file_async(
+      uri_, file_size_, write_flush_buffer_, &write_request_id_));
+  write_pending_ = true;
+  file_size_ += write_flush_buffer_->size();
+
+  return Status::Ok();
+}
+
 Status TileIO::compress_tile(Tile* tile) {
   // Simple case - No coordinates
   if (!tile->stores_coords())
@@ -255,6 +581,7 @@ Status TileIO::compress_tile(Tile* tile) {
         dim_num,
         buff,
         false);
+    dim_tile->set_chunk_size(tile->chunk_size());
     st = compress_one_tile(dim_tile);
     delete buff;
     delete dim_tile;
@@ -265,13 +592,181 @@ Status TileIO::compress_tile(Tile* tile) {
   return Status::Ok();
 }
 
-Status TileIO::compress_one_tile(Tile* tile) {
+Status TileIO::compress_chunk(
+    Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const {
+  // Apply the filter of the tile, compressing the filtered chunk instead
+  Buffer filtered;
+  ConstBuffer filtered_input(nullptr, 0);
+  if (tile->filter() != Filter::NO_FILTER) {
+    RETURN_NOT_OK(filtered.realloc(input_buffer->size()));
+    RETURN_NOT_OK(FilterKernels::apply(
+        tile->filter(),
+        tile->type(),
+        input_buffer->data(),
+        input_buffer->size(),
+        filtered.data()));
+    filtered_input = ConstBuffer(filtered.data(), input_buffer->size());
+    input_buffer = &filtered_input;
+  }
+
+  // Invoke the proper compressor
+  if (tile->compressor() == Compressor::ADAPTIVE)
+    return compress_chunk_adaptive(tile, input_buffer, output_buffer);
+  return compress_chunk_with(
+      tile->compressor(),
+      tile->compression_level(),
+      tile,
+      input_buffer,
+      output_buffer);
+}
+
+Status TileIO::compress_chunk_adaptive(
+    Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const {
+  // For easy reference
+  const Config& config = storage_manager_->config();
+  auto cell_size = tile->cell_size();
+  auto input = (const char*)input_buffer->data();
+  uint64_t nbytes = input_buffer->size();
+
+  // Sample evenly spaced blocks of the chunk, unless it is small enough to
+  // be trial-compressed as a whole
+  uint64_t block_num = constants::adaptive_sample_block_num;
+  uint64_t block_size =
+      constants::adaptive_sample_size / block_num / cell_size * cell_size;
+  uint64_t stride = nbytes / block_num / cell_size * cell_size;
+  bool sampled = nbytes > constants::adaptive_sample_size && block_size > 0 &&
+                 block_size <= stride;
+  Buffer sample;
+  if (sampled) {
+    RETURN_NOT_OK(sample.realloc(block_num * block_size));
+    for (uint64_t i = 0; i < block_num; ++i)
+      RETURN_NOT_OK(sample.write(input + i * stride, block_size));
+  }
+  ConstBuffer sample_input(
+      sampled ? sample.data() : input, sampled ? sample.size() : nbytes);
+
+  // Score every applicable candidate on the sample. Storing the data as
+  // they are scores their size.
+  uint64_t sample_size = sample_input.size();
+  Compressor best = Compressor::NO_COMPRESSION;
+  int best_level = -1;
+  double best_score = sample_size;
+  Buffer best_output, output;
+  for (const auto& candidate : config.adaptive_compressors()) {
+    if (sample_size == 0 || !adaptive_candidate_applies(candidate.first, tile))
+      continue;
+    output.reset_offset();
+    output.reset_size();
+    uint64_t max_size =
+        sample_size + overhead(candidate.first, tile, sample_size);
+    if (max_size > output.alloced_size())
+      RETURN_NOT_OK(output.realloc(max_size));
+    ConstBuffer candidate_input(sample_input.data(), sample_size);
+    if (!compress_chunk_with(
+             candidate.first,
+             candidate.second,
+             tile,
+             &candidate_input,
+             &output)
+             .ok())
+      continue;
+    double score = output.size() + (double)config.adaptive_decode_weight() *
+                                       adaptive_decode_cost(candidate.first) *
+                                       sample_size / 100;
+    if (score < best_score) {
+      best = candidate.first;
+      best_level = candidate.second;
+      best_score = score;
+      best_output.swap(&output);
+    }
+  }
+
+  // Write the selected compressor, followed by the compressed chunk
+  uint8_t compressor = (uint8_t)best;
+  RETURN_NOT_OK(output_buffer->write(&compressor, sizeof(uint8_t)));
+  if (best == Compressor::NO_COMPRESSION)
+    return output_buffer->write(input, nbytes);
+  if (!sampled)
+    return output_buffer->write(best_output.data(), best_output.size());
+  uint64_t start = output_buffer->offset();
+  RETURN_NOT_OK(compress_chunk_with(
+      best, best_level, tile, input_buffer, output_buffer));
+  if (output_buffer->offset() - start < nbytes)
+    return Status::Ok();
+
+  // The sample was not representative of the chunk, which did not shrink
+  output_buffer->set_offset(start - sizeof(uint8_t));
+  compressor = (uint8_t)Compressor::NO_COMPRESSION;
+  RETURN_NOT_OK(output_buffer->write(&compressor, sizeof(uint8_t)));
+  return output_buffer->write(input, nbytes);
+}
+
+Status TileIO::compress_chunk_with(
+    Compressor compressor,
+    int level,
+    Tile* tile,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) const {
   // For easy reference
-  auto level = tile->compression_level();
   auto type_size = datatype_size(tile->type());
-  auto compressor = tile->compressor();
   auto type = tile->type();
   auto cell_size = tile->cell_size();
+
+  // Invoke the proper compressor
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      assert(0);
+      break;
+    case Compressor::GZIP:
+      return GZip::compress(level, input_buffer, output_buffer);
+    case Compressor::ZSTD:
+      return ZStd::compress(level, dictionary_, input_buffer, output_buffer);
+    case Compressor::LZ4:
+      return LZ4::compress(level, input_buffer, output_buffer);
+    case Compressor::BLOSC:
+      return Blosc::compress(
+          "blosclz", type_size, level, input_buffer, output_buffer);
+#undef BLOSC_LZ4
+    case Compressor::BLOSC_LZ4:
+      return Blosc::compress(
+          "lz4", type_size, level, input_buffer, output_buffer);
+#undef BLOSC_LZ4HC
+    case Compressor::BLOSC_LZ4HC:
+      return Blosc::compress(
+          "lz4hc", type_size, level, input_buffer, output_buffer);
+#undef BLOSC_SNAPPY
+    case Compressor::BLOSC_SNAPPY:
+      return Blosc::compress(
+          "snappy", type_size, level, input_buffer, output_buffer);
+#undef BLOSC_ZLIB
+    case Compressor::BLOSC_ZLIB:
+      return Blosc::compress(
+          "zlib", type_size, level, input_buffer, output_buffer);
+#undef BLOSC_ZSTD
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::compress(
+          "zstd", type_size, level, input_buffer, output_buffer);
+    case Compressor::RLE:
+      return RLE::compress(cell_size, input_buffer, output_buffer);
+    case Compressor::BZIP2:
+      return BZip::compress(level, input_buffer, output_buffer);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::compress(type, input_buffer, output_buffer);
+    case Compressor::BLOCK_DOUBLE_DELTA:
+      return BlockDoubleDelta::compress(type, input_buffer, output_buffer);
+    case Compressor::GORILLA:
+      return Gorilla::compress(type, input_buffer, output_buffer);
+    case Compressor::ADAPTIVE:
+      assert(0);
+      break;
+  }
+
+  return LOG_STATUS(
+      Status::TileIOError("Cannot compress chunk; Unknown compressor"));
+}
+
+Status TileIO::compress_one_tile(Tile* tile) {
+  // For easy reference
   auto tile_size = tile->size();
 
   // Compute necessary info for chunking
@@ -279,91 +774,87 @@ Status TileIO::compress_one_tile(Tile* tile) {
   RETURN_NOT_OK(
       compute_chunking_info(tile, &chunk_num, &max_chunk_size, &overhead));
 
+  // Multiple chunks are compressed in parallel
+  if (chunk_num > 1)
+    return compress_one_tile_parallel(tile, chunk_num, max_chunk_size);
+
   // Properly reallocate buffer
   RETURN_NOT_OK(buffer_->realloc(buffer_->size() + tile_size + overhead));
 
-  // Write number of chunks
+  // Write number of chunks and chunk info
+  uint64_t compressed_chunk_size = 0;
   RETURN_NOT_OK(buffer_->write(&chunk_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(buffer_->write(&tile_size, sizeof(uint64_t)));
+  uint64_t buffer_offset = buffer_->offset();  // Will be used later
+  RETURN_NOT_OK(buffer_->write(&compressed_chunk_size, sizeof(uint64_t)));
 
-  // Compress in chunks
-  Status st;
-  uint64_t compressed_chunk_size = 0;
-  uint64_t buffer_offset;
-  uint64_t left_to_compress = tile_size;
-  for (uint64_t i = 0; i < chunk_num; ++i) {
-    // Write chunk info
-    auto chunk_size = MIN(left_to_compress, max_chunk_size);
-
-    RETURN_NOT_OK(buffer_->write(&chunk_size, sizeof(uint64_t)));
-    buffer_offset = buffer_->offset();  // Will be used later
-    RETURN_NOT_OK(buffer_->write(&compressed_chunk_size, sizeof(uint64_t)));
-
-    // Create const buffer
-    auto input_buffer = new ConstBuffer(tile->cur_data(), chunk_size);
-
-    // Invoke the proper compressor
-    switch (compressor) {
-      case Compressor::GZIP:
-        st = GZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::LZ4:
-        st = LZ4::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::BLOSC:
-        st =
-            Blosc::compress("blosclz", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
-        st = Blosc::compress("lz4", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
-        st = Blosc::compress("lz4hc", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
-        st = Blosc::compress("snappy", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
-        st = Blosc::compress("zlib", type_size, level, input_buffer, buffer_);
-        break;
-#undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::compress("zstd", type_size, level, input_buffer, buffer_);
-        break;
-      case Compressor::RLE:
-        st = RLE::compress(cell_size, input_buffer, buffer_);
-        break;
-      case Compressor::BZIP2:
-        st = BZip::compress(level, input_buffer, buffer_);
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::compress(type, input_buffer, buffer_);
-        break;
-      default:
-        assert(0);
-    }
+  // Compress the single chunk directly into the buffer
+  auto input_buffer = new ConstBuffer(tile->cur_data(), tile_size);
+  Status st = compress_chunk(tile, input_buffer, buffer_);
+  delete input_buffer;
+  RETURN_NOT_OK(st);
 
-    delete input_buffer;
-    RETURN_NOT_OK(st);
+  // Write compressed chunk size
+  compressed_chunk_size = buffer_->size() - (buffer_offset + sizeof(uint64_t));
+  std::memcpy(
+      buffer_->data(buffer_offset), &compressed_chunk_size, sizeof(uint64_t));
 
-    // Write compressed chunk size
-    compressed_chunk_size =
-        buffer_->size() - (buffer_offset + sizeof(uint64_t));
-    std::memcpy(
-        buffer_->data(buffer_offset), &compressed_chunk_size, sizeof(uint64_t));
+  tile->advance_offset(tile_size);
+
+  return Status::Ok();
+}
+
+Status TileIO::compress_one_tile_parallel(
+    Tile* tile, uint64_t chunk_num, uint64_t max_chunk_size) {
+  // For easy reference
+  auto tile_size = tile->size();
+  auto tile_data = (const char*)tile->cur_data();
+
+  // Each chunk is compressed into its own scratch buffer
+  std::vector<Buffer*> chunk_buffers(chunk_num);
+  for (uint64_t i = 0; i < chunk_num; ++i)
+    chunk_buffers[i] = new Buffer();
 
-    // Update
-    left_to_compress -= chunk_size;
-    tile->advance_offset(chunk_size);
+  // Compress the chunks concurrently on the thread pool
+  auto thread_pool = storage_manager_->thread_pool();
+  std::vector<std::future<Status>> tasks;
+  for (uint64_t i = 0; i < chunk_num; ++i) {
+    tasks.push_back(thread_pool->enqueue([&, i]() -> Status {
+      uint64_t chunk_offset = i * max_chunk_size;
+      uint64_t chunk_size = MIN(tile_size - chunk_offset, max_chunk_size);
+      RETURN_NOT_OK(chunk_buffers[i]->realloc(
+          chunk_size + this->overhead(tile, chunk_size)));
+      ConstBuffer input_buffer(tile_data + chunk_offset, chunk_size);
+      return compress_chunk(tile, &input_buffer, chunk_buffers[i]);
+    }));
+  }
+  Status st = thread_pool->wait_all(tasks);
+
+  // Stitch the compressed chunks together in the chunked tile format
+  if (st.ok()) {
+    uint64_t total_size = sizeof(uint64_t);
+    for (auto chunk_buffer : chunk_buffers)
+      total_size += 2 * sizeof(uint64_t) + chunk_buffer->size();
+    st = buffer_->realloc(buffer_->size() + total_size);
   }
+  if (st.ok())
+    st = buffer_->write(&chunk_num, sizeof(uint64_t));
+  for (uint64_t i = 0; i < chunk_num && st.ok(); ++i) {
+    uint64_t chunk_size = MIN(tile_size - i * max_chunk_size, max_chunk_size);
+    uint64_t compressed_chunk_size = chunk_buffers[i]->size();
+    st = buffer_->write(&chunk_size, sizeof(uint64_t));
+    if (st.ok())
+      st = buffer_->write(&compressed_chunk_size, sizeof(uint64_t));
+    if (st.ok())
+      st = buffer_->write(chunk_buffers[i]->data(), compressed_chunk_size);
+  }
+
+  // Clean up
+  for (auto chunk_buffer : chunk_buffers)
+    delete chunk_buffer;
+  RETURN_NOT_OK(st);
 
-  assert(left_to_compress == 0);
+  tile->advance_offset(tile_size);
 
   return Status::Ok();
 }
@@ -377,9 +868,12 @@ Status TileIO::compute_chunking_info(
   auto cell_size = tile->cell_size();
   auto tile_size = tile->size();
 
-  // Compute max chunk size
-  *max_chunk_size = MIN(constants::tile_chunk_size, tile_size);
+  // Compute max chunk size, which must be a multiple of the cell size
+  *max_chunk_size = MIN(tile->chunk_size(), constants::tile_chunk_size);
+  *max_chunk_size = MIN(*max_chunk_size, tile_size);
   *max_chunk_size = *max_chunk_size / cell_size * cell_size;
+  if (*max_chunk_size == 0)
+    *max_chunk_size = cell_size;
   uint64_t chunk_overhead = this->overhead(tile, *max_chunk_size);
 
   // Adjust max chunk size
@@ -403,8 +897,8 @@ Status TileIO::compute_chunking_info(
   // Compute overhead: equal to the compression overhead per chunk, plus 2
   // values per chunk that store the original and compressed chunk size,
   // plus a single value in the beginning for the total number of chunks.
-  *overhead =
-      (*chunk_num) * chunk_overhead * 2 * sizeof(uint64_t) + sizeof(uint64_t);
+  *overhead = (*chunk_num) * (chunk_overhead + 2 * sizeof(uint64_t)) +
+              sizeof(uint64_t);
 
   return Status::Ok();
 }
@@ -425,6 +919,104 @@ Status TileIO::decompress_tile(Tile* tile) {
   return Status::Ok();
 }
 
+Status TileIO::decompress_chunk(
+    Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const {
+  if (tile->filter() == Filter::NO_FILTER)
+    return decompress_chunk_unfiltered(tile, input_buffer, output_buffer);
+
+  // Decompress into a temporary buffer and reverse the filter of the tile
+  // from there into the output buffer
+  Buffer filtered;
+  RETURN_NOT_OK(filtered.realloc(output_buffer->free_space()));
+  RETURN_NOT_OK(decompress_chunk_unfiltered(tile, input_buffer, &filtered));
+  RETURN_NOT_OK(FilterKernels::reverse(
+      tile->filter(),
+      tile->type(),
+      filtered.data(),
+      filtered.size(),
+      output_buffer->cur_data()));
+  output_buffer->advance_size(filtered.size());
+  output_buffer->advance_offset(filtered.size());
+
+  return Status::Ok();
+}
+
+Status TileIO::decompress_chunk_unfiltered(
+    Tile* tile, ConstBuffer* input_buffer, Buffer* output_buffer) const {
+  if (tile->compressor() != Compressor::ADAPTIVE)
+    return decompress_chunk_with(
+        tile->compressor(), tile, input_buffer, output_buffer);
+
+  // Read the compressor selected for the chunk
+  uint8_t compressor;
+  RETURN_NOT_OK(input_buffer->read(&compressor, sizeof(uint8_t)));
+  if (!adaptive_chunk_compressor_valid(compressor))
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot decompress chunk; Invalid adaptive compressor"));
+  ConstBuffer chunk(
+      (const char*)input_buffer->data() + sizeof(uint8_t),
+      input_buffer->size() - sizeof(uint8_t));
+  if ((Compressor)compressor == Compressor::NO_COMPRESSION)
+    return output_buffer->write(&chunk, chunk.size());
+  return decompress_chunk_with(
+      (Compressor)compressor, tile, &chunk, output_buffer);
+}
+
+Status TileIO::decompress_chunk_with(
+    Compressor compressor,
+    Tile* tile,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) const {
+  // Invoke the proper decompressor
+  switch (compressor) {
+    case Compressor::NO_COMPRESSION:
+      assert(0);
+      break;
+    case Compressor::GZIP:
+      return GZip::decompress(input_buffer, output_buffer);
+    case Compressor::ZSTD:
+      return ZStd::decompress(dictionary_, input_buffer, output_buffer);
+    case Compressor::LZ4:
+      return LZ4::decompress(input_buffer, output_buffer);
+    case Compressor::BLOSC:
+#undef BLOSC_LZ4
+    case Compressor::BLOSC_LZ4:
+#undef BLOSC_LZ4HC
+    case Compressor::BLOSC_LZ4HC:
+#undef BLOSC_SNAPPY
+    case Compressor::BLOSC_SNAPPY:
+#undef BLOSC_ZLIB
+    case Compressor::BLOSC_ZLIB:
+#undef BLOSC_ZSTD
+    case Compressor::BLOSC_ZSTD:
+      return Blosc::decompress(input_buffer, output_buffer);
+    case Compressor::RLE:
+      // The files of earlier versions store the runs in the legacy format
+      // (the adaptive compressor always uses the current one)
+      if (tile->compressor() == Compressor::RLE &&
+          utils::is_older_version(
+              format_version_, constants::rle_format_min_version))
+        return RLE::decompress_legacy(
+            tile->cell_size(), input_buffer, output_buffer);
+      return RLE::decompress(tile->cell_size(), input_buffer, output_buffer);
+    case Compressor::BZIP2:
+      return BZip::decompress(input_buffer, output_buffer);
+    case Compressor::DOUBLE_DELTA:
+      return DoubleDelta::decompress(tile->type(), input_buffer, output_buffer);
+    case Compressor::BLOCK_DOUBLE_DELTA:
+      return BlockDoubleDelta::decompress(
+          tile->type(), input_buffer, output_buffer);
+    case Compressor::GORILLA:
+      return Gorilla::decompress(tile->type(), input_buffer, output_buffer);
+    case Compressor::ADAPTIVE:
+      assert(0);
+      break;
+  }
+
+  return LOG_STATUS(
+      Status::TileIOError("Cannot decompress chunk; Unknown compressor"));
+}
+
 Status TileIO::decompress_one_tile(Tile* tile) {
   // Read number of chunks
   uint64_t chunk_num;
@@ -432,66 +1024,89 @@ Status TileIO::decompress_one_tile(Tile* tile) {
   RETURN_NOT_OK(buffer_->read(&chunk_num, sizeof(uint64_t)));
   assert(chunk_num > 0);
 
-  Status st;
-  Datatype type = tile->type();
+  // Multiple chunks are decompressed in parallel
+  if (chunk_num > 1)
+    return decompress_one_tile_parallel(tile, chunk_num);
+
+  // Read original and compressed chunk size
+  uint64_t chunk_size, compressed_chunk_size;
+  RETURN_NOT_OK(buffer_->read(&chunk_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(buffer_->read(&compressed_chunk_size, sizeof(uint64_t)));
+
+  // Decompress the single chunk directly into the tile
+  auto input_buffer =
+      new ConstBuffer(buffer_->cur_data(), compressed_chunk_size);
+  Status st = decompress_chunk(tile, input_buffer, tile->buffer());
+  delete input_buffer;
+  RETURN_NOT_OK(st);
+
+  buffer_->advance_offset(compressed_chunk_size);
+
+  return Status::Ok();
+}
+
+Status TileIO::decompress_one_tile_parallel(Tile* tile, uint64_t chunk_num) {
+  // Scan the chunk headers to locate every chunk in buffer_ and compute
+  // its final offset in the tile
+  std::vector<uint64_t> chunk_sizes(chunk_num);
+  std::vector<uint64_t> compressed_chunk_sizes(chunk_num);
+  std::vector<uint64_t> compressed_chunk_offsets(chunk_num);
+  std::vector<uint64_t> chunk_offsets(chunk_num);
+  uint64_t tile_offset = tile->offset();
+  uint64_t total_size = 0;
   for (uint64_t i = 0; i < chunk_num; ++i) {
-    // Read original and compressed chunk size
-    uint64_t chunk_size, compressed_chunk_size;
-    RETURN_NOT_OK(buffer_->read(&chunk_size, sizeof(uint64_t)));
-    RETURN_NOT_OK(buffer_->read(&compressed_chunk_size, sizeof(uint64_t)));
-
-    auto input_buffer =
-        new ConstBuffer(buffer_->cur_data(), compressed_chunk_size);
-
-    // Invoke the proper decompressor
-    switch (tile->compressor()) {
-      case Compressor::NO_COMPRESSION:
-        assert(0);
-        break;
-      case Compressor::GZIP:
-        st = GZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::ZSTD:
-        st = ZStd::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::LZ4:
-        st = LZ4::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::BLOSC:
-#undef BLOSC_LZ4
-      case Compressor::BLOSC_LZ4:
-#undef BLOSC_LZ4HC
-      case Compressor::BLOSC_LZ4HC:
-#undef BLOSC_SNAPPY
-      case Compressor::BLOSC_SNAPPY:
-#undef BLOSC_ZLIB
-      case Compressor::BLOSC_ZLIB:
-#undef BLOSC_ZSTD
-      case Compressor::BLOSC_ZSTD:
-        st = Blosc::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::RLE:
-        st = RLE::decompress(tile->cell_size(), input_buffer, tile->buffer());
-        break;
-      case Compressor::BZIP2:
-        st = BZip::decompress(input_buffer, tile->buffer());
-        break;
-      case Compressor::DOUBLE_DELTA:
-        st = DoubleDelta::decompress(type, input_buffer, tile->buffer());
-        break;
-    }
+    RETURN_NOT_OK(buffer_->read(&chunk_sizes[i], sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        buffer_->read(&compressed_chunk_sizes[i], sizeof(uint64_t)));
+    compressed_chunk_offsets[i] = buffer_->offset();
+    chunk_offsets[i] = tile_offset + total_size;
+    total_size += chunk_sizes[i];
+    if (buffer_->offset() + compressed_chunk_sizes[i] > buffer_->size())
+      return LOG_STATUS(Status::TileIOError(
+          "Cannot decompress tile; Chunk exceeds the compressed tile size"));
+    buffer_->advance_offset(compressed_chunk_sizes[i]);
+  }
 
-    delete input_buffer;
-    RETURN_NOT_OK(st);
+  // Check that the decompressed chunks fit in the tile
+  auto tile_buffer = tile->buffer();
+  if (tile_offset + total_size > tile_buffer->alloced_size())
+    return LOG_STATUS(Status::TileIOError(
+        "Cannot decompress tile; Decompressed chunks exceed the tile size"));
 
-    buffer_->advance_offset(compressed_chunk_size);
+  // Decompress the chunks concurrently on the thread pool, each directly
+  // into its final position in the tile
+  auto thread_pool = storage_manager_->thread_pool();
+  std::vector<std::future<Status>> tasks;
+  for (uint64_t i = 0; i < chunk_num; ++i) {
+    tasks.push_back(thread_pool->enqueue([&, i]() -> Status {
+      ConstBuffer input_buffer(
+          buffer_->data(compressed_chunk_offsets[i]),
+          compressed_chunk_sizes[i]);
+      Buffer output_buffer(
+          tile_buffer->data(chunk_offsets[i]), chunk_sizes[i], false);
+      output_buffer.reset_size();
+      RETURN_NOT_OK(decompress_chunk(tile, &input_buffer, &output_buffer));
+      if (output_buffer.size() != chunk_sizes[i])
+        return LOG_STATUS(Status::TileIOError(
+            "Cannot decompress tile; Unexpected decompressed chunk size"));
+      return Status::Ok();
+    }));
   }
+  RETURN_NOT_OK(thread_pool->wait_all(tasks));
 
-  return st;
+  tile_buffer->advance_size(total_size);
+  tile_buffer->advance_offset(total_size);
+
+  return Status::Ok();
 }
 
 uint64_t TileIO::overhead(Tile* tile, uint64_t nbytes) const {
-  switch (tile->compressor()) {
+  return overhead(tile->compressor(), tile, nbytes);
+}
+
+uint64_t TileIO::overhead(
+    Compressor compressor, Tile* tile, uint64_t nbytes) const {
+  switch (compressor) {
     case Compressor::NO_COMPRESSION:
       return 0;
     case Compressor::GZIP:
@@ -518,6 +1133,22 @@ uint64_t TileIO::overhead(Tile* tile, uint64_t nbytes) const {
       return BZip::overhead(nbytes);
     case Compressor::DOUBLE_DELTA:
       return DoubleDelta::overhead(nbytes);
+    case Compressor::BLOCK_DOUBLE_DELTA:
+      return BlockDoubleDelta::overhead(nbytes);
+    case Compressor::GORILLA:
+      return Gorilla::overhead(nbytes);
+    case Compressor::ADAPTIVE: {
+      // The byte of the selected compressor, plus the largest overhead of
+      // the candidates
+      uint64_t max_overhead = 0;
+      for (const auto& candidate :
+           storage_manager_->config().adaptive_compressors()) {
+        uint64_t candidate_overhead = overhead(candidate.first, tile, nbytes);
+        if (candidate_overhead > max_overhead)
+          max_overhead = candidate_overhead;
+      }
+      return sizeof(uint8_t) + max_overhead;
+    }
   }
 }
 
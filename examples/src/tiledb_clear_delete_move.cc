@@ -38,7 +38,7 @@ int main() {
 
   // Initialize context with the default configuration parameters
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Clear an array_metadata
   tiledb_clear(ctx, "my_group/sparse_arrays/my_array_B");
@@ -47,7 +47,7 @@ void* print_upon_completion(void* s);
 int main() {
   // Create TileDB context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers
   int buffer_a1[16];
@@ -45,7 +45,7 @@
 int main(int argc, char** argv) {
   // Create TileDB context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers
   int buffer_a1[16];
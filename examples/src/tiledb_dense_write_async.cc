@@ -45,7 +45,7 @@ void* print_upon_completion(void* s);
 int main() {
   // Create TileDB context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers
   // clang-format off
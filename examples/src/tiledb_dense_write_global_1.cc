@@ -41,7 +41,7 @@
 int main() {
   // Initialize context with the default configuration parameters
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers
   // clang-format on
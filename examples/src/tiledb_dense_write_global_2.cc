@@ -42,7 +42,7 @@
 int main() {
   // Initialize context with the default configuration parameters
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers - #1
   int buffer_a1[] = {0, 1, 2, 3, 4, 5};
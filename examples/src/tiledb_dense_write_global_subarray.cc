@@ -43,7 +43,7 @@
 int main() {
   // Initialize context with the default configuration parameters
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Prepare cell buffers
   int buffer_a1[] = {112, 113, 114, 115};
@@ -50,7 +50,7 @@ int main() {
 
   // Initialize context with the default configuration parameters
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Create groups
   tiledb_group_create(ctx, "my_group");
@@ -9,7 +9,7 @@ const std::string FILENAME = "/dense_array_1";
 int main(int argc, char ** argv) {
   // Create TileDB context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
   using std::chrono::steady_clock;
   auto start = steady_clock::now();
   std::string array_name_string = URI_PREFIX + DIRNAME + FILENAME;
@@ -22,7 +22,7 @@ int main(int argc, char** argv) {
 
   TRACE('1');
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
   TRACE('2');
   std::string array_name_string = URI_PREFIX + DIRNAME + FILENAME;
   int number_of_iterations = 32;
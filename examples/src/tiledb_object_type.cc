@@ -38,7 +38,7 @@ void print_object_type(tiledb_object_t type);
 int main() {
   // Create context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Get object type for group
   tiledb_object_t type;
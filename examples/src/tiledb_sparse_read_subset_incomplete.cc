@@ -41,7 +41,7 @@
 int main(int argc, char** argv) {
   // Create TileDB context
   tiledb_ctx_t* ctx;
-  tiledb_ctx_create(&ctx);
+  tiledb_ctx_create(&ctx, nullptr);
 
   // Attributes to subset on
   const char* attributes[] = {"a1"};
@@ -0,0 +1,125 @@
+#include <async_io.h>
+#include <posix_filesystem.h>
+#include <catch.hpp>
+
+#include <fcntl.h>
+#include <cstring>
+#include <vector>
+
+using namespace tiledb;
+
+struct AsyncIOFx {
+  const std::string TEMP_DIR = posix::current_dir() + "/tiledb_async_io_test";
+  const std::string FILE = TEMP_DIR + "/file";
+
+  AsyncIOFx() {
+    posix::remove_path(TEMP_DIR);
+    REQUIRE(posix::create_dir(TEMP_DIR).ok());
+  }
+
+  ~AsyncIOFx() {
+    posix::remove_path(TEMP_DIR);
+  }
+
+  std::shared_ptr<FileHandle> open(int flags) const {
+    int fd;
+    REQUIRE(posix::open_file(FILE, flags, &fd).ok());
+    return std::make_shared<FileHandle>(fd);
+  }
+
+  void check_reads_and_writes(AsyncIO* async_io) const {
+    // Write many chunks out of order with requests in flight concurrently
+    const int chunk_num = 200;
+    const uint64_t chunk_size = 4096;
+    std::vector<char> data(chunk_num * chunk_size);
+    for (uint64_t i = 0; i < data.size(); ++i)
+      data[i] = (char)(i * 7 + i / chunk_size);
+    auto write_handle = open(O_WRONLY | O_CREAT);
+    std::vector<uint64_t> ids(chunk_num);
+    for (int i = chunk_num - 1; i >= 0; --i) {
+      REQUIRE(async_io
+                  ->submit_write(
+                      write_handle,
+                      i * chunk_size,
+                      &data[i * chunk_size],
+                      chunk_size,
+                      &ids[i])
+                  .ok());
+    }
+    for (int i = 0; i < chunk_num; ++i)
+      CHECK(async_io->wait(ids[i]).ok());
+    uint64_t file_size;
+    REQUIRE(posix::file_size(FILE, &file_size).ok());
+    CHECK(file_size == data.size());
+
+    // Read the chunks back concurrently
+    std::vector<char> read_data(data.size());
+    auto read_handle = open(O_RDONLY);
+    for (int i = 0; i < chunk_num; ++i) {
+      REQUIRE(async_io
+                  ->submit_read(
+                      read_handle,
+                      i * chunk_size,
+                      &read_data[i * chunk_size],
+                      chunk_size,
+                      &ids[i])
+                  .ok());
+    }
+    for (int i = chunk_num - 1; i >= 0; --i)
+      CHECK(async_io->wait(ids[i]).ok());
+    CHECK(!memcmp(&data[0], &read_data[0], data.size()));
+
+    // Reading past the end of the file fails upon completion
+    uint64_t id;
+    REQUIRE(async_io
+                ->submit_read(
+                    read_handle, data.size() - 10, &read_data[0], 20, &id)
+                .ok());
+    CHECK(!async_io->wait(id).ok());
+
+    // Generic tasks
+    int value = 0;
+    REQUIRE(async_io
+                ->submit_task(
+                    [&value]() {
+                      value = 1;
+                      return Status::Ok();
+                    },
+                    &id)
+                .ok());
+    CHECK(async_io->wait(id).ok());
+    CHECK(value == 1);
+    REQUIRE(async_io
+                ->submit_task(
+                    []() { return Status::IOError("Task error"); }, &id)
+                .ok());
+    CHECK(!async_io->wait(id).ok());
+
+    // A request can be waited on only once
+    CHECK(!async_io->wait(id).ok());
+  }
+};
+
+TEST_CASE_METHOD(
+    AsyncIOFx, "AsyncIO: Test thread backend", "[async_io]") {
+  AsyncIO async_io;
+  REQUIRE(async_io.init(false, 4).ok());
+  CHECK(!async_io.uses_io_uring());
+  check_reads_and_writes(&async_io);
+}
+
+TEST_CASE_METHOD(
+    AsyncIOFx, "AsyncIO: Test io_uring backend", "[async_io]") {
+  // Falls back to the thread backend if io_uring is not available
+  AsyncIO async_io;
+  REQUIRE(async_io.init(true, 4).ok());
+  check_reads_and_writes(&async_io);
+}
+
+TEST_CASE("AsyncIO: Test uninitialized", "[async_io]") {
+  AsyncIO async_io;
+  uint64_t id;
+  CHECK(!async_io.submit_task([]() { return Status::Ok(); }, &id).ok());
+  CHECK(!async_io.init(false, 0).ok());
+  CHECK(!async_io.submit_task([]() { return Status::Ok(); }, &id).ok());
+}
@@ -41,3 +41,61 @@ TEST_CASE("Buffer: Test default constructor with write void*", "[buffer]") {
 
   delete buff;
 }
+
+TEST_CASE("Buffer: Test wrapping an existing region", "[buffer]") {
+  // Wrap a region and write into it
+  Status st;
+  char data[3] = {0, 0, 0};
+  char input[3] = {1, 2, 3};
+  auto buff = new Buffer(data, sizeof(data), false);
+  CHECK(buff->size() == 3);
+  CHECK(buff->alloced_size() == 3);
+  CHECK(buff->free_space() == 0);
+  buff->reset_size();
+  CHECK(buff->free_space() == 3);
+  st = buff->write(input, sizeof(input));
+  REQUIRE(st.ok());
+  CHECK(buff->size() == 3);
+  CHECK(data[2] == 3);
+
+  // The region cannot grow
+  st = buff->write(input, 1);
+  CHECK(!st.ok());
+
+  delete buff;
+
+  // An owning buffer can be made to reference the region as well
+  buff = new Buffer();
+  st = buff->write(input, sizeof(input));
+  REQUIRE(st.ok());
+  buff->wrap(data, 2);
+  CHECK(buff->data() == data);
+  CHECK(buff->size() == 2);
+  CHECK(buff->offset() == 0);
+  CHECK(!buff->realloc(10).ok());
+
+  delete buff;
+}
+
+TEST_CASE("Buffer: Test swap", "[buffer]") {
+  Status st;
+  char data[3] = {1, 2, 3};
+  char wrapped[2] = {4, 5};
+  auto buff1 = new Buffer();
+  auto buff2 = new Buffer(wrapped, sizeof(wrapped), false);
+  st = buff1->write(data, sizeof(data));
+  REQUIRE(st.ok());
+
+  buff1->swap(buff2);
+  CHECK(buff1->data() == wrapped);
+  CHECK(buff1->size() == 2);
+  CHECK(buff1->offset() == 0);
+  CHECK(buff2->size() == 3);
+  CHECK(buff2->offset() == 3);
+  CHECK(buff2->alloced_size() == 3);
+  CHECK(((char*)buff2->data())[2] == 3);
+
+  // The ownership of the data is swapped as well
+  delete buff1;
+  delete buff2;
+}
@@ -71,8 +71,13 @@ struct ArraySchemaFx {
   const char* ATTR_COMPRESSOR_STR = "NO_COMPRESSION";
   const int ATTR_COMPRESSION_LEVEL = -1;
   const char* ATTR_COMPRESSION_LEVEL_STR = "-1";
+  const tiledb_filter_t ATTR_FILTER = TILEDB_BYTESHUFFLE;
+  const char* ATTR_FILTER_STR = "BYTESHUFFLE";
+  const uint64_t ATTR_DICTIONARY_SIZE = 4096;
+  const char* ATTR_DICTIONARY_SIZE_STR = "4096";
   const unsigned int CELL_VAL_NUM = 1;
   const char* CELL_VAL_NUM_STR = "1";
+  const uint64_t CHUNK_SIZE = 65536;
   const int DIM_NUM = 2;
   const char* DIM1_NAME = "d1";
   const char* DIM2_NAME = "d2";
@@ -101,7 +106,7 @@ struct ArraySchemaFx {
     array_metadata_ = nullptr;
 
     // Initialize context
-    rc = tiledb_ctx_create(&ctx_);
+    rc = tiledb_ctx_create(&ctx_, nullptr);
     assert(rc == TILEDB_OK);
 
     // Create group, delete it if it already exists
@@ -199,6 +204,15 @@ struct ArraySchemaFx {
     tiledb_attribute_t* attr;
     rc = tiledb_attribute_create(ctx_, &attr, ATTR_NAME, ATTR_TYPE);
     REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_chunk_size(ctx_, attr, 0);
+    REQUIRE(rc == TILEDB_ERR);
+    rc = tiledb_attribute_set_chunk_size(ctx_, attr, CHUNK_SIZE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_filter(ctx_, attr, ATTR_FILTER);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compression_dictionary_size(
+        ctx_, attr, ATTR_DICTIONARY_SIZE);
+    REQUIRE(rc == TILEDB_OK);
     rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, attr);
     REQUIRE(rc == TILEDB_OK);
 
@@ -295,11 +309,27 @@ TEST_CASE_METHOD(
   CHECK(attr_compressor == ATTR_COMPRESSOR);
   CHECK(attr_compression_level == ATTR_COMPRESSION_LEVEL);
 
+  tiledb_filter_t attr_filter;
+  rc = tiledb_attribute_get_filter(ctx_, attr, &attr_filter);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(attr_filter == ATTR_FILTER);
+
+  uint64_t attr_dictionary_size;
+  rc = tiledb_attribute_get_compression_dictionary_size(
+      ctx_, attr, &attr_dictionary_size);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(attr_dictionary_size == ATTR_DICTIONARY_SIZE);
+
   unsigned int cell_val_num;
   rc = tiledb_attribute_get_cell_val_num(ctx_, attr, &cell_val_num);
   REQUIRE(rc == TILEDB_OK);
   CHECK(cell_val_num == CELL_VAL_NUM);
 
+  uint64_t chunk_size;
+  rc = tiledb_attribute_get_chunk_size(ctx_, attr, &chunk_size);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(chunk_size == CHUNK_SIZE);
+
   rc = tiledb_attribute_iter_next(ctx_, attr_it);
   REQUIRE(rc == TILEDB_OK);
   rc = tiledb_attribute_iter_done(ctx_, attr_it, &attr_it_done);
@@ -404,6 +434,8 @@ TEST_CASE_METHOD(
       "- Type: " + ATTR_TYPE_STR + "\n" +
       "- Compressor: " + ATTR_COMPRESSOR_STR + "\n" +
       "- Compression level: " + ATTR_COMPRESSION_LEVEL_STR + "\n" +
+      "- Filter: " + ATTR_FILTER_STR + "\n" +
+      "- Compression dictionary size: " + ATTR_DICTIONARY_SIZE_STR + "\n" +
       "- Cell val num: " + CELL_VAL_NUM_STR + "\n";
   FILE* gold_fout = fopen("gold_fout.txt", "w");
   const char* dump = dump_str.c_str();
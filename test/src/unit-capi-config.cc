@@ -0,0 +1,99 @@
+/**
+ * @file unit-capi-config.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests for the C API tiledb_config_t object.
+ */
+
+#include "catch.hpp"
+#include "tiledb.h"
+
+TEST_CASE("C API: Test config", "[capi], [config]") {
+  tiledb_config_t* config;
+  int rc = tiledb_config_create(&config);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Invalid parameters and values
+  rc = tiledb_config_set(config, "sm.unknown", "1");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.num_threads", "0");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.num_threads", "-2");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.num_threads", "two");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "vfs.max_open_files", "-1");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "vfs.mmap_reads", "yes");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.tile_cache_size", "-1");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "LZ4,FOO");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "ADAPTIVE");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "ZSTD:");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "ZSTD:-1");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.adaptive_decode_weight", "-1");
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_config_set(config, "sm.parallel_read_blocks", "-1");
+  CHECK(rc == TILEDB_ERR);
+
+  // Disabling the descriptor cache is valid
+  rc = tiledb_config_set(config, "vfs.max_open_files", "0");
+  CHECK(rc == TILEDB_OK);
+
+  // Create a context with a valid configuration
+  rc = tiledb_config_set(config, "sm.num_threads", "2");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "vfs.max_open_files", "16");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "vfs.mmap_reads", "true");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "sm.tile_cache_size", "0");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "sm.adaptive_compressors", "RLE,ZSTD:19");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "sm.adaptive_decode_weight", "10");
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_config_set(config, "sm.parallel_read_blocks", "8");
+  CHECK(rc == TILEDB_OK);
+  tiledb_ctx_t* ctx;
+  rc = tiledb_ctx_create(&ctx, config);
+  CHECK(rc == TILEDB_OK);
+
+  // The configuration can be freed right after the context creation
+  rc = tiledb_config_free(config);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_ctx_free(ctx);
+  CHECK(rc == TILEDB_OK);
+}
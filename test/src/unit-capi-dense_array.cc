@@ -78,7 +78,7 @@ struct DenseArrayFx {
     std::srand(0);
 
     // Initialize context
-    int rc = tiledb_ctx_create(&ctx_);
+    int rc = tiledb_ctx_create(&ctx_, nullptr);
     assert(rc == TILEDB_OK);
 
     // Create group, delete it if it already exists
@@ -182,6 +182,8 @@ struct DenseArrayFx {
    * @param capacity The tile capacity.
    * @param cell_order The cell order.
    * @param tile_order The tile order.
+   * @param compressor The attribute compressor.
+   * @param chunk_size The attribute chunk size (0 keeps the default).
    */
   void create_dense_array_2D(
       const int64_t tile_extent_0,
@@ -192,7 +194,9 @@ struct DenseArrayFx {
       const int64_t domain_1_hi,
       const uint64_t capacity,
       const tiledb_layout_t cell_order,
-      const tiledb_layout_t tile_order) {
+      const tiledb_layout_t tile_order,
+      const tiledb_compressor_t compressor = TILEDB_NO_COMPRESSION,
+      const uint64_t chunk_size = 0) {
     // Error code
     int rc;
 
@@ -203,8 +207,12 @@ struct DenseArrayFx {
     tiledb_attribute_t* a;
     rc = tiledb_attribute_create(ctx_, &a, ATTR_NAME, ATTR_TYPE);
     REQUIRE(rc == TILEDB_OK);
-    //    rc = tiledb_attribute_set_compressor(ctx_, a, TILEDB_GZIP, -1);
-    //    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compressor(ctx_, a, compressor, -1);
+    REQUIRE(rc == TILEDB_OK);
+    if (chunk_size != 0) {
+      rc = tiledb_attribute_set_chunk_size(ctx_, a, chunk_size);
+      REQUIRE(rc == TILEDB_OK);
+    }
 
     // Create domain
     tiledb_domain_t* domain;
@@ -381,6 +389,23 @@ struct DenseArrayFx {
     array_name_ = URI_PREFIX + TEMP_DIR + GROUP + name;
   }
 
+  /**
+   * Switches to a context that splits the reads into at most the input
+   * number of blocks, which are read in parallel.
+   *
+   * @param block_num The maximum number of blocks.
+   */
+  void set_parallel_read_blocks(const char* block_num) {
+    tiledb_config_t* config;
+    REQUIRE(tiledb_config_create(&config) == TILEDB_OK);
+    REQUIRE(
+        tiledb_config_set(config, "sm.parallel_read_blocks", block_num) ==
+        TILEDB_OK);
+    REQUIRE(tiledb_ctx_free(ctx_) == TILEDB_OK);
+    REQUIRE(tiledb_ctx_create(&ctx_, config) == TILEDB_OK);
+    REQUIRE(tiledb_config_free(config) == TILEDB_OK);
+  }
+
   /**
    * Updates random locations in a dense array with the input domain sizes.
    *
@@ -694,6 +719,240 @@ TEST_CASE_METHOD(
   }
 }
 
+/**
+ * Tests that tiles compressed in multiple chunks are read back correctly.
+ */
+TEST_CASE_METHOD(
+    DenseArrayFx, "C API: Test dense chunked compression", "[dense]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  int64_t domain_size_0 = 1000;
+  int64_t domain_size_1 = 1000;
+  int64_t tile_extent_0 = 500;
+  int64_t tile_extent_1 = 500;
+  uint64_t capacity = 250000;
+  uint64_t chunk_size = 65536;
+
+  // Set array name
+  set_array_name("dense_test_1000x1000_500x500_chunked");
+
+  // Create a dense integer array, whose tiles span 16 chunks each
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      capacity,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      TILEDB_GZIP,
+      chunk_size);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read the entire array back and check
+  int* buffer = read_dense_array_2D(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  REQUIRE(buffer != NULL);
+
+  bool allok = true;
+  for (int64_t i = 0; i < domain_size_0 * domain_size_1; ++i) {
+    if (buffer[i] != i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+  delete[] buffer;
+
+  // Reading the array again is served by the tile cache
+  uint64_t hits, misses;
+  rc = tiledb_ctx_get_tile_cache_stats(ctx_, &hits, &misses);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(misses > 0);
+  uint64_t prev_hits = hits;
+  buffer = read_dense_array_2D(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  REQUIRE(buffer != NULL);
+  CHECK(
+      buffer[domain_size_0 * domain_size_1 - 1] ==
+      domain_size_0 * domain_size_1 - 1);
+  rc = tiledb_ctx_get_tile_cache_stats(ctx_, &hits, &misses);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(hits > prev_hits);
+
+  // Clean up
+  delete[] buffer;
+}
+
+/**
+ * Tests that tiles compressed with the ADAPTIVE compressor, which selects a
+ * compressor per chunk, are read back correctly.
+ */
+TEST_CASE_METHOD(
+    DenseArrayFx, "C API: Test dense adaptive compression", "[dense]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  int64_t domain_size_0 = 1000;
+  int64_t domain_size_1 = 1000;
+  int64_t tile_extent_0 = 500;
+  int64_t tile_extent_1 = 500;
+  uint64_t capacity = 250000;
+  uint64_t chunk_size = 0;
+
+  // Set array name
+  set_array_name("dense_test_1000x1000_500x500_adaptive");
+
+  SECTION("- default candidates, sampled chunks") {
+    chunk_size = 262144;
+  }
+
+  SECTION("- custom candidates favoring decompression speed") {
+    // Chunks of the sample size are trial-compressed as a whole
+    chunk_size = 65536;
+    tiledb_config_t* config;
+    REQUIRE(tiledb_config_create(&config) == TILEDB_OK);
+    REQUIRE(
+        tiledb_config_set(config, "sm.adaptive_compressors", "GZIP:1,LZ4") ==
+        TILEDB_OK);
+    REQUIRE(
+        tiledb_config_set(config, "sm.adaptive_decode_weight", "5") ==
+        TILEDB_OK);
+    REQUIRE(tiledb_ctx_free(ctx_) == TILEDB_OK);
+    REQUIRE(tiledb_ctx_create(&ctx_, config) == TILEDB_OK);
+    REQUIRE(tiledb_config_free(config) == TILEDB_OK);
+  }
+
+  // Create a dense integer array with the ADAPTIVE compressor
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      capacity,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ADAPTIVE,
+      chunk_size);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read the entire array back and check
+  int* buffer = read_dense_array_2D(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR);
+  REQUIRE(buffer != NULL);
+
+  bool allok = true;
+  for (int64_t i = 0; i < domain_size_0 * domain_size_1; ++i) {
+    if (buffer[i] != i) {
+      allok = false;
+      break;
+    }
+  }
+  CHECK(allok);
+  delete[] buffer;
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx, "C API: Test dense memory-mapped reads", "[dense]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  uint64_t capacity = 1000;
+
+  // Set array name
+  set_array_name("dense_test_100x100_10x10_mmap");
+
+  // Create an uncompressed dense integer array
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      capacity,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Write array cells with value = row id * COLUMNS + col id
+  rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Switch to a context that reads uncompressed tiles via memory mapping
+  tiledb_config_t* config;
+  REQUIRE(tiledb_config_create(&config) == TILEDB_OK);
+  REQUIRE(tiledb_config_set(config, "vfs.mmap_reads", "true") == TILEDB_OK);
+  REQUIRE(tiledb_ctx_free(ctx_) == TILEDB_OK);
+  REQUIRE(tiledb_ctx_create(&ctx_, config) == TILEDB_OK);
+  REQUIRE(tiledb_config_free(config) == TILEDB_OK);
+
+  // Read the entire array in the global order (sequential access) and a
+  // subarray in row-major order (random access), and check
+  int* buffer = read_dense_array_2D(
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER);
+  REQUIRE(buffer != NULL);
+  int64_t cell = 0;
+  bool allok = true;
+  for (int64_t t0 = 0; t0 < domain_size_0; t0 += tile_extent_0)
+    for (int64_t t1 = 0; t1 < domain_size_1; t1 += tile_extent_1)
+      for (int64_t i = t0; i < t0 + tile_extent_0; ++i)
+        for (int64_t j = t1; j < t1 + tile_extent_1; ++j)
+          allok = allok && (buffer[cell++] == i * domain_size_1 + j);
+  CHECK(allok);
+  delete[] buffer;
+
+  buffer = read_dense_array_2D(15, 64, 23, 77, TILEDB_READ, TILEDB_ROW_MAJOR);
+  REQUIRE(buffer != NULL);
+  cell = 0;
+  allok = true;
+  for (int64_t i = 15; i <= 64; ++i)
+    for (int64_t j = 23; j <= 77; ++j)
+      allok = allok && (buffer[cell++] == i * domain_size_1 + j);
+  CHECK(allok);
+  delete[] buffer;
+}
+
 /**
  * Tests random 2D subarray writes.
  */
@@ -876,3 +1135,451 @@ TEST_CASE_METHOD(DenseArrayFx, "C API: Test random dense updates", "[dense]") {
   delete[] buffer_a1;
   delete[] buffer_coords;
 }
+
+/**
+ * Tests reading subarrays of a 2D dense array with multiple fragments in
+ * parallel.
+ */
+TEST_CASE_METHOD(
+    DenseArrayFx, "C API: Test parallel dense reads", "[dense][parallel]") {
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t update_num = 100;
+  int seed = 7;
+
+  // Create a dense integer array with an update fragment
+  set_array_name("dense_test_parallel_reads");
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  int rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+  auto buffer_a1 = new int[update_num];
+  auto buffer_coords = new int64_t[2 * update_num];
+  void* buffers[] = {buffer_a1, buffer_coords};
+  uint64_t buffer_sizes[] = {update_num * sizeof(int),
+                             2 * update_num * sizeof(int64_t)};
+  rc = update_dense_array_2D(
+      domain_size_0, domain_size_1, update_num, seed, buffers, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  delete[] buffer_a1;
+  delete[] buffer_coords;
+
+  // The subarrays span several tile rows, a single (partial) tile row, and
+  // a single tile
+  const int64_t subarrays[][4] = {
+      {0, 99, 0, 99}, {13, 87, 5, 94}, {42, 47, 3, 71}, {21, 28, 31, 38}};
+  for (auto subarray : subarrays) {
+    int64_t cell_num =
+        (subarray[1] - subarray[0] + 1) * (subarray[3] - subarray[2] + 1);
+
+    // Read serially
+    set_parallel_read_blocks("1");
+    int* expected = read_dense_array_2D(
+        subarray[0],
+        subarray[1],
+        subarray[2],
+        subarray[3],
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER);
+    REQUIRE(expected != nullptr);
+
+    // Read with an uneven number of blocks
+    set_parallel_read_blocks("3");
+    int* result = read_dense_array_2D(
+        subarray[0],
+        subarray[1],
+        subarray[2],
+        subarray[3],
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER);
+    REQUIRE(result != nullptr);
+    CHECK(!memcmp(expected, result, cell_num * sizeof(int)));
+    delete[] result;
+
+    // Read in parts, since the results do not fit in the buffer
+    std::vector<int> parts;
+    std::vector<int> part((uint64_t)cell_num / 2 + 1);
+    void* part_buffers[] = {part.data()};
+    uint64_t part_buffer_sizes[1];
+    const char* attributes[] = {ATTR_NAME};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER,
+        subarray,
+        attributes,
+        1,
+        part_buffers,
+        part_buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_query_status_t status;
+    do {
+      part_buffer_sizes[0] = part.size() * sizeof(int);
+      REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+      parts.insert(
+          parts.end(),
+          part.begin(),
+          part.begin() + part_buffer_sizes[0] / sizeof(int));
+      REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+    } while (status == TILEDB_INCOMPLETE);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+    REQUIRE(parts.size() == (uint64_t)cell_num);
+    CHECK(!memcmp(expected, parts.data(), cell_num * sizeof(int)));
+    delete[] expected;
+  }
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test max read buffer sizes in dense arrays",
+    "[dense][buffer_sizes]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+  int64_t update_num = 100;
+  int seed = 7;
+
+  // Create a dense integer array with an update fragment
+  set_array_name("dense_test_max_read_buffer_sizes");
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+  auto buffer_a1 = new int[update_num];
+  auto buffer_coords = new int64_t[2 * update_num];
+  void* update_buffers[] = {buffer_a1, buffer_coords};
+  uint64_t update_buffer_sizes[] = {update_num * sizeof(int),
+                                    2 * update_num * sizeof(int64_t)};
+  rc = update_dense_array_2D(
+      domain_size_0,
+      domain_size_1,
+      update_num,
+      seed,
+      update_buffers,
+      update_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  delete[] buffer_a1;
+  delete[] buffer_coords;
+
+  // The sizes of the fixed-sized attributes are exact
+  const int64_t subarray[] = {13, 87, 5, 94};
+  uint64_t cell_num = 75 * 90;
+  const char* attributes[] = {ATTR_NAME, TILEDB_COORDS};
+  uint64_t buffer_sizes[2];
+  rc = tiledb_array_compute_max_read_buffer_sizes(
+      ctx_, array_name_.c_str(), subarray, attributes, 2, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(buffer_sizes[0] == cell_num * sizeof(int));
+  CHECK(buffer_sizes[1] == 2 * cell_num * sizeof(int64_t));
+  rc = tiledb_array_compute_max_read_buffer_sizes(
+      ctx_, array_name_.c_str(), nullptr, nullptr, 0, buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(buffer_sizes[0] == domain_size_0 * domain_size_1 * sizeof(int));
+
+  // Create an array with a variable-sized attribute
+  set_array_name("dense_test_max_read_buffer_sizes_var");
+  int64_t dim_domain[] = {1, 10};
+  int64_t tile_extent = 5;
+  tiledb_attribute_t* b;
+  rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM2_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(
+      ctx_, array_metadata_, TILEDB_DENSE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_free(ctx_, b);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // Write a part of the array, leaving the rest empty
+  const int64_t write_subarray[] = {3, 6, 2, 9};
+  uint64_t write_cell_num = 4 * 8;
+  std::vector<uint64_t> write_offsets;
+  std::string write_values;
+  for (uint64_t i = 0; i < write_cell_num; ++i) {
+    write_offsets.push_back(write_values.size());
+    write_values += std::string(i % 5 + 1, 'x');
+  }
+  void* write_buffers[] = {write_offsets.data(), &write_values[0]};
+  uint64_t write_buffer_sizes[] = {write_offsets.size() * sizeof(uint64_t),
+                                   write_values.size()};
+  tiledb_query_t* query;
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_WRITE,
+      TILEDB_ROW_MAJOR,
+      write_subarray,
+      nullptr,
+      0,
+      write_buffers,
+      write_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+
+  // A read with buffers of the computed sizes completes at once, retrieving
+  // the written values along with an empty value per empty cell
+  const int64_t read_subarray[] = {2, 8, 1, 10};
+  uint64_t read_cell_num = 7 * 10;
+  uint64_t var_buffer_sizes[2];
+  rc = tiledb_array_compute_max_read_buffer_sizes(
+      ctx_, array_name_.c_str(), read_subarray, nullptr, 0, var_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(var_buffer_sizes[0] == read_cell_num * sizeof(uint64_t));
+  uint64_t read_values_size =
+      write_values.size() + read_cell_num - write_cell_num;
+  CHECK(var_buffer_sizes[1] >= read_values_size);
+  std::vector<uint64_t> read_offsets(read_cell_num);
+  std::vector<char> read_values(var_buffer_sizes[1]);
+  void* read_buffers[] = {read_offsets.data(), read_values.data()};
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_READ,
+      TILEDB_ROW_MAJOR,
+      read_subarray,
+      nullptr,
+      0,
+      read_buffers,
+      var_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+  tiledb_query_status_t status;
+  REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+  CHECK(status == TILEDB_COMPLETED);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  CHECK(var_buffer_sizes[0] == read_cell_num * sizeof(uint64_t));
+  CHECK(var_buffer_sizes[1] == read_values_size);
+}
+
+TEST_CASE_METHOD(
+    DenseArrayFx,
+    "C API: Test dense reads in column-major order",
+    "[dense][col_major]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  int64_t domain_size_0 = 100;
+  int64_t domain_size_1 = 100;
+  int64_t tile_extent_0 = 10;
+  int64_t tile_extent_1 = 10;
+
+  // Create a dense integer array in row-major cell order
+  set_array_name("dense_test_col_major_reads");
+  create_dense_array_2D(
+      tile_extent_0,
+      tile_extent_1,
+      0,
+      domain_size_0 - 1,
+      0,
+      domain_size_1 - 1,
+      1000,
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+  rc = write_dense_array_by_tiles(
+      domain_size_0, domain_size_1, tile_extent_0, tile_extent_1);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read the whole subarray at once
+  const int64_t subarray[] = {13, 87, 5, 94};
+  int64_t rows = subarray[1] - subarray[0] + 1;
+  int64_t cols = subarray[3] - subarray[2] + 1;
+  std::vector<int> expected;
+  for (int64_t j = subarray[2]; j <= subarray[3]; ++j)
+    for (int64_t i = subarray[0]; i <= subarray[1]; ++i)
+      expected.push_back((int)(i * domain_size_1 + j));
+  int* result = read_dense_array_2D(
+      subarray[0],
+      subarray[1],
+      subarray[2],
+      subarray[3],
+      TILEDB_READ,
+      TILEDB_COL_MAJOR);
+  REQUIRE(result != nullptr);
+  CHECK(!memcmp(expected.data(), result, rows * cols * sizeof(int)));
+  delete[] result;
+
+  // Read in parts that end in the middle of tile columns
+  std::vector<int> parts;
+  std::vector<int> part(37);
+  void* part_buffers[] = {part.data()};
+  uint64_t part_buffer_sizes[1];
+  const char* attributes[] = {ATTR_NAME};
+  tiledb_query_t* query;
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_READ,
+      TILEDB_COL_MAJOR,
+      subarray,
+      attributes,
+      1,
+      part_buffers,
+      part_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_status_t status;
+  do {
+    part_buffer_sizes[0] = part.size() * sizeof(int);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    parts.insert(
+        parts.end(),
+        part.begin(),
+        part.begin() + part_buffer_sizes[0] / sizeof(int));
+    REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+  } while (status == TILEDB_INCOMPLETE);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  CHECK(parts == expected);
+
+  // Create an array with a variable-sized attribute
+  set_array_name("dense_test_col_major_reads_var");
+  int64_t dim_domain[] = {1, 10};
+  int64_t tile_extent = 5;
+  tiledb_attribute_t* b;
+  rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM2_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(
+      ctx_, array_metadata_, TILEDB_DENSE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_free(ctx_, b);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // Write the whole array in row-major order
+  std::vector<std::string> cell_values;
+  std::vector<uint64_t> write_offsets;
+  std::string write_values;
+  for (int i = 0; i < 100; ++i) {
+    cell_values.push_back(std::string(i % 3 + 1, (char)('a' + i % 26)));
+    write_offsets.push_back(write_values.size());
+    write_values += cell_values.back();
+  }
+  void* write_buffers[] = {write_offsets.data(), &write_values[0]};
+  uint64_t write_buffer_sizes[] = {write_offsets.size() * sizeof(uint64_t),
+                                   write_values.size()};
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_WRITE,
+      TILEDB_ROW_MAJOR,
+      nullptr,
+      nullptr,
+      0,
+      write_buffers,
+      write_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+
+  // Read in column-major order in parts, with both buffers overflowing
+  const int64_t var_subarray[] = {2, 8, 1, 10};
+  std::vector<std::string> expected_var;
+  for (int64_t j = var_subarray[2]; j <= var_subarray[3]; ++j)
+    for (int64_t i = var_subarray[0]; i <= var_subarray[1]; ++i)
+      expected_var.push_back(cell_values[(i - 1) * 10 + j - 1]);
+  std::vector<std::string> parts_var;
+  std::vector<uint64_t> read_offsets(6);
+  std::vector<char> read_values(11);
+  void* read_buffers[] = {read_offsets.data(), read_values.data()};
+  uint64_t read_buffer_sizes[2];
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_READ,
+      TILEDB_COL_MAJOR,
+      var_subarray,
+      nullptr,
+      0,
+      read_buffers,
+      read_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  do {
+    read_buffer_sizes[0] = read_offsets.size() * sizeof(uint64_t);
+    read_buffer_sizes[1] = read_values.size();
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    uint64_t cell_num = read_buffer_sizes[0] / sizeof(uint64_t);
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      uint64_t end =
+          (i == cell_num - 1) ? read_buffer_sizes[1] : read_offsets[i + 1];
+      parts_var.push_back(std::string(
+          &read_values[read_offsets[i]], end - read_offsets[i]));
+    }
+    REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+  } while (status == TILEDB_INCOMPLETE);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  CHECK(parts_var == expected_var);
+}
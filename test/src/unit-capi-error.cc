@@ -38,7 +38,7 @@
 
 TEST_CASE("C API: Test error and error message", "[capi]") {
   tiledb_ctx_t* ctx;
-  int rc = tiledb_ctx_create(&ctx);
+  int rc = tiledb_ctx_create(&ctx, nullptr);
   CHECK(rc == TILEDB_OK);
 
   const char* bad_path = nullptr;
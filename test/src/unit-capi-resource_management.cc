@@ -53,7 +53,7 @@ struct ResourceMgmtRx {
 
   ResourceMgmtRx() {
     // Initialize context
-    int rc = tiledb_ctx_create(&ctx_);
+    int rc = tiledb_ctx_create(&ctx_, nullptr);
     assert(rc == TILEDB_OK);
 
     // cleanup temporary test group if it exists
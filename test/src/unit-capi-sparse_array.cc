@@ -42,6 +42,8 @@
 #include <iostream>
 #include <map>
 #include <sstream>
+#include <string>
+#include <vector>
 
 struct SparseArrayFx {
   // Constant parameters
@@ -74,7 +76,7 @@ struct SparseArrayFx {
 
   SparseArrayFx() {
     // Initialize context
-    int rc = tiledb_ctx_create(&ctx_);
+    int rc = tiledb_ctx_create(&ctx_, nullptr);
     assert(rc == TILEDB_OK);
 
     // Create group, delete it if it already exists
@@ -125,6 +127,7 @@ struct SparseArrayFx {
    * @param capacity The tile capacity.
    * @param cell_order The cell order.
    * @param tile_order The tile order.
+   * @param filter The attribute filter.
    */
   void create_sparse_array_2D(
       const int64_t tile_extent_0,
@@ -136,7 +139,8 @@ struct SparseArrayFx {
       const uint64_t capacity,
       const tiledb_compressor_t compressor,
       const tiledb_layout_t cell_order,
-      const tiledb_layout_t tile_order) {
+      const tiledb_layout_t tile_order,
+      const tiledb_filter_t filter = TILEDB_NO_FILTER) {
     // Error code
     int rc;
 
@@ -150,6 +154,8 @@ struct SparseArrayFx {
     rc =
         tiledb_attribute_set_compressor(ctx_, a, compressor, COMPRESSION_LEVEL);
     REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_filter(ctx_, a, filter);
+    REQUIRE(rc == TILEDB_OK);
 
     // Create domain
     tiledb_domain_t* domain;
@@ -282,6 +288,23 @@ struct SparseArrayFx {
     array_name_ = URI_PREFIX + TEMP_DIR + GROUP + name;
   }
 
+  /**
+   * Switches to a context that splits the reads into at most the input
+   * number of blocks, which are read in parallel.
+   *
+   * @param block_num The maximum number of blocks.
+   */
+  void set_parallel_read_blocks(const char* block_num) {
+    tiledb_config_t* config;
+    REQUIRE(tiledb_config_create(&config) == TILEDB_OK);
+    REQUIRE(
+        tiledb_config_set(config, "sm.parallel_read_blocks", block_num) ==
+        TILEDB_OK);
+    REQUIRE(tiledb_ctx_free(ctx_) == TILEDB_OK);
+    REQUIRE(tiledb_ctx_create(&ctx_, config) == TILEDB_OK);
+    REQUIRE(tiledb_config_free(config) == TILEDB_OK);
+  }
+
   /**
    * Write random values in unsorted mode. The buffer is initialized with each
    * cell being equalt to row_id*domain_size_1+col_id.
@@ -595,6 +618,54 @@ TEST_CASE_METHOD(
     CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
   }
 
+  SECTION("- zstd compression with byte shuffle filter row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_ZSTD,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR,
+        TILEDB_BYTESHUFFLE);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+
+  SECTION("- zstd compression with bit shuffle filter row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_ZSTD,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR,
+        TILEDB_BITSHUFFLE);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+
+  SECTION("- zstd compression with delta filter row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_ZSTD,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR,
+        TILEDB_DELTA);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+
   SECTION("- double delta compression row/col-major") {
     create_sparse_array_2D(
         tile_extent_0,
@@ -609,4 +680,962 @@ TEST_CASE_METHOD(
         TILEDB_COL_MAJOR);
     CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
   }
+
+  SECTION("- block double delta compression row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_BLOCK_DOUBLE_DELTA,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+
+  SECTION("- gorilla compression row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_GORILLA,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+
+  SECTION("- adaptive compression row/col-major") {
+    create_sparse_array_2D(
+        tile_extent_0,
+        tile_extent_1,
+        domain_0_lo,
+        domain_0_hi,
+        domain_1_lo,
+        domain_1_hi,
+        capacity,
+        TILEDB_ADAPTIVE,
+        TILEDB_ROW_MAJOR,
+        TILEDB_COL_MAJOR);
+    CHECK(test_random_subarrays(domain_size_0, domain_size_1, ntests));
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse array with dictionary filter",
+    "[sparse][dictionary]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  const int64_t cell_num = 4000;
+  const char* countries[] = {"Greece", "USA", "", "United Kingdom", "Peru"};
+  tiledb_compressor_t compressor = TILEDB_NO_COMPRESSION;
+  set_array_name("sparse_test_dictionary");
+
+  SECTION("- no compression") {
+    compressor = TILEDB_NO_COMPRESSION;
+  }
+
+  SECTION("- zstd compression") {
+    compressor = TILEDB_ZSTD;
+  }
+
+  // Create a 1D array with two variable-sized attributes, which are read
+  // together below
+  int64_t dim_domain[] = {1, cell_num};
+  int64_t tile_extent = 1000;
+  const char* attr_names[] = {ATTR_NAME, "a2"};
+  tiledb_attribute_t* attrs[2];
+  for (int i = 0; i < 2; ++i) {
+    rc = tiledb_attribute_create(ctx_, &attrs[i], attr_names[i], TILEDB_CHAR);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_cell_val_num(ctx_, attrs[i], TILEDB_VAR_NUM);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compressor(
+        ctx_, attrs[i], compressor, COMPRESSION_LEVEL);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_filter(ctx_, attrs[i], TILEDB_DICTIONARY);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_capacity(ctx_, array_metadata_, 500);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(ctx_, array_metadata_, ARRAY_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  for (int i = 0; i < 2; ++i) {
+    rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, attrs[i]);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  for (int i = 0; i < 2; ++i)
+    tiledb_attribute_free(ctx_, attrs[i]);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // In the first attribute, the first half of the cells holds few distinct
+  // values, which are dictionary-encoded, and the second half distinct
+  // values, which are not. The second attribute is the other way around.
+  std::vector<std::string> cells[2];
+  for (int64_t i = 0; i < cell_num; ++i) {
+    bool few = i < cell_num / 2;
+    cells[0].push_back(
+        few ? countries[(i * 3) % 5] : "value_" + std::to_string(i));
+    cells[1].push_back(
+        few ? "key_" + std::to_string(i) : countries[(i * 7) % 5]);
+  }
+  std::vector<uint64_t> offsets[2];
+  std::string values[2];
+  std::vector<int64_t> coords;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      offsets[j].push_back(values[j].size());
+      values[j] += cells[j][i];
+    }
+    coords.push_back(i + 1);
+  }
+
+  // Write the cells in global order
+  tiledb_query_t* query;
+  void* write_buffers[] = {offsets[0].data(),
+                           &values[0][0],
+                           offsets[1].data(),
+                           &values[1][0],
+                           coords.data()};
+  uint64_t write_buffer_sizes[] = {offsets[0].size() * sizeof(uint64_t),
+                                   values[0].size(),
+                                   offsets[1].size() * sizeof(uint64_t),
+                                   values[1].size(),
+                                   coords.size() * sizeof(int64_t)};
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_WRITE,
+      TILEDB_GLOBAL_ORDER,
+      nullptr,
+      nullptr,
+      0,
+      write_buffers,
+      write_buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_free(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read back both attributes over the whole array and a range crossing the
+  // two halves
+  const int64_t subarrays[][2] = {{1, cell_num}, {1234, 2777}};
+  for (auto subarray : subarrays) {
+    // The maximum buffer sizes account for the decoded values
+    uint64_t read_buffer_sizes[4];
+    rc = tiledb_array_compute_max_read_buffer_sizes(
+        ctx_, array_name_.c_str(), subarray, attr_names, 2, read_buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    std::vector<uint64_t> read_offsets[2];
+    std::vector<char> read_values[2];
+    for (int j = 0; j < 2; ++j) {
+      read_offsets[j].resize(read_buffer_sizes[2 * j] / sizeof(uint64_t));
+      read_values[j].resize(read_buffer_sizes[2 * j + 1]);
+    }
+    void* read_buffers[] = {read_offsets[0].data(),
+                            read_values[0].data(),
+                            read_offsets[1].data(),
+                            read_values[1].data()};
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER,
+        subarray,
+        attr_names,
+        2,
+        read_buffers,
+        read_buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_query_status_t status;
+    rc = tiledb_query_get_status(ctx_, query, &status);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(status == TILEDB_COMPLETED);
+    rc = tiledb_query_free(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Check the cells
+    int64_t result_num = subarray[1] - subarray[0] + 1;
+    for (int j = 0; j < 2; ++j) {
+      REQUIRE(read_buffer_sizes[2 * j] == result_num * sizeof(uint64_t));
+      std::string expected_values;
+      bool allok = true;
+      for (int64_t i = 0; i < result_num; ++i) {
+        allok &= (read_offsets[j][i] == expected_values.size());
+        expected_values += cells[j][subarray[0] - 1 + i];
+      }
+      CHECK(allok);
+      REQUIRE(read_buffer_sizes[2 * j + 1] == expected_values.size());
+      CHECK(!memcmp(
+          read_values[j].data(),
+          expected_values.data(),
+          expected_values.size()));
+    }
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse array with compression dictionaries",
+    "[sparse][compression-dictionary]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  const int64_t cell_num = 20000;
+  const char* statuses[] = {"ok", "degraded", "failed", "rebooting"};
+  const uint64_t dictionary_sizes[] = {0, 2048};
+  uint64_t fragment_sizes[2];
+
+  // Small JSON-like records, which share much content across tiles
+  std::vector<std::string> cells;
+  std::vector<int> b_cells;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    cells.push_back(
+        "{\"host\":\"node-" + std::to_string(i % 16) +
+        ".example.com\",\"status\":\"" + statuses[(i / 3) % 4] +
+        "\",\"seq\":" + std::to_string(i) + "}");
+    b_cells.push_back((int)(i % 97) * 1000);
+  }
+  std::vector<uint64_t> offsets;
+  std::string values;
+  std::vector<int64_t> coords;
+  for (int64_t i = 0; i < cell_num; ++i) {
+    offsets.push_back(values.size());
+    values += cells[i];
+    coords.push_back(i + 1);
+  }
+
+  for (int d = 0; d < 2; ++d) {
+    set_array_name(
+        ("sparse_test_compression_dictionary_" + std::to_string(d)).c_str());
+
+    // Create a 1D array with small tiles, whose ZSTD-compressed attribute
+    // files use dictionaries of the given size
+    int64_t dim_domain[] = {1, cell_num};
+    int64_t tile_extent = 1000;
+    tiledb_attribute_t* a;
+    rc = tiledb_attribute_create(ctx_, &a, ATTR_NAME, TILEDB_CHAR);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_cell_val_num(ctx_, a, TILEDB_VAR_NUM);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compressor(ctx_, a, TILEDB_ZSTD, -1);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compression_dictionary_size(
+        ctx_, a, dictionary_sizes[d]);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_attribute_t* b;
+    rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_INT32);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compressor(ctx_, b, TILEDB_ZSTD, -1);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_attribute_set_compression_dictionary_size(
+        ctx_, b, dictionary_sizes[d]);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_domain_t* domain;
+    rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_domain_add_dimension(
+        ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_create(
+        ctx_, &array_metadata_, array_name_.c_str());
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_set_capacity(ctx_, array_metadata_, 64);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_set_array_type(
+        ctx_, array_metadata_, ARRAY_TYPE);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, a);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_create(ctx_, array_metadata_);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_attribute_free(ctx_, a);
+    tiledb_attribute_free(ctx_, b);
+    tiledb_domain_free(ctx_, domain);
+    tiledb_array_metadata_free(ctx_, array_metadata_);
+
+    // Write the cells in global order
+    tiledb_query_t* query;
+    void* write_buffers[] = {
+        offsets.data(), &values[0], b_cells.data(), coords.data()};
+    uint64_t write_buffer_sizes[] = {offsets.size() * sizeof(uint64_t),
+                                     values.size(),
+                                     b_cells.size() * sizeof(int),
+                                     coords.size() * sizeof(int64_t)};
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_WRITE,
+        TILEDB_GLOBAL_ORDER,
+        nullptr,
+        nullptr,
+        0,
+        write_buffers,
+        write_buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Read back a range of the array
+    const int64_t subarray[] = {1234, 15777};
+    int64_t result_num = subarray[1] - subarray[0] + 1;
+    const char* attributes[] = {ATTR_NAME, "b"};
+    std::vector<uint64_t> read_offsets(result_num);
+    std::vector<char> read_values(values.size());
+    std::vector<int> read_b(result_num);
+    void* read_buffers[] = {
+        read_offsets.data(), read_values.data(), read_b.data()};
+    uint64_t read_buffer_sizes[] = {
+        result_num * sizeof(uint64_t), values.size(), result_num * sizeof(int)};
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER,
+        subarray,
+        attributes,
+        2,
+        read_buffers,
+        read_buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_free(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Check the cells
+    REQUIRE(read_buffer_sizes[0] == result_num * sizeof(uint64_t));
+    REQUIRE(read_buffer_sizes[2] == result_num * sizeof(int));
+    std::string expected_values;
+    bool allok = true;
+    for (int64_t i = 0; i < result_num; ++i) {
+      allok &= (read_offsets[i] == expected_values.size());
+      allok &= (read_b[i] == b_cells[subarray[0] - 1 + i]);
+      expected_values += cells[subarray[0] - 1 + i];
+    }
+    CHECK(allok);
+    REQUIRE(read_buffer_sizes[1] == expected_values.size());
+    CHECK(!memcmp(
+        read_values.data(), expected_values.data(), expected_values.size()));
+
+    // Measure the fragment, including its metadata and dictionaries
+    fragment_sizes[d] = 0;
+    std::vector<std::string> paths;
+    tiledb::posix::ls(TEMP_DIR + GROUP + array_name_.substr(
+        array_name_.rfind('/') + 1), &paths);
+    for (const auto& path : paths) {
+      if (!tiledb::posix::is_dir(path))
+        continue;
+      std::vector<std::string> files;
+      tiledb::posix::ls(path, &files);
+      for (const auto& file : files) {
+        uint64_t file_size;
+        REQUIRE(tiledb::posix::file_size(file, &file_size).ok());
+        fragment_sizes[d] += file_size;
+      }
+    }
+  }
+
+#ifndef HAVE_HDFS
+  // The dictionaries shrink the fragment considerably
+  CHECK(fragment_sizes[1] < fragment_sizes[0] * 3 / 4);
+#endif
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx, "C API: Test parallel sparse reads", "[sparse][parallel]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  const int64_t cell_num = 1000;
+  set_array_name("sparse_test_parallel_reads");
+
+  // Create a 1D array with a fixed- and a variable-sized attribute
+  int64_t dim_domain[] = {1, cell_num};
+  int64_t tile_extent = 100;
+  tiledb_attribute_t* a;
+  rc = tiledb_attribute_create(ctx_, &a, ATTR_NAME, ATTR_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_t* b;
+  rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_capacity(ctx_, array_metadata_, 30);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(ctx_, array_metadata_, ARRAY_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, a);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_free(ctx_, a);
+  tiledb_attribute_free(ctx_, b);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // Write two fragments, holding the even and the odd coordinates
+  auto value = [](int64_t i) {
+    return std::string((uint64_t)(i % 7) + 1, (char)('a' + i % 26));
+  };
+  for (int64_t first = 2; first >= 1; --first) {
+    std::vector<int> write_a;
+    std::vector<uint64_t> write_offsets;
+    std::string write_values;
+    std::vector<int64_t> write_coords;
+    for (int64_t i = first; i <= cell_num; i += 2) {
+      write_a.push_back((int)i);
+      write_offsets.push_back(write_values.size());
+      write_values += value(i);
+      write_coords.push_back(i);
+    }
+    void* buffers[] = {write_a.data(),
+                       write_offsets.data(),
+                       &write_values[0],
+                       write_coords.data()};
+    uint64_t buffer_sizes[] = {write_a.size() * sizeof(int),
+                               write_offsets.size() * sizeof(uint64_t),
+                               write_values.size(),
+                               write_coords.size() * sizeof(int64_t)};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_WRITE,
+        TILEDB_GLOBAL_ORDER,
+        nullptr,
+        nullptr,
+        0,
+        buffers,
+        buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  }
+
+  // The expected results on a subarray spanning several tiles
+  const int64_t subarray[] = {37, 911};
+  std::vector<int> expected_a;
+  std::vector<uint64_t> expected_offsets;
+  std::string expected_values;
+  for (int64_t i = subarray[0]; i <= subarray[1]; ++i) {
+    expected_a.push_back((int)i);
+    expected_offsets.push_back(expected_values.size());
+    expected_values += value(i);
+  }
+  auto result_num = (uint64_t)expected_a.size();
+
+  // Read serially and in parallel, with buffers that fit all the results or
+  // only a part of them
+  const char* block_nums[] = {"1", "4"};
+  const uint64_t part_result_nums[] = {result_num, result_num / 3};
+  for (auto block_num : block_nums) {
+    set_parallel_read_blocks(block_num);
+    for (auto part_result_num : part_result_nums) {
+      std::vector<int> part_a(part_result_num);
+      std::vector<uint64_t> part_offsets(part_result_num);
+      std::vector<char> part_values(8 * part_result_num);
+      std::vector<int64_t> part_coords(part_result_num);
+      void* buffers[] = {part_a.data(),
+                         part_offsets.data(),
+                         part_values.data(),
+                         part_coords.data()};
+      uint64_t buffer_sizes[4];
+      const char* attributes[] = {ATTR_NAME, "b", TILEDB_COORDS};
+      tiledb_query_t* query;
+      rc = tiledb_query_create(
+          ctx_,
+          &query,
+          array_name_.c_str(),
+          TILEDB_READ,
+          TILEDB_GLOBAL_ORDER,
+          subarray,
+          attributes,
+          3,
+          buffers,
+          buffer_sizes);
+      REQUIRE(rc == TILEDB_OK);
+
+      // Gather the parts of the results
+      std::vector<int> read_a;
+      std::vector<uint64_t> read_offsets;
+      std::string read_values;
+      std::vector<int64_t> read_coords;
+      tiledb_query_status_t status;
+      do {
+        buffer_sizes[0] = part_a.size() * sizeof(int);
+        buffer_sizes[1] = part_offsets.size() * sizeof(uint64_t);
+        buffer_sizes[2] = part_values.size();
+        buffer_sizes[3] = part_coords.size() * sizeof(int64_t);
+        REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+        read_a.insert(
+            read_a.end(),
+            part_a.begin(),
+            part_a.begin() + buffer_sizes[0] / sizeof(int));
+        for (uint64_t i = 0; i < buffer_sizes[1] / sizeof(uint64_t); ++i)
+          read_offsets.push_back(read_values.size() + part_offsets[i]);
+        read_values.append(part_values.data(), buffer_sizes[2]);
+        read_coords.insert(
+            read_coords.end(),
+            part_coords.begin(),
+            part_coords.begin() + buffer_sizes[3] / sizeof(int64_t));
+        REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+      } while (status == TILEDB_INCOMPLETE);
+      REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+
+      // Check the results
+      CHECK(read_a == expected_a);
+      CHECK(read_offsets == expected_offsets);
+      CHECK(read_values == expected_values);
+      REQUIRE(read_coords.size() == result_num);
+      bool allok = true;
+      for (uint64_t i = 0; i < result_num; ++i)
+        allok &= (read_coords[i] == expected_a[i]);
+      CHECK(allok);
+    }
+  }
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test max read buffer sizes in sparse arrays",
+    "[sparse][buffer_sizes]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  const int64_t cell_num = 1000;
+  const uint64_t capacity = 30;
+  set_array_name("sparse_test_max_read_buffer_sizes");
+
+  // Create a 1D array with a fixed- and a variable-sized attribute
+  int64_t dim_domain[] = {1, cell_num};
+  int64_t tile_extent = 100;
+  tiledb_attribute_t* a;
+  rc = tiledb_attribute_create(ctx_, &a, ATTR_NAME, ATTR_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_t* b;
+  rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_capacity(ctx_, array_metadata_, capacity);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(ctx_, array_metadata_, ARRAY_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, a);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_free(ctx_, a);
+  tiledb_attribute_free(ctx_, b);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // Write two fragments, holding the even and the odd coordinates
+  auto value = [](int64_t i) {
+    return std::string((uint64_t)(i % 7) + 1, (char)('a' + i % 26));
+  };
+  for (int64_t first = 2; first >= 1; --first) {
+    std::vector<int> write_a;
+    std::vector<uint64_t> write_offsets;
+    std::string write_values;
+    std::vector<int64_t> write_coords;
+    for (int64_t i = first; i <= cell_num; i += 2) {
+      write_a.push_back((int)i);
+      write_offsets.push_back(write_values.size());
+      write_values += value(i);
+      write_coords.push_back(i);
+    }
+    void* buffers[] = {write_a.data(),
+                       write_offsets.data(),
+                       &write_values[0],
+                       write_coords.data()};
+    uint64_t buffer_sizes[] = {write_a.size() * sizeof(int),
+                               write_offsets.size() * sizeof(uint64_t),
+                               write_values.size(),
+                               write_coords.size() * sizeof(int64_t)};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_WRITE,
+        TILEDB_GLOBAL_ORDER,
+        nullptr,
+        nullptr,
+        0,
+        buffers,
+        buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  }
+
+  // The subarrays span several tiles, a single cell, and the entire domain
+  const int64_t subarrays[][2] = {{37, 911}, {500, 500}, {1, cell_num}};
+  const char* attributes[] = {ATTR_NAME, "b", TILEDB_COORDS};
+  for (auto subarray : subarrays) {
+    uint64_t result_num = subarray[1] - subarray[0] + 1;
+    uint64_t result_values_size = 0;
+    for (int64_t i = subarray[0]; i <= subarray[1]; ++i)
+      result_values_size += value(i).size();
+
+    // The sizes bound the results, and they are not much larger than the
+    // overlapping tiles of the two fragments
+    uint64_t buffer_sizes[4];
+    rc = tiledb_array_compute_max_read_buffer_sizes(
+        ctx_, array_name_.c_str(), subarray, attributes, 3, buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    CHECK(buffer_sizes[0] >= result_num * sizeof(int));
+    CHECK(buffer_sizes[1] >= result_num * sizeof(uint64_t));
+    CHECK(buffer_sizes[2] >= result_values_size);
+    CHECK(buffer_sizes[3] >= result_num * sizeof(int64_t));
+    uint64_t max_cell_num = result_num + 4 * capacity;
+    CHECK(buffer_sizes[0] <= max_cell_num * sizeof(int));
+    CHECK(buffer_sizes[1] <= max_cell_num * sizeof(uint64_t));
+    CHECK(buffer_sizes[2] <= max_cell_num * 7);
+    CHECK(buffer_sizes[3] <= max_cell_num * sizeof(int64_t));
+
+    // A read with buffers of these sizes completes at once
+    std::vector<int> read_a(buffer_sizes[0] / sizeof(int));
+    std::vector<uint64_t> read_offsets(buffer_sizes[1] / sizeof(uint64_t));
+    std::vector<char> read_values(buffer_sizes[2]);
+    std::vector<int64_t> read_coords(buffer_sizes[3] / sizeof(int64_t));
+    void* buffers[] = {read_a.data(),
+                       read_offsets.data(),
+                       read_values.data(),
+                       read_coords.data()};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_READ,
+        TILEDB_GLOBAL_ORDER,
+        subarray,
+        attributes,
+        3,
+        buffers,
+        buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    tiledb_query_status_t status;
+    REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+    CHECK(status == TILEDB_COMPLETED);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+    CHECK(buffer_sizes[0] == result_num * sizeof(int));
+    CHECK(buffer_sizes[1] == result_num * sizeof(uint64_t));
+    CHECK(buffer_sizes[2] == result_values_size);
+    CHECK(buffer_sizes[3] == result_num * sizeof(int64_t));
+    CHECK(read_a[0] == subarray[0]);
+    CHECK(read_coords[result_num - 1] == subarray[1]);
+  }
+
+  // All the attributes are considered by default
+  uint64_t default_sizes[4];
+  rc = tiledb_array_compute_max_read_buffer_sizes(
+      ctx_, array_name_.c_str(), nullptr, nullptr, 0, default_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(default_sizes[0] == cell_num * sizeof(int));
+  CHECK(default_sizes[1] == cell_num * sizeof(uint64_t));
+  CHECK(default_sizes[3] == cell_num * sizeof(int64_t));
+
+  // Invalid attributes
+  const char* invalid_attributes[] = {"foo"};
+  rc = tiledb_array_compute_max_read_buffer_sizes(
+      ctx_,
+      array_name_.c_str(),
+      nullptr,
+      invalid_attributes,
+      1,
+      default_sizes);
+  CHECK(rc == TILEDB_ERR);
+}
+
+TEST_CASE_METHOD(
+    SparseArrayFx,
+    "C API: Test sparse reads with predicates",
+    "[sparse][predicate]") {
+  // Error code
+  int rc;
+
+  // Parameters used in this test
+  const int64_t cell_num = 1000;
+  set_array_name("sparse_test_predicates");
+
+  // Create a 1D array with a fixed- and a variable-sized attribute. The
+  // column-major cell order makes row-major reads go through the tile slabs
+  int64_t dim_domain[] = {1, cell_num};
+  int64_t tile_extent = 100;
+  tiledb_attribute_t* a;
+  rc = tiledb_attribute_create(ctx_, &a, ATTR_NAME, ATTR_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_t* b;
+  rc = tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_domain_t* domain;
+  rc = tiledb_domain_create(ctx_, &domain, DIM_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_domain_add_dimension(
+      ctx_, domain, DIM1_NAME, &dim_domain[0], &tile_extent);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_create(
+      ctx_, &array_metadata_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_capacity(ctx_, array_metadata_, 30);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_cell_order(
+      ctx_, array_metadata_, TILEDB_COL_MAJOR);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_array_type(ctx_, array_metadata_, ARRAY_TYPE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, a);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_add_attribute(ctx_, array_metadata_, b);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_metadata_set_domain(ctx_, array_metadata_, domain);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_metadata_);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_attribute_free(ctx_, a);
+  tiledb_attribute_free(ctx_, b);
+  tiledb_domain_free(ctx_, domain);
+  tiledb_array_metadata_free(ctx_, array_metadata_);
+
+  // Writes a fragment with the input coordinates and values of "a"
+  auto value = [](int64_t i) {
+    return std::string((uint64_t)(i % 7) + 1, (char)('a' + i % 26));
+  };
+  std::map<int64_t, int> cells;
+  auto write = [&](const std::vector<int64_t>& coords,
+                   const std::vector<int>& values) {
+    std::vector<uint64_t> write_offsets;
+    std::string write_values;
+    for (uint64_t i = 0; i < coords.size(); ++i) {
+      write_offsets.push_back(write_values.size());
+      write_values += value(coords[i]);
+      cells[coords[i]] = values[i];
+    }
+    void* buffers[] = {(void*)values.data(),
+                       write_offsets.data(),
+                       &write_values[0],
+                       (void*)coords.data()};
+    uint64_t buffer_sizes[] = {values.size() * sizeof(int),
+                               write_offsets.size() * sizeof(uint64_t),
+                               write_values.size(),
+                               coords.size() * sizeof(int64_t)};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_WRITE,
+        TILEDB_GLOBAL_ORDER,
+        nullptr,
+        nullptr,
+        0,
+        buffers,
+        buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  };
+
+  // Reads the cells satisfying "a > 900" and "a < 2000", along with "b"
+  // that is not involved in the predicates, and checks them against the
+  // latest values written
+  const int low = 900, high = 2000;
+  auto check_read = [&](tiledb_layout_t layout, uint64_t part_result_num) {
+    std::vector<int64_t> expected_coords;
+    std::vector<uint64_t> expected_offsets;
+    std::string expected_values;
+    for (auto& cell : cells) {
+      if (cell.second > low && cell.second < high) {
+        expected_coords.push_back(cell.first);
+        expected_offsets.push_back(expected_values.size());
+        expected_values += value(cell.first);
+      }
+    }
+
+    std::vector<uint64_t> part_offsets(part_result_num);
+    std::vector<char> part_values(8 * part_result_num);
+    std::vector<int64_t> part_coords(part_result_num);
+    void* buffers[] = {
+        part_offsets.data(), part_values.data(), part_coords.data()};
+    uint64_t buffer_sizes[3];
+    const char* attributes[] = {"b", TILEDB_COORDS};
+    tiledb_query_t* query;
+    rc = tiledb_query_create(
+        ctx_,
+        &query,
+        array_name_.c_str(),
+        TILEDB_READ,
+        layout,
+        nullptr,
+        attributes,
+        2,
+        buffers,
+        buffer_sizes);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_add_predicate(ctx_, query, ATTR_NAME, TILEDB_GT, &low);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_add_predicate(ctx_, query, ATTR_NAME, TILEDB_LT, &high);
+    REQUIRE(rc == TILEDB_OK);
+
+    // Gather the parts of the results
+    std::vector<uint64_t> read_offsets;
+    std::string read_values;
+    std::vector<int64_t> read_coords;
+    tiledb_query_status_t status;
+    do {
+      buffer_sizes[0] = part_offsets.size() * sizeof(uint64_t);
+      buffer_sizes[1] = part_values.size();
+      buffer_sizes[2] = part_coords.size() * sizeof(int64_t);
+      REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+      for (uint64_t i = 0; i < buffer_sizes[0] / sizeof(uint64_t); ++i)
+        read_offsets.push_back(read_values.size() + part_offsets[i]);
+      read_values.append(part_values.data(), buffer_sizes[1]);
+      read_coords.insert(
+          read_coords.end(),
+          part_coords.begin(),
+          part_coords.begin() + buffer_sizes[2] / sizeof(int64_t));
+      REQUIRE(tiledb_query_get_status(ctx_, query, &status) == TILEDB_OK);
+    } while (status == TILEDB_INCOMPLETE);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+
+    CHECK(read_coords == expected_coords);
+    CHECK(read_offsets == expected_offsets);
+    CHECK(read_values == expected_values);
+  };
+
+  // A single fragment, where "a" increases with the coordinates
+  std::vector<int64_t> coords;
+  std::vector<int> values;
+  for (int64_t i = 1; i <= cell_num; ++i) {
+    coords.push_back(i);
+    values.push_back((int)i);
+  }
+  write(coords, values);
+  check_read(TILEDB_GLOBAL_ORDER, cell_num);
+  check_read(TILEDB_GLOBAL_ORDER, 37);
+  check_read(TILEDB_ROW_MAJOR, 37);
+
+  // A newer fragment makes some cells satisfy the predicates and others
+  // not, including cells in tiles of the older fragment that are skipped
+  coords.clear();
+  values.clear();
+  for (int64_t i = 1; i <= 50; ++i) {
+    coords.push_back(i);
+    values.push_back(high - 1);
+  }
+  for (int64_t i = 921; i <= 950; ++i) {
+    coords.push_back(i);
+    values.push_back(0);
+  }
+  write(coords, values);
+  const char* block_nums[] = {"1", "4"};
+  for (auto block_num : block_nums) {
+    set_parallel_read_blocks(block_num);
+    check_read(TILEDB_GLOBAL_ORDER, cell_num);
+    check_read(TILEDB_GLOBAL_ORDER, 37);
+    check_read(TILEDB_ROW_MAJOR, 37);
+  }
+
+  // Invalid predicates
+  int64_t coords_value = 0;
+  void* buffers[] = {&coords_value};
+  uint64_t buffer_sizes[] = {sizeof(int64_t)};
+  const char* attributes[] = {TILEDB_COORDS};
+  tiledb_query_t* query;
+  rc = tiledb_query_create(
+      ctx_,
+      &query,
+      array_name_.c_str(),
+      TILEDB_READ,
+      TILEDB_GLOBAL_ORDER,
+      nullptr,
+      attributes,
+      1,
+      buffers,
+      buffer_sizes);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(
+      tiledb_query_add_predicate(ctx_, query, "b", TILEDB_EQ, "a") ==
+      TILEDB_ERR);
+  CHECK(
+      tiledb_query_add_predicate(
+          ctx_, query, TILEDB_COORDS, TILEDB_EQ, &coords_value) ==
+      TILEDB_ERR);
+  CHECK(
+      tiledb_query_add_predicate(ctx_, query, "foo", TILEDB_EQ, &low) ==
+      TILEDB_ERR);
+  REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
 }
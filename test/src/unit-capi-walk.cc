@@ -206,7 +206,7 @@ TEST_CASE("C API: Test walk", "[capi], [walk]") {
   create_golden_output(&golden);
 
   tiledb_ctx_t* ctx;
-  int rc = tiledb_ctx_create(&ctx);
+  int rc = tiledb_ctx_create(&ctx, nullptr);
   CHECK(rc == TILEDB_OK);
 
   // Preorder and postorder traversals
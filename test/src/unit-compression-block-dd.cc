@@ -0,0 +1,190 @@
+
+/**
+ * @file   unit-compression-block-dd.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the block double delta compression.
+ */
+
+#include "block_dd_compressor.h"
+#include "catch.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace tiledb;
+
+/**
+ * Compresses and decompresses the input values, checking that they
+ * round-trip, and returns the compressed size.
+ */
+template <class T>
+static uint64_t check_round_trip(Datatype type, const std::vector<T>& data) {
+  uint64_t nbytes = data.size() * sizeof(T);
+
+  // Compress
+  auto input = new ConstBuffer(data.data(), nbytes);
+  auto compressed = new Buffer();
+  Status st = BlockDoubleDelta::compress(type, input, compressed);
+  REQUIRE(st.ok());
+  CHECK(compressed->size() <= nbytes + BlockDoubleDelta::overhead(nbytes));
+  delete input;
+
+  // Decompress into a buffer of the exact size, which cannot grow
+  std::vector<T> decompressed_data(data.size() + 1);
+  auto decompressed = new Buffer(decompressed_data.data(), nbytes, false);
+  decompressed->reset_size();
+  input = new ConstBuffer(compressed->data(), compressed->size());
+  st = BlockDoubleDelta::decompress(type, input, decompressed);
+  REQUIRE(st.ok());
+  CHECK(input->end());
+  CHECK(decompressed->size() == nbytes);
+  CHECK(std::memcmp(data.data(), decompressed_data.data(), nbytes) == 0);
+
+  uint64_t compressed_size = compressed->size();
+  delete input;
+  delete compressed;
+  delete decompressed;
+
+  return compressed_size;
+}
+
+/** Checks various sequences of the input type. */
+template <class T>
+static void check_sequences(Datatype type) {
+  const uint64_t sizes[] = {1, 2, 3, 100, 130, 258, 1000};
+  std::mt19937_64 gen(123);
+
+  for (auto n : sizes) {
+    // Constant stride: all double deltas are zero
+    std::vector<T> data(n);
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = (T)(7 + 3 * i);
+    uint64_t frame_num = (n > 2) ? (n - 2 + 127) / 128 : 0;
+    CHECK(
+        check_round_trip(type, data) ==
+        sizeof(uint64_t) + std::min(n, (uint64_t)2) * sizeof(T) + frame_num);
+
+    // Small jitter around a stride, wrapping around the type range
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = (T)(5 * i + gen() % 4);
+    check_round_trip(type, data);
+
+    // Random values, which are stored as raw frames
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = (T)gen();
+    check_round_trip(type, data);
+
+    // Frames alternating between small and random double deltas
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = ((i / 128) % 2) ? (T)gen() : (T)(i * i);
+    check_round_trip(type, data);
+  }
+}
+
+TEST_CASE(
+    "Compression-BlockDoubleDelta: Test round trip for all types",
+    "[block-double-delta]") {
+  check_sequences<char>(Datatype::CHAR);
+  check_sequences<int8_t>(Datatype::INT8);
+  check_sequences<uint8_t>(Datatype::UINT8);
+  check_sequences<int16_t>(Datatype::INT16);
+  check_sequences<uint16_t>(Datatype::UINT16);
+  check_sequences<int32_t>(Datatype::INT32);
+  check_sequences<uint32_t>(Datatype::UINT32);
+  check_sequences<int64_t>(Datatype::INT64);
+  check_sequences<uint64_t>(Datatype::UINT64);
+}
+
+TEST_CASE(
+    "Compression-BlockDoubleDelta: Test every bitsize",
+    "[block-double-delta]") {
+  // Full and partial frames whose double deltas need exactly b bits
+  for (int b = 1; b <= 33; ++b) {
+    std::vector<int64_t> data(2 + 128 + 50);
+    int64_t delta = 0;
+    for (uint64_t i = 1; i < data.size(); ++i) {
+      // The zigzag encoding of -2^(b-1) is 2^b - 1
+      int64_t dd = (i % 3) ? -(int64_t)(i % 2) : -(((int64_t)1) << (b - 1));
+      delta += dd;
+      data[i] = data[i - 1] + delta;
+    }
+    uint64_t size = check_round_trip(Datatype::INT64, data);
+    uint64_t packed = (b <= 32) ? (16 * b + (50 * b + 7) / 8) : 178 * 8;
+    CHECK(size == sizeof(uint64_t) + 2 * sizeof(int64_t) + 2 + packed);
+  }
+}
+
+TEST_CASE(
+    "Compression-BlockDoubleDelta: Test invalid input",
+    "[block-double-delta]") {
+  Status st;
+
+  // Unsupported type
+  float values[] = {1.0, 2.0, 3.0};
+  auto input = new ConstBuffer(values, sizeof(values));
+  auto output = new Buffer();
+  st = BlockDoubleDelta::compress(Datatype::FLOAT32, input, output);
+  CHECK(!st.ok());
+  delete input;
+
+  // Input size not a multiple of the type size
+  int ints[] = {1, 2, 3};
+  input = new ConstBuffer(ints, sizeof(ints) - 1);
+  st = BlockDoubleDelta::compress(Datatype::INT32, input, output);
+  CHECK(!st.ok());
+  delete input;
+
+  // Truncated compressed data
+  std::vector<int> data(300);
+  for (uint64_t i = 0; i < data.size(); ++i)
+    data[i] = (int)(i * i);
+  input = new ConstBuffer(data.data(), data.size() * sizeof(int));
+  st = BlockDoubleDelta::compress(Datatype::INT32, input, output);
+  REQUIRE(st.ok());
+  delete input;
+  auto decompressed = new Buffer();
+  input = new ConstBuffer(output->data(), output->size() - 1);
+  st = BlockDoubleDelta::decompress(Datatype::INT32, input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Invalid bitsize
+  auto bitsize = (unsigned char*)output->data() + sizeof(uint64_t) +
+                 2 * sizeof(int);
+  *bitsize = 40;
+  input = new ConstBuffer(output->data(), output->size());
+  st = BlockDoubleDelta::decompress(Datatype::INT32, input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  delete decompressed;
+  delete output;
+}
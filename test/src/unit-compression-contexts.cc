@@ -0,0 +1,177 @@
+
+/**
+ * @file   unit-compression-contexts.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the reuse of the compression library contexts across calls.
+ */
+
+
+#include "bzip_compressor.h"
+#include "catch.hpp"
+#include "gzip_compressor.h"
+#include "lz4_compressor.h"
+#include "zstd_compressor.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace tiledb;
+
+/** The compressors whose library contexts are reused. */
+enum class Codec { BZIP2, GZIP, LZ4, ZSTD };
+
+/** Compresses the input with the input codec and level. */
+static Status compress(Codec codec, int level, ConstBuffer* in, Buffer* out) {
+  switch (codec) {
+    case Codec::BZIP2:
+      return BZip::compress(level, in, out);
+    case Codec::GZIP:
+      return GZip::compress(level, in, out);
+    case Codec::LZ4:
+      return LZ4::compress(level, in, out);
+    case Codec::ZSTD:
+      return ZStd::compress(level, in, out);
+  }
+  return Status::Ok();
+}
+
+/** Decompresses the input with the input codec. */
+static Status decompress(Codec codec, ConstBuffer* in, Buffer* out) {
+  switch (codec) {
+    case Codec::BZIP2:
+      return BZip::decompress(in, out);
+    case Codec::GZIP:
+      return GZip::decompress(in, out);
+    case Codec::LZ4:
+      return LZ4::decompress(in, out);
+    case Codec::ZSTD:
+      return ZStd::decompress(in, out);
+  }
+  return Status::Ok();
+}
+
+/** Returns the compression overhead of the input codec. */
+static uint64_t overhead(Codec codec, uint64_t nbytes) {
+  switch (codec) {
+    case Codec::BZIP2:
+      return BZip::overhead(nbytes);
+    case Codec::GZIP:
+      return GZip::overhead(nbytes);
+    case Codec::LZ4:
+      return LZ4::overhead(nbytes);
+    case Codec::ZSTD:
+      return ZStd::overhead(nbytes);
+  }
+  return 0;
+}
+
+/**
+ * Compresses and decompresses chunks of various sizes and contents with
+ * alternating levels, so that the contexts of the calling thread are reused
+ * in various states. Returns *true* if all the chunks round-trip.
+ */
+static bool check_round_trips(Codec codec, unsigned seed) {
+  const uint64_t sizes[] = {1, 100, 4096, 100000, 7, 65536};
+  const int levels[] = {-1, 1, 9, 3};
+  bool allok = true;
+  for (int i = 0; i < 12; ++i) {
+    uint64_t nbytes = sizes[i % 6];
+    std::vector<char> data(nbytes);
+    for (uint64_t j = 0; j < nbytes; ++j)
+      data[j] = (char)((j * (seed + i)) % ((i % 3) * 50 + 7));
+
+    Buffer compressed;
+    REQUIRE(compressed.realloc(nbytes + overhead(codec, nbytes)).ok());
+    ConstBuffer input(data.data(), nbytes);
+    Status st = compress(codec, levels[i % 4], &input, &compressed);
+    allok = allok && st.ok();
+
+    std::vector<char> decompressed_data(nbytes);
+    Buffer decompressed(decompressed_data.data(), nbytes, false);
+    decompressed.reset_size();
+    ConstBuffer compressed_input(compressed.data(), compressed.size());
+    st = decompress(codec, &compressed_input, &decompressed);
+    allok = allok && st.ok() && decompressed.size() == nbytes &&
+            !std::memcmp(data.data(), decompressed_data.data(), nbytes);
+  }
+  return allok;
+}
+
+TEST_CASE(
+    "Compression-Contexts: Test repeated and concurrent calls", "[contexts]") {
+  const Codec codecs[] = {Codec::BZIP2, Codec::GZIP, Codec::LZ4, Codec::ZSTD};
+  for (auto codec : codecs) {
+    // Calls on the same thread
+    CHECK(check_round_trips(codec, 1));
+    CHECK(check_round_trips(codec, 2));
+
+    // Calls on concurrent threads, each with its own contexts
+    const int thread_num = 4;
+    std::vector<std::thread> threads;
+    bool results[thread_num];
+    for (int t = 0; t < thread_num; ++t)
+      threads.emplace_back(
+          [&results, codec, t]() {
+            results[t] = check_round_trips(codec, 3 + t);
+          });
+    for (auto& thread : threads)
+      thread.join();
+    for (int t = 0; t < thread_num; ++t)
+      CHECK(results[t]);
+  }
+}
+
+TEST_CASE(
+    "Compression-Contexts: Test reuse after a failed call", "[contexts]") {
+  const Codec codecs[] = {Codec::BZIP2, Codec::GZIP, Codec::ZSTD};
+  for (auto codec : codecs) {
+    std::vector<char> data(10000, 'a');
+    Buffer compressed;
+    REQUIRE(compressed.realloc(data.size() + overhead(codec, 10000)).ok());
+    ConstBuffer input(data.data(), data.size());
+    REQUIRE(compress(codec, -1, &input, &compressed).ok());
+
+    // A truncated input fails midway, leaving the context in use
+    std::vector<char> decompressed_data(data.size());
+    Buffer decompressed(decompressed_data.data(), data.size(), false);
+    decompressed.reset_size();
+    ConstBuffer truncated(compressed.data(), compressed.size() / 2);
+    CHECK(!decompress(codec, &truncated, &decompressed).ok());
+
+    // An output buffer that is too small fails compression midway
+    Buffer small;
+    REQUIRE(small.realloc(2).ok());
+    CHECK(!compress(codec, -1, &input, &small).ok());
+
+    // The contexts are still usable
+    CHECK(check_round_trips(codec, 5));
+  }
+}
@@ -0,0 +1,195 @@
+
+/**
+ * @file   unit-compression-dictionary.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the dictionary encoding of variable-sized tiles.
+ */
+
+#include "catch.hpp"
+#include "dictionary_encoding.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tiledb;
+
+/**
+ * Encodes and decodes the input cells, checking that they round-trip, and
+ * returns the encoded buffer.
+ */
+static Buffer* check_round_trip(const std::vector<std::string>& cells) {
+  // Concatenate the cell values, with offsets that do not start from zero,
+  // as in the tiles of a fragment
+  std::string values;
+  std::vector<uint64_t> offsets;
+  for (const auto& cell : cells) {
+    offsets.push_back(1000 + values.size());
+    values += cell;
+  }
+
+  // Encode
+  auto input = new ConstBuffer(values.data(), values.size());
+  auto encoded = new Buffer();
+  Status st = DictionaryEncoding::encode(
+      offsets.data(), offsets.size(), input, encoded);
+  REQUIRE(st.ok());
+  CHECK(encoded->size() <= values.size() + sizeof(uint8_t));
+  delete input;
+
+  // Decode
+  auto decoded = new Buffer();
+  input = new ConstBuffer(encoded->data(), encoded->size());
+  st = DictionaryEncoding::decode(input, decoded);
+  REQUIRE(st.ok());
+  CHECK(input->end());
+  REQUIRE(decoded->size() == values.size());
+  CHECK(std::memcmp(decoded->data(), values.data(), values.size()) == 0);
+  delete input;
+  delete decoded;
+
+  return encoded;
+}
+
+/** Returns the encoding byte and the code size of an encoded tile. */
+static void get_encoding(
+    const Buffer* encoded, uint8_t* encoding, uint8_t* code_size) {
+  auto data = (const unsigned char*)encoded->data();
+  *encoding = data[0];
+  *code_size = (*encoding == DictionaryEncoding::DICTIONARY) ?
+                   data[sizeof(uint8_t) + 3 * sizeof(uint64_t)] :
+                   0;
+}
+
+TEST_CASE(
+    "Compression-Dictionary: Test low cardinality", "[dictionary]") {
+  const char* countries[] = {"Greece", "USA", "", "United Kingdom", "Peru"};
+  std::vector<std::string> cells;
+  for (int i = 0; i < 1000; ++i)
+    cells.push_back(countries[(i * 7) % 5]);
+
+  auto encoded = check_round_trip(cells);
+  uint8_t encoding, code_size;
+  get_encoding(encoded, &encoding, &code_size);
+  CHECK(encoding == DictionaryEncoding::DICTIONARY);
+  CHECK(code_size == 1);
+  CHECK(encoded->size() < 1100);
+  delete encoded;
+}
+
+TEST_CASE(
+    "Compression-Dictionary: Test high cardinality", "[dictionary]") {
+  // Distinct values are stored as they are
+  std::vector<std::string> cells;
+  char value[32];
+  for (int i = 0; i < 1000; ++i) {
+    std::snprintf(value, sizeof(value), "value_%d", i);
+    cells.push_back(value);
+  }
+  auto encoded = check_round_trip(cells);
+  uint8_t encoding, code_size;
+  get_encoding(encoded, &encoding, &code_size);
+  CHECK(encoding == DictionaryEncoding::RAW);
+  delete encoded;
+
+  // Small and empty inputs
+  cells.resize(1);
+  encoded = check_round_trip(cells);
+  get_encoding(encoded, &encoding, &code_size);
+  CHECK(encoding == DictionaryEncoding::RAW);
+  delete encoded;
+  cells.clear();
+  encoded = check_round_trip(cells);
+  CHECK(encoded->size() == sizeof(uint8_t));
+  delete encoded;
+}
+
+TEST_CASE("Compression-Dictionary: Test code sizes", "[dictionary]") {
+  const int distinct_nums[] = {256, 257, 65536, 65537};
+  const uint8_t code_sizes[] = {1, 2, 2, 4};
+  char value[32];
+  for (int k = 0; k < 4; ++k) {
+    // Every distinct value appears four times
+    std::vector<std::string> cells;
+    for (int i = 0; i < 4 * distinct_nums[k]; ++i) {
+      std::snprintf(
+          value, sizeof(value), "value_%010d", i % distinct_nums[k]);
+      cells.push_back(value);
+    }
+    auto encoded = check_round_trip(cells);
+    uint8_t encoding, code_size;
+    get_encoding(encoded, &encoding, &code_size);
+    CHECK(encoding == DictionaryEncoding::DICTIONARY);
+    CHECK(code_size == code_sizes[k]);
+    delete encoded;
+  }
+}
+
+TEST_CASE("Compression-Dictionary: Test invalid input", "[dictionary]") {
+  Status st;
+
+  // Offsets beyond the input
+  const char values[] = "aaaabbbbaaaabbbbaaaabbbbaaaabbbbaaaabbbb";
+  uint64_t offsets[] = {0, 4, 80};
+  auto input = new ConstBuffer(values, sizeof(values) - 1);
+  auto output = new Buffer();
+  st = DictionaryEncoding::encode(offsets, 3, input, output);
+  CHECK(!st.ok());
+  delete input;
+
+  // Truncated encoded data
+  std::vector<std::string> cells(200, "abcdefgh");
+  auto encoded = check_round_trip(cells);
+  auto decoded = new Buffer();
+  input = new ConstBuffer(encoded->data(), encoded->size() - 1);
+  st = DictionaryEncoding::decode(input, decoded);
+  CHECK(!st.ok());
+  delete input;
+
+  // Invalid code
+  auto data = (unsigned char*)encoded->data();
+  data[encoded->size() - 1] = 1;
+  input = new ConstBuffer(encoded->data(), encoded->size());
+  st = DictionaryEncoding::decode(input, decoded);
+  CHECK(!st.ok());
+  delete input;
+
+  // Invalid encoding
+  data[0] = 7;
+  input = new ConstBuffer(encoded->data(), encoded->size());
+  st = DictionaryEncoding::decode(input, decoded);
+  CHECK(!st.ok());
+  delete input;
+
+  delete decoded;
+  delete encoded;
+  delete output;
+}
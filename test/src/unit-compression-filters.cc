@@ -0,0 +1,160 @@
+
+/**
+ * @file   unit-compression-filters.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the pre-compression filters.
+ */
+
+#include "catch.hpp"
+#include "filter_kernels.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace tiledb;
+
+/** Applies and reverses the filter, checking that the data round-trip. */
+static void check_round_trip(
+    Filter filter, Datatype type, const std::vector<unsigned char>& data) {
+  std::vector<unsigned char> filtered(data.size() + 1);
+  std::vector<unsigned char> reversed(data.size() + 1);
+  REQUIRE(FilterKernels::apply(
+              filter, type, data.data(), data.size(), filtered.data())
+              .ok());
+  REQUIRE(FilterKernels::reverse(
+              filter, type, filtered.data(), data.size(), reversed.data())
+              .ok());
+  CHECK(std::memcmp(data.data(), reversed.data(), data.size()) == 0);
+}
+
+TEST_CASE("Filters: Test round trip", "[filters]") {
+  const Filter filters[] = {
+      Filter::NO_FILTER, Filter::BYTESHUFFLE, Filter::BITSHUFFLE};
+  const Datatype types[] = {Datatype::INT8,
+                            Datatype::INT16,
+                            Datatype::INT32,
+                            Datatype::INT64,
+                            Datatype::UINT32,
+                            Datatype::FLOAT32,
+                            Datatype::FLOAT64};
+  const uint64_t sizes[] = {0, 1, 7, 8, 15, 16, 17, 33, 100, 1000, 4099};
+  std::mt19937 gen(7);
+
+  for (auto size : sizes) {
+    std::vector<unsigned char> data(size);
+    for (auto& byte : data)
+      byte = (unsigned char)gen();
+    for (auto type : types) {
+      for (auto filter : filters)
+        check_round_trip(filter, type, data);
+      if (type != Datatype::FLOAT32 && type != Datatype::FLOAT64)
+        check_round_trip(Filter::DELTA, type, data);
+    }
+  }
+}
+
+TEST_CASE("Filters: Test byte shuffle", "[filters]") {
+  // 20 values of 4 bytes, so that both the vectorized and the scalar part
+  // are covered, plus a trailing byte
+  std::vector<unsigned char> data(81);
+  for (uint64_t i = 0; i < data.size(); ++i)
+    data[i] = (unsigned char)i;
+  std::vector<unsigned char> filtered(data.size());
+  REQUIRE(FilterKernels::apply(
+              Filter::BYTESHUFFLE,
+              Datatype::INT32,
+              data.data(),
+              data.size(),
+              filtered.data())
+              .ok());
+  for (uint64_t k = 0; k < 4; ++k) {
+    for (uint64_t i = 0; i < 20; ++i)
+      CHECK(filtered[k * 20 + i] == data[i * 4 + k]);
+  }
+  CHECK(filtered[80] == 80);
+}
+
+TEST_CASE("Filters: Test bit shuffle", "[filters]") {
+  // 24 values of 2 bytes, where only value i has bit (i % 16) set
+  std::vector<uint16_t> data(24);
+  for (uint64_t i = 0; i < data.size(); ++i)
+    data[i] = (uint16_t)(1 << (i % 16));
+  std::vector<unsigned char> filtered(data.size() * sizeof(uint16_t));
+  REQUIRE(FilterKernels::apply(
+              Filter::BITSHUFFLE,
+              Datatype::UINT16,
+              data.data(),
+              filtered.size(),
+              filtered.data())
+              .ok());
+
+  // Bit b of value i is in bit plane b, in byte i / 8 and bit i % 8
+  for (uint64_t b = 0; b < 16; ++b) {
+    for (uint64_t i = 0; i < data.size(); ++i) {
+      bool set = ((data[i] >> b) & 1) != 0;
+      CHECK(((filtered[b * 3 + i / 8] >> (i % 8)) & 1) == (set ? 1 : 0));
+    }
+  }
+}
+
+TEST_CASE("Filters: Test delta", "[filters]") {
+  std::vector<int64_t> data = {5, 7, 4, 4, INT64_MAX, INT64_MIN, 0};
+  std::vector<int64_t> filtered(data.size());
+  uint64_t nbytes = data.size() * sizeof(int64_t);
+  REQUIRE(FilterKernels::apply(
+              Filter::DELTA,
+              Datatype::INT64,
+              data.data(),
+              nbytes,
+              filtered.data())
+              .ok());
+  CHECK(filtered[0] == 5);
+  CHECK(filtered[1] == 2);
+  CHECK(filtered[2] == -3);
+  CHECK(filtered[3] == 0);
+  CHECK(filtered[5] == 1);
+  std::vector<int64_t> reversed(data.size());
+  REQUIRE(FilterKernels::reverse(
+              Filter::DELTA,
+              Datatype::INT64,
+              filtered.data(),
+              nbytes,
+              reversed.data())
+              .ok());
+  CHECK(reversed == data);
+
+  // Real values are not supported
+  float values[] = {1.0, 2.0};
+  float out[2];
+  CHECK(!FilterKernels::apply(
+             Filter::DELTA, Datatype::FLOAT32, values, sizeof(values), out)
+             .ok());
+}
@@ -0,0 +1,202 @@
+
+/**
+ * @file   unit-compression-gorilla.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017 TileDB Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the Gorilla compression.
+ */
+
+#include "catch.hpp"
+#include "gorilla_compressor.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tiledb;
+
+/**
+ * Compresses and decompresses the input values, checking that they
+ * round-trip bit for bit, and returns the compressed size.
+ */
+template <class T>
+static uint64_t check_round_trip(Datatype type, const std::vector<T>& data) {
+  uint64_t nbytes = data.size() * sizeof(T);
+
+  // Compress
+  auto input = new ConstBuffer(data.data(), nbytes);
+  auto compressed = new Buffer();
+  Status st = Gorilla::compress(type, input, compressed);
+  REQUIRE(st.ok());
+  CHECK(compressed->size() <= nbytes + Gorilla::overhead(nbytes));
+  delete input;
+
+  // Decompress into a buffer of the exact size, which cannot grow
+  std::vector<T> decompressed_data(data.size() + 1);
+  auto decompressed = new Buffer(decompressed_data.data(), nbytes, false);
+  decompressed->reset_size();
+  input = new ConstBuffer(compressed->data(), compressed->size());
+  st = Gorilla::decompress(type, input, decompressed);
+  REQUIRE(st.ok());
+  CHECK(input->end());
+  CHECK(decompressed->size() == nbytes);
+  CHECK(std::memcmp(data.data(), decompressed_data.data(), nbytes) == 0);
+
+  uint64_t compressed_size = compressed->size();
+  delete input;
+  delete compressed;
+  delete decompressed;
+
+  return compressed_size;
+}
+
+/** Checks various sequences of the input real type. */
+template <class T>
+static void check_sequences(Datatype type) {
+  const uint64_t sizes[] = {0, 1, 2, 3, 100, 1000};
+  std::mt19937_64 gen(123);
+  std::uniform_real_distribution<T> dist(-1e6, 1e6);
+
+  for (auto n : sizes) {
+    // Constant values: one bit per value after the first
+    std::vector<T> data(n, (T)3.25);
+    uint64_t bits = (n > 0) ? 8 * sizeof(T) + n - 1 : 0;
+    uint64_t size = check_round_trip(type, data);
+    if (n > 0)
+      CHECK(size == Gorilla::overhead(0) + (bits + 7) / 8);
+
+    // A smooth signal sampled on a grid, which compresses
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = (T)(100 + std::sin(i / 50.0));
+    size = check_round_trip(type, data);
+    if (n >= 100)
+      CHECK(size < n * sizeof(T));
+
+    // Random values, which are stored as they are
+    for (uint64_t i = 0; i < n; ++i)
+      data[i] = dist(gen);
+    size = check_round_trip(type, data);
+    if (n >= 100)
+      CHECK(size == Gorilla::overhead(0) + n * sizeof(T));
+  }
+
+  // Special values
+  std::vector<T> special = {(T)0.0,
+                            (T)-0.0,
+                            std::numeric_limits<T>::infinity(),
+                            -std::numeric_limits<T>::infinity(),
+                            std::numeric_limits<T>::quiet_NaN(),
+                            std::numeric_limits<T>::denorm_min(),
+                            std::numeric_limits<T>::max(),
+                            std::numeric_limits<T>::lowest(),
+                            (T)1.0,
+                            (T)1.0,
+                            (T)1.5};
+  check_round_trip(type, special);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test round trip for real types", "[gorilla]") {
+  check_sequences<float>(Datatype::FLOAT32);
+  check_sequences<double>(Datatype::FLOAT64);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test round trip for integer types", "[gorilla]") {
+  std::vector<int32_t> data32(500);
+  std::vector<uint64_t> data64(500);
+  for (uint64_t i = 0; i < data32.size(); ++i) {
+    data32[i] = (int32_t)(i * i) - 1000;
+    data64[i] = (i % 7 == 0) ? UINT64_MAX - i : i << 20;
+  }
+  check_round_trip(Datatype::INT32, data32);
+  check_round_trip(Datatype::UINT64, data64);
+}
+
+TEST_CASE(
+    "Compression-Gorilla: Test every meaningful bits window", "[gorilla]") {
+  // XORs with every combination of leading and trailing zeros, including
+  // leading zeros beyond the encodable maximum
+  std::vector<uint64_t> data(1, 0);
+  for (int lead = 0; lead < 64; ++lead) {
+    for (int trail = 0; lead + trail < 64; trail += 3) {
+      uint64_t x = (((uint64_t)1) << (63 - lead)) | (((uint64_t)1) << trail);
+      data.push_back(data.back() ^ x);
+      data.push_back(data.back() ^ x);
+    }
+  }
+  check_round_trip(Datatype::UINT64, data);
+}
+
+TEST_CASE("Compression-Gorilla: Test invalid input", "[gorilla]") {
+  Status st;
+
+  // Unsupported type
+  int16_t shorts[] = {1, 2, 3};
+  auto input = new ConstBuffer(shorts, sizeof(shorts));
+  auto output = new Buffer();
+  st = Gorilla::compress(Datatype::INT16, input, output);
+  CHECK(!st.ok());
+  delete input;
+
+  // Input size not a multiple of the type size
+  double doubles[] = {1.0, 2.0, 3.0};
+  input = new ConstBuffer(doubles, sizeof(doubles) - 1);
+  st = Gorilla::compress(Datatype::FLOAT64, input, output);
+  CHECK(!st.ok());
+  delete input;
+
+  // Truncated compressed data
+  std::vector<double> data(300);
+  for (uint64_t i = 0; i < data.size(); ++i)
+    data[i] = i / 4.0;
+  input = new ConstBuffer(data.data(), data.size() * sizeof(double));
+  st = Gorilla::compress(Datatype::FLOAT64, input, output);
+  REQUIRE(st.ok());
+  delete input;
+  auto encoding = (unsigned char*)output->data() + sizeof(uint64_t);
+  CHECK(*encoding == Gorilla::XOR);
+  auto decompressed = new Buffer();
+  input = new ConstBuffer(output->data(), output->size() - 1);
+  st = Gorilla::decompress(Datatype::FLOAT64, input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Invalid encoding
+  *encoding = 7;
+  input = new ConstBuffer(output->data(), output->size());
+  st = Gorilla::decompress(Datatype::FLOAT64, input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  delete decompressed;
+  delete output;
+}
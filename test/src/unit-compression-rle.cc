@@ -33,6 +33,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "catch.hpp"
 #include "rle_compressor.h"
@@ -105,7 +106,7 @@ TEST_CASE("Compression-RLE: Test all values unique", "[rle]") {
 
 TEST_CASE("Compression-RLE: Test all values the same", "[rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = sizeof(int) + 1;
   auto compressed = new Buffer();
   auto decompressed = new Buffer();
   tiledb::Status st;
@@ -125,7 +126,7 @@ TEST_CASE("Compression-RLE: Test all values the same", "[rle]") {
   auto input = new ConstBuffer(data, sizeof(data));
   st = tiledb::RLE::compress(sizeof(int), input, compressed);
   CHECK(st.ok());
-  CHECK(compressed->size() == run_size);
+  CHECK(compressed->size() == 1 + run_size);
   delete input;
 
   // Decompress data
@@ -143,7 +144,7 @@ TEST_CASE("Compression-RLE: Test all values the same", "[rle]") {
 
 TEST_CASE("Compression-RLE: Test a mix of short and long runs", "[rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = sizeof(int) + 1;
   tiledb::Status st;
 
   // Prepare data
@@ -164,7 +165,7 @@ TEST_CASE("Compression-RLE: Test a mix of short and long runs", "[rle]") {
   auto input = new ConstBuffer(data, sizeof(data));
   st = tiledb::RLE::compress(sizeof(int), input, compressed);
   CHECK(st.ok());
-  CHECK(compressed->size() == 21 * run_size);
+  CHECK(compressed->size() == 1 + 21 * run_size);
   delete input;
 
   // Decompress data
@@ -181,9 +182,9 @@ TEST_CASE("Compression-RLE: Test a mix of short and long runs", "[rle]") {
   delete decompressed;
 }
 
-TEST_CASE("Compression-RLE: Test when a run exceeds max run length", "[rle]") {
+TEST_CASE("Compression-RLE: Test a run longer than 65535 values", "[rle]") {
   // Initializations
-  uint64_t run_size = 6;
+  uint64_t run_size = sizeof(int) + 1;
   auto decompressed = new Buffer();
   tiledb::Status st;
 
@@ -205,7 +206,8 @@ TEST_CASE("Compression-RLE: Test when a run exceeds max run length", "[rle]") {
   auto input = new ConstBuffer(data, sizeof(data));
   st = tiledb::RLE::compress(sizeof(int), input, compressed);
   CHECK(st.ok());
-  CHECK(compressed->size() == 32 * run_size);
+  // The long run is not split, and its length takes three bytes
+  CHECK(compressed->size() == 1 + 30 * run_size + sizeof(int) + 3);
   delete input;
 
   // Decompress data
@@ -227,7 +229,7 @@ TEST_CASE(
   // Initializations
   tiledb::Status st;
   uint64_t value_size = 2 * sizeof(double);
-  uint64_t run_size = value_size + 2;
+  uint64_t run_size = value_size + 1;
 
   // Prepare data
   double data[220];
@@ -260,7 +262,7 @@ TEST_CASE(
   auto input = new ConstBuffer(data, sizeof(data));
   st = tiledb::RLE::compress(value_size, input, compressed);
   CHECK(st.ok());
-  CHECK(compressed->size() == 21 * run_size);
+  CHECK(compressed->size() == 1 + 21 * run_size);
   delete input;
 
   // Decompress data
@@ -276,3 +278,141 @@ TEST_CASE(
   delete compressed;
   delete decompressed;
 }
+
+TEST_CASE(
+    "Compression-RLE: Test runs around the vector width with various value "
+    "sizes",
+    "[rle]") {
+  const uint64_t run_lens[] = {
+      1, 2, 15, 16, 17, 31, 32, 33, 64, 127, 128, 129, 1000, 16385, 3};
+  const uint64_t value_sizes[] = {1, 2, 3, 4, 8, 16, 33};
+
+  for (auto value_size : value_sizes) {
+    // Prepare data, where consecutive runs differ in a single byte that
+    // moves across the value
+    std::vector<unsigned char> data;
+    uint64_t expected_size = 1;
+    int r = 0;
+    for (auto run_len : run_lens) {
+      std::vector<unsigned char> value(value_size, (unsigned char)value_size);
+      value[r % value_size] = (unsigned char)(r + 100);
+      for (uint64_t i = 0; i < run_len; ++i)
+        data.insert(data.end(), value.begin(), value.end());
+      expected_size += value_size;
+      for (uint64_t len = run_len; len >= 0x80; len >>= 7)
+        ++expected_size;
+      ++expected_size;
+      ++r;
+    }
+
+    // Compress
+    auto compressed = new Buffer();
+    auto input = new ConstBuffer(&data[0], data.size());
+    Status st = tiledb::RLE::compress(value_size, input, compressed);
+    CHECK(st.ok());
+    CHECK(compressed->size() == expected_size);
+    CHECK(
+        compressed->size() <=
+        data.size() + tiledb::RLE::overhead(data.size(), value_size));
+    delete input;
+
+    // Decompress into a buffer that does not own its data
+    std::vector<unsigned char> decompressed_data(data.size());
+    auto decompressed =
+        new Buffer(&decompressed_data[0], decompressed_data.size(), false);
+    decompressed->reset_size();
+    input = new ConstBuffer(compressed->data(), compressed->size());
+    st = tiledb::RLE::decompress(value_size, input, decompressed);
+    CHECK(st.ok());
+    CHECK(decompressed->size() == data.size());
+    CHECK_FALSE(memcmp(&data[0], &decompressed_data[0], data.size()));
+
+    delete input;
+    delete compressed;
+    delete decompressed;
+  }
+}
+
+TEST_CASE("Compression-RLE: Test invalid compressed data", "[rle]") {
+  auto decompressed = new Buffer();
+  Status st;
+
+  // Unsupported format version
+  unsigned char version[] = {1, 0, 0, 0, 0, 1};
+  auto input = new ConstBuffer(version, sizeof(version));
+  st = tiledb::RLE::decompress(sizeof(int), input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Truncated value
+  unsigned char value[] = {2, 7, 0, 0};
+  input = new ConstBuffer(value, sizeof(value));
+  st = tiledb::RLE::decompress(sizeof(int), input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Truncated run length
+  unsigned char run_len[] = {2, 7, 0x80};
+  input = new ConstBuffer(run_len, sizeof(run_len));
+  st = tiledb::RLE::decompress(sizeof(char), input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Empty run
+  unsigned char empty_run[] = {2, 7, 0};
+  input = new ConstBuffer(empty_run, sizeof(empty_run));
+  st = tiledb::RLE::decompress(sizeof(char), input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  // Run exceeding an output buffer that cannot grow
+  unsigned char long_run[] = {2, 7, 0x80, 0x01};
+  char output[100];
+  auto fixed = new Buffer(output, sizeof(output), false);
+  fixed->reset_size();
+  input = new ConstBuffer(long_run, sizeof(long_run));
+  st = tiledb::RLE::decompress(sizeof(char), input, fixed);
+  CHECK(!st.ok());
+  delete input;
+  delete fixed;
+
+  delete decompressed;
+}
+
+TEST_CASE("Compression-RLE: Test legacy format", "[rle]") {
+  // Runs of 2-byte values, each followed by a 2-byte run length (most
+  // significant byte first), as written by earlier versions
+  unsigned char legacy[] = {2, 0, 0, 3, 7, 1, 1, 2};
+  auto input = new ConstBuffer(legacy, sizeof(legacy));
+  auto decompressed = new Buffer();
+  Status st = tiledb::RLE::decompress_legacy(2, input, decompressed);
+  REQUIRE(st.ok());
+  REQUIRE(decompressed->size() == 2 * (3 + 258));
+  auto data = (const unsigned char*)decompressed->data();
+  for (uint64_t i = 0; i < 3; ++i) {
+    CHECK(data[2 * i] == 2);
+    CHECK(data[2 * i + 1] == 0);
+  }
+  for (uint64_t i = 3; i < 3 + 258; ++i) {
+    CHECK(data[2 * i] == 7);
+    CHECK(data[2 * i + 1] == 1);
+  }
+  delete input;
+
+  // The legacy data cannot be decoded as the current format, whose version
+  // byte they happen to start with
+  input = new ConstBuffer(legacy, sizeof(legacy));
+  decompressed->reset_size();
+  decompressed->reset_offset();
+  st = tiledb::RLE::decompress(2, input, decompressed);
+  CHECK((!st.ok() || decompressed->size() != 2 * (3 + 258)));
+  delete input;
+
+  // Truncated run
+  input = new ConstBuffer(legacy, sizeof(legacy) - 1);
+  st = tiledb::RLE::decompress_legacy(2, input, decompressed);
+  CHECK(!st.ok());
+  delete input;
+
+  delete decompressed;
+}
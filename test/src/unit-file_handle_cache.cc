@@ -0,0 +1,116 @@
+#include <file_handle_cache.h>
+#include <posix_filesystem.h>
+#include <catch.hpp>
+
+#include <fcntl.h>
+#include <cstring>
+
+using namespace tiledb;
+
+struct FileHandleCacheFx {
+  const std::string TEMP_DIR = posix::current_dir() + "/tiledb_fd_cache_test";
+
+  FileHandleCacheFx() {
+    posix::remove_path(TEMP_DIR);
+    REQUIRE(posix::create_dir(TEMP_DIR).ok());
+    for (int i = 0; i < 3; ++i)
+      REQUIRE(posix::write_to_file(file(i), "abcd", 4).ok());
+  }
+
+  ~FileHandleCacheFx() {
+    posix::remove_path(TEMP_DIR);
+  }
+
+  std::string file(int i) const {
+    return TEMP_DIR + "/file_" + std::to_string(i);
+  }
+};
+
+TEST_CASE_METHOD(
+    FileHandleCacheFx, "FileHandleCache: Test LRU eviction", "[fd_cache]") {
+  FileHandleCache cache(2);
+  std::shared_ptr<FileHandle> h0, h1, h2, h;
+
+  REQUIRE(cache.get(file(0), O_RDONLY, &h0).ok());
+  REQUIRE(cache.get(file(1), O_RDONLY, &h1).ok());
+  CHECK(cache.size() == 2);
+
+  // A hit returns the cached descriptor and makes it most recently used
+  REQUIRE(cache.get(file(0), O_RDONLY, &h).ok());
+  CHECK(h->fd() == h0->fd());
+
+  // The least recently used file (file_1) is evicted
+  REQUIRE(cache.get(file(2), O_RDONLY, &h2).ok());
+  CHECK(cache.size() == 2);
+  REQUIRE(cache.get(file(0), O_RDONLY, &h).ok());
+  CHECK(h->fd() == h0->fd());
+  REQUIRE(cache.get(file(1), O_RDONLY, &h).ok());
+  CHECK(h->fd() != h1->fd());
+
+  // An evicted handle remains usable by its holder
+  char data[4];
+  CHECK(posix::read_from_file(h1->fd(), 0, data, 4).ok());
+  CHECK(!memcmp(data, "abcd", 4));
+
+  // Opening a missing file fails
+  CHECK(!cache.get(file(3), O_RDONLY, &h).ok());
+}
+
+TEST_CASE_METHOD(
+    FileHandleCacheFx, "FileHandleCache: Test invalidation", "[fd_cache]") {
+  FileHandleCache cache(10);
+  std::shared_ptr<FileHandle> h;
+
+  REQUIRE(cache.get(file(0), O_RDONLY, &h).ok());
+  REQUIRE(cache.get(file(0), O_WRONLY | O_APPEND, &h).ok());
+  REQUIRE(cache.get(file(1), O_RDONLY, &h).ok());
+  CHECK(cache.size() == 3);
+
+  // Releasing drops a single (path, flags) entry
+  cache.release(file(0), O_WRONLY | O_APPEND);
+  CHECK(cache.size() == 2);
+
+  // Invalidating a file drops only that file
+  cache.invalidate(file(1));
+  CHECK(cache.size() == 1);
+
+  // Invalidating a directory drops everything below it, but not paths
+  // that merely share its prefix
+  cache.invalidate(TEMP_DIR + "/file");
+  CHECK(cache.size() == 1);
+  cache.invalidate(TEMP_DIR + "/");
+  CHECK(cache.size() == 0);
+
+  // With a zero bound nothing is cached
+  FileHandleCache no_cache(0);
+  REQUIRE(no_cache.get(file(0), O_RDONLY, &h).ok());
+  CHECK(no_cache.size() == 0);
+}
+
+TEST_CASE_METHOD(
+    FileHandleCacheFx, "FileHandleCache: Test revalidation", "[fd_cache]") {
+  FileHandleCache cache(10);
+  std::shared_ptr<FileHandle> h0, h;
+  char data[4];
+
+  REQUIRE(cache.get(file(0), O_RDONLY, &h0).ok());
+
+  // Replacing the file behind the back of the cache reopens it upon a hit
+  REQUIRE(posix::remove_file(file(0)).ok());
+  REQUIRE(posix::write_to_file(file(0), "efgh", 4).ok());
+  REQUIRE(cache.get(file(0), O_RDONLY, &h).ok());
+  CHECK(h->fd() != h0->fd());
+  CHECK(cache.size() == 1);
+  CHECK(posix::read_from_file(h->fd(), 0, data, 4).ok());
+  CHECK(!memcmp(data, "efgh", 4));
+
+  // The reopened descriptor is cached
+  std::shared_ptr<FileHandle> h1;
+  REQUIRE(cache.get(file(0), O_RDONLY, &h1).ok());
+  CHECK(h1->fd() == h->fd());
+
+  // A removed file is not served from the cache
+  REQUIRE(posix::remove_file(file(0)).ok());
+  CHECK(!cache.get(file(0), O_RDONLY, &h).ok());
+  CHECK(cache.size() == 0);
+}
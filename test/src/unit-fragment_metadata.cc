@@ -0,0 +1,209 @@
+#include <constants.h>
+#include <fragment_metadata.h>
+#include <posix_filesystem.h>
+#include <storage_manager.h>
+#include <tiledb.h>
+#include <catch.hpp>
+
+#include <cstring>
+#include <vector>
+
+using namespace tiledb;
+
+struct FragmentMetadataFx {
+  const std::string TEMP_DIR =
+      posix::current_dir() + "/tiledb_fragment_metadata_test";
+  const std::string ARRAY = TEMP_DIR + "/array";
+  const int64_t CELL_NUM = 20;
+  const uint64_t CAPACITY = 4;
+
+  tiledb_ctx_t* ctx_;
+
+  FragmentMetadataFx() {
+    REQUIRE(tiledb_ctx_create(&ctx_, nullptr) == TILEDB_OK);
+    posix::remove_path(TEMP_DIR);
+    REQUIRE(posix::create_dir(TEMP_DIR).ok());
+  }
+
+  ~FragmentMetadataFx() {
+    posix::remove_path(TEMP_DIR);
+    tiledb_ctx_free(ctx_);
+  }
+
+  void create_array() {
+    // Attribute "a" is fixed-sized, and "b" variable-sized
+    tiledb_attribute_t* a;
+    REQUIRE(tiledb_attribute_create(ctx_, &a, "a", TILEDB_INT32) == TILEDB_OK);
+    tiledb_attribute_t* b;
+    REQUIRE(tiledb_attribute_create(ctx_, &b, "b", TILEDB_CHAR) == TILEDB_OK);
+    REQUIRE(
+        tiledb_attribute_set_cell_val_num(ctx_, b, TILEDB_VAR_NUM) ==
+        TILEDB_OK);
+
+    int64_t dim_domain[] = {1, 100};
+    int64_t tile_extent = 10;
+    tiledb_domain_t* domain;
+    REQUIRE(tiledb_domain_create(ctx_, &domain, TILEDB_INT64) == TILEDB_OK);
+    REQUIRE(
+        tiledb_domain_add_dimension(
+            ctx_, domain, "d", &dim_domain[0], &tile_extent) == TILEDB_OK);
+
+    tiledb_array_metadata_t* array_metadata;
+    REQUIRE(
+        tiledb_array_metadata_create(ctx_, &array_metadata, ARRAY.c_str()) ==
+        TILEDB_OK);
+    REQUIRE(
+        tiledb_array_metadata_set_array_type(
+            ctx_, array_metadata, TILEDB_SPARSE) == TILEDB_OK);
+    REQUIRE(
+        tiledb_array_metadata_set_capacity(ctx_, array_metadata, CAPACITY) ==
+        TILEDB_OK);
+    REQUIRE(
+        tiledb_array_metadata_add_attribute(ctx_, array_metadata, a) ==
+        TILEDB_OK);
+    REQUIRE(
+        tiledb_array_metadata_add_attribute(ctx_, array_metadata, b) ==
+        TILEDB_OK);
+    REQUIRE(
+        tiledb_array_metadata_set_domain(ctx_, array_metadata, domain) ==
+        TILEDB_OK);
+    REQUIRE(tiledb_array_create(ctx_, array_metadata) == TILEDB_OK);
+
+    tiledb_attribute_free(ctx_, a);
+    tiledb_attribute_free(ctx_, b);
+    tiledb_domain_free(ctx_, domain);
+    tiledb_array_metadata_free(ctx_, array_metadata);
+  }
+
+  void write_array() {
+    std::vector<int> a(CELL_NUM);
+    std::vector<uint64_t> b_offsets(CELL_NUM);
+    std::string b_values;
+    std::vector<int64_t> coords(CELL_NUM);
+    for (int64_t i = 0; i < CELL_NUM; ++i) {
+      a[i] = (int)i;
+      b_offsets[i] = b_values.size();
+      b_values += std::string(i % 3 + 1, (char)('a' + i % 26));
+      coords[i] = 3 * i + 1;
+    }
+
+    void* buffers[] = {&a[0], &b_offsets[0], &b_values[0], &coords[0]};
+    uint64_t buffer_sizes[] = {CELL_NUM * sizeof(int),
+                               CELL_NUM * sizeof(uint64_t),
+                               b_values.size(),
+                               CELL_NUM * sizeof(int64_t)};
+    tiledb_query_t* query;
+    REQUIRE(
+        tiledb_query_create(
+            ctx_,
+            &query,
+            ARRAY.c_str(),
+            TILEDB_WRITE,
+            TILEDB_GLOBAL_ORDER,
+            nullptr,
+            nullptr,
+            0,
+            buffers,
+            buffer_sizes) == TILEDB_OK);
+    REQUIRE(tiledb_query_submit(ctx_, query) == TILEDB_OK);
+    REQUIRE(tiledb_query_free(ctx_, query) == TILEDB_OK);
+  }
+
+  URI fragment_uri() const {
+    std::vector<std::string> paths;
+    REQUIRE(posix::ls(ARRAY, &paths).ok());
+    for (const auto& path : paths) {
+      if (posix::is_dir(path))
+        return URI(path);
+    }
+    FAIL("No fragment found");
+    return URI();
+  }
+};
+
+TEST_CASE_METHOD(
+    FragmentMetadataFx,
+    "FragmentMetadata: Test lazy section loading",
+    "[fragment_metadata]") {
+  create_array();
+  write_array();
+
+  StorageManager storage_manager;
+  REQUIRE(storage_manager.init(nullptr).ok());
+  ArrayMetadata array_metadata((URI(ARRAY)));
+  REQUIRE(storage_manager.load(ARRAY, &array_metadata).ok());
+  FragmentMetadata metadata(&array_metadata, false, fragment_uri());
+
+  // Only the footer is loaded at first
+  REQUIRE(storage_manager.load(&metadata).ok());
+  uint64_t tile_num = (CELL_NUM + CAPACITY - 1) / CAPACITY;
+  CHECK(metadata.tile_num() == tile_num);
+  CHECK(metadata.last_tile_cell_num() == CAPACITY);
+  CHECK(metadata.non_empty_domain() != nullptr);
+  for (unsigned int i = 0; i < 3; ++i)
+    CHECK(metadata.version()[i] == constants::version[i]);
+  CHECK(metadata.mbr_num() == 0);
+  for (unsigned int i = 0; i < 3; ++i)
+    CHECK(metadata.tile_offsets()[i].empty());
+  CHECK(metadata.tile_var_offsets()[1].empty());
+
+  // Load the sections needed to read "b"
+  REQUIRE(metadata.load_sections(&storage_manager, {1}).ok());
+  CHECK(metadata.mbr_num() == tile_num);
+  CHECK(metadata.tile_offsets()[0].empty());
+  CHECK(metadata.tile_offsets()[1].size() == tile_num);
+  CHECK(metadata.tile_offsets()[2].size() == tile_num);
+  CHECK(metadata.tile_var_offsets()[1].size() == tile_num);
+  CHECK(metadata.tile_var_sizes()[1].size() == tile_num);
+  int64_t mbr[2];
+  metadata.get_mbr(1, mbr);
+  CHECK(mbr[0] == 3 * CAPACITY + 1);
+  CHECK(mbr[1] == 3 * (2 * CAPACITY - 1) + 1);
+  auto mbr_lows = (const int64_t*)metadata.mbr_bounds(0, false);
+  auto mbr_highs = (const int64_t*)metadata.mbr_bounds(0, true);
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    CHECK(mbr_lows[i] == 3 * (int64_t)(i * CAPACITY) + 1);
+    CHECK(mbr_highs[i] == 3 * (int64_t)((i + 1) * CAPACITY - 1) + 1);
+  }
+  auto bounding_coords = (const int64_t*)metadata.bounding_coords(tile_num - 1);
+  CHECK(bounding_coords[0] == 3 * (CELL_NUM - CAPACITY) + 1);
+  CHECK(bounding_coords[1] == 3 * (CELL_NUM - 1) + 1);
+
+  // Loading again is a no-op, and further sections are added
+  REQUIRE(metadata.load_sections(&storage_manager, {0, 1}).ok());
+  CHECK(metadata.mbr_num() == tile_num);
+  CHECK(metadata.tile_offsets()[0].size() == tile_num);
+  CHECK(metadata.tile_offsets()[0][0] == 0);
+  CHECK(metadata.tile_offsets()[1].size() == tile_num);
+}
+
+TEST_CASE_METHOD(
+    FragmentMetadataFx,
+    "FragmentMetadata: Test tile statistics",
+    "[fragment_metadata][predicate]") {
+  create_array();
+  write_array();
+
+  StorageManager storage_manager;
+  REQUIRE(storage_manager.init(nullptr).ok());
+  ArrayMetadata array_metadata((URI(ARRAY)));
+  REQUIRE(storage_manager.load(ARRAY, &array_metadata).ok());
+  CHECK(array_metadata.has_tile_stats(0));
+  CHECK(!array_metadata.has_tile_stats(1));
+  CHECK(!array_metadata.has_tile_stats(2));
+  FragmentMetadata metadata(&array_metadata, false, fragment_uri());
+  REQUIRE(storage_manager.load(&metadata).ok());
+
+  // The statistics are loaded along with the section of the attribute
+  uint64_t tile_num = (CELL_NUM + CAPACITY - 1) / CAPACITY;
+  CHECK(metadata.tile_stats_num(0) == 0);
+  REQUIRE(metadata.load_sections(&storage_manager, {0, 1}).ok());
+  REQUIRE(metadata.tile_stats_num(0) == tile_num);
+  CHECK(metadata.tile_stats_num(1) == 0);
+  auto mins = (const int*)metadata.tile_stats(0, false);
+  auto maxs = (const int*)metadata.tile_stats(0, true);
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    CHECK(mins[i] == (int)(i * CAPACITY));
+    CHECK(maxs[i] == (int)((i + 1) * CAPACITY - 1));
+  }
+}
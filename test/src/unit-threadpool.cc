@@ -0,0 +1,69 @@
+#include <thread_pool.h>
+#include <catch.hpp>
+
+#include <atomic>
+
+using namespace tiledb;
+
+TEST_CASE("ThreadPool: Test init", "[threadpool]") {
+  ThreadPool pool;
+  CHECK(!pool.init(0).ok());
+  CHECK(pool.init(4).ok());
+  CHECK(pool.thread_num() == 4);
+  CHECK(!pool.init(4).ok());
+}
+
+TEST_CASE("ThreadPool: Test enqueue and wait", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> tasks;
+  for (int i = 0; i < 100; ++i) {
+    tasks.push_back(pool.enqueue([&result]() {
+      ++result;
+      return Status::Ok();
+    }));
+  }
+  CHECK(pool.wait_all(tasks).ok());
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test error status", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(2).ok());
+
+  std::vector<std::future<Status>> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.push_back(pool.enqueue([i]() {
+      return (i == 5) ? Status::Error("task failed") : Status::Ok();
+    }));
+  }
+  Status st = pool.wait_all(tasks);
+  CHECK(!st.ok());
+  CHECK_THAT(st.message(), Catch::Equals("task failed"));
+}
+
+TEST_CASE("ThreadPool: Test nested tasks", "[threadpool]") {
+  // Every worker waits on tasks it enqueued itself, which must not
+  // deadlock even with a single worker thread
+  ThreadPool pool;
+  REQUIRE(pool.init(1).ok());
+
+  std::atomic<int> result(0);
+  std::vector<std::future<Status>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(pool.enqueue([&pool, &result]() {
+      std::vector<std::future<Status>> inner_tasks;
+      for (int j = 0; j < 10; ++j) {
+        inner_tasks.push_back(pool.enqueue([&result]() {
+          ++result;
+          return Status::Ok();
+        }));
+      }
+      return pool.wait_all(inner_tasks);
+    }));
+  }
+  CHECK(pool.wait_all(tasks).ok());
+  CHECK(result == 40);
+}
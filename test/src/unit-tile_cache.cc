@@ -0,0 +1,82 @@
+#include <tile_cache.h>
+#include <catch.hpp>
+
+#include <cstring>
+
+using namespace tiledb;
+
+TEST_CASE("TileCache: Test hits, misses and eviction", "[tile_cache]") {
+  TileCache cache(10);
+  URI frag_1("file:///array/__frag_1");
+  URI frag_2("file:///array/__frag_2");
+  char data[6] = {1, 2, 3, 4, 5, 6};
+  Buffer tile(data, sizeof(data), false);
+  Buffer out;
+  bool hit;
+
+  // Miss
+  REQUIRE(cache.read(frag_1, 0, 0, false, &out, &hit).ok());
+  CHECK(!hit);
+  CHECK(cache.misses() == 1);
+
+  // Hit after insertion
+  REQUIRE(cache.insert(frag_1, 0, 0, false, &tile).ok());
+  CHECK(cache.size() == 6);
+  REQUIRE(cache.read(frag_1, 0, 0, false, &out, &hit).ok());
+  CHECK(hit);
+  CHECK(cache.hits() == 1);
+  CHECK(out.size() == 6);
+  CHECK(out.offset() == 0);
+  CHECK(!memcmp(out.data(), data, 6));
+
+  // The attribute, tile index and var flag are all part of the key
+  REQUIRE(cache.read(frag_1, 1, 0, false, &out, &hit).ok());
+  CHECK(!hit);
+  REQUIRE(cache.read(frag_1, 0, 1, false, &out, &hit).ok());
+  CHECK(!hit);
+  REQUIRE(cache.read(frag_1, 0, 0, true, &out, &hit).ok());
+  CHECK(!hit);
+
+  // Exceeding the budget evicts the least recently used tile
+  REQUIRE(cache.insert(frag_2, 0, 0, false, &tile).ok());
+  CHECK(cache.size() == 6);
+  REQUIRE(cache.read(frag_1, 0, 0, false, &out, &hit).ok());
+  CHECK(!hit);
+  REQUIRE(cache.read(frag_2, 0, 0, false, &out, &hit).ok());
+  CHECK(hit);
+
+  // Tiles larger than the cache are not inserted
+  char large_data[11] = {};
+  Buffer large_tile(large_data, sizeof(large_data), false);
+  REQUIRE(cache.insert(frag_1, 0, 0, false, &large_tile).ok());
+  CHECK(cache.size() == 6);
+}
+
+TEST_CASE("TileCache: Test invalidation", "[tile_cache]") {
+  TileCache cache(100);
+  URI frag_1("file:///array/__frag_1");
+  URI frag_10("file:///array/__frag_10");
+  URI other("file:///other_array/__frag_1");
+  char data[4] = {1, 2, 3, 4};
+  Buffer tile(data, sizeof(data), false);
+  Buffer out;
+  bool hit;
+
+  REQUIRE(cache.insert(frag_1, 0, 0, false, &tile).ok());
+  REQUIRE(cache.insert(frag_1, 0, 0, true, &tile).ok());
+  REQUIRE(cache.insert(frag_10, 0, 0, false, &tile).ok());
+  REQUIRE(cache.insert(other, 0, 0, false, &tile).ok());
+  CHECK(cache.size() == 16);
+
+  // Invalidating a fragment does not affect fragments sharing its prefix
+  cache.invalidate(frag_1);
+  CHECK(cache.size() == 8);
+  REQUIRE(cache.read(frag_10, 0, 0, false, &out, &hit).ok());
+  CHECK(hit);
+
+  // Invalidating an array drops all its fragments
+  cache.invalidate(URI("file:///array"));
+  CHECK(cache.size() == 4);
+  REQUIRE(cache.read(other, 0, 0, false, &out, &hit).ok());
+  CHECK(hit);
+}